@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+
+#include <SCEDA/common.h>
+#include <SCEDA/hashmap.h>
+#include <SCEDA/chashmap.h>
+
+#define THREADS 4
+#define KEYS 100000
+#define OPERATIONS 2000000
+
+int keys[KEYS];
+
+// a map shared through a global lock...
+SCEDA_HashMap *map;
+pthread_mutex_t map_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// ... or a concurrent map
+SCEDA_CHashMap *cmap;
+
+int match_int(int *x, int *y) {
+  return *x == *y;
+}
+
+unsigned int hash_int(int *x) {
+  return *x;
+}
+
+double elapsed(struct timespec *start) {
+  struct timespec end;
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  return (end.tv_sec - start->tv_sec) + (end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+// 4 lookups for 1 update
+void *work_locked(void *arg) {
+  unsigned int seed = (unsigned int)(long)arg;
+  int i;
+  for(i = 0; i < OPERATIONS; i++) {
+    int *key = &keys[rand_r(&seed) % KEYS];
+    pthread_mutex_lock(&map_lock);
+    if(i % 5 == 0) {
+      SCEDA_hashmap_put(map, key, key, NULL);
+    } else {
+      SCEDA_hashmap_get(map, key);
+    }
+    pthread_mutex_unlock(&map_lock);
+  }
+  return NULL;
+}
+
+void *work_concurrent(void *arg) {
+  unsigned int seed = (unsigned int)(long)arg;
+  int i;
+  for(i = 0; i < OPERATIONS; i++) {
+    int *key = &keys[rand_r(&seed) % KEYS];
+    if(i % 5 == 0) {
+      SCEDA_chashmap_put(cmap, key, key, NULL);
+    } else {
+      SCEDA_chashmap_get(cmap, key);
+    }
+  }
+  return NULL;
+}
+
+double run(void *(*work)(void *)) {
+  pthread_t threads[THREADS];
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  int t;
+  for(t = 0; t < THREADS; t++) {
+    pthread_create(&threads[t], NULL, work, (void *)(long)(t + 1));
+  }
+  for(t = 0; t < THREADS; t++) {
+    pthread_join(threads[t], NULL);
+  }
+  return elapsed(&start);
+}
+
+int main(int argc, char *argv[]) {
+  int i;
+  for(i = 0; i < KEYS; i++) {
+    keys[i] = i;
+  }
+
+  fprintf(stdout, "%d threads, %d operations each (80%% get, 20%% put)\n", THREADS, OPERATIONS);
+
+  map = SCEDA_hashmap_create(NULL, NULL, (SCEDA_match_fun)match_int, (SCEDA_hash_fun)hash_int);
+  double t = run(work_locked);
+  fprintf(stdout, "SCEDA_HashMap + global lock: %d bindings (%.3fs)\n", SCEDA_hashmap_size(map), t);
+  SCEDA_hashmap_delete(map);
+
+  cmap = SCEDA_chashmap_create(NULL, NULL, (SCEDA_match_fun)match_int, (SCEDA_hash_fun)hash_int);
+  t = run(work_concurrent);
+  fprintf(stdout, "SCEDA_CHashMap: %d bindings (%.3fs)\n", SCEDA_chashmap_size(cmap), t);
+  SCEDA_chashmap_delete(cmap);
+
+  return 0;
+}
@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <SCEDA/common.h>
+#include <SCEDA/hashset.h>
+#include <SCEDA/hashmap.h>
+#include <SCEDA/graph.h>
+#include <SCEDA/graph_flow.h>
+
+#define LAYERS 40
+#define WIDTH 50
+#define DEGREE 4
+
+#define ROUNDS 500
+
+#define KEYS (1 << 16)
+#define LOOKUPS (1 << 23)
+
+int get_capacity(SCEDA_Edge *e, void *ctxt) {
+  return SCEDA_edge_get_data(int *, e)[0];
+}
+
+int match_key(const void *x, const void *y) {
+  return (x == y);
+}
+
+unsigned int hash_key(const void *x) {
+  return (unsigned int)(long)x * 2654435769u;
+}
+
+const char *layout_name[] = { "open", "ordered", "swiss" };
+
+double elapsed(clock_t start) {
+  return ((double)(clock() - start)) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char *argv[]) {
+  srand(1);
+
+  // layered network: s -> layer 0 -> ... -> layer LAYERS-1 -> t
+  SCEDA_Graph *g = SCEDA_graph_create(NULL, free);
+
+  SCEDA_Vertex *s = SCEDA_graph_add_vertex(g, NULL);
+  SCEDA_Vertex *t = SCEDA_graph_add_vertex(g, NULL);
+  SCEDA_Vertex *layer[LAYERS][WIDTH];
+
+  int i, j, k;
+  for(i = 0; i < LAYERS; i++) {
+    for(j = 0; j < WIDTH; j++) {
+      layer[i][j] = SCEDA_graph_add_vertex(g, NULL);
+    }
+  }
+
+  for(j = 0; j < WIDTH; j++) {
+    int *c = malloc(sizeof(int));
+    *c = 1000;
+    SCEDA_graph_add_edge(g, s, layer[0][j], c);
+    c = malloc(sizeof(int));
+    *c = 1000;
+    SCEDA_graph_add_edge(g, layer[LAYERS-1][j], t, c);
+  }
+  for(i = 0; i + 1 < LAYERS; i++) {
+    for(j = 0; j < WIDTH; j++) {
+      for(k = 0; k < DEGREE; k++) {
+	int *c = malloc(sizeof(int));
+	*c = 1 + rand() % 100;
+	SCEDA_graph_add_edge(g, layer[i][j], layer[i+1][rand() % WIDTH], c);
+      }
+    }
+  }
+
+  fprintf(stdout, "graph: %d vertices, %d edges\n", SCEDA_graph_vcount(g), SCEDA_graph_ecount(g));
+
+  // put/get heavy loop on a vertex map
+  {
+    clock_t start = clock();
+    long sum = 0;
+    int r;
+    for(r = 0; r < ROUNDS; r++) {
+      SCEDA_HashMap *map = SCEDA_vertex_map_create(NULL);
+      SCEDA_VerticesIterator vertices;
+      SCEDA_vertices_iterator_init(g, &vertices);
+      while(SCEDA_vertices_iterator_has_next(&vertices)) {
+	SCEDA_Vertex *v = SCEDA_vertices_iterator_next(&vertices);
+	SCEDA_hashmap_put(map, v, v, NULL);
+      }
+      SCEDA_vertices_iterator_cleanup(&vertices);
+      SCEDA_EdgesIterator edges;
+      SCEDA_edges_iterator_init(g, &edges);
+      while(SCEDA_edges_iterator_has_next(&edges)) {
+	SCEDA_Edge *e = SCEDA_edges_iterator_next(&edges);
+	if(SCEDA_hashmap_get(map, SCEDA_edge_source(e)) != NULL) {
+	  sum++;
+	}
+	if(SCEDA_hashmap_get(map, SCEDA_edge_target(e)) != NULL) {
+	  sum++;
+	}
+      }
+      SCEDA_edges_iterator_cleanup(&edges);
+      SCEDA_hashmap_delete(map);
+    }
+    fprintf(stdout, "put/get loop: %ld hits in %.3fs\n", sum, elapsed(start));
+  }
+
+  // membership tests on an edge set holding half of the edges, for
+  // each layout (half of the tests fail)
+  {
+    int layout;
+    for(layout = SCEDA_HASH_OPEN; layout <= SCEDA_HASH_SWISS; layout++) {
+      SCEDA_HashSet *set = SCEDA_edge_set_create();
+      SCEDA_hashset_set_layout(set, layout);
+      SCEDA_EdgesIterator edges;
+      SCEDA_edges_iterator_init(g, &edges);
+      for(i = 0; SCEDA_edges_iterator_has_next(&edges); i++) {
+	SCEDA_Edge *e = SCEDA_edges_iterator_next(&edges);
+	if(i % 2 == 0) {
+	  SCEDA_hashset_add(set, e);
+	}
+      }
+      SCEDA_edges_iterator_cleanup(&edges);
+
+      clock_t start = clock();
+      long sum = 0;
+      int r;
+      for(r = 0; r < 2 * ROUNDS; r++) {
+	SCEDA_edges_iterator_init(g, &edges);
+	while(SCEDA_edges_iterator_has_next(&edges)) {
+	  if(SCEDA_hashset_contains(set, SCEDA_edges_iterator_next(&edges))) {
+	    sum++;
+	  }
+	}
+	SCEDA_edges_iterator_cleanup(&edges);
+      }
+      fprintf(stdout, "contains (%s layout): %ld hits in %.3fs\n", layout_name[layout], sum, elapsed(start));
+      SCEDA_hashset_delete(set);
+    }
+  }
+
+  // iteration over an edge map after many removals, for both layouts
+  {
+    int layout;
+    for(layout = SCEDA_HASH_OPEN; layout <= SCEDA_HASH_ORDERED; layout++) {
+      SCEDA_HashMap *map = SCEDA_edge_map_create(NULL);
+      SCEDA_hashmap_set_layout(map, layout);
+      SCEDA_hashmap_set_shrink(map, FALSE);
+      SCEDA_EdgesIterator edges;
+      SCEDA_edges_iterator_init(g, &edges);
+      for(i = 0; SCEDA_edges_iterator_has_next(&edges); i++) {
+	SCEDA_Edge *e = SCEDA_edges_iterator_next(&edges);
+	SCEDA_hashmap_put(map, e, e, NULL);
+      }
+      SCEDA_edges_iterator_cleanup(&edges);
+      SCEDA_edges_iterator_init(g, &edges);
+      for(i = 0; SCEDA_edges_iterator_has_next(&edges); i++) {
+	void *e = SCEDA_edges_iterator_next(&edges);
+	void *v;
+	if(i % 8 != 0) {
+	  SCEDA_hashmap_remove(map, &e, &v);
+	}
+      }
+      SCEDA_edges_iterator_cleanup(&edges);
+
+      clock_t start = clock();
+      long sum = 0;
+      int r;
+      for(r = 0; r < 20 * ROUNDS; r++) {
+	SCEDA_HashMapIterator bindings;
+	SCEDA_hashmap_iterator_init(map, &bindings);
+	while(SCEDA_hashmap_iterator_has_next(&bindings)) {
+	  SCEDA_Edge *e;
+	  SCEDA_hashmap_iterator_next(&bindings, &e);
+	  sum++;
+	}
+	SCEDA_hashmap_iterator_cleanup(&bindings);
+      }
+      fprintf(stdout, "iteration (%s layout): %ld bindings in %.3fs\n", layout_name[layout], sum, elapsed(start));
+      SCEDA_hashmap_delete(map);
+    }
+  }
+
+  // random lookups in a map larger than the first level caches, one at a time
+  // and by batches, for each layout (half of the keys are unbound)
+  {
+    void **keys = malloc(LOOKUPS * sizeof(void *));
+    void **values = malloc(LOOKUPS * sizeof(void *));
+    for(i = 0; i < LOOKUPS; i++) {
+      keys[i] = (void *)(long)(1 + rand() % (2 * KEYS));
+    }
+    int layout;
+    for(layout = SCEDA_HASH_OPEN; layout <= SCEDA_HASH_SWISS; layout++) {
+      SCEDA_HashMap *map = SCEDA_hashmap_create(NULL, NULL, match_key, hash_key);
+      SCEDA_hashmap_set_layout(map, layout);
+      for(i = 1; i <= KEYS; i++) {
+	SCEDA_hashmap_put(map, (void *)(long)i, (void *)(long)i, NULL);
+      }
+
+      clock_t start = clock();
+      long sum = 0;
+      for(i = 0; i < LOOKUPS; i++) {
+	if(SCEDA_hashmap_get(map, keys[i]) != NULL) {
+	  sum++;
+	}
+      }
+      fprintf(stdout, "get (%s layout): %ld hits in %.3fs\n", layout_name[layout], sum, elapsed(start));
+
+      start = clock();
+      sum = 0;
+      for(i = 0; i < LOOKUPS; i += 64) {
+	sum += SCEDA_hashmap_get_many(map, keys + i, 64, values + i);
+      }
+      fprintf(stdout, "get_many (%s layout): %ld hits in %.3fs\n", layout_name[layout], sum, elapsed(start));
+      SCEDA_hashmap_delete(map);
+    }
+    free(keys);
+    free(values);
+  }
+
+  // max flow
+  {
+    clock_t start = clock();
+    SCEDA_HashMap *flow = SCEDA_graph_max_flow(g, s, t, get_capacity, NULL);
+    double time = elapsed(start);
+
+    int value = 0;
+    SCEDA_OutEdgesIterator out;
+    SCEDA_out_edges_iterator_init(s, &out);
+    while(SCEDA_out_edges_iterator_has_next(&out)) {
+      SCEDA_Edge *e = SCEDA_out_edges_iterator_next(&out);
+      value += *(int *)SCEDA_hashmap_get(flow, e);
+    }
+    SCEDA_out_edges_iterator_cleanup(&out);
+
+    fprintf(stdout, "max flow: value %d in %.3fs\n", value, time);
+    SCEDA_hashmap_delete(flow);
+  }
+
+  SCEDA_graph_delete(g);
+
+  return 0;
+}
@@ -0,0 +1,225 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+
+#include <SCEDA/common.h>
+#include <SCEDA/heap.h>
+#include <SCEDA/iheap.h>
+#include <SCEDA/bqueue.h>
+#include <SCEDA/rheap.h>
+
+#define VERTICES 200000
+#define DEGREE 8
+#define ROUNDS 5
+#define MAX_WEIGHT 1000
+
+// random graph in compressed adjacency form
+int succ[VERTICES * DEGREE];
+int weight[VERTICES * DEGREE];
+int dist[VERTICES];
+
+int compare_dist(int *d1, int *d2) {
+  return (*d1 > *d2) - (*d1 < *d2);
+}
+
+double elapsed(clock_t start) {
+  return ((double)(clock() - start)) / CLOCKS_PER_SEC;
+}
+
+long checksum() {
+  long sum = 0;
+  int i;
+  for(i = 0; i < VERTICES; i++) {
+    if(dist[i] != INT_MAX) {
+      sum += dist[i];
+    }
+  }
+  return sum;
+}
+
+// Dijkstra with a Fibonacci or pairing heap (one element per vertex)
+long dijkstra_heap(int source, int kind, int pooled) {
+  SCEDA_Heap *heap;
+  if(pooled) {
+    heap = SCEDA_heap_create_pooled(NULL, NULL, (SCEDA_compare_fun)compare_dist);
+  } else {
+    heap = SCEDA_heap_create(NULL, NULL, (SCEDA_compare_fun)compare_dist);
+  }
+  SCEDA_heap_set_kind(heap, kind);
+  SCEDA_HeapElt **elts = malloc(VERTICES * sizeof(SCEDA_HeapElt *));
+  int i;
+  for(i = 0; i < VERTICES; i++) {
+    dist[i] = (i == source) ? 0 : INT_MAX;
+    elts[i] = SCEDA_heap_insert(heap, (void *)(long)i, &dist[i]);
+  }
+  while(!SCEDA_heap_is_empty(heap)) {
+    void *u;
+    int *du;
+    SCEDA_heap_extract(heap, &u, (void **)&du);
+    elts[(long)u] = NULL;
+    if(*du == INT_MAX) {
+      continue;
+    }
+    int k;
+    for(k = (long)u * DEGREE; k < ((long)u + 1) * DEGREE; k++) {
+      int v = succ[k];
+      if((elts[v] != NULL) && (*du + weight[k] < dist[v])) {
+	dist[v] = *du + weight[k];
+	SCEDA_heap_decrease_key(heap, elts[v]);
+      }
+    }
+  }
+  free(elts);
+  SCEDA_heap_delete(heap);
+  return checksum();
+}
+
+// Dijkstra with an indexed heap (vertices are the handles)
+long dijkstra_iheap(int source, int arity) {
+  SCEDA_IHeap *heap = SCEDA_iheap_create(VERTICES, NULL, NULL, (SCEDA_compare_fun)compare_dist);
+  SCEDA_iheap_set_arity(heap, arity);
+  int i;
+  for(i = 0; i < VERTICES; i++) {
+    dist[i] = (i == source) ? 0 : INT_MAX;
+    SCEDA_iheap_insert(heap, i, NULL, &dist[i]);
+  }
+  while(!SCEDA_iheap_is_empty(heap)) {
+    int u;
+    void *value;
+    int *du;
+    SCEDA_iheap_extract(heap, &u, &value, (void **)&du);
+    if(*du == INT_MAX) {
+      continue;
+    }
+    int k;
+    for(k = u * DEGREE; k < (u + 1) * DEGREE; k++) {
+      int v = succ[k];
+      if(SCEDA_iheap_contains(heap, v) && (*du + weight[k] < dist[v])) {
+	dist[v] = *du + weight[k];
+	SCEDA_iheap_decrease_key(heap, v);
+      }
+    }
+  }
+  SCEDA_iheap_delete(heap);
+  return checksum();
+}
+
+// Dijkstra with a bucket queue (span = largest weight)
+long dijkstra_bqueue(int source) {
+  SCEDA_BucketQueue *queue = SCEDA_bqueue_create(VERTICES, MAX_WEIGHT);
+  int i;
+  for(i = 0; i < VERTICES; i++) {
+    dist[i] = INT_MAX;
+  }
+  dist[source] = 0;
+  SCEDA_bqueue_insert(queue, source, 0);
+  int u, du;
+  while(SCEDA_bqueue_extract(queue, &u, &du) == 0) {
+    int k;
+    for(k = u * DEGREE; k < (u + 1) * DEGREE; k++) {
+      int v = succ[k];
+      if(du + weight[k] < dist[v]) {
+	if(dist[v] == INT_MAX) {
+	  SCEDA_bqueue_insert(queue, v, du + weight[k]);
+	} else {
+	  SCEDA_bqueue_decrease_key(queue, v, du + weight[k]);
+	}
+	dist[v] = du + weight[k];
+      }
+    }
+  }
+  SCEDA_bqueue_delete(queue);
+  return checksum();
+}
+
+// Dijkstra with a radix heap
+long dijkstra_rheap(int source) {
+  SCEDA_RadixHeap *heap = SCEDA_rheap_create(VERTICES);
+  int i;
+  for(i = 0; i < VERTICES; i++) {
+    dist[i] = INT_MAX;
+  }
+  dist[source] = 0;
+  SCEDA_rheap_insert(heap, source, 0);
+  int u, du;
+  while(SCEDA_rheap_extract(heap, &u, &du) == 0) {
+    int k;
+    for(k = u * DEGREE; k < (u + 1) * DEGREE; k++) {
+      int v = succ[k];
+      if(du + weight[k] < dist[v]) {
+	if(dist[v] == INT_MAX) {
+	  SCEDA_rheap_insert(heap, v, du + weight[k]);
+	} else {
+	  SCEDA_rheap_decrease_key(heap, v, du + weight[k]);
+	}
+	dist[v] = du + weight[k];
+      }
+    }
+  }
+  SCEDA_rheap_delete(heap);
+  return checksum();
+}
+
+int main(int argc, char *argv[]) {
+  srand(1);
+
+  int k;
+  for(k = 0; k < VERTICES * DEGREE; k++) {
+    succ[k] = rand() % VERTICES;
+    weight[k] = 1 + rand() % MAX_WEIGHT;
+  }
+
+  fprintf(stdout, "graph: %d vertices, %d edges\n", VERTICES, VERTICES * DEGREE);
+
+  clock_t start;
+  long sum;
+  int r;
+
+  start = clock();
+  for(r = 0, sum = 0; r < ROUNDS; r++) {
+    sum += dijkstra_heap(r, SCEDA_HEAP_FIBONACCI, FALSE);
+  }
+  fprintf(stdout, "SCEDA_Heap: checksum %ld (%.3fs)\n", sum, elapsed(start));
+
+  start = clock();
+  for(r = 0, sum = 0; r < ROUNDS; r++) {
+    sum += dijkstra_heap(r, SCEDA_HEAP_FIBONACCI, TRUE);
+  }
+  fprintf(stdout, "SCEDA_Heap (pooled): checksum %ld (%.3fs)\n", sum, elapsed(start));
+
+  start = clock();
+  for(r = 0, sum = 0; r < ROUNDS; r++) {
+    sum += dijkstra_heap(r, SCEDA_HEAP_PAIRING, FALSE);
+  }
+  fprintf(stdout, "SCEDA_Heap (pairing): checksum %ld (%.3fs)\n", sum, elapsed(start));
+
+  start = clock();
+  for(r = 0, sum = 0; r < ROUNDS; r++) {
+    sum += dijkstra_heap(r, SCEDA_HEAP_PAIRING, TRUE);
+  }
+  fprintf(stdout, "SCEDA_Heap (pairing, pooled): checksum %ld (%.3fs)\n", sum, elapsed(start));
+
+  int arity;
+  for(arity = 2; arity <= 8; arity *= 2) {
+    start = clock();
+    for(r = 0, sum = 0; r < ROUNDS; r++) {
+      sum += dijkstra_iheap(r, arity);
+    }
+    fprintf(stdout, "SCEDA_IHeap (arity %d): checksum %ld (%.3fs)\n", arity, sum, elapsed(start));
+  }
+
+  start = clock();
+  for(r = 0, sum = 0; r < ROUNDS; r++) {
+    sum += dijkstra_bqueue(r);
+  }
+  fprintf(stdout, "SCEDA_BucketQueue: checksum %ld (%.3fs)\n", sum, elapsed(start));
+
+  start = clock();
+  for(r = 0, sum = 0; r < ROUNDS; r++) {
+    sum += dijkstra_rheap(r);
+  }
+  fprintf(stdout, "SCEDA_RadixHeap: checksum %ld (%.3fs)\n", sum, elapsed(start));
+
+  return 0;
+}
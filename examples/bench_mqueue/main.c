@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+
+#include <SCEDA/common.h>
+#include <SCEDA/pqueue.h>
+#include <SCEDA/mqueue.h>
+
+#define THREADS 4
+#define PREFILL 100000
+#define OPERATIONS 1000000
+
+int keys[PREFILL + THREADS * OPERATIONS];
+
+// a priority queue shared through a global lock...
+SCEDA_PQueue *pqueue;
+pthread_mutex_t pqueue_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// ... or a MultiQueue
+SCEDA_MultiQueue *mqueue;
+
+int compare_int(int *x, int *y) {
+  return (*x > *y) - (*x < *y);
+}
+
+double elapsed(struct timespec *start) {
+  struct timespec end;
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  return (end.tv_sec - start->tv_sec) + (end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+// each thread alternates insertions and extractions
+void *work_locked(void *arg) {
+  int *key = &keys[PREFILL + (long)arg * OPERATIONS];
+  int i;
+  for(i = 0; i < OPERATIONS; i++) {
+    void *data;
+    pthread_mutex_lock(&pqueue_lock);
+    SCEDA_pqueue_insert(pqueue, &key[i]);
+    pthread_mutex_unlock(&pqueue_lock);
+    pthread_mutex_lock(&pqueue_lock);
+    SCEDA_pqueue_extract(pqueue, &data);
+    pthread_mutex_unlock(&pqueue_lock);
+  }
+  return NULL;
+}
+
+void *work_relaxed(void *arg) {
+  int *key = &keys[PREFILL + (long)arg * OPERATIONS];
+  int i;
+  for(i = 0; i < OPERATIONS; i++) {
+    void *data;
+    SCEDA_mqueue_insert(mqueue, &key[i]);
+    SCEDA_mqueue_extract(mqueue, &data);
+  }
+  return NULL;
+}
+
+double run(void *(*work)(void *)) {
+  pthread_t threads[THREADS];
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  long t;
+  for(t = 0; t < THREADS; t++) {
+    pthread_create(&threads[t], NULL, work, (void *)t);
+  }
+  for(t = 0; t < THREADS; t++) {
+    pthread_join(threads[t], NULL);
+  }
+  return elapsed(&start);
+}
+
+int main(int argc, char *argv[]) {
+  srand(1);
+  int i;
+  for(i = 0; i < PREFILL + THREADS * OPERATIONS; i++) {
+    keys[i] = rand();
+  }
+
+  fprintf(stdout, "%d threads, %d insert/extract pairs each, %d elements\n", THREADS, OPERATIONS, PREFILL);
+
+  pqueue = SCEDA_pqueue_create(NULL, (SCEDA_compare_fun)compare_int);
+  for(i = 0; i < PREFILL; i++) {
+    SCEDA_pqueue_insert(pqueue, &keys[i]);
+  }
+  double t = run(work_locked);
+  fprintf(stdout, "SCEDA_PQueue + global lock: %d elements left (%.3fs)\n", SCEDA_pqueue_size(pqueue), t);
+  SCEDA_pqueue_delete(pqueue);
+
+  mqueue = SCEDA_mqueue_create(THREADS, NULL, (SCEDA_compare_fun)compare_int);
+  for(i = 0; i < PREFILL; i++) {
+    SCEDA_mqueue_insert(mqueue, &keys[i]);
+  }
+  t = run(work_relaxed);
+  fprintf(stdout, "SCEDA_MultiQueue: %d elements left (%.3fs)\n", SCEDA_mqueue_size(mqueue), t);
+
+  SCEDA_mqueue_delete(mqueue);
+
+  return 0;
+}
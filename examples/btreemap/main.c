@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SCEDA/common.h>
+#include <SCEDA/btreemap.h>
+
+typedef struct {
+  int value;
+} Integer;
+
+Integer *new_Integer(int n) {
+  Integer *x = malloc(sizeof(Integer));
+  x->value = n;
+  return x;
+}
+
+void delete_Integer(Integer *x) {
+  free(x);
+}
+
+int compare_string(const char *s1, const char *s2) {
+  return strcmp(s1, s2);
+}
+
+void delete_string(char *s) {
+  free(s);
+}
+
+int main(int argc, char *argv[]) {
+  // create a map from strings to Integer
+  SCEDA_BTreeMap *map = SCEDA_btreemap_create((SCEDA_delete_fun)delete_string,
+					    (SCEDA_delete_fun)delete_Integer,
+					    (SCEDA_compare_fun)compare_string);
+
+  // note that strings are allocated onto the heap, thanks to strdup function
+  SCEDA_btreemap_put(map, strdup("Odissey"), new_Integer(2001), NULL);
+  SCEDA_btreemap_put(map, strdup("Torment"), new_Integer(2002), NULL);
+  SCEDA_btreemap_put(map, strdup("Judgment"), new_Integer(2002), NULL);
+  SCEDA_btreemap_put(map, strdup("Onslaught"), new_Integer(2002), NULL);
+  SCEDA_btreemap_put(map, strdup("Legions"), new_Integer(2003), NULL);
+  SCEDA_btreemap_put(map, strdup("Scourge"), new_Integer(2003), NULL);
+  SCEDA_btreemap_put(map, strdup("Mirrodin"), new_Integer(2003), NULL);
+  SCEDA_btreemap_put(map, strdup("Darksteel"), new_Integer(2004), NULL);
+  SCEDA_btreemap_put(map, strdup("Fifth Dawn"), new_Integer(2004), NULL);
+  SCEDA_btreemap_put(map, strdup("Champions of Kamigawa"), new_Integer(2004), NULL);
+
+  // iterate over the map
+  SCEDA_BTreeMapIterator elts;
+  SCEDA_btreemap_iterator_init(map, &elts);
+  while(SCEDA_btreemap_iterator_has_next(&elts)) {
+    // peek the next element
+    char *key;
+    Integer *x = SCEDA_btreemap_iterator_next(&elts, (void **)&key);
+    fprintf(stdout,"%s -> %d\n",key, x->value);
+  }
+  SCEDA_btreemap_iterator_cleanup(&elts);
+
+  // find the last edition (in alphabetical order) before "M"
+  char *name;
+  Integer *year;
+  if(SCEDA_btreemap_lower(map, "M", (void **)&name, (void **)&year) == 0) {
+    fprintf(stdout,"before M: %s -> %d\n", name, year->value);
+  }
+
+  // iterate over the editions from "M" onwards
+  SCEDA_btreemap_iterator_init_lower_bound(map, "M", &elts);
+  while(SCEDA_btreemap_iterator_has_next(&elts)) {
+    char *key;
+    Integer *x = SCEDA_btreemap_iterator_next(&elts, (void **)&key);
+    fprintf(stdout,"from M: %s -> %d\n",key, x->value);
+  }
+  SCEDA_btreemap_iterator_cleanup(&elts);
+
+  // delete the set
+ SCEDA_btreemap_delete(map);
+
+  return 0;
+}
@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <sched.h>
+#include <pthread.h>
+#include <SCEDA/common.h>
+#include <SCEDA/cqueue.h>
+
+#define CAPACITY 16
+#define THREADS 4
+#define N 100000
+#define BATCH 5
+
+// data are encoded as pointers: producer t enqueues t * N + i + 1,
+// for i from 0 to N - 1 (NULL is never enqueued)
+#define ENCODE(t, i) ((void *)(intptr_t)((t) * N + (i) + 1))
+#define DECODE(x) ((int)(intptr_t)(x) - 1)
+
+SCEDA_CQueue queue;
+int received[THREADS * N];
+int dequeued = 0;
+int errors = 0;
+
+void *produce(void *arg) {
+  int t = (int)(intptr_t)arg;
+  void *data[BATCH];
+  int i = 0;
+
+  // blocks of BATCH elements are enqueued alternately in a single
+  // batch and one by one
+  while(i < N) {
+    if((i / BATCH) % 2) {
+      SCEDA_cqueue_enqueue(&queue, ENCODE(t, i));
+      i++;
+    } else {
+      int k;
+      for(k = 0; (k < BATCH) && (i + k < N); k++) {
+	data[k] = ENCODE(t, i + k);
+      }
+      SCEDA_cqueue_enqueue_many(&queue, data, k);
+      i += k;
+    }
+  }
+
+  return NULL;
+}
+
+void *consume(void *arg) {
+  // last[t] is the last element of producer t seen by this consumer:
+  // elements of a producer must come in order
+  int last[THREADS];
+  void *data[BATCH];
+  int t, k, n;
+  int single = 0;
+
+  for(t = 0; t < THREADS; t++) {
+    last[t] = -1;
+  }
+
+  while(__atomic_load_n(&dequeued, __ATOMIC_RELAXED) < THREADS * N) {
+    if(single) {
+      n = (SCEDA_cqueue_try_dequeue(&queue, &data[0]) == 0) ? 1 : 0;
+    } else {
+      n = SCEDA_cqueue_try_dequeue_many(&queue, data, BATCH);
+    }
+    single = !single;
+
+    if(n == 0) {
+      sched_yield();
+      continue;
+    }
+
+    for(k = 0; k < n; k++) {
+      int x = DECODE(data[k]);
+      t = x / N;
+      if((x % N) <= last[t]) {
+	__atomic_add_fetch(&errors, 1, __ATOMIC_RELAXED);
+      }
+      last[t] = x % N;
+      __atomic_add_fetch(&received[x], 1, __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&dequeued, n, __ATOMIC_RELAXED);
+  }
+
+  return NULL;
+}
+
+int main(int argc, char *argv[]) {
+  void *data[CAPACITY + 1];
+  void *x;
+  int i, n;
+
+  // single thread: the same elements go through single and batched
+  // operations, in the same order
+  SCEDA_cqueue_init(&queue, CAPACITY, NULL);
+  fprintf(stdout, "capacity = %d\n", SCEDA_cqueue_capacity(&queue));
+
+  n = 0;
+  while(SCEDA_cqueue_try_enqueue(&queue, ENCODE(0, n)) == 0) {
+    n++;
+  }
+  fprintf(stdout, "try_enqueue: %d elements\n", n);
+
+  int ok = 1;
+  i = 0;
+  while((n = SCEDA_cqueue_try_dequeue_many(&queue, data, 3)) != 0) {
+    int k;
+    for(k = 0; k < n; k++, i++) {
+      ok = ok && (DECODE(data[k]) == i);
+    }
+  }
+  fprintf(stdout, "try_dequeue_many: %d elements, %s\n", i, ok ? "in order" : "NOT in order");
+
+  // a batch larger than the room left is cut
+  for(i = 0; i <= CAPACITY; i++) {
+    data[i] = ENCODE(0, i);
+  }
+  SCEDA_cqueue_enqueue(&queue, data[0]);
+  n = SCEDA_cqueue_try_enqueue_many(&queue, &data[1], CAPACITY);
+  fprintf(stdout, "try_enqueue_many: %d elements\n", n);
+  ok = (SCEDA_cqueue_try_enqueue_many(&queue, data, 1) == 0);
+  fprintf(stdout, "try_enqueue_many on a full queue: %s\n", ok ? "none" : "NOT none");
+
+  ok = 1;
+  for(i = 0; i < CAPACITY; i++) {
+    if(SCEDA_cqueue_try_dequeue(&queue, &x) != 0) {
+      ok = 0;
+      break;
+    }
+    ok = ok && (DECODE(x) == i);
+  }
+  ok = ok && (SCEDA_cqueue_try_dequeue(&queue, &x) != 0);
+  fprintf(stdout, "try_dequeue: %d elements, %s\n", i, ok ? "in order" : "NOT in order");
+
+  // blocking operations on a queue that does not need to wait
+  SCEDA_cqueue_enqueue_many(&queue, data, 10);
+  ok = (SCEDA_cqueue_size(&queue) == 10);
+  for(i = 0; i < 4; i++) {
+    ok = ok && (DECODE(SCEDA_cqueue_dequeue(&queue)) == i);
+  }
+  n = SCEDA_cqueue_dequeue_many(&queue, data, CAPACITY);
+  ok = ok && (n == 6) && SCEDA_cqueue_is_empty(&queue);
+  for(i = 0; i < n; i++) {
+    ok = ok && (DECODE(data[i]) == 4 + i);
+  }
+  fprintf(stdout, "enqueue_many/dequeue/dequeue_many: %s\n", ok ? "OK" : "FAILED");
+
+  SCEDA_cqueue_cleanup(&queue);
+
+  // several threads: producers mix enqueue and enqueue_many, and
+  // consumers mix try_dequeue and try_dequeue_many
+  SCEDA_cqueue_init(&queue, CAPACITY, NULL);
+
+  pthread_t producers[THREADS];
+  pthread_t consumers[THREADS];
+  int t;
+  for(t = 0; t < THREADS; t++) {
+    pthread_create(&producers[t], NULL, produce, (void *)(intptr_t)t);
+    pthread_create(&consumers[t], NULL, consume, NULL);
+  }
+  for(t = 0; t < THREADS; t++) {
+    pthread_join(producers[t], NULL);
+    pthread_join(consumers[t], NULL);
+  }
+
+  int missing = 0;
+  for(i = 0; i < THREADS * N; i++) {
+    if(received[i] != 1) {
+      missing++;
+    }
+  }
+  fprintf(stdout, "%d threads: %d elements, %d lost or duplicated, %d out of order\n",
+	  THREADS, dequeued, missing, errors);
+
+  SCEDA_cqueue_cleanup(&queue);
+
+  return 0;
+}
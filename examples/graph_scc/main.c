@@ -19,6 +19,23 @@ void delete_Integer(Integer *x) {
   free(x);
 }
 
+void print_components(SCEDA_List *components) {
+  SCEDA_ListIterator comp;
+  SCEDA_list_iterator_init(components, &comp);
+  while(SCEDA_list_iterator_has_next(&comp)) {
+    SCEDA_HashSet *cc = SCEDA_list_iterator_next(&comp);
+    SCEDA_HashSetIterator ccvert;
+    SCEDA_hashset_iterator_init(cc, &ccvert);
+    while(SCEDA_hashset_iterator_has_next(&ccvert)) {
+      SCEDA_Vertex *u = SCEDA_hashset_iterator_next(&ccvert);
+      fprintf(stdout,"%d ",SCEDA_vertex_get_data(Integer *, u)->value);
+    }
+    SCEDA_hashset_iterator_cleanup(&ccvert);
+    fprintf(stdout,"\n");
+  }
+  SCEDA_list_iterator_cleanup(&comp);
+}
+
 int main(int argc, char *argv[]) {
   // create a graph whose nodes are labelled by Integer and edges are not labelled
   SCEDA_Graph *g = SCEDA_graph_create((SCEDA_delete_fun)delete_Integer, NULL);
@@ -35,28 +52,18 @@ int main(int argc, char *argv[]) {
   SCEDA_graph_add_edge(g, v2, v0, NULL);
   SCEDA_graph_add_edge(g, v4, v5, NULL);
   SCEDA_graph_add_edge(g, v5, v4, NULL);
+  SCEDA_graph_add_edge(g, v1, v3, NULL);
 
   SCEDA_List *scc = SCEDA_graph_strongly_connected_components(g);
-
   fprintf(stdout,"g has %d strongly connected components:\n", SCEDA_list_size(scc));
-
-  SCEDA_ListIterator comp;
-  SCEDA_list_iterator_init(scc, &comp);
-  while(SCEDA_list_iterator_has_next(&comp)) {
-    SCEDA_HashSet *cc = SCEDA_list_iterator_next(&comp);
-    SCEDA_HashSetIterator ccvert;
-    SCEDA_hashset_iterator_init(cc, &ccvert);
-    while(SCEDA_hashset_iterator_has_next(&ccvert)) {
-      SCEDA_Vertex *u = SCEDA_hashset_iterator_next(&ccvert);
-      fprintf(stdout,"%d ",SCEDA_vertex_get_data(Integer *, u)->value);
-    }
-    SCEDA_hashset_iterator_cleanup(&ccvert);
-    fprintf(stdout,"\n");
-  }
-  SCEDA_list_iterator_cleanup(&comp);
-
+  print_components(scc);
   SCEDA_list_delete(scc);
 
+  SCEDA_List *wcc = SCEDA_graph_weakly_connected_components(g);
+  fprintf(stdout,"g has %d weakly connected components:\n", SCEDA_list_size(wcc));
+  print_components(wcc);
+  SCEDA_list_delete(wcc);
+
   SCEDA_graph_delete(g);
 
   return 0;
@@ -25,6 +25,31 @@ unsigned int hash_Integer(Integer *x) {
   return x->value;
 }
 
+// print the elements of a set of Integers less than 30, in ascending order
+void print_set(const char *name, SCEDA_HashSet *set) {
+  fprintf(stdout,"%s:",name);
+  int i;
+  for(i = 0; i < 30; i++) {
+    Integer x = { i };
+    if(SCEDA_hashset_contains(set, &x)) {
+      fprintf(stdout," %d",i);
+    }
+  }
+  fprintf(stdout," (%d elements)\n",SCEDA_hashset_size(set));
+}
+
+// compute res = op(set1, set2) into a new set, print it and delete it
+void print_op(const char *name, int (*op)(SCEDA_HashSet *, SCEDA_HashSet *, SCEDA_HashSet *),
+	      SCEDA_HashSet *set1, SCEDA_HashSet *set2) {
+  // the elements of res are shared with set1 and set2
+  SCEDA_HashSet *res = SCEDA_hashset_create(NULL, (SCEDA_match_fun)match_Integer,
+					    (SCEDA_hash_fun)hash_Integer);
+  if(op(res, set1, set2) == 0) {
+    print_set(name, res);
+  }
+  SCEDA_hashset_delete(res);
+}
+
 int main(int argc, char *argv[]) {
   // create a set of Integer
   SCEDA_HashSet *set = SCEDA_hashset_create((SCEDA_delete_fun)delete_Integer,
@@ -47,6 +72,34 @@ int main(int argc, char *argv[]) {
   }
   SCEDA_hashset_iterator_cleanup(&elts);
 
+  // set algebra with the multiples of 3 and an empty set
+  SCEDA_HashSet *multiples = SCEDA_hashset_create((SCEDA_delete_fun)delete_Integer,
+						 (SCEDA_match_fun)match_Integer,
+						 (SCEDA_hash_fun)hash_Integer);
+  for(i = 0; i < 10; i++) {
+    SCEDA_hashset_add(multiples, new_Integer(3 * i));
+  }
+  SCEDA_HashSet *empty = SCEDA_hashset_create(NULL, (SCEDA_match_fun)match_Integer,
+					      (SCEDA_hash_fun)hash_Integer);
+
+  print_op("set | multiples", SCEDA_hashset_union, set, multiples);
+  print_op("set & multiples", SCEDA_hashset_intersection, set, multiples);
+  print_op("set - multiples", SCEDA_hashset_difference, set, multiples);
+  print_op("set | empty", SCEDA_hashset_union, set, empty);
+  print_op("set & empty", SCEDA_hashset_intersection, set, empty);
+  print_op("set - set", SCEDA_hashset_difference, set, set);
+  fprintf(stdout,"union into a non empty set: %d\n",SCEDA_hashset_union(multiples, set, empty));
+
+  SCEDA_HashSet *common = SCEDA_hashset_create(NULL, (SCEDA_match_fun)match_Integer,
+					       (SCEDA_hash_fun)hash_Integer);
+  SCEDA_hashset_intersection(common, set, multiples);
+  fprintf(stdout,"set & multiples <= multiples: %d\n",SCEDA_hashset_is_subset(common, multiples));
+  fprintf(stdout,"set <= multiples: %d\n",SCEDA_hashset_is_subset(set, multiples));
+  fprintf(stdout,"empty <= set: %d\n",SCEDA_hashset_is_subset(empty, set));
+  SCEDA_hashset_delete(common);
+  SCEDA_hashset_delete(empty);
+  SCEDA_hashset_delete(multiples);
+
   // delete the set
   SCEDA_hashset_delete(set);
 
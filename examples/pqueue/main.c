@@ -31,6 +31,25 @@ int compare_Task(Task *x, Task *y) {
   }
 }
 
+// extract all the tasks of a queue, print their priorities and check
+// that they come in ascending order
+void drain(const char *name, SCEDA_PQueue *pqueue) {
+  int sorted = TRUE;
+  int last = 0;
+  fprintf(stdout,"%s:", name);
+  while(!SCEDA_pqueue_is_empty(pqueue)) {
+    Task *t;
+    SCEDA_pqueue_extract(pqueue, (void **)&t);
+    fprintf(stdout," %d", t->priority);
+    if(t->priority < last) {
+      sorted = FALSE;
+    }
+    last = t->priority;
+    delete_Task(t);
+  }
+  fprintf(stdout," (%s)\n", sorted ? "sorted" : "NOT sorted");
+}
+
 int main(int argc, char *argv[]) {
   // create a priority queue
   SCEDA_PQueue *pqueue = SCEDA_pqueue_create((SCEDA_delete_fun)delete_Task, (SCEDA_compare_fun)compare_Task);
@@ -50,5 +69,53 @@ int main(int argc, char *argv[]) {
   // delete the priority queue
   SCEDA_pqueue_delete(pqueue);
 
+  int priorities[] = { 7, 3, 9, 1, 12, 5, 5, 8, 2, 15, 0, 11, 6, 14, 4, 10 };
+  Task *tasks[16];
+  int i;
+  for(i = 0; i < 16; i++) {
+    tasks[i] = new_Task("task", priorities[i]);
+  }
+
+  // build a priority queue from an array, in linear time
+  pqueue = SCEDA_pqueue_create_from_array((SCEDA_delete_fun)delete_Task, (SCEDA_compare_fun)compare_Task,
+					  (void **)tasks, 6);
+  fprintf(stdout,"from array: %d tasks\n", SCEDA_pqueue_size(pqueue));
+
+  // insert at least as many tasks as the queue holds: the heap is
+  // rebuilt in linear time
+  SCEDA_pqueue_insert_all(pqueue, (void **)&tasks[6], 7);
+  // insert fewer tasks: they are inserted one by one
+  SCEDA_pqueue_insert_all(pqueue, (void **)&tasks[13], 3);
+  fprintf(stdout,"insert_all: %d tasks\n", SCEDA_pqueue_size(pqueue));
+  fprintf(stdout,"insert_all of no task: %d\n", SCEDA_pqueue_insert_all(pqueue, (void **)tasks, 0));
+  fprintf(stdout,"insert_all of -1 tasks: %d\n", SCEDA_pqueue_insert_all(pqueue, (void **)tasks, -1));
+
+  // the arity of the heap is a power of two between 2 and
+  // SCEDA_PQUEUE_MAX_ARITY, which may be changed at any time
+  fprintf(stdout,"arity 1: %d\n", SCEDA_pqueue_set_arity(pqueue, 1));
+  fprintf(stdout,"arity 3: %d\n", SCEDA_pqueue_set_arity(pqueue, 3));
+  fprintf(stdout,"arity %d: %d\n", 2 * SCEDA_PQUEUE_MAX_ARITY, SCEDA_pqueue_set_arity(pqueue, 2 * SCEDA_PQUEUE_MAX_ARITY));
+  fprintf(stdout,"arity 4: %d\n", SCEDA_pqueue_set_arity(pqueue, 4));
+
+  // keep the array of the queue while it is emptied
+  SCEDA_pqueue_set_shrink(pqueue, FALSE);
+  int length = pqueue->length;
+  drain("4-ary", pqueue);
+  fprintf(stdout,"array kept: %s\n", (pqueue->length == length) ? "yes" : "no");
+  SCEDA_pqueue_delete(pqueue);
+
+  // the same with a queue on the stack, built from an empty array
+  SCEDA_PQueue queue;
+  SCEDA_pqueue_init_from_array(&queue, (SCEDA_delete_fun)delete_Task, (SCEDA_compare_fun)compare_Task,
+			       (void **)tasks, 0);
+  SCEDA_pqueue_set_arity(&queue, SCEDA_PQUEUE_MAX_ARITY);
+  for(i = 0; i < 16; i++) {
+    tasks[i] = new_Task("task", priorities[i]);
+  }
+  SCEDA_pqueue_insert_all(&queue, (void **)tasks, 16);
+  SCEDA_pqueue_set_arity(&queue, 2);
+  drain("binary", &queue);
+  SCEDA_pqueue_cleanup(&queue);
+
   return 0;
 }
@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SCEDA/common.h>
+#include <SCEDA/ptreemap.h>
+
+int compare_string(const char *s1, const char *s2) {
+  return strcmp(s1, s2);
+}
+
+void print_map(const char *name, SCEDA_PTreeMap *map) {
+  fprintf(stdout,"%s:", name);
+  SCEDA_PTreeMapIterator elts;
+  SCEDA_ptreemap_iterator_init(map, &elts);
+  while(SCEDA_ptreemap_iterator_has_next(&elts)) {
+    char *key;
+    char *value = SCEDA_ptreemap_iterator_next(&elts, (void **)&key);
+    fprintf(stdout," %s=%s", key, value);
+  }
+  SCEDA_ptreemap_iterator_cleanup(&elts);
+  fprintf(stdout,"\n");
+}
+
+int main(int argc, char *argv[]) {
+  // keys and values are not owned by persistent maps: string
+  // literals live as long as the program
+  SCEDA_PTreeMap *empty = SCEDA_ptreemap_create((SCEDA_compare_fun)compare_string);
+
+  SCEDA_PTreeMapCell config;
+  SCEDA_ptreemap_cell_init(&config, empty);
+
+  // the writer publishes successive versions of the configuration
+  const char *settings[][2] = { { "colour", "blue" }, { "size", "large" }, { "font", "serif" } };
+  int i;
+  for(i = 0; i < 3; i++) {
+    SCEDA_PTreeMap *current = SCEDA_ptreemap_cell_get(&config);
+    SCEDA_PTreeMap *next = SCEDA_ptreemap_put(current, settings[i][0], settings[i][1], NULL);
+    SCEDA_ptreemap_release(current);
+    SCEDA_ptreemap_cell_set(&config, next);
+  }
+
+  // a reader takes a snapshot...
+  SCEDA_PTreeMap *snapshot = SCEDA_ptreemap_cell_get(&config);
+
+  // ... which is not affected by later versions
+  SCEDA_PTreeMap *current = SCEDA_ptreemap_cell_get(&config);
+  void *key = "size";
+  void *value;
+  SCEDA_PTreeMap *next = SCEDA_ptreemap_remove(current, &key, &value);
+  SCEDA_ptreemap_release(current);
+  current = next;
+  next = SCEDA_ptreemap_put(current, "colour", "red", NULL);
+  SCEDA_ptreemap_release(current);
+  SCEDA_ptreemap_cell_set(&config, next);
+
+  print_map("snapshot", snapshot);
+  current = SCEDA_ptreemap_cell_get(&config);
+  print_map("current", current);
+  SCEDA_ptreemap_release(current);
+
+  // release the snapshot and the cell
+  SCEDA_ptreemap_release(snapshot);
+  SCEDA_ptreemap_cell_cleanup(&config);
+
+  return 0;
+}
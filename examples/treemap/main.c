@@ -26,6 +26,52 @@ void delete_string(char *s) {
   free(s);
 }
 
+void print_query(const char *name, int (*query)(SCEDA_TreeMap *, const void *, void **, void **),
+		 SCEDA_TreeMap *map, const char *key) {
+  char *res;
+  Integer *x;
+  if(query(map, key, (void **)&res, (void **)&x) == 0) {
+    fprintf(stdout,"%s(%s) = %s -> %d\n",name, key, res, x->value);
+  } else {
+    fprintf(stdout,"%s(%s): none\n",name, key);
+  }
+}
+
+void print_from(const char *name, SCEDA_TreeMapIterator *elts) {
+  fprintf(stdout,"%s:",name);
+  while(SCEDA_treemap_iterator_has_next(elts)) {
+    char *key;
+    SCEDA_treemap_iterator_next(elts, (void **)&key);
+    fprintf(stdout," [%s]",key);
+  }
+  fprintf(stdout,"\n");
+  SCEDA_treemap_iterator_cleanup(elts);
+}
+
+void print_map(const char *name, SCEDA_TreeMap *map) {
+  SCEDA_TreeMapIterator elts;
+  SCEDA_treemap_iterator_init(map, &elts);
+  fprintf(stdout,"%s:",name);
+  while(SCEDA_treemap_iterator_has_next(&elts)) {
+    char *key;
+    Integer *x = SCEDA_treemap_iterator_next(&elts, (void **)&key);
+    fprintf(stdout," [%s -> %d]",key, x->value);
+  }
+  fprintf(stdout,"\n");
+  SCEDA_treemap_iterator_cleanup(&elts);
+}
+
+// compute res = op(map1, map2) into a new map, print it and delete it
+void print_op(const char *name, int (*op)(SCEDA_TreeMap *, SCEDA_TreeMap *, SCEDA_TreeMap *),
+	      SCEDA_TreeMap *map1, SCEDA_TreeMap *map2) {
+  // the bindings of res are shared with map1 and map2
+  SCEDA_TreeMap *res = SCEDA_treemap_create(NULL, NULL, (SCEDA_compare_fun)compare_string);
+  if(op(res, map1, map2) == 0) {
+    print_map(name, res);
+  }
+  SCEDA_treemap_delete(res);
+}
+
 int main(int argc, char *argv[]) {
   // create a set of Integer
   SCEDA_TreeMap *map = SCEDA_treemap_create((SCEDA_delete_fun)delete_string,
@@ -55,6 +101,85 @@ int main(int argc, char *argv[]) {
   }
   SCEDA_treemap_iterator_cleanup(&elts);
 
+  // nearest editions (in alphabetical order) to a given name, which
+  // may be a key of the map or be out of its range
+  const char *names[] = { "A", "Judgment", "M", "Torment", "Z" };
+  int i;
+  for(i = 0; i < 5; i++) {
+    print_query("floor", SCEDA_treemap_floor, map, names[i]);
+    print_query("ceiling", SCEDA_treemap_ceiling, map, names[i]);
+    print_query("lower", SCEDA_treemap_lower, map, names[i]);
+    print_query("higher", SCEDA_treemap_higher, map, names[i]);
+  }
+
+  // positions of editions
+  for(i = 0; i < 5; i++) {
+    fprintf(stdout,"rank(%s) = %d\n",names[i], SCEDA_treemap_rank(map, names[i]));
+  }
+  int ranks[] = { -1, 0, 5, 9, 10 };
+  for(i = 0; i < 5; i++) {
+    char *key;
+    Integer *x;
+    if(SCEDA_treemap_select(map, ranks[i], (void **)&key, (void **)&x) == 0) {
+      fprintf(stdout,"select(%d) = %s -> %d\n",ranks[i], key, x->value);
+    } else {
+      fprintf(stdout,"select(%d): out of bounds\n",ranks[i]);
+    }
+  }
+
+  // iterate from a given name onwards
+  SCEDA_treemap_iterator_init_lower_bound(map, "Legions", &elts);
+  print_from(">= Legions", &elts);
+  SCEDA_treemap_iterator_init_upper_bound(map, "Legions", &elts);
+  print_from("> Legions", &elts);
+  SCEDA_treemap_iterator_init_lower_bound(map, "M", &elts);
+  print_from(">= M", &elts);
+  SCEDA_treemap_iterator_init_upper_bound(map, "Torment", &elts);
+  print_from("> Torment", &elts);
+
+  // an empty map has no nearest keys
+  SCEDA_TreeMap *empty = SCEDA_treemap_create(NULL, NULL, (SCEDA_compare_fun)compare_string);
+  print_query("floor", SCEDA_treemap_floor, empty, "M");
+  print_query("higher", SCEDA_treemap_higher, empty, "M");
+  fprintf(stdout,"empty: rank(M) = %d\n",SCEDA_treemap_rank(empty, "M"));
+  SCEDA_treemap_iterator_init_lower_bound(empty, "M", &elts);
+  print_from("empty >= M", &elts);
+
+  // build a map from keys sorted in ascending order, in linear time
+  // (keys are static strings, so that only values are deleted)
+  char *keys[] = { "Betrayers of Kamigawa", "Darksteel", "Saviors of Kamigawa", "Torment" };
+  Integer *years[] = { new_Integer(2005), new_Integer(0), new_Integer(2005), new_Integer(0) };
+  SCEDA_TreeMap *other = SCEDA_treemap_create(NULL, (SCEDA_delete_fun)delete_Integer,
+					      (SCEDA_compare_fun)compare_string);
+  SCEDA_treemap_build_sorted(other, (void **)keys, (void **)years, 4);
+  print_map("other", other);
+
+  // a map is only built from keys sorted in strictly ascending order
+  char *unsorted[] = { "Mirrodin", "Darksteel" };
+  fprintf(stdout,"build_sorted unsorted: %d\n",SCEDA_treemap_build_sorted(empty, (void **)unsorted, NULL, 2));
+  fprintf(stdout,"build_sorted into a non empty map: %d\n",SCEDA_treemap_build_sorted(other, (void **)keys, NULL, 1));
+
+  // map algebra: bindings of the first map are kept for keys bound in
+  // both maps
+  print_op("other | map", SCEDA_treemap_union, other, map);
+  print_op("map & other", SCEDA_treemap_intersection, map, other);
+  print_op("other & map", SCEDA_treemap_intersection, other, map);
+  print_op("other - map", SCEDA_treemap_difference, other, map);
+  print_op("other | empty", SCEDA_treemap_union, other, empty);
+  print_op("empty & other", SCEDA_treemap_intersection, empty, other);
+  print_op("other - other", SCEDA_treemap_difference, other, other);
+  fprintf(stdout,"union into a non empty map: %d\n",SCEDA_treemap_union(other, map, empty));
+
+  fprintf(stdout,"other <= map: %d\n",SCEDA_treemap_is_subset(other, map));
+  SCEDA_TreeMap *common = SCEDA_treemap_create(NULL, NULL, (SCEDA_compare_fun)compare_string);
+  SCEDA_treemap_intersection(common, other, map);
+  fprintf(stdout,"other & map <= map: %d\n",SCEDA_treemap_is_subset(common, map));
+  fprintf(stdout,"empty <= map: %d\n",SCEDA_treemap_is_subset(empty, map));
+  fprintf(stdout,"map <= empty: %d\n",SCEDA_treemap_is_subset(map, empty));
+  SCEDA_treemap_delete(common);
+  SCEDA_treemap_delete(other);
+  SCEDA_treemap_delete(empty);
+
   // delete the set
  SCEDA_treemap_delete(map);
 
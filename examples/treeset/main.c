@@ -27,6 +27,44 @@ int compare_Integer(Integer *x, Integer *y) {
   }
 }
 
+void print_query(const char *name, int (*query)(SCEDA_TreeSet *, const void *, void **),
+		 SCEDA_TreeSet *set, int n) {
+  Integer key = { n };
+  Integer *x;
+  if(query(set, &key, (void **)&x) == 0) {
+    fprintf(stdout,"%s(%d) = %d\n",name, n, x->value);
+  } else {
+    fprintf(stdout,"%s(%d): none\n",name, n);
+  }
+}
+
+void print_from(const char *name, SCEDA_TreeSetIterator *elts) {
+  fprintf(stdout,"%s:",name);
+  while(SCEDA_treeset_iterator_has_next(elts)) {
+    Integer *x = SCEDA_treeset_iterator_next(elts);
+    fprintf(stdout," %d",x->value);
+  }
+  fprintf(stdout,"\n");
+  SCEDA_treeset_iterator_cleanup(elts);
+}
+
+void print_set(const char *name, SCEDA_TreeSet *set) {
+  SCEDA_TreeSetIterator elts;
+  SCEDA_treeset_iterator_init(set, &elts);
+  print_from(name, &elts);
+}
+
+// compute res = op(set1, set2) into a new set, print it and delete it
+void print_op(const char *name, int (*op)(SCEDA_TreeSet *, SCEDA_TreeSet *, SCEDA_TreeSet *),
+	      SCEDA_TreeSet *set1, SCEDA_TreeSet *set2) {
+  // the elements of res are shared with set1 and set2
+  SCEDA_TreeSet *res = SCEDA_treeset_create(NULL, (SCEDA_compare_fun)compare_Integer);
+  if(op(res, set1, set2) == 0) {
+    print_set(name, res);
+  }
+  SCEDA_treeset_delete(res);
+}
+
 int main(int argc, char *argv[]) {
   // create a set of Integer
   SCEDA_TreeSet *set = SCEDA_treeset_create((SCEDA_delete_fun)delete_Integer,
@@ -48,7 +86,112 @@ int main(int argc, char *argv[]) {
   }
   SCEDA_treeset_iterator_cleanup(&elts);
 
-  // delete the set
+  // create a set of multiples of 3
+  SCEDA_TreeSet *multiples = SCEDA_treeset_create((SCEDA_delete_fun)delete_Integer,
+						  (SCEDA_compare_fun)compare_Integer);
+  for(i = 9; i >= 0; i--) {
+    SCEDA_treeset_add(multiples, new_Integer(3 * i));
+  }
+
+  // nearest elements below or above a given value, which may belong
+  // to the set or be out of its range
+  int probes[] = { -1, 0, 4, 27, 28 };
+  int j;
+  for(j = 0; j < 5; j++) {
+    print_query("floor", SCEDA_treeset_floor, multiples, probes[j]);
+    print_query("ceiling", SCEDA_treeset_ceiling, multiples, probes[j]);
+    print_query("lower", SCEDA_treeset_lower, multiples, probes[j]);
+    print_query("higher", SCEDA_treeset_higher, multiples, probes[j]);
+  }
+
+  // positions of elements
+  for(j = 0; j < 5; j++) {
+    Integer key = { probes[j] };
+    fprintf(stdout,"rank(%d) = %d\n",probes[j], SCEDA_treeset_rank(multiples, &key));
+  }
+  int ranks[] = { -1, 0, 4, 9, 10 };
+  for(j = 0; j < 5; j++) {
+    Integer *x;
+    if(SCEDA_treeset_select(multiples, ranks[j], (void **)&x) == 0) {
+      fprintf(stdout,"select(%d) = %d\n",ranks[j], x->value);
+    } else {
+      fprintf(stdout,"select(%d): out of bounds\n",ranks[j]);
+    }
+  }
+
+  // iterate from a given value onwards
+  Integer key = { 12 };
+  SCEDA_treeset_iterator_init_lower_bound(multiples, &key, &elts);
+  print_from(">= 12", &elts);
+  SCEDA_treeset_iterator_init_upper_bound(multiples, &key, &elts);
+  print_from("> 12", &elts);
+  key.value = 13;
+  SCEDA_treeset_iterator_init_lower_bound(multiples, &key, &elts);
+  print_from(">= 13", &elts);
+  key.value = 27;
+  SCEDA_treeset_iterator_init_upper_bound(multiples, &key, &elts);
+  print_from("> 27", &elts);
+  key.value = -5;
+  SCEDA_treeset_iterator_init_upper_bound(multiples, &key, &elts);
+  print_from("> -5", &elts);
+
+  // an empty set has no nearest elements
+  SCEDA_TreeSet *empty = SCEDA_treeset_create(NULL, (SCEDA_compare_fun)compare_Integer);
+  key.value = 0;
+  print_query("floor", SCEDA_treeset_floor, empty, 0);
+  print_query("ceiling", SCEDA_treeset_ceiling, empty, 0);
+  fprintf(stdout,"empty: rank(0) = %d\n",SCEDA_treeset_rank(empty, &key));
+  SCEDA_treeset_iterator_init_lower_bound(empty, &key, &elts);
+  print_from("empty >= 0", &elts);
+
+  // build a set of even numbers from a sorted array, in linear time
+  Integer *data[10];
+  for(i = 0; i < 10; i++) {
+    data[i] = new_Integer(2 * i);
+  }
+  SCEDA_TreeSet *evens = SCEDA_treeset_create((SCEDA_delete_fun)delete_Integer,
+					     (SCEDA_compare_fun)compare_Integer);
+  SCEDA_treeset_build_sorted(evens, (void **)data, 10);
+  print_set("evens", evens);
+  // the built tree keeps order statistics
+  Integer *x;
+  if(SCEDA_treeset_select(evens, 7, (void **)&x) == 0) {
+    fprintf(stdout,"evens: select(7) = %d\n",x->value);
+  }
+
+  // a set is only built from an array sorted in strictly ascending order
+  Integer unsorted[3] = { { 1 }, { 3 }, { 2 } };
+  Integer *udata[3] = { &unsorted[0], &unsorted[1], &unsorted[2] };
+  fprintf(stdout,"build_sorted unsorted: %d\n",SCEDA_treeset_build_sorted(empty, (void **)udata, 3));
+  udata[2] = &unsorted[1];
+  fprintf(stdout,"build_sorted duplicates: %d\n",SCEDA_treeset_build_sorted(empty, (void **)udata, 3));
+  fprintf(stdout,"build_sorted into a non empty set: %d\n",SCEDA_treeset_build_sorted(evens, (void **)udata, 1));
+
+  // set algebra
+  print_op("evens | multiples", SCEDA_treeset_union, evens, multiples);
+  print_op("evens & multiples", SCEDA_treeset_intersection, evens, multiples);
+  print_op("evens - multiples", SCEDA_treeset_difference, evens, multiples);
+  print_op("multiples - evens", SCEDA_treeset_difference, multiples, evens);
+  print_op("evens | empty", SCEDA_treeset_union, evens, empty);
+  print_op("empty & evens", SCEDA_treeset_intersection, empty, evens);
+  print_op("evens - empty", SCEDA_treeset_difference, evens, empty);
+  print_op("evens - evens", SCEDA_treeset_difference, evens, evens);
+  fprintf(stdout,"union into a non empty set: %d\n",SCEDA_treeset_union(multiples, evens, set));
+
+  fprintf(stdout,"evens <= set: %d\n",SCEDA_treeset_is_subset(evens, set));
+  SCEDA_treeset_delete(set);
+  set = SCEDA_treeset_create(NULL, (SCEDA_compare_fun)compare_Integer);
+  SCEDA_treeset_intersection(set, evens, multiples);
+  fprintf(stdout,"evens & multiples <= evens: %d\n",SCEDA_treeset_is_subset(set, evens));
+  fprintf(stdout,"evens & multiples <= multiples: %d\n",SCEDA_treeset_is_subset(set, multiples));
+  fprintf(stdout,"evens <= evens: %d\n",SCEDA_treeset_is_subset(evens, evens));
+  fprintf(stdout,"empty <= evens: %d\n",SCEDA_treeset_is_subset(empty, evens));
+  fprintf(stdout,"evens <= empty: %d\n",SCEDA_treeset_is_subset(evens, empty));
+  SCEDA_treeset_delete(empty);
+
+  // delete the sets
+  SCEDA_treeset_delete(evens);
+  SCEDA_treeset_delete(multiples);
   SCEDA_treeset_delete(set);
 
   return 0;
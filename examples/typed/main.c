@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <SCEDA/common.h>
+#include <SCEDA/hashmap.h>
+#include <SCEDA/pqueue.h>
+#include <SCEDA/typed_vector.h>
+#include <SCEDA/typed_pqueue.h>
+#include <SCEDA/typed_hashmap.h>
+
+#define N 1000000
+
+#define int_less(a, b) ((a) < (b))
+#define int_hash(x) ((unsigned int)(x))
+#define int_eq(a, b) ((a) == (b))
+
+SCEDA_DEFINE_VECTOR(IntVector, int)
+SCEDA_DEFINE_PQUEUE(IntPQueue, int, int_less)
+SCEDA_DEFINE_HASHMAP(IntMap, int, int, int_hash, int_eq)
+
+int compare_int(int *x, int *y) {
+  return *x - *y;
+}
+
+int match_int(int *x, int *y) {
+  return *x == *y;
+}
+
+unsigned int hash_int(int *x) {
+  return *x;
+}
+
+double elapsed(clock_t start) {
+  return ((double)(clock() - start)) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char *argv[]) {
+  srand(1);
+
+  IntVector keys;
+  IntVector_init(&keys);
+  int i;
+  for(i = 0; i < N; i++) {
+    IntVector_push(&keys, rand() % N);
+  }
+
+  // boxed priority queue: every element is allocated
+  clock_t start = clock();
+  long sum = 0;
+  SCEDA_PQueue *pqueue = SCEDA_pqueue_create(free, (SCEDA_compare_fun)compare_int);
+  for(i = 0; i < N; i++) {
+    int *x = malloc(sizeof(int));
+    *x = IntVector_get(&keys, i);
+    SCEDA_pqueue_insert(pqueue, x);
+  }
+  while(!SCEDA_pqueue_is_empty(pqueue)) {
+    int *x;
+    SCEDA_pqueue_extract(pqueue, (void **)&x);
+    sum += *x;
+    free(x);
+  }
+  SCEDA_pqueue_delete(pqueue);
+  fprintf(stdout, "SCEDA_PQueue: sum = %ld (%.3fs)\n", sum, elapsed(start));
+
+  // typed priority queue
+  start = clock();
+  sum = 0;
+  IntPQueue *ipqueue = IntPQueue_create();
+  for(i = 0; i < N; i++) {
+    IntPQueue_insert(ipqueue, IntVector_get(&keys, i));
+  }
+  int x;
+  while(IntPQueue_extract(ipqueue, &x) == 0) {
+    sum += x;
+  }
+  IntPQueue_delete(ipqueue);
+  fprintf(stdout, "IntPQueue: sum = %ld (%.3fs)\n", sum, elapsed(start));
+
+  // boxed hash map: count occurrences of each key
+  start = clock();
+  SCEDA_HashMap *map = SCEDA_hashmap_create(free, free, (SCEDA_match_fun)match_int, (SCEDA_hash_fun)hash_int);
+  for(i = 0; i < N; i++) {
+    int *count = SCEDA_hashmap_get(map, IntVector_at(&keys, i));
+    if(count == NULL) {
+      int *key = malloc(sizeof(int));
+      *key = IntVector_get(&keys, i);
+      count = malloc(sizeof(int));
+      *count = 0;
+      SCEDA_hashmap_put(map, key, count, NULL);
+    }
+    (*count)++;
+  }
+  fprintf(stdout, "SCEDA_HashMap: %d distinct keys (%.3fs)\n", SCEDA_hashmap_size(map), elapsed(start));
+  SCEDA_hashmap_delete(map);
+
+  // typed hash map
+  start = clock();
+  IntMap imap;
+  IntMap_init(&imap);
+  for(i = 0; i < N; i++) {
+    int key = IntVector_get(&keys, i);
+    int *count = IntMap_get(&imap, key);
+    if(count == NULL) {
+      IntMap_put(&imap, key, 1, NULL);
+    } else {
+      (*count)++;
+    }
+  }
+  fprintf(stdout, "IntMap: %d distinct keys (%.3fs)\n", IntMap_size(&imap), elapsed(start));
+
+  int max_key = -1, max_count = 0;
+  IntMapIterator iter;
+  IntMap_iterator_init(&imap, &iter);
+  while(IntMap_iterator_has_next(&iter)) {
+    int key;
+    int count = IntMap_iterator_next(&iter, &key);
+    if((count > max_count) || ((count == max_count) && (key < max_key))) {
+      max_key = key;
+      max_count = count;
+    }
+  }
+  IntMap_iterator_cleanup(&iter);
+  fprintf(stdout, "most frequent key: %d (%d times)\n", max_key, max_count);
+
+  IntMap_cleanup(&imap);
+  IntVector_cleanup(&keys);
+
+  return 0;
+}
@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <SCEDA/common.h>
+#include <SCEDA/vector.h>
+
+typedef struct {
+  int value;
+} Integer;
+
+Integer *new_Integer(int n) {
+  Integer *x = malloc(sizeof(Integer));
+  x->value = n;
+  return x;
+}
+
+void delete_Integer(Integer *x) {
+  free(x);
+}
+
+int compare_Integer(Integer *x, Integer *y) {
+  if(x->value < y->value) {
+    return -1;
+  } else if(x->value == y->value) {
+    return 0;
+  } else {
+    return 1;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // create a vector of Integer
+  SCEDA_Vector *vector = SCEDA_vector_create((SCEDA_delete_fun)delete_Integer);
+
+  int i;
+  for(i = 0; i < 10; i++) {
+    // add (7 * i) mod 10 at the end of the vector
+    SCEDA_vector_push(vector, new_Integer((7 * i) % 10));
+  }
+
+  // sort the vector
+  SCEDA_vector_sort(vector, (SCEDA_compare_fun)compare_Integer);
+
+  // print its content
+  SCEDA_VectorIterator iter;
+  SCEDA_vector_iterator_init(vector, &iter);
+  while(SCEDA_vector_iterator_has_next(&iter)) {
+    Integer *x = SCEDA_vector_iterator_next(&iter);
+    fprintf(stdout,"%d ",x->value);
+  }
+  SCEDA_vector_iterator_cleanup(&iter);
+  fprintf(stdout,"\n");
+
+  // look for some elements
+  for(i = 0; i < 12; i += 3) {
+    Integer x;
+    x.value = i;
+    int pos = SCEDA_vector_bsearch(vector, &x, (SCEDA_compare_fun)compare_Integer);
+    fprintf(stdout,"%d is at position %d\n", i, pos);
+  }
+
+  // random access
+  Integer *x = SCEDA_vector_get(Integer *, vector, 5);
+  fprintf(stdout,"vector[5] = %d\n", x->value);
+
+  // delete the vector (and its elements)
+  SCEDA_vector_delete(vector);
+
+  return 0;
+}
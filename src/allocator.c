@@ -0,0 +1,49 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include "allocator.h"
+#include <stdlib.h>
+
+static void *SCEDA_std_alloc(size_t size, void *ctxt) {
+  return malloc(size);
+}
+
+static void SCEDA_std_free(void *ptr, size_t size, void *ctxt) {
+  free(ptr);
+}
+
+static SCEDA_Allocator SCEDA_std_allocator = { SCEDA_std_alloc, SCEDA_std_free, NULL };
+
+static SCEDA_Allocator *SCEDA_default_allocator = &SCEDA_std_allocator;
+
+SCEDA_Allocator *SCEDA_allocator_std() {
+  return &SCEDA_std_allocator;
+}
+
+SCEDA_Allocator *SCEDA_allocator_get_default() {
+  return SCEDA_default_allocator;
+}
+
+void SCEDA_allocator_set_default(SCEDA_Allocator *alloc) {
+  if(alloc == NULL) {
+    SCEDA_default_allocator = &SCEDA_std_allocator;
+  } else {
+    SCEDA_default_allocator = alloc;
+  }
+}
@@ -0,0 +1,73 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_ALLOCATOR_H
+#define __SCEDA_ALLOCATOR_H
+/** \file allocator.h
+    \brief Memory allocators */
+
+#include <stddef.h>
+
+/** Allocation functions.
+
+    @param[in] size = number of bytes to allocate
+    @param[in] ctxt = context of the allocator
+
+    @return the allocated block or NULL */
+typedef void *(*SCEDA_alloc_fun)(size_t size, void *ctxt);
+
+/** Deallocation functions.
+
+    @param[in] ptr = block to deallocate
+    @param[in] size = size of the block (as given at allocation)
+    @param[in] ctxt = context of the allocator */
+typedef void (*SCEDA_free_fun)(void *ptr, size_t size, void *ctxt);
+
+/** Memory allocator.
+
+    The free function may be NULL, in which case blocks are never
+    deallocated one by one (e.g. arenas released all at once by their
+    owner). Containers using such an allocator and without delete
+    function are then cleaned up in constant time. */
+typedef struct {
+  SCEDA_alloc_fun alloc;
+  SCEDA_free_fun free;
+  void *ctxt;
+} SCEDA_Allocator;
+
+/** Get the standard allocator (malloc/free).
+
+    @return the standard allocator */
+SCEDA_Allocator *SCEDA_allocator_std();
+
+/** Get the process-wide default allocator, used by the containers
+    that are not given an allocator explicitly. It is initially the
+    standard allocator.
+
+    @return the default allocator */
+SCEDA_Allocator *SCEDA_allocator_get_default();
+
+/** Set the process-wide default allocator. Containers keep the
+    allocator they have been initialised with.
+
+    @param[in] alloc = new default allocator (NULL means the standard
+    allocator) */
+void SCEDA_allocator_set_default(SCEDA_Allocator *alloc);
+
+#endif
@@ -0,0 +1,95 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include <string.h>
+#include "aqueue.h"
+#include "util.h"
+
+void SCEDA_aqueue_init_with_allocator(SCEDA_AQueue *queue, SCEDA_Allocator *alloc, SCEDA_delete_fun delete) {
+  queue->size = 0;
+  queue->head = 0;
+  queue->length = 0;
+  queue->delete = delete;
+  queue->alloc = alloc;
+  queue->elts = NULL;
+}
+
+void SCEDA_aqueue_init(SCEDA_AQueue *queue, SCEDA_delete_fun delete) {
+  SCEDA_aqueue_init_with_allocator(queue, SCEDA_allocator_get_default(), delete);
+}
+
+SCEDA_AQueue *SCEDA_aqueue_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete) {
+  SCEDA_AQueue *queue = (SCEDA_AQueue *)alloc_malloc(alloc, sizeof(SCEDA_AQueue));
+  SCEDA_aqueue_init_with_allocator(queue, alloc, delete);
+  return queue;
+}
+
+SCEDA_AQueue *SCEDA_aqueue_create(SCEDA_delete_fun delete) {
+  return SCEDA_aqueue_create_with_allocator(SCEDA_allocator_get_default(), delete);
+}
+
+static void SCEDA_aqueue_cleanup_elts(SCEDA_AQueue *queue) {
+  if(queue->delete != NULL) {
+    int i;
+    for(i = 0; i < queue->size; i++) {
+      queue->delete(SCEDA_aqueue_nth(queue, i));
+    }
+  }
+}
+
+void SCEDA_aqueue_cleanup(SCEDA_AQueue *queue) {
+  SCEDA_Allocator *alloc = queue->alloc;
+  SCEDA_aqueue_cleanup_elts(queue);
+  if(queue->elts != NULL) {
+    alloc_free(alloc, queue->elts, queue->length * sizeof(void *));
+  }
+  // keep the allocator, so that the queue can still be cleaned up or deleted
+  memset(queue, 0, sizeof(SCEDA_AQueue));
+  queue->alloc = alloc;
+}
+
+void SCEDA_aqueue_delete(SCEDA_AQueue *queue) {
+  SCEDA_Allocator *alloc = queue->alloc;
+  SCEDA_aqueue_cleanup(queue);
+  alloc_free(alloc, queue, sizeof(SCEDA_AQueue));
+}
+
+void SCEDA_aqueue_clear(SCEDA_AQueue *queue) {
+  SCEDA_aqueue_cleanup_elts(queue);
+  queue->size = 0;
+  queue->head = 0;
+}
+
+void SCEDA_aqueue_grow(SCEDA_AQueue *queue) {
+  int length = (queue->length == 0) ? SCEDA_AQUEUE_MIN_LENGTH : 2 * queue->length;
+  void *(*elts)[] = alloc_malloc(queue->alloc, length * sizeof(void *));
+
+  // unwrap the elements at the beginning of the new array
+  int i;
+  for(i = 0; i < queue->size; i++) {
+    (*elts)[i] = SCEDA_aqueue_nth(queue, i);
+  }
+
+  if(queue->elts != NULL) {
+    alloc_free(queue->alloc, queue->elts, queue->length * sizeof(void *));
+  }
+  queue->elts = elts;
+  queue->length = length;
+  queue->head = 0;
+}
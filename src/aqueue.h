@@ -0,0 +1,151 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_AQUEUE_H
+#define __SCEDA_AQUEUE_H
+/** \file aqueue.h
+    \brief queues implemented as circular arrays */
+
+#include "common.h"
+#include <string.h>
+
+/** Queue stored in a circular array. The array is allocated on the
+    first enqueue and its length is always a power of two. */
+typedef struct {
+  int size;
+  int head;
+  int length;
+  SCEDA_delete_fun delete;
+  SCEDA_Allocator *alloc;
+  void *(*elts)[];
+} SCEDA_AQueue;
+
+/** Initial length of the array of a queue. */
+#define SCEDA_AQUEUE_MIN_LENGTH 16
+
+/** Initialise a queue.
+
+    @param[in] queue = queue to initialise
+    @param[in] delete = function to delete data or NULL */
+void SCEDA_aqueue_init(SCEDA_AQueue *queue, SCEDA_delete_fun delete);
+
+/** Initialise a queue whose array is allocated by a given allocator.
+
+    @param[in] queue = queue to initialise
+    @param[in] alloc = allocator
+    @param[in] delete = function to delete data or NULL */
+void SCEDA_aqueue_init_with_allocator(SCEDA_AQueue *queue, SCEDA_Allocator *alloc, SCEDA_delete_fun delete);
+
+/** Create a queue, ready for use.
+
+    @param[in] delete = function to delete data or NULL
+
+    @return the queue */
+SCEDA_AQueue *SCEDA_aqueue_create(SCEDA_delete_fun delete);
+
+/** Create a queue, ready for use. The queue and its array are
+    allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete = function to delete data or NULL
+
+    @return the queue */
+SCEDA_AQueue *SCEDA_aqueue_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete);
+
+/** Clean up a queue.
+
+    @param[in] queue = queue to clean up */
+void SCEDA_aqueue_cleanup(SCEDA_AQueue *queue);
+
+/** Delete a queue.
+
+    @param[in] queue = queue to delete */
+void SCEDA_aqueue_delete(SCEDA_AQueue *queue);
+
+/** Clear a queue. The array is kept.
+
+    @param[in] queue = queue to clear */
+void SCEDA_aqueue_clear(SCEDA_AQueue *queue);
+
+/** Double the length of the array of a queue (internal use).
+
+    @param[in] queue = queue */
+void SCEDA_aqueue_grow(SCEDA_AQueue *queue);
+
+#define SCEDA_aqueue_nth(queue$, i$) ((*((queue$)->elts))[((queue$)->head + (i$)) & ((queue$)->length - 1)])
+
+/** Enqueue an element in amortized time complexity O(1).
+
+    @param[in] queue = queue
+    @param[in] data = data to enqueue
+
+    @return 0 in case of success, -1 otherwise
+
+    \hideinitializer */
+#define SCEDA_aqueue_enqueue(queue$, data$) \
+  ({ SCEDA_AQueue *_queue = (queue$); \
+     if(_queue->size == _queue->length) { \
+       SCEDA_aqueue_grow(_queue); \
+     } \
+     SCEDA_aqueue_nth(_queue, _queue->size) = (void *)(data$); \
+     _queue->size++; \
+     0; })
+
+/** Dequeue an element in time complexity O(1).
+
+    @param[in] queue = queue
+    @param[out] data = dequeued data
+
+    @return 0 in case of success, -1 otherwise
+
+    \hideinitializer */
+#define SCEDA_aqueue_dequeue(queue$, data$) \
+  ({ SCEDA_AQueue *_queue = (queue$); \
+     int _res = -1; \
+     if(_queue->size > 0) { \
+       *(data$) = SCEDA_aqueue_nth(_queue, 0); \
+       _queue->head = (_queue->head + 1) & (_queue->length - 1); \
+       _queue->size--; \
+       _res = 0; \
+     } \
+     _res; })
+
+/** Give the size of the queue.
+
+    \hideinitializer */
+#define SCEDA_aqueue_size(queue$) ((queue$)->size)
+
+/** SCEDA_AQueue is empty?
+
+    \hideinitializer */
+#define SCEDA_aqueue_is_empty(queue$) (SCEDA_aqueue_size(queue$) == 0)
+
+/** Return the top element of the queue or NULL.
+
+    @param type = type of queue elements
+    @param[in] queue = queue
+
+    @return top element of the queue or NULL if queue is empty
+
+    \hideinitializer */
+#define SCEDA_aqueue_peek(type$, queue$) \
+  ({ SCEDA_AQueue *_queue = (queue$); \
+     (_queue->size == 0) ? (type$)NULL : (type$)SCEDA_aqueue_nth(_queue, 0); })
+
+#endif
@@ -0,0 +1,85 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include <string.h>
+#include "astack.h"
+#include "util.h"
+
+void SCEDA_astack_init_with_allocator(SCEDA_AStack *stack, SCEDA_Allocator *alloc, SCEDA_delete_fun delete) {
+  stack->size = 0;
+  stack->length = 0;
+  stack->delete = delete;
+  stack->alloc = alloc;
+  stack->elts = NULL;
+}
+
+void SCEDA_astack_init(SCEDA_AStack *stack, SCEDA_delete_fun delete) {
+  SCEDA_astack_init_with_allocator(stack, SCEDA_allocator_get_default(), delete);
+}
+
+SCEDA_AStack *SCEDA_astack_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete) {
+  SCEDA_AStack *stack = (SCEDA_AStack *)alloc_malloc(alloc, sizeof(SCEDA_AStack));
+  SCEDA_astack_init_with_allocator(stack, alloc, delete);
+  return stack;
+}
+
+SCEDA_AStack *SCEDA_astack_create(SCEDA_delete_fun delete) {
+  return SCEDA_astack_create_with_allocator(SCEDA_allocator_get_default(), delete);
+}
+
+static void SCEDA_astack_cleanup_elts(SCEDA_AStack *stack) {
+  if(stack->delete != NULL) {
+    int i;
+    for(i = stack->size - 1; i >= 0; i--) {
+      stack->delete(SCEDA_astack_nth(stack, i));
+    }
+  }
+}
+
+void SCEDA_astack_cleanup(SCEDA_AStack *stack) {
+  SCEDA_Allocator *alloc = stack->alloc;
+  SCEDA_astack_cleanup_elts(stack);
+  if(stack->elts != NULL) {
+    alloc_free(alloc, stack->elts, stack->length * sizeof(void *));
+  }
+  // keep the allocator, so that the stack can still be cleaned up or deleted
+  memset(stack, 0, sizeof(SCEDA_AStack));
+  stack->alloc = alloc;
+}
+
+void SCEDA_astack_delete(SCEDA_AStack *stack) {
+  SCEDA_Allocator *alloc = stack->alloc;
+  SCEDA_astack_cleanup(stack);
+  alloc_free(alloc, stack, sizeof(SCEDA_AStack));
+}
+
+void SCEDA_astack_clear(SCEDA_AStack *stack) {
+  SCEDA_astack_cleanup_elts(stack);
+  stack->size = 0;
+}
+
+void SCEDA_astack_grow(SCEDA_AStack *stack) {
+  int length = (stack->length == 0) ? SCEDA_DFLT_SIZE : 2 * stack->length;
+  if(stack->elts == NULL) {
+    stack->elts = alloc_malloc(stack->alloc, length * sizeof(void *));
+  } else {
+    stack->elts = alloc_realloc(stack->alloc, stack->elts, stack->length * sizeof(void *), length * sizeof(void *));
+  }
+  stack->length = length;
+}
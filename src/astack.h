@@ -0,0 +1,144 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_ASTACK_H
+#define __SCEDA_ASTACK_H
+/** \file astack.h
+    \brief stacks implemented as growable arrays */
+
+#include "common.h"
+#include <string.h>
+
+/** Stack stored in a growable array. The array is allocated on the
+    first push. */
+typedef struct {
+  int size;
+  int length;
+  SCEDA_delete_fun delete;
+  SCEDA_Allocator *alloc;
+  void *(*elts)[];
+} SCEDA_AStack;
+
+/** Initialise a stack.
+
+    @param[in] stack = stack to initialise
+    @param[in] delete = function to delete data or NULL */
+void SCEDA_astack_init(SCEDA_AStack *stack, SCEDA_delete_fun delete);
+
+/** Initialise a stack whose array is allocated by a given allocator.
+
+    @param[in] stack = stack to initialise
+    @param[in] alloc = allocator
+    @param[in] delete = function to delete data or NULL */
+void SCEDA_astack_init_with_allocator(SCEDA_AStack *stack, SCEDA_Allocator *alloc, SCEDA_delete_fun delete);
+
+/** Create a stack, ready for use.
+
+    @param[in] delete = function to delete data or NULL
+
+    @return the stack */
+SCEDA_AStack *SCEDA_astack_create(SCEDA_delete_fun delete);
+
+/** Create a stack, ready for use. The stack and its array are
+    allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete = function to delete data or NULL
+
+    @return the stack */
+SCEDA_AStack *SCEDA_astack_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete);
+
+/** Clean up a stack.
+
+    @param[in] stack = stack to clean up */
+void SCEDA_astack_cleanup(SCEDA_AStack *stack);
+
+/** Delete a stack.
+
+    @param[in] stack = stack to delete */
+void SCEDA_astack_delete(SCEDA_AStack *stack);
+
+/** Clear a stack. The array is kept.
+
+    @param[in] stack = stack to clear */
+void SCEDA_astack_clear(SCEDA_AStack *stack);
+
+/** Double the length of the array of a stack (internal use).
+
+    @param[in] stack = stack */
+void SCEDA_astack_grow(SCEDA_AStack *stack);
+
+#define SCEDA_astack_nth(stack$, i$) ((*((stack$)->elts))[i$])
+
+/** Push an element in amortized time complexity O(1).
+
+    @param[in] stack = stack
+    @param[in] data = data to push
+
+    @return 0 in case of success, -1 otherwise
+
+    \hideinitializer */
+#define SCEDA_astack_push(stack$, data$) \
+  ({ SCEDA_AStack *_stack = (stack$); \
+     if(_stack->size == _stack->length) { \
+       SCEDA_astack_grow(_stack); \
+     } \
+     SCEDA_astack_nth(_stack, _stack->size++) = (void *)(data$); \
+     0; })
+
+/** Pop an element in time complexity O(1).
+
+    @param[in] stack = stack
+    @param[out] data = popped data
+
+    @return 0 in case of success, -1 otherwise
+
+    \hideinitializer */
+#define SCEDA_astack_pop(stack$, data$) \
+  ({ SCEDA_AStack *_stack = (stack$); \
+     int _res = -1; \
+     if(_stack->size > 0) { \
+       *(data$) = SCEDA_astack_nth(_stack, --_stack->size); \
+       _res = 0; \
+     } \
+     _res; })
+
+/** Give the size of the stack.
+
+    \hideinitializer */
+#define SCEDA_astack_size(stack$) ((stack$)->size)
+
+/** SCEDA_AStack is empty?
+
+    \hideinitializer */
+#define SCEDA_astack_is_empty(stack$) (SCEDA_astack_size(stack$) == 0)
+
+/** Return the top element of the stack or NULL.
+
+    @param type = type of elements in the stack
+    @param[in] stack = stack
+
+    @return top element or NULL if stack is empty
+
+    \hideinitializer */
+#define SCEDA_astack_peek(type$, stack$) \
+  ({ SCEDA_AStack *_stack = (stack$); \
+     (_stack->size == 0) ? (type$)NULL : (type$)SCEDA_astack_nth(_stack, _stack->size - 1); })
+
+#endif
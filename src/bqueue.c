@@ -0,0 +1,215 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include <string.h>
+#include "bqueue.h"
+#include "util.h"
+
+#define nbuckets(queue) ((queue)->span + 1)
+
+static void SCEDA_bqueue_grow(SCEDA_BucketQueue *queue, int capacity) {
+  SCEDA_Allocator *alloc = queue->alloc;
+  int old = queue->capacity;
+  queue->key = alloc_realloc(alloc, queue->key, old * sizeof(int), capacity * sizeof(int));
+  queue->next = alloc_realloc(alloc, queue->next, old * sizeof(int), capacity * sizeof(int));
+  queue->previous = alloc_realloc(alloc, queue->previous, old * sizeof(int), capacity * sizeof(int));
+  queue->bucket = alloc_realloc(alloc, queue->bucket, old * sizeof(int), capacity * sizeof(int));
+  memset(&queue->bucket[old], -1, (capacity - old) * sizeof(int));
+  queue->capacity = capacity;
+}
+
+void SCEDA_bqueue_init_with_allocator(SCEDA_BucketQueue *queue, SCEDA_Allocator *alloc, int capacity, int span) {
+  if(capacity < SCEDA_DFLT_SIZE) {
+    capacity = SCEDA_DFLT_SIZE;
+  }
+  if(span < 0) {
+    span = 0;
+  }
+  queue->size = 0;
+  queue->capacity = capacity;
+  queue->span = span;
+  queue->base = 0;
+  queue->heads = alloc_malloc(alloc, (span + 1) * sizeof(int));
+  queue->key = alloc_malloc(alloc, capacity * sizeof(int));
+  queue->next = alloc_malloc(alloc, capacity * sizeof(int));
+  queue->previous = alloc_malloc(alloc, capacity * sizeof(int));
+  queue->bucket = alloc_malloc(alloc, capacity * sizeof(int));
+  memset(queue->heads, -1, (span + 1) * sizeof(int));
+  memset(queue->bucket, -1, capacity * sizeof(int));
+  queue->alloc = alloc;
+}
+
+void SCEDA_bqueue_init(SCEDA_BucketQueue *queue, int capacity, int span) {
+  SCEDA_bqueue_init_with_allocator(queue, SCEDA_allocator_get_default(), capacity, span);
+}
+
+SCEDA_BucketQueue *SCEDA_bqueue_create_with_allocator(SCEDA_Allocator *alloc, int capacity, int span) {
+  SCEDA_BucketQueue *queue = (SCEDA_BucketQueue *)alloc_malloc(alloc, sizeof(SCEDA_BucketQueue));
+  SCEDA_bqueue_init_with_allocator(queue, alloc, capacity, span);
+  return queue;
+}
+
+SCEDA_BucketQueue *SCEDA_bqueue_create(int capacity, int span) {
+  return SCEDA_bqueue_create_with_allocator(SCEDA_allocator_get_default(), capacity, span);
+}
+
+void SCEDA_bqueue_cleanup(SCEDA_BucketQueue *queue) {
+  SCEDA_Allocator *alloc = queue->alloc;
+  int capacity = queue->capacity;
+  if(queue->heads != NULL) {
+    alloc_free(alloc, queue->heads, nbuckets(queue) * sizeof(int));
+    alloc_free(alloc, queue->key, capacity * sizeof(int));
+    alloc_free(alloc, queue->next, capacity * sizeof(int));
+    alloc_free(alloc, queue->previous, capacity * sizeof(int));
+    alloc_free(alloc, queue->bucket, capacity * sizeof(int));
+  }
+  memset(queue, 0, sizeof(SCEDA_BucketQueue));
+  queue->alloc = alloc;
+}
+
+void SCEDA_bqueue_delete(SCEDA_BucketQueue *queue) {
+  SCEDA_Allocator *alloc = queue->alloc;
+  SCEDA_bqueue_cleanup(queue);
+  alloc_free(alloc, queue, sizeof(SCEDA_BucketQueue));
+}
+
+void SCEDA_bqueue_clear(SCEDA_BucketQueue *queue) {
+  int b;
+  for(b = 0; b < nbuckets(queue); b++) {
+    int h;
+    for(h = queue->heads[b]; h != -1; h = queue->next[h]) {
+      queue->bucket[h] = -1;
+    }
+    queue->heads[b] = -1;
+  }
+  queue->size = 0;
+  queue->base = 0;
+}
+
+static inline void SCEDA_bqueue_link(SCEDA_BucketQueue *queue, int handle) {
+  int b = queue->key[handle] % nbuckets(queue);
+  int head = queue->heads[b];
+  queue->next[handle] = head;
+  queue->previous[handle] = -1;
+  if(head != -1) {
+    queue->previous[head] = handle;
+  }
+  queue->heads[b] = handle;
+  queue->bucket[handle] = b;
+}
+
+static inline void SCEDA_bqueue_unlink(SCEDA_BucketQueue *queue, int handle) {
+  int next = queue->next[handle];
+  int previous = queue->previous[handle];
+  if(previous == -1) {
+    queue->heads[queue->bucket[handle]] = next;
+  } else {
+    queue->next[previous] = next;
+  }
+  if(next != -1) {
+    queue->previous[next] = previous;
+  }
+  queue->bucket[handle] = -1;
+}
+
+/* move the base up to the minimum key (the queue must not be empty) */
+static inline int SCEDA_bqueue_first(SCEDA_BucketQueue *queue) {
+  int n = nbuckets(queue);
+  int b = queue->base % n;
+  while(queue->heads[b] == -1) {
+    queue->base++;
+    b++;
+    if(b == n) {
+      b = 0;
+    }
+  }
+  return queue->heads[b];
+}
+
+int SCEDA_bqueue_insert(SCEDA_BucketQueue *queue, int handle, int key) {
+  if((handle < 0) || (key < 0)) {
+    return -1;
+  }
+  if((key < queue->base) || (key - queue->base > queue->span)) {
+    if(queue->size != 0) {
+      return -1;
+    }
+    queue->base = key;
+  }
+  if(handle >= queue->capacity) {
+    SCEDA_bqueue_grow(queue, (handle < 2 * queue->capacity) ? 2 * queue->capacity : handle + 1);
+  } else if(queue->bucket[handle] != -1) {
+    return -1;
+  }
+
+  queue->key[handle] = key;
+  SCEDA_bqueue_link(queue, handle);
+  queue->size++;
+  return 0;
+}
+
+int SCEDA_bqueue_min(SCEDA_BucketQueue *queue, int *handle, int *key) {
+  if(queue->size == 0) {
+    return -1;
+  }
+  int h = SCEDA_bqueue_first(queue);
+  *handle = h;
+  if(key != NULL) {
+    *key = queue->key[h];
+  }
+  return 0;
+}
+
+int SCEDA_bqueue_extract(SCEDA_BucketQueue *queue, int *handle, int *key) {
+  if(queue->size == 0) {
+    return -1;
+  }
+  int h = SCEDA_bqueue_first(queue);
+  SCEDA_bqueue_unlink(queue, h);
+  queue->size--;
+  *handle = h;
+  if(key != NULL) {
+    *key = queue->key[h];
+  }
+  return 0;
+}
+
+int SCEDA_bqueue_decrease_key(SCEDA_BucketQueue *queue, int handle, int key) {
+  if(!SCEDA_bqueue_contains(queue, handle) || (key > queue->key[handle]) || (key < queue->base)) {
+    return -1;
+  }
+  if(key != queue->key[handle]) {
+    SCEDA_bqueue_unlink(queue, handle);
+    queue->key[handle] = key;
+    SCEDA_bqueue_link(queue, handle);
+  }
+  return 0;
+}
+
+int SCEDA_bqueue_remove(SCEDA_BucketQueue *queue, int handle, int *key) {
+  if(!SCEDA_bqueue_contains(queue, handle)) {
+    return -1;
+  }
+  SCEDA_bqueue_unlink(queue, handle);
+  queue->size--;
+  if(key != NULL) {
+    *key = queue->key[handle];
+  }
+  return 0;
+}
@@ -0,0 +1,194 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_BQUEUE_H
+#define __SCEDA_BQUEUE_H
+/** \file bqueue.h
+    \brief Bucket queues (Dial) for monotone integer keys. */
+
+#include "common.h"
+
+/** Bucket queue.
+
+    Elements are identified by dense integer handles, as in indexed
+    heaps, and their keys are non negative integers. The queue is
+    monotone: a key inserted (or decreased) must not be smaller than
+    the last extracted (or minimum) key, nor greater than this key
+    plus the span of the queue. Any key may be inserted in an empty
+    queue.
+
+    As keys lie in [base, base + span], the element of key k is kept
+    in the bucket k mod (span + 1), buckets being doubly linked lists
+    of handles. bucket[h] is the bucket of handle h, or -1 if h is not
+    in the queue. */
+typedef struct {
+  int size;
+  int capacity;
+  int span;
+  int base;
+  int *heads;
+  int *key;
+  int *next;
+  int *previous;
+  int *bucket;
+  SCEDA_Allocator *alloc;
+} SCEDA_BucketQueue;
+
+/** Initialise a bucket queue for handles 0 to capacity - 1. The
+    queue grows when larger handles are inserted.
+
+    @param[in] queue = queue to initialise
+    @param[in] capacity = number of handles
+    @param[in] span = maximal difference between two keys of the queue */
+void SCEDA_bqueue_init(SCEDA_BucketQueue *queue, int capacity, int span);
+
+/** Create a bucket queue for handles 0 to capacity - 1.
+
+    @param[in] capacity = number of handles
+    @param[in] span = maximal difference between two keys of the queue
+
+    @return a bucket queue */
+SCEDA_BucketQueue *SCEDA_bqueue_create(int capacity, int span);
+
+/** Initialise a bucket queue whose arrays are allocated by a given
+    allocator.
+
+    @param[in] queue = queue to initialise
+    @param[in] alloc = allocator
+    @param[in] capacity = number of handles
+    @param[in] span = maximal difference between two keys of the queue */
+void SCEDA_bqueue_init_with_allocator(SCEDA_BucketQueue *queue, SCEDA_Allocator *alloc, int capacity, int span);
+
+/** Create a bucket queue. The queue and its arrays are allocated by
+    the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] capacity = number of handles
+    @param[in] span = maximal difference between two keys of the queue
+
+    @return a bucket queue */
+SCEDA_BucketQueue *SCEDA_bqueue_create_with_allocator(SCEDA_Allocator *alloc, int capacity, int span);
+
+/** Clean up a bucket queue.
+
+    @param[in] queue = queue to clean up */
+void SCEDA_bqueue_cleanup(SCEDA_BucketQueue *queue);
+
+/** Delete a bucket queue.
+
+    @param[in] queue = queue to delete */
+void SCEDA_bqueue_delete(SCEDA_BucketQueue *queue);
+
+/** Clear a bucket queue. Its capacity and span are kept.
+
+    @param[in] queue = queue to clear */
+void SCEDA_bqueue_clear(SCEDA_BucketQueue *queue);
+
+/** Insert an element into a bucket queue in time complexity O(1).
+
+    @param[in] queue = queue
+    @param[in] handle = handle of the element (non negative)
+    @param[in] key = key of the element
+
+    @return 0 in case of success, -1 if handle is negative or already
+    in the queue, or if key is out of the range of the queue */
+int SCEDA_bqueue_insert(SCEDA_BucketQueue *queue, int handle, int key);
+
+/** Extract an element of minimum key from a bucket queue in
+    amortized time complexity O(span).
+
+    @param[in] queue = queue
+    @param[out] handle = handle of extracted element
+    @param[out] key = key of extracted element (set by function if not NULL)
+
+    @return 0 in case of success, -1 if the queue is empty */
+int SCEDA_bqueue_extract(SCEDA_BucketQueue *queue, int *handle, int *key);
+
+/** Return an element of minimum key of a bucket queue in amortized
+    time complexity O(span).
+
+    @param[in] queue = queue
+    @param[out] handle = handle of minimum element
+    @param[out] key = key of minimum element (set by function if not NULL)
+
+    @return 0 in case of success, -1 if the queue is empty */
+int SCEDA_bqueue_min(SCEDA_BucketQueue *queue, int *handle, int *key);
+
+/** Decrease the key of an element in time complexity O(1).
+
+    @param[in] queue = queue
+    @param[in] handle = handle of the element
+    @param[in] key = new key
+
+    @return 0 in case of success, -1 if handle is not in the queue or
+    if key is greater than its current key or smaller than the last
+    extracted (or minimum) key */
+int SCEDA_bqueue_decrease_key(SCEDA_BucketQueue *queue, int handle, int key);
+
+/** Remove an element from a bucket queue in time complexity O(1).
+
+    @param[in] queue = queue
+    @param[in] handle = handle of the element to remove
+    @param[out] key = key of removed element (set by function if not NULL)
+
+    @return 0 in case of success, -1 if handle is not in the queue */
+int SCEDA_bqueue_remove(SCEDA_BucketQueue *queue, int handle, int *key);
+
+/** Test whether an element is in a bucket queue in time complexity O(1).
+
+    @param[in] queue = queue
+    @param[in] handle = handle
+
+    @return TRUE if handle is in the queue, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_bqueue_contains(queue$, handle$)				\
+  ({ SCEDA_BucketQueue *_queue = (queue$);				\
+     int _handle = (handle$);						\
+     ((_handle >= 0) && (_handle < _queue->capacity) && (_queue->bucket[_handle] != -1)); })
+
+/** Return the key of an element of a bucket queue.
+
+    @param[in] queue = queue
+    @param[in] handle = handle (must be in the queue)
+
+    @return the key of the element
+
+    \hideinitializer */
+#define SCEDA_bqueue_get_key(queue$, handle$) ((queue$)->key[handle$])
+
+/** Return the size of a bucket queue.
+
+    @param[in] queue = queue
+
+    @return the size of the queue
+
+    \hideinitializer */
+#define SCEDA_bqueue_size(queue$) ((queue$)->size)
+
+/** Test whether a bucket queue is empty.
+
+    @param[in] queue = queue
+
+    @return TRUE if queue is empty, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_bqueue_is_empty(queue$) (SCEDA_bqueue_size(queue$) == 0)
+
+#endif
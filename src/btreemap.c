@@ -0,0 +1,552 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include <stddef.h>
+#include <string.h>
+#include "btreemap.h"
+#include "util.h"
+
+#define T SCEDA_BTREE_DEGREE
+
+/* leaves are allocated without their children array */
+#define node_size(leaf) ((leaf) ? offsetof(SCEDA_BTreeNode, children) : sizeof(SCEDA_BTreeNode))
+
+static SCEDA_BTreeNode *SCEDA_btreemap_node_create(SCEDA_BTreeMap *map, int leaf) {
+  SCEDA_BTreeNode *x = (SCEDA_BTreeNode *)alloc_malloc(map->alloc, node_size(leaf));
+  x->count = 0;
+  x->leaf = leaf;
+  return x;
+}
+
+static void SCEDA_btreemap_node_delete(SCEDA_BTreeMap *map, SCEDA_BTreeNode *x) {
+  alloc_free(map->alloc, x, node_size(x->leaf));
+}
+
+/* Return the index of the first key of x greater than or equal to key
+   (x->count if none). found is set when the key is equal. */
+static int SCEDA_btreemap_search_node(SCEDA_BTreeMap *map, SCEDA_BTreeNode *x, const void *key, int *found) {
+  SCEDA_compare_fun compare = map->compare_key;
+  int lo = 0;
+  int hi = x->count;
+  while(lo < hi) {
+    int mid = (lo + hi) / 2;
+    int res = compare(key, x->keys[mid]);
+    if(res == 0) {
+      *found = TRUE;
+      return mid;
+    } else if(res < 0) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  *found = FALSE;
+  return lo;
+}
+
+void SCEDA_btreemap_init_with_allocator(SCEDA_BTreeMap *map, SCEDA_Allocator *alloc, SCEDA_delete_fun delete_key,
+					SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key) {
+  map->size = 0;
+  map->root = NULL;
+  map->delete_key = delete_key;
+  map->delete_value = delete_value;
+  map->compare_key = compare_key;
+  map->alloc = alloc;
+}
+
+void SCEDA_btreemap_init(SCEDA_BTreeMap *map, SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key) {
+  SCEDA_btreemap_init_with_allocator(map, SCEDA_allocator_get_default(), delete_key, delete_value, compare_key);
+}
+
+SCEDA_BTreeMap *SCEDA_btreemap_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete_key,
+						     SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key) {
+  SCEDA_BTreeMap *map = (SCEDA_BTreeMap *)alloc_malloc(alloc, sizeof(SCEDA_BTreeMap));
+  SCEDA_btreemap_init_with_allocator(map, alloc, delete_key, delete_value, compare_key);
+  return map;
+}
+
+SCEDA_BTreeMap *SCEDA_btreemap_create(SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key) {
+  return SCEDA_btreemap_create_with_allocator(SCEDA_allocator_get_default(), delete_key, delete_value, compare_key);
+}
+
+static void SCEDA_btreemap_cleanup_aux(SCEDA_BTreeMap *map, SCEDA_BTreeNode *x) {
+  int i;
+  if(!x->leaf) {
+    for(i = 0; i <= x->count; i++) {
+      SCEDA_btreemap_cleanup_aux(map, x->children[i]);
+    }
+  }
+  for(i = 0; i < x->count; i++) {
+    if(map->delete_key != NULL) {
+      map->delete_key(x->keys[i]);
+    }
+    if(map->delete_value != NULL) {
+      map->delete_value(x->values[i]);
+    }
+  }
+  SCEDA_btreemap_node_delete(map, x);
+}
+
+static void SCEDA_btreemap_cleanup_elts(SCEDA_BTreeMap *map) {
+  // nothing to delete nor deallocate one by one otherwise
+  if((map->root != NULL) && ((map->delete_key != NULL) || (map->delete_value != NULL) || (map->alloc->free != NULL))) {
+    SCEDA_btreemap_cleanup_aux(map, map->root);
+  }
+}
+
+void SCEDA_btreemap_cleanup(SCEDA_BTreeMap *map) {
+  SCEDA_Allocator *alloc = map->alloc;
+  SCEDA_btreemap_cleanup_elts(map);
+  // keep the allocator, so that the map can still be cleaned up or deleted
+  memset(map, 0, sizeof(SCEDA_BTreeMap));
+  map->alloc = alloc;
+}
+
+void SCEDA_btreemap_delete(SCEDA_BTreeMap *map) {
+  SCEDA_Allocator *alloc = map->alloc;
+  SCEDA_btreemap_cleanup(map);
+  alloc_free(alloc, map, sizeof(SCEDA_BTreeMap));
+}
+
+void SCEDA_btreemap_clear(SCEDA_BTreeMap *map) {
+  SCEDA_btreemap_cleanup_elts(map);
+  map->root = NULL;
+  map->size = 0;
+}
+
+static SCEDA_BTreeNode *SCEDA_btreemap_find(SCEDA_BTreeMap *map, const void *key, int *i) {
+  SCEDA_BTreeNode *x = map->root;
+  while(x != NULL) {
+    int found;
+    *i = SCEDA_btreemap_search_node(map, x, key, &found);
+    if(found) {
+      return x;
+    }
+    x = x->leaf ? NULL : x->children[*i];
+  }
+  return NULL;
+}
+
+int SCEDA_btreemap_contains_key(SCEDA_BTreeMap *map, const void *key) {
+  int i;
+  return (SCEDA_btreemap_find(map, key, &i) != NULL);
+}
+
+void *SCEDA_btreemap_get(SCEDA_BTreeMap *map, const void *key) {
+  int i;
+  SCEDA_BTreeNode *x = SCEDA_btreemap_find(map, key, &i);
+  return (x == NULL) ? NULL : x->values[i];
+}
+
+int SCEDA_btreemap_lookup(SCEDA_BTreeMap *map, void **key, void **value) {
+  int i;
+  SCEDA_BTreeNode *x = SCEDA_btreemap_find(map, *key, &i);
+  if(x == NULL) {
+    return -1;
+  }
+  *key = x->keys[i];
+  *value = x->values[i];
+  return 0;
+}
+
+/* Split the full i-th child of x (x is not full) */
+static void SCEDA_btreemap_split_child(SCEDA_BTreeMap *map, SCEDA_BTreeNode *x, int i) {
+  SCEDA_BTreeNode *y = x->children[i];
+  SCEDA_BTreeNode *z = SCEDA_btreemap_node_create(map, y->leaf);
+
+  // z gets the T-1 greatest bindings of y, the median goes up into x
+  z->count = T - 1;
+  memcpy(z->keys, y->keys + T, (T - 1) * sizeof(void *));
+  memcpy(z->values, y->values + T, (T - 1) * sizeof(void *));
+  if(!y->leaf) {
+    memcpy(z->children, y->children + T, T * sizeof(SCEDA_BTreeNode *));
+  }
+  y->count = T - 1;
+
+  memmove(x->children + i + 2, x->children + i + 1, (x->count - i) * sizeof(SCEDA_BTreeNode *));
+  memmove(x->keys + i + 1, x->keys + i, (x->count - i) * sizeof(void *));
+  memmove(x->values + i + 1, x->values + i, (x->count - i) * sizeof(void *));
+  x->children[i + 1] = z;
+  x->keys[i] = y->keys[T - 1];
+  x->values[i] = y->values[T - 1];
+  x->count++;
+}
+
+int SCEDA_btreemap_put(SCEDA_BTreeMap *map, const void *key, const void *value, void **old_value) {
+  if(map->root == NULL) {
+    map->root = SCEDA_btreemap_node_create(map, TRUE);
+  } else if(map->root->count == SCEDA_BTREE_MAX_KEYS) {
+    SCEDA_BTreeNode *root = SCEDA_btreemap_node_create(map, FALSE);
+    root->children[0] = map->root;
+    map->root = root;
+    SCEDA_btreemap_split_child(map, root, 0);
+  }
+
+  // full nodes are split on the way down, so that x is never full
+  SCEDA_BTreeNode *x = map->root;
+  for(;;) {
+    int found;
+    int i = SCEDA_btreemap_search_node(map, x, key, &found);
+    if(found) {
+      if(old_value != NULL) {
+	*old_value = x->values[i];
+      }
+      x->values[i] = (void *)value;
+      return 1;
+    }
+    if(x->leaf) {
+      memmove(x->keys + i + 1, x->keys + i, (x->count - i) * sizeof(void *));
+      memmove(x->values + i + 1, x->values + i, (x->count - i) * sizeof(void *));
+      x->keys[i] = (void *)key;
+      x->values[i] = (void *)value;
+      x->count++;
+      map->size++;
+      return 0;
+    }
+    if(x->children[i]->count == SCEDA_BTREE_MAX_KEYS) {
+      SCEDA_btreemap_split_child(map, x, i);
+      int res = map->compare_key(key, x->keys[i]);
+      if(res == 0) {
+	if(old_value != NULL) {
+	  *old_value = x->values[i];
+	}
+	x->values[i] = (void *)value;
+	return 1;
+      } else if(res > 0) {
+	i++;
+      }
+    }
+    x = x->children[i];
+  }
+}
+
+/* Remove the i-th binding of the leaf x */
+static void SCEDA_btreemap_leaf_remove(SCEDA_BTreeNode *x, int i) {
+  x->count--;
+  memmove(x->keys + i, x->keys + i + 1, (x->count - i) * sizeof(void *));
+  memmove(x->values + i, x->values + i + 1, (x->count - i) * sizeof(void *));
+}
+
+/* Merge the i-th binding of x and its (i+1)-th child into its i-th
+   child. Both children have T-1 bindings. */
+static void SCEDA_btreemap_merge_children(SCEDA_BTreeMap *map, SCEDA_BTreeNode *x, int i) {
+  SCEDA_BTreeNode *y = x->children[i];
+  SCEDA_BTreeNode *z = x->children[i + 1];
+
+  y->keys[y->count] = x->keys[i];
+  y->values[y->count] = x->values[i];
+  memcpy(y->keys + y->count + 1, z->keys, z->count * sizeof(void *));
+  memcpy(y->values + y->count + 1, z->values, z->count * sizeof(void *));
+  if(!y->leaf) {
+    memcpy(y->children + y->count + 1, z->children, (z->count + 1) * sizeof(SCEDA_BTreeNode *));
+  }
+  y->count += z->count + 1;
+
+  memmove(x->keys + i, x->keys + i + 1, (x->count - i - 1) * sizeof(void *));
+  memmove(x->values + i, x->values + i + 1, (x->count - i - 1) * sizeof(void *));
+  memmove(x->children + i + 1, x->children + i + 2, (x->count - i - 1) * sizeof(SCEDA_BTreeNode *));
+  x->count--;
+
+  SCEDA_btreemap_node_delete(map, z);
+}
+
+/* Make sure that the i-th child of x has at least T bindings, by
+   borrowing one from a sibling or merging with it. Return the index of
+   the child that now covers the keys of the former i-th child. */
+static int SCEDA_btreemap_fill_child(SCEDA_BTreeMap *map, SCEDA_BTreeNode *x, int i) {
+  SCEDA_BTreeNode *c = x->children[i];
+  if(c->count >= T) {
+    return i;
+  }
+
+  if((i > 0) && (x->children[i - 1]->count >= T)) {
+    // rotate a binding from the left sibling through x
+    SCEDA_BTreeNode *l = x->children[i - 1];
+    memmove(c->keys + 1, c->keys, c->count * sizeof(void *));
+    memmove(c->values + 1, c->values, c->count * sizeof(void *));
+    if(!c->leaf) {
+      memmove(c->children + 1, c->children, (c->count + 1) * sizeof(SCEDA_BTreeNode *));
+      c->children[0] = l->children[l->count];
+    }
+    c->keys[0] = x->keys[i - 1];
+    c->values[0] = x->values[i - 1];
+    c->count++;
+    l->count--;
+    x->keys[i - 1] = l->keys[l->count];
+    x->values[i - 1] = l->values[l->count];
+    return i;
+  }
+
+  if((i < x->count) && (x->children[i + 1]->count >= T)) {
+    // rotate a binding from the right sibling through x
+    SCEDA_BTreeNode *r = x->children[i + 1];
+    c->keys[c->count] = x->keys[i];
+    c->values[c->count] = x->values[i];
+    if(!c->leaf) {
+      c->children[c->count + 1] = r->children[0];
+      memmove(r->children, r->children + 1, r->count * sizeof(SCEDA_BTreeNode *));
+    }
+    c->count++;
+    x->keys[i] = r->keys[0];
+    x->values[i] = r->values[0];
+    r->count--;
+    memmove(r->keys, r->keys + 1, r->count * sizeof(void *));
+    memmove(r->values, r->values + 1, r->count * sizeof(void *));
+    return i;
+  }
+
+  if(i < x->count) {
+    SCEDA_btreemap_merge_children(map, x, i);
+    return i;
+  } else {
+    SCEDA_btreemap_merge_children(map, x, i - 1);
+    return i - 1;
+  }
+}
+
+/* Remove the greatest (max = TRUE) or least binding of the subtree x,
+   which has at least T bindings if it is not the root */
+static void SCEDA_btreemap_remove_extremum(SCEDA_BTreeMap *map, SCEDA_BTreeNode *x, int max, void **key, void **value) {
+  while(!x->leaf) {
+    int i = max ? x->count : 0;
+    i = SCEDA_btreemap_fill_child(map, x, i);
+    x = x->children[i];
+  }
+  int i = max ? x->count - 1 : 0;
+  *key = x->keys[i];
+  *value = x->values[i];
+  SCEDA_btreemap_leaf_remove(x, i);
+}
+
+int SCEDA_btreemap_remove(SCEDA_BTreeMap *map, void **key, void **value) {
+  if(map->root == NULL) {
+    return 1;
+  }
+
+  // nodes are filled on the way down, so that every node but the root
+  // has at least T bindings when it is reached
+  int res = 1;
+  SCEDA_BTreeNode *x = map->root;
+  for(;;) {
+    int found;
+    int i = SCEDA_btreemap_search_node(map, x, *key, &found);
+    if(found) {
+      *key = x->keys[i];
+      *value = x->values[i];
+      res = 0;
+      if(x->leaf) {
+	SCEDA_btreemap_leaf_remove(x, i);
+      } else if(x->children[i]->count >= T) {
+	SCEDA_btreemap_remove_extremum(map, x->children[i], TRUE, &x->keys[i], &x->values[i]);
+      } else if(x->children[i + 1]->count >= T) {
+	SCEDA_btreemap_remove_extremum(map, x->children[i + 1], FALSE, &x->keys[i], &x->values[i]);
+      } else {
+	// the binding goes down into the merged child, where it is removed
+	SCEDA_btreemap_merge_children(map, x, i);
+	x = x->children[i];
+	i = T - 1;
+	while(!x->leaf) {
+	  if(x->children[i]->count >= T) {
+	    SCEDA_btreemap_remove_extremum(map, x->children[i], TRUE, &x->keys[i], &x->values[i]);
+	    break;
+	  } else if(x->children[i + 1]->count >= T) {
+	    SCEDA_btreemap_remove_extremum(map, x->children[i + 1], FALSE, &x->keys[i], &x->values[i]);
+	    break;
+	  }
+	  SCEDA_btreemap_merge_children(map, x, i);
+	  x = x->children[i];
+	  i = T - 1;
+	}
+	if(x->leaf) {
+	  SCEDA_btreemap_leaf_remove(x, i);
+	}
+      }
+      break;
+    }
+    if(x->leaf) {
+      break;
+    }
+    i = SCEDA_btreemap_fill_child(map, x, i);
+    x = x->children[i];
+  }
+
+  // the root may have been emptied by a merge
+  SCEDA_BTreeNode *root = map->root;
+  if(root->count == 0) {
+    map->root = root->leaf ? NULL : root->children[0];
+    SCEDA_btreemap_node_delete(map, root);
+  }
+
+  if(res == 0) {
+    map->size--;
+  }
+
+  return res;
+}
+
+/* Find the binding with the least key greater than (or equal to, if
+   not strict) key */
+static int SCEDA_btreemap_ceiling_aux(SCEDA_BTreeMap *map, const void *key, int strict, void **res_key, void **value) {
+  SCEDA_BTreeNode *res = NULL;
+  int res_i = 0;
+  SCEDA_BTreeNode *x = map->root;
+  while(x != NULL) {
+    int found;
+    int i = SCEDA_btreemap_search_node(map, x, key, &found);
+    if(found) {
+      if(!strict) {
+	res = x;
+	res_i = i;
+	break;
+      }
+      i++;
+    }
+    if(i < x->count) {
+      res = x;
+      res_i = i;
+    }
+    x = x->leaf ? NULL : x->children[i];
+  }
+  if(res == NULL) {
+    return -1;
+  }
+  *res_key = res->keys[res_i];
+  *value = res->values[res_i];
+  return 0;
+}
+
+/* Find the binding with the greatest key less than (or equal to, if
+   not strict) key */
+static int SCEDA_btreemap_floor_aux(SCEDA_BTreeMap *map, const void *key, int strict, void **res_key, void **value) {
+  SCEDA_BTreeNode *res = NULL;
+  int res_i = 0;
+  SCEDA_BTreeNode *x = map->root;
+  while(x != NULL) {
+    int found;
+    int i = SCEDA_btreemap_search_node(map, x, key, &found);
+    if(found && !strict) {
+      res = x;
+      res_i = i;
+      break;
+    }
+    if(i > 0) {
+      res = x;
+      res_i = i - 1;
+    }
+    x = x->leaf ? NULL : x->children[i];
+  }
+  if(res == NULL) {
+    return -1;
+  }
+  *res_key = res->keys[res_i];
+  *value = res->values[res_i];
+  return 0;
+}
+
+int SCEDA_btreemap_floor(SCEDA_BTreeMap *map, const void *key, void **res_key, void **value) {
+  return SCEDA_btreemap_floor_aux(map, key, FALSE, res_key, value);
+}
+
+int SCEDA_btreemap_ceiling(SCEDA_BTreeMap *map, const void *key, void **res_key, void **value) {
+  return SCEDA_btreemap_ceiling_aux(map, key, FALSE, res_key, value);
+}
+
+int SCEDA_btreemap_lower(SCEDA_BTreeMap *map, const void *key, void **res_key, void **value) {
+  return SCEDA_btreemap_floor_aux(map, key, TRUE, res_key, value);
+}
+
+int SCEDA_btreemap_higher(SCEDA_BTreeMap *map, const void *key, void **res_key, void **value) {
+  return SCEDA_btreemap_ceiling_aux(map, key, TRUE, res_key, value);
+}
+
+#define iter_push(iter, x, i) ({ (iter)->nodes[(iter)->depth] = (x); (iter)->index[(iter)->depth] = (i); (iter)->depth++; })
+#define iter_top_node(iter) ((iter)->nodes[(iter)->depth - 1])
+#define iter_top_index(iter) ((iter)->index[(iter)->depth - 1])
+
+/* Pop the nodes whose bindings have all been visited */
+static void SCEDA_btreemap_iterator_pop(SCEDA_BTreeMapIterator *iter) {
+  while((iter->depth > 0) && (iter_top_index(iter) == iter_top_node(iter)->count)) {
+    iter->depth--;
+  }
+}
+
+/* Push the path to the least binding of x */
+static void SCEDA_btreemap_iterator_descend(SCEDA_BTreeMapIterator *iter, SCEDA_BTreeNode *x) {
+  for(;;) {
+    iter_push(iter, x, 0);
+    if(x->leaf) {
+      break;
+    }
+    x = x->children[0];
+  }
+}
+
+void SCEDA_btreemap_iterator_init(SCEDA_BTreeMap *map, SCEDA_BTreeMapIterator *iter) {
+  iter->map = map;
+  iter->depth = 0;
+  if(map->root != NULL) {
+    SCEDA_btreemap_iterator_descend(iter, map->root);
+    SCEDA_btreemap_iterator_pop(iter);
+  }
+}
+
+static void SCEDA_btreemap_iterator_init_bound(SCEDA_BTreeMap *map, const void *key, int strict, SCEDA_BTreeMapIterator *iter) {
+  iter->map = map;
+  iter->depth = 0;
+  SCEDA_BTreeNode *x = map->root;
+  while(x != NULL) {
+    int found;
+    int i = SCEDA_btreemap_search_node(map, x, key, &found);
+    if(found) {
+      if(!strict) {
+	iter_push(iter, x, i);
+	break;
+      }
+      // the next key is the least one of the right subtree
+      iter_push(iter, x, i + 1);
+      if(!x->leaf) {
+	SCEDA_btreemap_iterator_descend(iter, x->children[i + 1]);
+      }
+      break;
+    }
+    iter_push(iter, x, i);
+    x = x->leaf ? NULL : x->children[i];
+  }
+  SCEDA_btreemap_iterator_pop(iter);
+}
+
+void SCEDA_btreemap_iterator_init_lower_bound(SCEDA_BTreeMap *map, const void *key, SCEDA_BTreeMapIterator *iter) {
+  SCEDA_btreemap_iterator_init_bound(map, key, FALSE, iter);
+}
+
+void SCEDA_btreemap_iterator_init_upper_bound(SCEDA_BTreeMap *map, const void *key, SCEDA_BTreeMapIterator *iter) {
+  SCEDA_btreemap_iterator_init_bound(map, key, TRUE, iter);
+}
+
+void *SCEDA_btreemap_iterator_next(SCEDA_BTreeMapIterator *iter, void **key) {
+  SCEDA_BTreeNode *x = iter_top_node(iter);
+  int i = iter_top_index(iter)++;
+  *key = x->keys[i];
+  void *value = x->values[i];
+  if(!x->leaf) {
+    SCEDA_btreemap_iterator_descend(iter, x->children[i + 1]);
+  }
+  SCEDA_btreemap_iterator_pop(iter);
+  return value;
+}
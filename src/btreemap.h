@@ -0,0 +1,280 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_BTREEMAP_H
+#define __SCEDA_BTREEMAP_H
+/** \file btreemap.h
+    \brief BTreeMap implementation */
+
+#include "common.h"
+#include <string.h>
+
+/** Minimum degree of the B-tree: every node but the root holds
+    between SCEDA_BTREE_DEGREE - 1 and 2 * SCEDA_BTREE_DEGREE - 1
+    bindings. Keys of a node are stored contiguously (two cache lines
+    with the default degree) so that searching a node touches as few
+    cache lines as possible. */
+#define SCEDA_BTREE_DEGREE 8
+
+#define SCEDA_BTREE_MAX_KEYS (2 * SCEDA_BTREE_DEGREE - 1)
+
+/** Maximal height of a B-tree (more than enough for 2^31 bindings) */
+#define SCEDA_BTREE_MAX_HEIGHT 16
+
+/** Node of a B-tree. Leaves are allocated without their children
+    array. */
+typedef struct _SCEDA_BTreeNode {
+  int count;
+  int leaf;
+  void *keys[SCEDA_BTREE_MAX_KEYS];
+  void *values[SCEDA_BTREE_MAX_KEYS];
+  struct _SCEDA_BTreeNode *children[SCEDA_BTREE_MAX_KEYS + 1];
+} SCEDA_BTreeNode;
+
+typedef struct {
+  int size;
+  SCEDA_BTreeNode *root;
+  SCEDA_delete_fun delete_key;
+  SCEDA_delete_fun delete_value;
+  SCEDA_compare_fun compare_key;
+  SCEDA_Allocator *alloc;
+} SCEDA_BTreeMap;
+
+/** Initialise a (B-tree) map.
+
+    @param[in] map = map
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] compare_key = comparison function on keys */
+void SCEDA_btreemap_init(SCEDA_BTreeMap *map, SCEDA_delete_fun delete_key,
+			 SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key);
+
+/** Initialise a (B-tree) map whose nodes are allocated by a given
+    allocator.
+
+    @param[in] map = map
+    @param[in] alloc = allocator
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] compare_key = comparison function on keys */
+void SCEDA_btreemap_init_with_allocator(SCEDA_BTreeMap *map, SCEDA_Allocator *alloc, SCEDA_delete_fun delete_key,
+					SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key);
+
+/** Create a (B-tree) map, ready for use.
+
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] compare_key = comparison function on keys
+
+    @return the (B-tree) map */
+SCEDA_BTreeMap *SCEDA_btreemap_create(SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+				      SCEDA_compare_fun compare_key);
+
+/** Create a (B-tree) map, ready for use. The map and its nodes are
+    allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] compare_key = comparison function on keys
+
+    @return the (B-tree) map */
+SCEDA_BTreeMap *SCEDA_btreemap_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete_key,
+						     SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key);
+
+/** Clean up a (B-tree) map.
+
+    @param[in] map = map to clean up */
+void SCEDA_btreemap_cleanup(SCEDA_BTreeMap *map);
+
+/** Delete a (B-tree) map.
+
+    @param[in] map = map to delete */
+void SCEDA_btreemap_delete(SCEDA_BTreeMap *map);
+
+/** Clear a (B-tree) map.
+
+    @param[in] map = map to clear */
+void SCEDA_btreemap_clear(SCEDA_BTreeMap *map);
+
+/** Add (or replace) a binding in the map in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] key = key to be bound
+    @param[in] value = value to bind to key
+    @param[out] old_value = old value bound to key (set by function if not NULL)
+
+    @return 0 if new binding, 1 if binding was replaced, -1 otherwise */
+int SCEDA_btreemap_put(SCEDA_BTreeMap *map, const void *key, const void *value, void **old_value);
+
+/** Remove a binding in the map in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in, out] key = key to remove (replaced by the actual key)
+    @param[out] value = value removed (replaced by the actual value)
+
+    @return 0 in case of success, 1 if key was unbound, -1 otherwise */
+int SCEDA_btreemap_remove(SCEDA_BTreeMap *map, void **key, void **value);
+
+/** Test whether the given key is bound in the map in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] key = key
+
+    @return TRUE if key is bound to a value, FALSE otherwise */
+int SCEDA_btreemap_contains_key(SCEDA_BTreeMap *map, const void *key);
+
+/** Return the value bound to the given key or NULL in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] key = key
+
+    @return the value bound to the key or NULL if the key was unbound */
+void *SCEDA_btreemap_get(SCEDA_BTreeMap *map, const void *key);
+
+/** Look up for a binding in a map in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in, out] key = key to look for (replaced by the actual key)
+    @param[out] value = value bound to key (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_btreemap_lookup(SCEDA_BTreeMap *map, void **key, void **value);
+
+/** Find the binding of a map with the greatest key less than or
+    equal to key in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] key = key
+    @param[out] res_key = found key (filled by the function)
+    @param[out] value = value bound to the found key (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_btreemap_floor(SCEDA_BTreeMap *map, const void *key, void **res_key, void **value);
+
+/** Find the binding of a map with the least key greater than or
+    equal to key in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] key = key
+    @param[out] res_key = found key (filled by the function)
+    @param[out] value = value bound to the found key (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_btreemap_ceiling(SCEDA_BTreeMap *map, const void *key, void **res_key, void **value);
+
+/** Find the binding of a map with the greatest key strictly less
+    than key in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] key = key
+    @param[out] res_key = found key (filled by the function)
+    @param[out] value = value bound to the found key (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_btreemap_lower(SCEDA_BTreeMap *map, const void *key, void **res_key, void **value);
+
+/** Find the binding of a map with the least key strictly greater
+    than key in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] key = key
+    @param[out] res_key = found key (filled by the function)
+    @param[out] value = value bound to the found key (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_btreemap_higher(SCEDA_BTreeMap *map, const void *key, void **res_key, void **value);
+
+/** Size of the (B-tree) map in time complexity O(1).
+
+    @param[in] map = map
+
+    @return size of the map
+
+    \hideinitializer */
+#define SCEDA_btreemap_size(map$) ((map$)->size)
+
+/** Test whether the (B-tree) map is empty in time complexity O(1).
+
+    @param[in] map = map
+
+    @return TRUE if empty, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_btreemap_is_empty(map$) (SCEDA_btreemap_size(map$) == 0)
+
+/** B-tree map iterator. It records the path from the root to the
+    next binding. */
+typedef struct {
+  int depth;
+  SCEDA_BTreeNode *nodes[SCEDA_BTREE_MAX_HEIGHT];
+  int index[SCEDA_BTREE_MAX_HEIGHT];
+  SCEDA_BTreeMap *map;
+} SCEDA_BTreeMapIterator;
+
+/** Initialise a (B-tree) map iterator. Keys are visited in ascending
+    order.
+
+    @param[in] map = map
+    @param[in] iter = map iterator */
+void SCEDA_btreemap_iterator_init(SCEDA_BTreeMap *map, SCEDA_BTreeMapIterator *iter);
+
+/** Initialise a (B-tree) map iterator starting at the least key
+    greater than or equal to key, in time complexity O(log|map|). Keys
+    are visited in ascending order.
+
+    @param[in] map = map
+    @param[in] key = key
+    @param[in] iter = map iterator */
+void SCEDA_btreemap_iterator_init_lower_bound(SCEDA_BTreeMap *map, const void *key, SCEDA_BTreeMapIterator *iter);
+
+/** Initialise a (B-tree) map iterator starting at the least key
+    strictly greater than key, in time complexity O(log|map|). Keys
+    are visited in ascending order.
+
+    @param[in] map = map
+    @param[in] key = key
+    @param[in] iter = map iterator */
+void SCEDA_btreemap_iterator_init_upper_bound(SCEDA_BTreeMap *map, const void *key, SCEDA_BTreeMapIterator *iter);
+
+/** Test whether there is a next data in the map iterator.
+
+    @param[in] iter = map iterator
+
+    @return TRUE if there is a "next" data, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_btreemap_iterator_has_next(iter$) ((iter$)->depth > 0)
+
+/** Return the next data of the map iterator.
+
+    @param[in] iter = map iterator
+    @param[out] key = corresponding key (filled by the iterator)
+
+    @return the "next" data */
+void *SCEDA_btreemap_iterator_next(SCEDA_BTreeMapIterator *iter, void **key);
+
+/** Clean up the (B-tree) map iterator.
+
+    @param[in] iter = map iterator
+
+    \hideinitializer */
+#define SCEDA_btreemap_iterator_cleanup(iter$) (memset(iter$, 0, sizeof(SCEDA_BTreeMapIterator)))
+
+#endif
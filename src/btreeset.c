@@ -0,0 +1,92 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include "btreeset.h"
+#include "util.h"
+
+/* A B-tree set is a B-tree map whose values are NULL */
+
+void SCEDA_btreeset_init_with_allocator(SCEDA_BTreeSet *set, SCEDA_Allocator *alloc,
+					SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  SCEDA_btreemap_init_with_allocator(&(set->elements), alloc, delete, NULL, compare);
+}
+
+void SCEDA_btreeset_init(SCEDA_BTreeSet *set, SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  SCEDA_btreeset_init_with_allocator(set, SCEDA_allocator_get_default(), delete, compare);
+}
+
+SCEDA_BTreeSet *SCEDA_btreeset_create_with_allocator(SCEDA_Allocator *alloc,
+						     SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  SCEDA_BTreeSet *set = (SCEDA_BTreeSet *)alloc_malloc(alloc, sizeof(SCEDA_BTreeSet));
+  SCEDA_btreeset_init_with_allocator(set, alloc, delete, compare);
+  return set;
+}
+
+SCEDA_BTreeSet *SCEDA_btreeset_create(SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  return SCEDA_btreeset_create_with_allocator(SCEDA_allocator_get_default(), delete, compare);
+}
+
+void SCEDA_btreeset_cleanup(SCEDA_BTreeSet *set) {
+  SCEDA_btreemap_cleanup(&(set->elements));
+}
+
+void SCEDA_btreeset_delete(SCEDA_BTreeSet *set) {
+  SCEDA_Allocator *alloc = set->elements.alloc;
+  SCEDA_btreeset_cleanup(set);
+  alloc_free(alloc, set, sizeof(SCEDA_BTreeSet));
+}
+
+void SCEDA_btreeset_clear(SCEDA_BTreeSet *set) {
+  SCEDA_btreemap_clear(&(set->elements));
+}
+
+int SCEDA_btreeset_add(SCEDA_BTreeSet *set, const void *data) {
+  // an existing binding keeps its key: only its (NULL) value is replaced
+  return SCEDA_btreemap_put(&(set->elements), data, NULL, NULL);
+}
+
+int SCEDA_btreeset_remove(SCEDA_BTreeSet *set, void **data) {
+  void *value;
+  return SCEDA_btreemap_remove(&(set->elements), data, &value);
+}
+
+int SCEDA_btreeset_lookup(SCEDA_BTreeSet *set, void **data) {
+  void *value;
+  return SCEDA_btreemap_lookup(&(set->elements), data, &value);
+}
+
+int SCEDA_btreeset_floor(SCEDA_BTreeSet *set, const void *data, void **res) {
+  void *value;
+  return SCEDA_btreemap_floor(&(set->elements), data, res, &value);
+}
+
+int SCEDA_btreeset_ceiling(SCEDA_BTreeSet *set, const void *data, void **res) {
+  void *value;
+  return SCEDA_btreemap_ceiling(&(set->elements), data, res, &value);
+}
+
+int SCEDA_btreeset_lower(SCEDA_BTreeSet *set, const void *data, void **res) {
+  void *value;
+  return SCEDA_btreemap_lower(&(set->elements), data, res, &value);
+}
+
+int SCEDA_btreeset_higher(SCEDA_BTreeSet *set, const void *data, void **res) {
+  void *value;
+  return SCEDA_btreemap_higher(&(set->elements), data, res, &value);
+}
@@ -0,0 +1,237 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_BTREESET_H
+#define __SCEDA_BTREESET_H
+/** \file btreeset.h
+    \brief BTreeSet implementation */
+
+#include "common.h"
+#include "btreemap.h"
+
+typedef struct {
+  SCEDA_BTreeMap elements;
+} SCEDA_BTreeSet;
+
+/** Initialise a (B-tree) set.
+
+    @param[in] set = set
+    @param[in] delete = delete function or NULL
+    @param[in] compare = comparison function */
+void SCEDA_btreeset_init(SCEDA_BTreeSet *set, SCEDA_delete_fun delete, SCEDA_compare_fun compare);
+
+/** Initialise a (B-tree) set whose nodes are allocated by a given
+    allocator.
+
+    @param[in] set = set
+    @param[in] alloc = allocator
+    @param[in] delete = delete function or NULL
+    @param[in] compare = comparison function */
+void SCEDA_btreeset_init_with_allocator(SCEDA_BTreeSet *set, SCEDA_Allocator *alloc,
+					SCEDA_delete_fun delete, SCEDA_compare_fun compare);
+
+/** Create a (B-tree) set, ready for use.
+
+    @param[in] delete = delete function or NULL
+    @param[in] compare = comparison function
+
+    @return the (B-tree) set */
+SCEDA_BTreeSet *SCEDA_btreeset_create(SCEDA_delete_fun delete, SCEDA_compare_fun compare);
+
+/** Create a (B-tree) set, ready for use. The set and its nodes are
+    allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete = delete function or NULL
+    @param[in] compare = comparison function
+
+    @return the (B-tree) set */
+SCEDA_BTreeSet *SCEDA_btreeset_create_with_allocator(SCEDA_Allocator *alloc,
+						     SCEDA_delete_fun delete, SCEDA_compare_fun compare);
+
+/** Clean up a (B-tree) set.
+
+    @param[in] set = set to clean up */
+void SCEDA_btreeset_cleanup(SCEDA_BTreeSet *set);
+
+/** Delete a (B-tree) set.
+
+    @param[in] set = set to delete */
+void SCEDA_btreeset_delete(SCEDA_BTreeSet *set);
+
+/** Clear a (B-tree) set.
+
+    @param[in] set = set to clear */
+void SCEDA_btreeset_clear(SCEDA_BTreeSet *set);
+
+/** Insert data into a (B-tree) set in time complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in] data = data to add
+
+    @return 0 in case of success, 1 if already present, -1 otherwise */
+int SCEDA_btreeset_add(SCEDA_BTreeSet *set, const void *data);
+
+/** Remove a data from a set in time complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in, out] data = data to remove (replaced by the actual data)
+
+    @return 0 in case of success, 1 if not in the set, -1 otherwise */
+int SCEDA_btreeset_remove(SCEDA_BTreeSet *set, void **data);
+
+/** Test whether a given data belongs to a set in time complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in] data = data to look for
+
+    @return TRUE if present, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_btreeset_contains(set$, data$) (SCEDA_btreemap_contains_key(&((set$)->elements), data$))
+
+/** Look up for a data in a set in time complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in, out] data = data to look for (replaced by the actual data)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_btreeset_lookup(SCEDA_BTreeSet *set, void **data);
+
+/** Find the greatest element of a set less than or equal to data in
+    time complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in] data = data
+    @param[out] res = found element (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_btreeset_floor(SCEDA_BTreeSet *set, const void *data, void **res);
+
+/** Find the least element of a set greater than or equal to data in
+    time complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in] data = data
+    @param[out] res = found element (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_btreeset_ceiling(SCEDA_BTreeSet *set, const void *data, void **res);
+
+/** Find the greatest element of a set strictly less than data in time
+    complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in] data = data
+    @param[out] res = found element (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_btreeset_lower(SCEDA_BTreeSet *set, const void *data, void **res);
+
+/** Find the least element of a set strictly greater than data in time
+    complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in] data = data
+    @param[out] res = found element (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_btreeset_higher(SCEDA_BTreeSet *set, const void *data, void **res);
+
+/** Size of the (B-tree) set in time complexity O(1).
+
+    @param[in] set = set
+
+    @return size of the set
+
+    \hideinitializer */
+#define SCEDA_btreeset_size(set$) (SCEDA_btreemap_size(&((set$)->elements)))
+
+/** Test whether the (B-tree) set is empty in time complexity O(1).
+
+    @param[in] set = set
+
+    @return TRUE if empty, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_btreeset_is_empty(set$) (SCEDA_btreeset_size(set$) == 0)
+
+/** Iterator (ascending order) */
+typedef SCEDA_BTreeMapIterator SCEDA_BTreeSetIterator;
+
+/** Initialise a (B-tree) set iterator.
+    Elements are visited in ascending order.
+
+    @param[in] set = set
+    @param[in] iter = set iterator
+
+    \hideinitializer */
+#define SCEDA_btreeset_iterator_init(set$, iter$) (SCEDA_btreemap_iterator_init(&((set$)->elements), iter$))
+
+/** Initialise a (B-tree) set iterator starting at the least element
+    greater than or equal to data, in time complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in] data = data
+    @param[in] iter = set iterator
+
+    \hideinitializer */
+#define SCEDA_btreeset_iterator_init_lower_bound(set$, data$, iter$) \
+  (SCEDA_btreemap_iterator_init_lower_bound(&((set$)->elements), data$, iter$))
+
+/** Initialise a (B-tree) set iterator starting at the least element
+    strictly greater than data, in time complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in] data = data
+    @param[in] iter = set iterator
+
+    \hideinitializer */
+#define SCEDA_btreeset_iterator_init_upper_bound(set$, data$, iter$) \
+  (SCEDA_btreemap_iterator_init_upper_bound(&((set$)->elements), data$, iter$))
+
+/** Test whether there is a next data in the set iterator.
+
+    @param[in] iter = set iterator
+
+    @return TRUE if there is a "next" data, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_btreeset_iterator_has_next(iter$) (SCEDA_btreemap_iterator_has_next(iter$))
+
+/** Return the next data of the set iterator.
+
+    @param[in] iter = set iterator
+
+    @return the "next" data
+
+    \hideinitializer */
+#define SCEDA_btreeset_iterator_next(iter$) \
+  ({ void *_data; \
+     SCEDA_btreemap_iterator_next(iter$, &_data); \
+     _data; })
+
+/** Clean up the (B-tree) set iterator.
+
+    @param[in] iter = set iterator
+
+    \hideinitializer */
+#define SCEDA_btreeset_iterator_cleanup(iter$) (SCEDA_btreemap_iterator_cleanup(iter$))
+
+#endif
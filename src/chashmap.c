@@ -0,0 +1,205 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include "chashmap.h"
+#include "util.h"
+
+/* stripe of a key: the hash code is mixed first, as the maps of the
+   stripes use its low bits */
+static inline SCEDA_CHashMapStripe *stripe_of(SCEDA_CHashMap *map, const void *key) {
+  unsigned int h = map->hash_key(key);
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  return &(map->stripe[h & (map->stripes - 1)]);
+}
+
+#define lock(s) (pthread_mutex_lock(&((s)->lock)))
+#define unlock(s) (pthread_mutex_unlock(&((s)->lock)))
+
+void SCEDA_chashmap_init_with_allocator(SCEDA_CHashMap *map, SCEDA_Allocator *alloc, int stripes,
+					SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+					SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
+  int n = 1;
+  while(n < stripes) {
+    n *= 2;
+  }
+  map->stripes = n;
+  map->hash_key = hash_key;
+  map->alloc = alloc;
+  // the stripes are aligned on a cache line within a larger block
+  map->stripe_block = alloc_malloc(alloc, n * sizeof(SCEDA_CHashMapStripe) + SCEDA_CACHE_LINE);
+  map->stripe = (SCEDA_CHashMapStripe *)(((unsigned long)map->stripe_block + SCEDA_CACHE_LINE - 1)
+					 & ~(unsigned long)(SCEDA_CACHE_LINE - 1));
+  int i;
+  for(i = 0; i < n; i++) {
+    safe_call(pthread_mutex_init(&(map->stripe[i].lock), NULL));
+    SCEDA_hashmap_init_with_allocator(&(map->stripe[i].map), alloc, delete_key, delete_value, match_key, hash_key);
+  }
+}
+
+void SCEDA_chashmap_init_with_stripes(SCEDA_CHashMap *map, int stripes,
+				      SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+				      SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
+  SCEDA_chashmap_init_with_allocator(map, SCEDA_allocator_get_default(), stripes, delete_key, delete_value, match_key, hash_key);
+}
+
+void SCEDA_chashmap_init(SCEDA_CHashMap *map, SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+			 SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
+  SCEDA_chashmap_init_with_stripes(map, SCEDA_CHASHMAP_DFLT_STRIPES, delete_key, delete_value, match_key, hash_key);
+}
+
+SCEDA_CHashMap *SCEDA_chashmap_create_with_allocator(SCEDA_Allocator *alloc, int stripes,
+						     SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+						     SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
+  SCEDA_CHashMap *map = (SCEDA_CHashMap *)alloc_malloc(alloc, sizeof(SCEDA_CHashMap));
+  SCEDA_chashmap_init_with_allocator(map, alloc, stripes, delete_key, delete_value, match_key, hash_key);
+  return map;
+}
+
+SCEDA_CHashMap *SCEDA_chashmap_create_with_stripes(int stripes,
+						   SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+						   SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
+  return SCEDA_chashmap_create_with_allocator(SCEDA_allocator_get_default(), stripes, delete_key, delete_value, match_key, hash_key);
+}
+
+SCEDA_CHashMap *SCEDA_chashmap_create(SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+				      SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
+  return SCEDA_chashmap_create_with_stripes(SCEDA_CHASHMAP_DFLT_STRIPES, delete_key, delete_value, match_key, hash_key);
+}
+
+void SCEDA_chashmap_cleanup(SCEDA_CHashMap *map) {
+  int i;
+  for(i = 0; i < map->stripes; i++) {
+    SCEDA_hashmap_cleanup(&(map->stripe[i].map));
+    pthread_mutex_destroy(&(map->stripe[i].lock));
+  }
+  SCEDA_Allocator *alloc = map->alloc;
+  if(map->stripe_block != NULL) {
+    alloc_free(alloc, map->stripe_block, map->stripes * sizeof(SCEDA_CHashMapStripe) + SCEDA_CACHE_LINE);
+  }
+  memset(map, 0, sizeof(SCEDA_CHashMap));
+  map->alloc = alloc;
+}
+
+void SCEDA_chashmap_delete(SCEDA_CHashMap *map) {
+  SCEDA_Allocator *alloc = map->alloc;
+  SCEDA_chashmap_cleanup(map);
+  alloc_free(alloc, map, sizeof(SCEDA_CHashMap));
+}
+
+void SCEDA_chashmap_clear(SCEDA_CHashMap *map) {
+  int i;
+  for(i = 0; i < map->stripes; i++) {
+    SCEDA_CHashMapStripe *s = &(map->stripe[i]);
+    lock(s);
+    SCEDA_hashmap_clear(&(s->map));
+    unlock(s);
+  }
+}
+
+void SCEDA_chashmap_reserve(SCEDA_CHashMap *map, int capacity) {
+  // a little slack, as keys are not spread exactly evenly
+  int per_stripe = capacity / map->stripes + capacity / (8 * map->stripes) + 1;
+  int i;
+  for(i = 0; i < map->stripes; i++) {
+    SCEDA_CHashMapStripe *s = &(map->stripe[i]);
+    lock(s);
+    SCEDA_hashmap_reserve(&(s->map), per_stripe);
+    unlock(s);
+  }
+}
+
+void SCEDA_chashmap_set_shrink(SCEDA_CHashMap *map, int shrink) {
+  int i;
+  for(i = 0; i < map->stripes; i++) {
+    SCEDA_CHashMapStripe *s = &(map->stripe[i]);
+    lock(s);
+    SCEDA_hashmap_set_shrink(&(s->map), shrink);
+    unlock(s);
+  }
+}
+
+int SCEDA_chashmap_put(SCEDA_CHashMap *map, const void *key, const void *value, void **old_value) {
+  SCEDA_CHashMapStripe *s = stripe_of(map, key);
+  lock(s);
+  int res = SCEDA_hashmap_put(&(s->map), key, value, old_value);
+  unlock(s);
+  return res;
+}
+
+int SCEDA_chashmap_remove(SCEDA_CHashMap *map, void **key, void **value) {
+  SCEDA_CHashMapStripe *s = stripe_of(map, *key);
+  lock(s);
+  int res = SCEDA_hashmap_remove(&(s->map), key, value);
+  unlock(s);
+  return res;
+}
+
+int SCEDA_chashmap_contains_key(SCEDA_CHashMap *map, const void *key) {
+  SCEDA_CHashMapStripe *s = stripe_of(map, key);
+  lock(s);
+  int res = SCEDA_hashmap_contains_key(&(s->map), key);
+  unlock(s);
+  return res;
+}
+
+void *SCEDA_chashmap_get(SCEDA_CHashMap *map, const void *key) {
+  SCEDA_CHashMapStripe *s = stripe_of(map, key);
+  lock(s);
+  void *res = SCEDA_hashmap_get(&(s->map), key);
+  unlock(s);
+  return res;
+}
+
+int SCEDA_chashmap_lookup(SCEDA_CHashMap *map, void **key, void **value) {
+  SCEDA_CHashMapStripe *s = stripe_of(map, *key);
+  lock(s);
+  int res = SCEDA_hashmap_lookup(&(s->map), key, value);
+  unlock(s);
+  return res;
+}
+
+int SCEDA_chashmap_compute_if_absent(SCEDA_CHashMap *map, const void *key,
+				     SCEDA_compute_fun compute, void *ctxt, void **value) {
+  SCEDA_CHashMapStripe *s = stripe_of(map, key);
+  void *k = (void *)key;
+  int res;
+  lock(s);
+  if(SCEDA_hashmap_lookup(&(s->map), &k, value) == 0) {
+    res = 1;
+  } else {
+    *value = compute(key, ctxt);
+    res = SCEDA_hashmap_put(&(s->map), key, *value, NULL);
+  }
+  unlock(s);
+  return res;
+}
+
+int SCEDA_chashmap_size(SCEDA_CHashMap *map) {
+  int size = 0;
+  int i;
+  for(i = 0; i < map->stripes; i++) {
+    SCEDA_CHashMapStripe *s = &(map->stripe[i]);
+    lock(s);
+    size += SCEDA_hashmap_size(&(s->map));
+    unlock(s);
+  }
+  return size;
+}
@@ -0,0 +1,308 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_CHASHMAP_H
+#define __SCEDA_CHASHMAP_H
+/** \file chashmap.h
+    \brief Concurrent HashMap implementation (lock striping) */
+
+#include "common.h"
+#include "hashmap.h"
+#include <pthread.h>
+#include <string.h>
+
+/** Default number of stripes of a concurrent map */
+#define SCEDA_CHASHMAP_DFLT_STRIPES 64
+
+/** Functions computing the value to bind to an unbound key.
+
+    @param[in] key = key
+    @param[in] ctxt = context
+
+    @return the value to bind to key */
+typedef void *(*SCEDA_compute_fun)(const void *key, void *ctxt);
+
+/** Stripe of a concurrent map: a (hash) map and the lock guarding it.
+    Stripes fill whole cache lines and start on a cache line, so that
+    threads working on different stripes do not share cache lines. */
+typedef struct {
+  pthread_mutex_t lock;
+  SCEDA_HashMap map;
+  char pad[SCEDA_CACHE_LINE - (sizeof(pthread_mutex_t) + sizeof(SCEDA_HashMap)) % SCEDA_CACHE_LINE];
+} SCEDA_CHashMapStripe;
+
+/** Concurrent (hash) map.
+
+    Keys are spread over a fixed number of stripes according to their
+    hash code, each stripe being an ordinary SCEDA_HashMap guarded by
+    its own mutex. Threads working on keys of different stripes never
+    wait for each other, and a stripe is resized on its own.
+
+    Every operation but the iterator may be called concurrently. The
+    allocator (if any) must then be thread-safe, as the standard one
+    is. */
+typedef struct {
+  int stripes;
+  SCEDA_hash_fun hash_key;
+  SCEDA_Allocator *alloc;
+  SCEDA_CHashMapStripe *stripe;
+  void *stripe_block;
+} SCEDA_CHashMap;
+
+/** Initialise a concurrent (hash) map.
+
+    @param[in] map = map
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] match_key = equality function on keys
+    @param[in] hash_key = hash function for keys */
+void SCEDA_chashmap_init(SCEDA_CHashMap *map, SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+			 SCEDA_match_fun match_key, SCEDA_hash_fun hash_key);
+
+/** Initialise a concurrent (hash) map with a given number of stripes
+    (rounded up to a power of two).
+
+    @param[in] map = map
+    @param[in] stripes = number of stripes
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] match_key = equality function on keys
+    @param[in] hash_key = hash function for keys */
+void SCEDA_chashmap_init_with_stripes(SCEDA_CHashMap *map, int stripes,
+				      SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+				      SCEDA_match_fun match_key, SCEDA_hash_fun hash_key);
+
+/** Initialise a concurrent (hash) map whose stripes are allocated by
+    a given (thread-safe) allocator.
+
+    @param[in] map = map
+    @param[in] alloc = allocator
+    @param[in] stripes = number of stripes
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] match_key = equality function on keys
+    @param[in] hash_key = hash function for keys */
+void SCEDA_chashmap_init_with_allocator(SCEDA_CHashMap *map, SCEDA_Allocator *alloc, int stripes,
+					SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+					SCEDA_match_fun match_key, SCEDA_hash_fun hash_key);
+
+/** Create a concurrent (hash) map, ready for use.
+
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] match_key = equality function on keys
+    @param[in] hash_key = hash function for keys
+
+    @return the (hash) map */
+SCEDA_CHashMap *SCEDA_chashmap_create(SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+				      SCEDA_match_fun match_key, SCEDA_hash_fun hash_key);
+
+/** Create a concurrent (hash) map with a given number of stripes
+    (rounded up to a power of two).
+
+    @param[in] stripes = number of stripes
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] match_key = equality function on keys
+    @param[in] hash_key = hash function for keys
+
+    @return the (hash) map */
+SCEDA_CHashMap *SCEDA_chashmap_create_with_stripes(int stripes,
+						   SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+						   SCEDA_match_fun match_key, SCEDA_hash_fun hash_key);
+
+/** Create a concurrent (hash) map. The map and its stripes are
+    allocated by the given (thread-safe) allocator.
+
+    @param[in] alloc = allocator
+    @param[in] stripes = number of stripes
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] match_key = equality function on keys
+    @param[in] hash_key = hash function for keys
+
+    @return the (hash) map */
+SCEDA_CHashMap *SCEDA_chashmap_create_with_allocator(SCEDA_Allocator *alloc, int stripes,
+						     SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+						     SCEDA_match_fun match_key, SCEDA_hash_fun hash_key);
+
+/** Clean up a concurrent (hash) map. No other thread may use it.
+
+    @param[in] map = map to clean up */
+void SCEDA_chashmap_cleanup(SCEDA_CHashMap *map);
+
+/** Delete a concurrent (hash) map. No other thread may use it.
+
+    @param[in] map = map to delete */
+void SCEDA_chashmap_delete(SCEDA_CHashMap *map);
+
+/** Clear a concurrent (hash) map, one stripe after the other.
+
+    @param[in] map = map to clear */
+void SCEDA_chashmap_clear(SCEDA_CHashMap *map);
+
+/** Reserve room for capacity bindings in a concurrent (hash) map,
+    spread evenly over its stripes.
+
+    @param[in] map = map
+    @param[in] capacity = expected number of bindings */
+void SCEDA_chashmap_reserve(SCEDA_CHashMap *map, int capacity);
+
+/** Set the shrink policy of the stripes of a concurrent (hash) map
+    (see SCEDA_hashmap_set_shrink).
+
+    @param[in] map = map
+    @param[in] shrink = TRUE to allow shrinking, FALSE otherwise */
+void SCEDA_chashmap_set_shrink(SCEDA_CHashMap *map, int shrink);
+
+/** Add (or replace) a binding in the map in time complexity O(1).
+
+    @param[in] map = map
+    @param[in] key = key to be bound
+    @param[in] value = value to bind to key
+    @param[out] old_value = old value bound to key (set by function if not NULL)
+
+    @return 0 if new binding, 1 if binding was replaced, -1 otherwise */
+int SCEDA_chashmap_put(SCEDA_CHashMap *map, const void *key, const void *value, void **old_value);
+
+/** Remove a binding in the map in time complexity O(1).
+
+    @param[in] map = map
+    @param[in, out] key = key to remove (replaced by the actual key)
+    @param[out] value = value removed (replaced by the actual value)
+
+    @return 0 in case of success, 1 if key was unbound, -1 otherwise */
+int SCEDA_chashmap_remove(SCEDA_CHashMap *map, void **key, void **value);
+
+/** Test whether the given key is bound in the map in time complexity O(1).
+
+    @param[in] map = map
+    @param[in] key = key
+
+    @return TRUE if key is bound to a value, FALSE otherwise */
+int SCEDA_chashmap_contains_key(SCEDA_CHashMap *map, const void *key);
+
+/** Return the value bound to the given key or NULL in time complexity O(1).
+
+    The value may be removed (and deleted by its owner) by another
+    thread as soon as it is returned: values shared between threads
+    should outlive the map or be reference counted.
+
+    @param[in] map = map
+    @param[in] key = key
+
+    @return the value bound to the key or NULL if the key was unbound */
+void *SCEDA_chashmap_get(SCEDA_CHashMap *map, const void *key);
+
+/** Look up for a binding in a map in time complexity O(1).
+
+    @param[in] map = map
+    @param[in, out] key = key to look for (replaced by the actual key)
+    @param[out] value = value bound to key (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_chashmap_lookup(SCEDA_CHashMap *map, void **key, void **value);
+
+/** Return the value bound to the given key, binding it first to the
+    value computed by compute if it is unbound. Check and binding are
+    atomic: compute is called at most once per key, while the stripe
+    of the key is locked (so it must not use the map).
+
+    @param[in] map = map
+    @param[in] key = key
+    @param[in] compute = function computing the value to bind to key
+    @param[in] ctxt = context of compute
+    @param[out] value = value bound to key (filled by the function)
+
+    @return 0 if a new binding was added, 1 if key was already bound, -1 otherwise */
+int SCEDA_chashmap_compute_if_absent(SCEDA_CHashMap *map, const void *key,
+				     SCEDA_compute_fun compute, void *ctxt, void **value);
+
+/** Size of the concurrent (hash) map in time complexity O(stripes).
+    Under concurrent modifications, the result is only a snapshot of
+    each stripe at a different time.
+
+    @param[in] map = map
+
+    @return size of the map */
+int SCEDA_chashmap_size(SCEDA_CHashMap *map);
+
+/** Test whether the concurrent (hash) map is empty in time complexity
+    O(stripes).
+
+    @param[in] map = map
+
+    @return TRUE if empty, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_chashmap_is_empty(map$) (SCEDA_chashmap_size(map$) == 0)
+
+/** Concurrent hash map iterator. It must not be used while other
+    threads modify the map. */
+typedef struct {
+  int stripe;
+  SCEDA_HashMapIterator iter;
+  SCEDA_CHashMap *map;
+} SCEDA_CHashMapIterator;
+
+/** Initialise a concurrent (hash) map iterator.
+
+    @param[in] map = map
+    @param[in] iter = map iterator
+
+    \hideinitializer */
+#define SCEDA_chashmap_iterator_init(map$, iter$)			\
+  ({ SCEDA_CHashMapIterator *_citer = (iter$);				\
+     _citer->stripe = 0;						\
+     _citer->map = (map$);						\
+     SCEDA_hashmap_iterator_init(&(_citer->map->stripe[0].map), &(_citer->iter)); })
+
+/** Test whether there is a next data in the map iterator.
+
+    @param[in] iter = map iterator
+
+    @return TRUE if there is a "next" data, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_chashmap_iterator_has_next(iter$)				\
+  ({ SCEDA_CHashMapIterator *_citer = (iter$);				\
+     while(!SCEDA_hashmap_iterator_has_next(&(_citer->iter)) && (_citer->stripe < _citer->map->stripes - 1)) { \
+       _citer->stripe++;						\
+       SCEDA_hashmap_iterator_init(&(_citer->map->stripe[_citer->stripe].map), &(_citer->iter)); \
+     }									\
+     SCEDA_hashmap_iterator_has_next(&(_citer->iter)); })
+
+/** Return the next data of the map iterator.
+
+    @param[in] iter = map iterator
+    @param[out] key = corresponding key (filled by the iterator)
+
+    @return the "next" data
+
+    \hideinitializer */
+#define SCEDA_chashmap_iterator_next(iter$, key$) (SCEDA_hashmap_iterator_next(&((iter$)->iter), key$))
+
+/** Clean up a concurrent (hash) map iterator.
+
+    @param[in] iter = map iterator
+
+    \hideinitializer */
+#define SCEDA_chashmap_iterator_cleanup(iter$) (memset(iter$, 0, sizeof(SCEDA_CHashMapIterator)))
+
+#endif
@@ -23,6 +23,7 @@
     \brief Useful definitions. */
 
 #include <stdlib.h>
+#include "allocator.h"
 
 /** FALSE */
 #ifndef FALSE
@@ -37,6 +38,10 @@
 /** DeFauLT SIZE of all growing/shrinking structures */
 #define SCEDA_DFLT_SIZE 10
 
+/** Size of a cache line, used to keep apart the data written by
+    different threads in concurrent containers */
+#define SCEDA_CACHE_LINE 64
+
 /** Delete functions. */
 typedef void (*SCEDA_delete_fun)(void *);
 
@@ -60,4 +65,31 @@ typedef int (*SCEDA_compare_fun)(const void *, const void *);
 /** Hash functions. */
 typedef unsigned int (*SCEDA_hash_fun)(const void *);
 
+/** Give a new seed for a hash table. Hash tables xor the hash codes
+    with their own seed, so that two tables do not store the same keys
+    in the same order. It may be called from several threads.
+
+    @return the seed */
+unsigned int SCEDA_hash_seed();
+
+/** Layout of hash sets and maps: open addressing table (default) */
+#define SCEDA_HASH_OPEN 0
+
+/** Layout of hash sets and maps: dense array of entries, in insertion
+    order, indexed by an open addressing table */
+#define SCEDA_HASH_ORDERED 1
+
+/** Layout of hash sets and maps: open addressing table probed by
+    groups of buckets, guided by a control byte per bucket holding 7
+    bits of the hash code (Swiss table) */
+#define SCEDA_HASH_SWISS 2
+
+/** Slot of the index table of hash sets and maps with the ordered
+    layout: position of the entry in the dense array (-1 if the slot
+    is free) and cached hash code of the entry. */
+typedef struct {
+  int entry;
+  unsigned int hash;
+} SCEDA_HashIndexSlot;
+
 #endif
@@ -0,0 +1,252 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include <sched.h>
+#include <string.h>
+#include "cqueue.h"
+#include "util.h"
+
+#define load(x, order) (__atomic_load_n(&(x), order))
+#define store(x, v, order) (__atomic_store_n(&(x), v, order))
+#define claim(x, expected, desired) (__atomic_compare_exchange_n(&(x), &(expected), desired, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+
+#define nth_cell(queue, pos) (&((queue)->cells[(pos) & ((queue)->length - 1)]))
+
+/* spin a little, then let the other threads run */
+#define SCEDA_CQUEUE_SPINS 64
+
+static inline void backoff(int *spins) {
+  if(*spins < SCEDA_CQUEUE_SPINS) {
+    (*spins)++;
+  } else {
+    sched_yield();
+  }
+}
+
+void SCEDA_cqueue_init_with_allocator(SCEDA_CQueue *queue, SCEDA_Allocator *alloc, int capacity, SCEDA_delete_fun delete) {
+  int length = 2;
+  while(length < capacity) {
+    length *= 2;
+  }
+  memset(queue, 0, sizeof(SCEDA_CQueue));
+  queue->length = length;
+  queue->delete = delete;
+  queue->alloc = alloc;
+  queue->cells = alloc_malloc(alloc, length * sizeof(SCEDA_CQueueCell));
+  int i;
+  for(i = 0; i < length; i++) {
+    queue->cells[i].seq = i;
+    queue->cells[i].data = NULL;
+  }
+  queue->enqueue_pos = 0;
+  queue->dequeue_pos = 0;
+}
+
+void SCEDA_cqueue_init(SCEDA_CQueue *queue, int capacity, SCEDA_delete_fun delete) {
+  SCEDA_cqueue_init_with_allocator(queue, SCEDA_allocator_get_default(), capacity, delete);
+}
+
+SCEDA_CQueue *SCEDA_cqueue_create_with_allocator(SCEDA_Allocator *alloc, int capacity, SCEDA_delete_fun delete) {
+  SCEDA_CQueue *queue = (SCEDA_CQueue *)alloc_malloc(alloc, sizeof(SCEDA_CQueue));
+  SCEDA_cqueue_init_with_allocator(queue, alloc, capacity, delete);
+  return queue;
+}
+
+SCEDA_CQueue *SCEDA_cqueue_create(int capacity, SCEDA_delete_fun delete) {
+  return SCEDA_cqueue_create_with_allocator(SCEDA_allocator_get_default(), capacity, delete);
+}
+
+void SCEDA_cqueue_cleanup(SCEDA_CQueue *queue) {
+  SCEDA_Allocator *alloc = queue->alloc;
+  // a queue that has already been cleaned up has no cells
+  if(queue->cells != NULL) {
+    if(queue->delete != NULL) {
+      void *data;
+      while(SCEDA_cqueue_try_dequeue(queue, &data) == 0) {
+	queue->delete(data);
+      }
+    }
+    alloc_free(alloc, queue->cells, queue->length * sizeof(SCEDA_CQueueCell));
+  }
+  memset(queue, 0, sizeof(SCEDA_CQueue));
+  queue->alloc = alloc;
+}
+
+void SCEDA_cqueue_delete(SCEDA_CQueue *queue) {
+  SCEDA_Allocator *alloc = queue->alloc;
+  SCEDA_cqueue_cleanup(queue);
+  alloc_free(alloc, queue, sizeof(SCEDA_CQueue));
+}
+
+int SCEDA_cqueue_try_enqueue(SCEDA_CQueue *queue, const void *data) {
+  SCEDA_CQueueCell *cell;
+  unsigned long pos = load(queue->enqueue_pos, __ATOMIC_RELAXED);
+  for(;;) {
+    cell = nth_cell(queue, pos);
+    long diff = (long)(load(cell->seq, __ATOMIC_ACQUIRE) - pos);
+    if(diff == 0) {
+      if(claim(queue->enqueue_pos, pos, pos + 1)) {
+	break;
+      }
+    } else if(diff < 0) {
+      // the cell still holds the element enqueued one lap before
+      return -1;
+    } else {
+      pos = load(queue->enqueue_pos, __ATOMIC_RELAXED);
+    }
+  }
+  cell->data = (void *)data;
+  store(cell->seq, pos + 1, __ATOMIC_RELEASE);
+  return 0;
+}
+
+int SCEDA_cqueue_try_dequeue(SCEDA_CQueue *queue, void **data) {
+  SCEDA_CQueueCell *cell;
+  unsigned long pos = load(queue->dequeue_pos, __ATOMIC_RELAXED);
+  for(;;) {
+    cell = nth_cell(queue, pos);
+    long diff = (long)(load(cell->seq, __ATOMIC_ACQUIRE) - (pos + 1));
+    if(diff == 0) {
+      if(claim(queue->dequeue_pos, pos, pos + 1)) {
+	break;
+      }
+    } else if(diff < 0) {
+      // the cell has not been filled yet
+      return -1;
+    } else {
+      pos = load(queue->dequeue_pos, __ATOMIC_RELAXED);
+    }
+  }
+  *data = cell->data;
+  store(cell->seq, pos + queue->length, __ATOMIC_RELEASE);
+  return 0;
+}
+
+int SCEDA_cqueue_try_enqueue_many(SCEDA_CQueue *queue, void *data[], int n) {
+  int k;
+  unsigned long pos = load(queue->enqueue_pos, __ATOMIC_RELAXED);
+  for(;;) {
+    // count the consecutive cells ready for enqueuing from pos
+    unsigned long seq = pos;
+    for(k = 0; k < n; k++) {
+      seq = load(nth_cell(queue, pos + k)->seq, __ATOMIC_ACQUIRE);
+      if(seq != pos + k) {
+	break;
+      }
+    }
+    if(k > 0) {
+      if(claim(queue->enqueue_pos, pos, pos + k)) {
+	break;
+      }
+    } else if((long)(seq - pos) < 0) {
+      return 0;
+    } else {
+      pos = load(queue->enqueue_pos, __ATOMIC_RELAXED);
+    }
+  }
+  int i;
+  for(i = 0; i < k; i++) {
+    SCEDA_CQueueCell *cell = nth_cell(queue, pos + i);
+    cell->data = data[i];
+    store(cell->seq, pos + i + 1, __ATOMIC_RELEASE);
+  }
+  return k;
+}
+
+int SCEDA_cqueue_try_dequeue_many(SCEDA_CQueue *queue, void *data[], int n) {
+  int k;
+  unsigned long pos = load(queue->dequeue_pos, __ATOMIC_RELAXED);
+  for(;;) {
+    // count the consecutive cells ready for dequeuing from pos
+    unsigned long seq = pos + 1;
+    for(k = 0; k < n; k++) {
+      seq = load(nth_cell(queue, pos + k)->seq, __ATOMIC_ACQUIRE);
+      if(seq != pos + k + 1) {
+	break;
+      }
+    }
+    if(k > 0) {
+      if(claim(queue->dequeue_pos, pos, pos + k)) {
+	break;
+      }
+    } else if((long)(seq - (pos + 1)) < 0) {
+      return 0;
+    } else {
+      pos = load(queue->dequeue_pos, __ATOMIC_RELAXED);
+    }
+  }
+  int i;
+  for(i = 0; i < k; i++) {
+    SCEDA_CQueueCell *cell = nth_cell(queue, pos + i);
+    data[i] = cell->data;
+    store(cell->seq, pos + i + queue->length, __ATOMIC_RELEASE);
+  }
+  return k;
+}
+
+void SCEDA_cqueue_enqueue(SCEDA_CQueue *queue, const void *data) {
+  int spins = 0;
+  while(SCEDA_cqueue_try_enqueue(queue, data) != 0) {
+    backoff(&spins);
+  }
+}
+
+void *SCEDA_cqueue_dequeue(SCEDA_CQueue *queue) {
+  int spins = 0;
+  void *data;
+  while(SCEDA_cqueue_try_dequeue(queue, &data) != 0) {
+    backoff(&spins);
+  }
+  return data;
+}
+
+void SCEDA_cqueue_enqueue_many(SCEDA_CQueue *queue, void *data[], int n) {
+  int spins = 0;
+  while(n > 0) {
+    int k = SCEDA_cqueue_try_enqueue_many(queue, data, n);
+    if(k == 0) {
+      backoff(&spins);
+    } else {
+      data += k;
+      n -= k;
+      spins = 0;
+    }
+  }
+}
+
+int SCEDA_cqueue_dequeue_many(SCEDA_CQueue *queue, void *data[], int n) {
+  int spins = 0;
+  int k;
+  while((k = SCEDA_cqueue_try_dequeue_many(queue, data, n)) == 0) {
+    backoff(&spins);
+  }
+  return k;
+}
+
+int SCEDA_cqueue_size(SCEDA_CQueue *queue) {
+  unsigned long dequeue_pos = load(queue->dequeue_pos, __ATOMIC_RELAXED);
+  unsigned long enqueue_pos = load(queue->enqueue_pos, __ATOMIC_RELAXED);
+  long size = (long)(enqueue_pos - dequeue_pos);
+  if(size < 0) {
+    return 0;
+  } else if(size > queue->length) {
+    return queue->length;
+  }
+  return (int)size;
+}
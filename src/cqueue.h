@@ -0,0 +1,190 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_CQUEUE_H
+#define __SCEDA_CQUEUE_H
+/** \file cqueue.h
+    \brief Bounded lock-free multi-producer multi-consumer queues */
+
+#include "common.h"
+
+/** Cell of a concurrent queue. seq tells which enqueue (seq == pos)
+    or dequeue (seq == pos + 1) the cell is ready for, pos being a
+    position in the unbounded sequence of enqueues and dequeues. */
+typedef struct {
+  unsigned long seq;
+  void *data;
+} SCEDA_CQueueCell;
+
+/** Bounded queue that may be shared by any number of producer and
+    consumer threads (Vyukov's algorithm).
+
+    The cells form a circular array whose length is a power of
+    two. Producers (resp. consumers) claim a position by a
+    compare-and-swap on enqueue_pos (resp. dequeue_pos), then
+    publish the cell by setting its sequence number: no lock is
+    taken and nothing is allocated after initialisation. */
+typedef struct {
+  int length;
+  SCEDA_delete_fun delete;
+  SCEDA_Allocator *alloc;
+  SCEDA_CQueueCell *cells;
+  char pad1[SCEDA_CACHE_LINE];
+  unsigned long enqueue_pos;
+  char pad2[SCEDA_CACHE_LINE - sizeof(unsigned long)];
+  unsigned long dequeue_pos;
+  char pad3[SCEDA_CACHE_LINE - sizeof(unsigned long)];
+} SCEDA_CQueue;
+
+/** Initialise a concurrent queue.
+
+    @param[in] queue = queue to initialise
+    @param[in] capacity = capacity of the queue (rounded up to a power of two)
+    @param[in] delete = function to delete data or NULL */
+void SCEDA_cqueue_init(SCEDA_CQueue *queue, int capacity, SCEDA_delete_fun delete);
+
+/** Initialise a concurrent queue whose array is allocated by a given
+    allocator.
+
+    @param[in] queue = queue to initialise
+    @param[in] alloc = allocator
+    @param[in] capacity = capacity of the queue (rounded up to a power of two)
+    @param[in] delete = function to delete data or NULL */
+void SCEDA_cqueue_init_with_allocator(SCEDA_CQueue *queue, SCEDA_Allocator *alloc, int capacity, SCEDA_delete_fun delete);
+
+/** Create a concurrent queue.
+
+    @param[in] capacity = capacity of the queue (rounded up to a power of two)
+    @param[in] delete = function to delete data or NULL
+
+    @return the queue */
+SCEDA_CQueue *SCEDA_cqueue_create(int capacity, SCEDA_delete_fun delete);
+
+/** Create a concurrent queue. The queue and its array are allocated
+    by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] capacity = capacity of the queue (rounded up to a power of two)
+    @param[in] delete = function to delete data or NULL
+
+    @return the queue */
+SCEDA_CQueue *SCEDA_cqueue_create_with_allocator(SCEDA_Allocator *alloc, int capacity, SCEDA_delete_fun delete);
+
+/** Clean up a concurrent queue. No other thread may use it.
+
+    @param[in] queue = queue to clean up */
+void SCEDA_cqueue_cleanup(SCEDA_CQueue *queue);
+
+/** Delete a concurrent queue. No other thread may use it.
+
+    @param[in] queue = queue to delete */
+void SCEDA_cqueue_delete(SCEDA_CQueue *queue);
+
+/** Enqueue an element if the queue is not full, without waiting.
+
+    @param[in] queue = queue
+    @param[in] data = data to enqueue
+
+    @return 0 in case of success, -1 if the queue is full */
+int SCEDA_cqueue_try_enqueue(SCEDA_CQueue *queue, const void *data);
+
+/** Dequeue an element if the queue is not empty, without waiting.
+
+    @param[in] queue = queue
+    @param[out] data = dequeued data
+
+    @return 0 in case of success, -1 if the queue is empty */
+int SCEDA_cqueue_try_dequeue(SCEDA_CQueue *queue, void **data);
+
+/** Enqueue up to n elements with a single compare-and-swap, without
+    waiting. The enqueued elements are data[0] to data[k - 1], and
+    they are consecutive in the queue.
+
+    @param[in] queue = queue
+    @param[in] data = array of data to enqueue
+    @param[in] n = number of data
+
+    @return the number k of enqueued elements (0 if the queue is full) */
+int SCEDA_cqueue_try_enqueue_many(SCEDA_CQueue *queue, void *data[], int n);
+
+/** Dequeue up to n elements with a single compare-and-swap, without
+    waiting.
+
+    @param[in] queue = queue
+    @param[out] data = array filled with the dequeued data
+    @param[in] n = size of the array
+
+    @return the number of dequeued elements (0 if the queue is empty) */
+int SCEDA_cqueue_try_dequeue_many(SCEDA_CQueue *queue, void *data[], int n);
+
+/** Enqueue an element, waiting for room if the queue is full. The
+    thread spins, then yields the processor, until a consumer makes
+    room.
+
+    @param[in] queue = queue
+    @param[in] data = data to enqueue */
+void SCEDA_cqueue_enqueue(SCEDA_CQueue *queue, const void *data);
+
+/** Dequeue an element, waiting for one if the queue is empty. The
+    thread spins, then yields the processor, until a producer
+    enqueues an element.
+
+    @param[in] queue = queue
+
+    @return the dequeued data */
+void *SCEDA_cqueue_dequeue(SCEDA_CQueue *queue);
+
+/** Enqueue n elements, waiting for room as SCEDA_cqueue_enqueue()
+    does. Elements may be interleaved with those of other producers.
+
+    @param[in] queue = queue
+    @param[in] data = array of data to enqueue
+    @param[in] n = number of data */
+void SCEDA_cqueue_enqueue_many(SCEDA_CQueue *queue, void *data[], int n);
+
+/** Dequeue between 1 and n elements, waiting for one as
+    SCEDA_cqueue_dequeue() does.
+
+    @param[in] queue = queue
+    @param[out] data = array filled with the dequeued data
+    @param[in] n = size of the array (at least 1)
+
+    @return the number of dequeued elements */
+int SCEDA_cqueue_dequeue_many(SCEDA_CQueue *queue, void *data[], int n);
+
+/** Give the size of a concurrent queue. Under concurrent operations,
+    the result is only an estimate.
+
+    @param[in] queue = queue
+
+    @return the number of elements in the queue */
+int SCEDA_cqueue_size(SCEDA_CQueue *queue);
+
+/** Give the capacity of a concurrent queue.
+
+    \hideinitializer */
+#define SCEDA_cqueue_capacity(queue$) ((queue$)->length)
+
+/** Concurrent queue is empty? Under concurrent operations, the result
+    is only an estimate.
+
+    \hideinitializer */
+#define SCEDA_cqueue_is_empty(queue$) (SCEDA_cqueue_size(queue$) == 0)
+
+#endif
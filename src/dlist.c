@@ -21,22 +21,49 @@
 #include "dlist.h"
 #include "util.h"
 
-void SCEDA_dlist_init(SCEDA_DList *list, SCEDA_delete_fun delete) {
+void SCEDA_dlist_init_with_allocator(SCEDA_DList *list, SCEDA_Allocator *alloc, SCEDA_delete_fun delete) {
   list->size = 0;
   list->head = NULL;
   list->tail = NULL;
   list->delete = delete;
+  list->alloc = alloc;
+  list->pool = NULL;
+}
+
+void SCEDA_dlist_init(SCEDA_DList *list, SCEDA_delete_fun delete) {
+  SCEDA_dlist_init_with_allocator(list, SCEDA_allocator_get_default(), delete);
+}
+
+SCEDA_DList *SCEDA_dlist_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete) {
+  SCEDA_DList *list = alloc_malloc(alloc, sizeof(SCEDA_DList));
+  SCEDA_dlist_init_with_allocator(list, alloc, delete);
+  return list;
 }
 
 SCEDA_DList *SCEDA_dlist_create(SCEDA_delete_fun delete) {
-  SCEDA_DList *list = safe_malloc(sizeof(SCEDA_DList));
-  SCEDA_dlist_init(list,delete);
+  return SCEDA_dlist_create_with_allocator(SCEDA_allocator_get_default(), delete);
+}
+
+void SCEDA_dlist_init_pooled(SCEDA_DList *list, SCEDA_delete_fun delete) {
+  SCEDA_Pool *pool = SCEDA_pool_create(sizeof(SCEDA_DListElt));
+  SCEDA_dlist_init_with_allocator(list, SCEDA_pool_allocator(pool), delete);
+  list->pool = pool;
+}
+
+SCEDA_DList *SCEDA_dlist_create_pooled(SCEDA_delete_fun delete) {
+  SCEDA_DList *list = alloc_malloc(SCEDA_allocator_get_default(), sizeof(SCEDA_DList));
+  SCEDA_dlist_init_pooled(list, delete);
   return list;
 }
 
-void SCEDA_dlist_cleanup(SCEDA_DList *list) {
+static void SCEDA_dlist_cleanup_elts(SCEDA_DList *list) {
   void *data = NULL;
 
+  if((list->delete == NULL) && ((list->pool != NULL) || (list->alloc->free == NULL))) {
+    // nothing to delete nor deallocate one by one
+    return;
+  }
+
   while(SCEDA_dlist_size(list) > 0) {
     if(SCEDA_dlist_rem(list, SCEDA_dlist_tail(list), &data) == 0) {
       if(list->delete != NULL) {
@@ -44,23 +71,41 @@ void SCEDA_dlist_cleanup(SCEDA_DList *list) {
       }
     }
   }
+}
 
+void SCEDA_dlist_cleanup(SCEDA_DList *list) {
+  // keep the allocator of the list itself, so that it can still be
+  // cleaned up or deleted
+  SCEDA_Allocator *alloc = (list->pool != NULL) ? list->pool->upstream : list->alloc;
+  SCEDA_dlist_cleanup_elts(list);
+  if(list->pool != NULL) {
+    SCEDA_pool_delete(list->pool);
+  }
   memset(list, 0, sizeof(SCEDA_DList));
+  list->alloc = alloc;
 }
 
 void SCEDA_dlist_delete(SCEDA_DList *list) {
+  // a list owning its pool is allocated by the upstream allocator
+  SCEDA_Allocator *alloc = (list->pool != NULL) ? list->pool->upstream : list->alloc;
   SCEDA_dlist_cleanup(list);
-  free(list);
+  alloc_free(alloc, list, sizeof(SCEDA_DList));
 }
 
 void SCEDA_dlist_clear(SCEDA_DList *list) {
   SCEDA_delete_fun delete = list->delete;
-  SCEDA_dlist_cleanup(list);
-  SCEDA_dlist_init(list, delete);
+  SCEDA_Allocator *alloc = list->alloc;
+  SCEDA_Pool *pool = list->pool;
+  SCEDA_dlist_cleanup_elts(list);
+  if(pool != NULL) {
+    SCEDA_pool_clear(pool);
+  }
+  SCEDA_dlist_init_with_allocator(list, alloc, delete);
+  list->pool = pool;
 }
 
 int SCEDA_dlist_ins_next(SCEDA_DList *list, SCEDA_DListElt *element, const void *data) {
-  SCEDA_DListElt *new_element = safe_malloc(sizeof(SCEDA_DListElt));
+  SCEDA_DListElt *new_element = alloc_malloc(list->alloc, sizeof(SCEDA_DListElt));
 
   new_element->data = (void *)data;
 
@@ -88,7 +133,7 @@ int SCEDA_dlist_ins_next(SCEDA_DList *list, SCEDA_DListElt *element, const void
 }
 
 int SCEDA_dlist_ins_previous(SCEDA_DList *list, SCEDA_DListElt *element, const void *data) {
-  SCEDA_DListElt *new_element = safe_malloc(sizeof(SCEDA_DListElt));
+  SCEDA_DListElt *new_element = alloc_malloc(list->alloc, sizeof(SCEDA_DListElt));
 
   new_element->data = (void *)data;
 
@@ -133,7 +178,7 @@ int SCEDA_dlist_rem(SCEDA_DList *list, SCEDA_DListElt *element, void **data) {
   }
 
   *data = SCEDA_dlist_data(void *, element);
-  free(element);
+  alloc_free(list->alloc, element, sizeof(SCEDA_DListElt));
 
   list->size--;
   return 0;
@@ -27,7 +27,7 @@
 static inline void SCEDA_vertex_delete_struct(SCEDA_Vertex *v) {
   SCEDA_hashmap_delete(v->in_edges);
   SCEDA_hashmap_delete(v->out_edges);
-  free(v);
+  alloc_free(v->alloc, v, sizeof(SCEDA_Vertex));
 }
 
 static void SCEDA_vertex_delete(SCEDA_Vertex *v) {
@@ -47,7 +47,7 @@ static int SCEDA_vertex_hash(SCEDA_Vertex *v) {
 }
 
 static inline void SCEDA_edge_delete_struct(SCEDA_Edge *e) {
-  free(e);
+  alloc_free(e->alloc, e, sizeof(SCEDA_Edge));
 }
 
 static void SCEDA_edge_delete(SCEDA_Edge *e) {
@@ -82,51 +82,74 @@ SCEDA_HashMap *SCEDA_edge_map_create(SCEDA_delete_fun delete) {
   return SCEDA_hashmap_create(NULL, delete, (SCEDA_match_fun)SCEDA_edge_match, (SCEDA_hash_fun)SCEDA_edge_hash);
 }
 
-void SCEDA_graph_init(SCEDA_Graph *g,
-		SCEDA_delete_fun delete_vertex_data,
-		SCEDA_delete_fun delete_edge_data) {
+void SCEDA_graph_init_with_allocator(SCEDA_Graph *g, SCEDA_Allocator *alloc,
+				     SCEDA_delete_fun delete_vertex_data,
+				     SCEDA_delete_fun delete_edge_data) {
   g->counter = 0;
-  g->vertices = SCEDA_hashset_create((SCEDA_delete_fun)SCEDA_vertex_delete, (SCEDA_match_fun)SCEDA_vertex_match, (SCEDA_hash_fun)SCEDA_vertex_hash);
-  g->edges = SCEDA_hashset_create((SCEDA_delete_fun)SCEDA_edge_delete, (SCEDA_match_fun)SCEDA_edge_match, (SCEDA_hash_fun)SCEDA_edge_hash);
+  g->vertices = SCEDA_hashset_create_with_allocator(alloc, (SCEDA_delete_fun)SCEDA_vertex_delete, (SCEDA_match_fun)SCEDA_vertex_match, (SCEDA_hash_fun)SCEDA_vertex_hash);
+  g->edges = SCEDA_hashset_create_with_allocator(alloc, (SCEDA_delete_fun)SCEDA_edge_delete, (SCEDA_match_fun)SCEDA_edge_match, (SCEDA_hash_fun)SCEDA_edge_hash);
+  // vertices and edges are iterated in their order of creation
+  safe_call(SCEDA_hashset_set_layout(g->vertices, SCEDA_HASH_ORDERED));
+  safe_call(SCEDA_hashset_set_layout(g->edges, SCEDA_HASH_ORDERED));
   g->delete_vertex_data = delete_vertex_data;
   g->delete_edge_data = delete_edge_data;
+  g->alloc = alloc;
+}
+
+void SCEDA_graph_init(SCEDA_Graph *g,
+		SCEDA_delete_fun delete_vertex_data,
+		SCEDA_delete_fun delete_edge_data) {
+  SCEDA_graph_init_with_allocator(g, SCEDA_allocator_get_default(), delete_vertex_data, delete_edge_data);
+}
+
+SCEDA_Graph *SCEDA_graph_create_with_allocator(SCEDA_Allocator *alloc,
+					       SCEDA_delete_fun delete_vertex_data,
+					       SCEDA_delete_fun delete_edge_data) {
+  SCEDA_Graph *g = (SCEDA_Graph *)alloc_malloc(alloc, sizeof(SCEDA_Graph));
+  SCEDA_graph_init_with_allocator(g, alloc, delete_vertex_data, delete_edge_data);
+  return g;
 }
 
 SCEDA_Graph *SCEDA_graph_create(SCEDA_delete_fun delete_vertex_data,
 		    SCEDA_delete_fun delete_edge_data) {
-  SCEDA_Graph *g = (SCEDA_Graph *)safe_malloc(sizeof(SCEDA_Graph));
-  SCEDA_graph_init(g, delete_vertex_data, delete_edge_data);
-  return g;
+  return SCEDA_graph_create_with_allocator(SCEDA_allocator_get_default(), delete_vertex_data, delete_edge_data);
 }
 
 void SCEDA_graph_cleanup(SCEDA_Graph *g) {
-  SCEDA_hashset_delete(g->vertices);
-  SCEDA_hashset_delete(g->edges);
+  SCEDA_Allocator *alloc = g->alloc;
+  if(g->vertices != NULL) {
+    SCEDA_hashset_delete(g->vertices);
+    SCEDA_hashset_delete(g->edges);
+  }
   memset(g, 0, sizeof(SCEDA_Graph));
+  g->alloc = alloc;
 }
 
 void SCEDA_graph_delete(SCEDA_Graph *g) {
+  SCEDA_Allocator *alloc = g->alloc;
   SCEDA_graph_cleanup(g);
-  free(g);
+  alloc_free(alloc, g, sizeof(SCEDA_Graph));
 }
 
 void SCEDA_graph_clear(SCEDA_Graph *g) {
   SCEDA_delete_fun delete_vertex_data = g->delete_vertex_data;
   SCEDA_delete_fun delete_edge_data = g->delete_edge_data;
+  SCEDA_Allocator *alloc = g->alloc;
   SCEDA_graph_cleanup(g);
-  SCEDA_graph_init(g, delete_vertex_data, delete_edge_data);
+  SCEDA_graph_init_with_allocator(g, alloc, delete_vertex_data, delete_edge_data);
 }
 
 SCEDA_Vertex *SCEDA_graph_add_vertex(SCEDA_Graph *g, const void *data) {
-  SCEDA_Vertex *v = (SCEDA_Vertex *)safe_malloc(sizeof(SCEDA_Vertex));
+  SCEDA_Vertex *v = (SCEDA_Vertex *)alloc_malloc(g->alloc, sizeof(SCEDA_Vertex));
 
   v->id = g->counter++;
 
   v->data = (void *)data;
   v->delete = g->delete_vertex_data;
+  v->alloc = g->alloc;
 
-  v->in_edges = SCEDA_vertex_map_create(NULL);
-  v->out_edges = SCEDA_vertex_map_create((SCEDA_delete_fun)SCEDA_hashset_delete);
+  v->in_edges = SCEDA_hashmap_create_with_allocator(g->alloc, NULL, NULL, (SCEDA_match_fun)SCEDA_vertex_match, (SCEDA_hash_fun)SCEDA_vertex_hash);
+  v->out_edges = SCEDA_hashmap_create_with_allocator(g->alloc, NULL, (SCEDA_delete_fun)SCEDA_hashset_delete, (SCEDA_match_fun)SCEDA_vertex_match, (SCEDA_hash_fun)SCEDA_vertex_hash);
 
   safe_call(SCEDA_hashset_add(g->vertices, v));
 
@@ -189,7 +212,7 @@ int SCEDA_graph_remove_vertex(SCEDA_Graph *g, SCEDA_Vertex *v, void **data) {
 }
 
 SCEDA_Edge *SCEDA_graph_add_edge(SCEDA_Graph *g, SCEDA_Vertex *v_s, SCEDA_Vertex *v_t, const void *data) {
-  SCEDA_Edge *e = (SCEDA_Edge *)safe_malloc(sizeof(SCEDA_Edge));
+  SCEDA_Edge *e = (SCEDA_Edge *)alloc_malloc(g->alloc, sizeof(SCEDA_Edge));
 
   e->id = g->counter++;
 
@@ -198,12 +221,13 @@ SCEDA_Edge *SCEDA_graph_add_edge(SCEDA_Graph *g, SCEDA_Vertex *v_s, SCEDA_Vertex
 
   e->data = (void *)data;
   e->delete = g->delete_edge_data;
+  e->alloc = g->alloc;
 
   safe_call(SCEDA_hashset_add(g->edges, e));
 
   SCEDA_HashSet *out = SCEDA_hashmap_get(v_s->out_edges, v_t);
   if(out == NULL) {
-    out = SCEDA_edge_set_create(NULL);
+    out = SCEDA_hashset_create_with_allocator(g->alloc, NULL, (SCEDA_match_fun)SCEDA_edge_match, (SCEDA_hash_fun)SCEDA_edge_hash);
     safe_call(SCEDA_hashmap_put(v_s->out_edges, v_t, out, NULL));
     safe_call(SCEDA_hashmap_put(v_t->in_edges, v_s, out, NULL));
   }
@@ -37,6 +37,7 @@ typedef struct {
   void *data;
   int index;  // mandatory field used by several algorithms
   SCEDA_delete_fun delete;
+  SCEDA_Allocator *alloc;
 } SCEDA_Vertex;
 
 /** Type of closures that take a vertex and return a "cost" */
@@ -88,6 +89,7 @@ typedef struct {
   /** Label of the edge */
   void *data;
   SCEDA_delete_fun delete;
+  SCEDA_Allocator *alloc;
 } SCEDA_Edge;
 
 /** Type of closures that take an edge and return a "cost" */
@@ -121,6 +123,7 @@ typedef struct {
   SCEDA_HashSet *edges;
   SCEDA_delete_fun delete_vertex_data;
   SCEDA_delete_fun delete_edge_data;
+  SCEDA_Allocator *alloc;
 } SCEDA_Graph;
 
 /** Initialise a graph.
@@ -141,6 +144,29 @@ void SCEDA_graph_init(SCEDA_Graph *g,
 SCEDA_Graph *SCEDA_graph_create(SCEDA_delete_fun delete_vertex_data,
 			  SCEDA_delete_fun delete_edge_data);
 
+/** Initialise a graph whose vertices, edges and internal structures
+    are allocated by a given allocator.
+
+    @param[in] g = graph to initialise
+    @param[in] alloc = allocator
+    @param[in] delete_vertex_data = delete function for vertex data
+    @param[in] delete_edge_data = delete function for edge data */
+void SCEDA_graph_init_with_allocator(SCEDA_Graph *g, SCEDA_Allocator *alloc,
+				     SCEDA_delete_fun delete_vertex_data,
+				     SCEDA_delete_fun delete_edge_data);
+
+/** Create a graph, ready for use. The graph, its vertices, edges and
+    internal structures are allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete_vertex_data = delete function for vertex data
+    @param[in] delete_edge_data = delete function for edge data
+
+    @return the created graph */
+SCEDA_Graph *SCEDA_graph_create_with_allocator(SCEDA_Allocator *alloc,
+					       SCEDA_delete_fun delete_vertex_data,
+					       SCEDA_delete_fun delete_edge_data);
+
 /** Clean up a graph.
 
     @param[in] g = graph to delete */
@@ -112,6 +112,21 @@
     Return the list of the strongly connected components of the given
     graph. A component is encoded as a (hash) set of vertices.
 
+    \section wccsec Weakly connected components
+
+    \code
+    List *graph_weakly_connected_components(Graph *g);
+    \endcode
+
+    Return the list of the weakly connected components of the given
+    graph, that is its connected components when the orientation of
+    edges is ignored. A component is encoded as a (hash) set of
+    vertices.
+
+    Components are computed by merging the endpoints of every edge in
+    a union-find (see \ref unionfind_sec), in almost linear time
+    O((|V|+|E|).alpha(|V|)).
+
     \section maxantichsec Maximum antichain
 
     \code
@@ -156,6 +171,26 @@
     which indicates the incoming edge in the shortest path and the
     cost of the shortest path (from the source).
 
+    \code
+    HashMap *graph_shortest_path_dijkstra_with_queue(Graph *g, Vertex *from, int_edge_fun dist, void *dist_ctxt, int queue);
+    \endcode
+
+    Same as above, with a given priority queue: DIJKSTRA_HEAP (an
+    indexed heap comparing path infos), DIJKSTRA_BUCKETS (a bucket
+    queue) or DIJKSTRA_RADIX (a radix heap). With DIJKSTRA_AUTO, as
+    in graph_shortest_path_dijkstra(), a bucket queue is used when
+    the largest edge weight is at most DIJKSTRA_MAX_BUCKETS, and a
+    radix heap otherwise. The indexed heap is always used when the
+    distances could overflow an int.
+
+    \code
+    HashMap *graph_shortest_path_dijkstra_with_bound(Graph *g, Vertex *from, int_edge_fun dist, void *dist_ctxt, int queue, int max_weight);
+    \endcode
+
+    Same as above, when an upper bound on edge weights is known: dist
+    is then not called on every edge to compute the largest weight
+    before the search. A negative bound means that it is unknown.
+
     \code
     HashMap *graph_shortest_path_bellman_ford(Graph *g, Vertex *from, int_edge_fun dist, void *dist_ctxt, int *has_neg_cycle);
     \endcode
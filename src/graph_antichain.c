@@ -24,6 +24,7 @@
 #include "common.h"
 #include "list.h"
 #include "hashmap.h"
+#include "vector.h"
 
 // the resulting graph will contain pointers on vertice of G
 static SCEDA_Graph *SCEDA_graph_split(const SCEDA_Graph *g, SCEDA_List **y_vert, SCEDA_List **z_vert) {
@@ -37,8 +38,12 @@ static SCEDA_Graph *SCEDA_graph_split(const SCEDA_Graph *g, SCEDA_List **y_vert,
 
   int n = SCEDA_graph_vcount(g);
 
-  SCEDA_Vertex *v_y[n];
-  SCEDA_Vertex *v_z[n];
+  SCEDA_Vector v_y;
+  SCEDA_Vector v_z;
+  SCEDA_vector_init(&v_y, NULL);
+  SCEDA_vector_init(&v_z, NULL);
+  safe_call(SCEDA_vector_resize(&v_y, n));
+  safe_call(SCEDA_vector_resize(&v_z, n));
 
   SCEDA_VerticesIterator g_vertice;
   SCEDA_vertices_iterator_init(g, &g_vertice);
@@ -47,8 +52,8 @@ static SCEDA_Graph *SCEDA_graph_split(const SCEDA_Graph *g, SCEDA_List **y_vert,
     int i = SCEDA_vertex_get_index(vx);
     SCEDA_Vertex *vy = SCEDA_graph_add_vertex(bg, vx);
     SCEDA_Vertex *vz = SCEDA_graph_add_vertex(bg, vx);
-    v_y[i] = vy;
-    v_z[i] = vz;
+    SCEDA_vector_set(&v_y, i, vy);
+    SCEDA_vector_set(&v_z, i, vz);
     SCEDA_vertex_set_index(vy, 2*i);
     SCEDA_vertex_set_index(vz, 2*i+1);
   }
@@ -58,13 +63,13 @@ static SCEDA_Graph *SCEDA_graph_split(const SCEDA_Graph *g, SCEDA_List **y_vert,
   while(SCEDA_vertices_iterator_has_next(&g_vertice)) {
     SCEDA_Vertex *vi = SCEDA_vertices_iterator_next(&g_vertice);
     int i = SCEDA_vertex_get_index(vi);
-    SCEDA_Vertex *vy = v_y[i];
+    SCEDA_Vertex *vy = SCEDA_vector_get(SCEDA_Vertex *, &v_y, i);
     SCEDA_VertexSuccIterator vi_succ;
     SCEDA_vertex_succ_iterator_init(vi, &vi_succ);
     while(SCEDA_vertex_succ_iterator_has_next(&vi_succ)) {
       SCEDA_Vertex *vj = SCEDA_vertex_succ_iterator_next(&vi_succ);
       int j = SCEDA_vertex_get_index(vj);
-      SCEDA_Vertex *vz = v_z[j];
+      SCEDA_Vertex *vz = SCEDA_vector_get(SCEDA_Vertex *, &v_z, j);
       SCEDA_graph_add_edge(bg, vy, vz, NULL);
     }
     SCEDA_vertex_succ_iterator_cleanup(&vi_succ);
@@ -76,10 +81,13 @@ static SCEDA_Graph *SCEDA_graph_split(const SCEDA_Graph *g, SCEDA_List **y_vert,
 
   int i;
   for(i = n-1; i >= 0; i--) {
-    safe_call(SCEDA_list_ins_next(*y_vert, NULL, v_y[i]));
-    safe_call(SCEDA_list_ins_next(*z_vert, NULL, v_z[i]));
+    safe_call(SCEDA_list_ins_next(*y_vert, NULL, SCEDA_vector_get(SCEDA_Vertex *, &v_y, i)));
+    safe_call(SCEDA_list_ins_next(*z_vert, NULL, SCEDA_vector_get(SCEDA_Vertex *, &v_z, i)));
   }
 
+  SCEDA_vector_cleanup(&v_y);
+  SCEDA_vector_cleanup(&v_z);
+
   return bg;
 }
 
@@ -92,6 +100,8 @@ int SCEDA_graph_minimum_chain_cover(SCEDA_Graph *gf, SCEDA_HashMap **prev_in_cha
 
   *prev_in_chain = SCEDA_vertex_map_create(NULL);
   *next_in_chain = SCEDA_vertex_map_create(NULL);
+  SCEDA_hashmap_reserve(*prev_in_chain, SCEDA_graph_vcount(gf));
+  SCEDA_hashmap_reserve(*next_in_chain, SCEDA_graph_vcount(gf));
 
   SCEDA_List *y_vert;
   SCEDA_List *z_vert;
@@ -105,14 +115,16 @@ int SCEDA_graph_minimum_chain_cover(SCEDA_Graph *gf, SCEDA_HashMap **prev_in_cha
 
   int n = SCEDA_graph_vcount(gf);
 
-  SCEDA_Vertex *v_y[n];
+  SCEDA_Vector v_y;
+  SCEDA_vector_init(&v_y, NULL);
+  safe_call(SCEDA_vector_resize(&v_y, n));
 
   SCEDA_ListIterator vertice;
   SCEDA_list_iterator_init(y_vert, &vertice);
   while(SCEDA_list_iterator_has_next(&vertice)) {
     SCEDA_Vertex *vy = SCEDA_list_iterator_next(&vertice);
     int i = SCEDA_vertex_get_index(vy) / 2;
-    v_y[i] = vy;
+    SCEDA_vector_set(&v_y, i, vy);
   }
   SCEDA_list_iterator_cleanup(&vertice);
 
@@ -128,7 +140,7 @@ int SCEDA_graph_minimum_chain_cover(SCEDA_Graph *gf, SCEDA_HashMap **prev_in_cha
 
       for(;;) {
 	int i = SCEDA_vertex_get_index(v);
-	vy = v_y[i];
+	vy = SCEDA_vector_get(SCEDA_Vertex *, &v_y, i);
 	vz = SCEDA_vertex_get_spouse(vy);
 	if(vz == NULL) {
 	  SCEDA_vertex_set_next_in_chain(v, NULL);
@@ -145,6 +157,7 @@ int SCEDA_graph_minimum_chain_cover(SCEDA_Graph *gf, SCEDA_HashMap **prev_in_cha
   SCEDA_list_iterator_cleanup(&vertice);
 
   SCEDA_hashmap_delete(spouse);
+  SCEDA_vector_cleanup(&v_y);
 
 #undef SCEDA_vertex_get_spouse
 
@@ -169,37 +182,39 @@ static SCEDA_List *SCEDA_graph_maximum_antichain_aux(SCEDA_Graph *gf) {
   int count = SCEDA_graph_minimum_chain_cover(gf, &prev_in_chain, &next_in_chain);
 
   // initialise antichain with max elements
-  SCEDA_Vertex *antichain[count];
+  SCEDA_Vector antichain;
+  SCEDA_vector_init(&antichain, NULL);
+  safe_call(SCEDA_vector_reserve(&antichain, count));
 
-  int i = 0;
   SCEDA_VerticesIterator vertice;
   SCEDA_vertices_iterator_init(gf, &vertice);
   while(SCEDA_vertices_iterator_has_next(&vertice)) {
     SCEDA_Vertex *v = SCEDA_vertices_iterator_next(&vertice);
     if(SCEDA_vertex_get_next_in_chain(v) == NULL) {
-      antichain[i++] = v;
+      safe_call(SCEDA_vector_push(&antichain, v));
     }
   }
   SCEDA_vertices_iterator_cleanup(&vertice);
 
-  // assert(i == count);
+  // assert(SCEDA_vector_size(&antichain) == count);
 
   // walk backward in the chains until finding an antichain
+  int i;
   int is_antichain = FALSE;
   while(!is_antichain) {
     is_antichain = TRUE;
     for(i = 0; i < count; i++) {
-      SCEDA_Vertex *vi = antichain[i];
+      SCEDA_Vertex *vi = SCEDA_vector_get(SCEDA_Vertex *, &antichain, i);
       int j;
       for(j = 0; j < count; j++) {
 	if(j == i) {
 	  continue;
 	}
-	SCEDA_Vertex *vj = antichain[j];
+	SCEDA_Vertex *vj = SCEDA_vector_get(SCEDA_Vertex *, &antichain, j);
 	if(SCEDA_vertex_is_succ_of(vi, vj)) {
 	  is_antichain = FALSE;
-	  antichain[i] = SCEDA_vertex_get_prev_in_chain(vi); // walk backward in the chain
-	  // assert(antichain[i] != NULL);
+	  SCEDA_vector_set(&antichain, i, SCEDA_vertex_get_prev_in_chain(vi)); // walk backward in the chain
+	  // assert(SCEDA_vector_get(SCEDA_Vertex *, &antichain, i) != NULL);
 	  break;
 	}
       }
@@ -208,10 +223,11 @@ static SCEDA_List *SCEDA_graph_maximum_antichain_aux(SCEDA_Graph *gf) {
 
   SCEDA_List *result = SCEDA_list_create(NULL);
   for(i = 0; i < count; i++) {
-    SCEDA_Vertex *vi = antichain[i];
+    SCEDA_Vertex *vi = SCEDA_vector_get(SCEDA_Vertex *, &antichain, i);
     safe_call(SCEDA_list_ins_next(result, NULL, SCEDA_vertex_get_data(SCEDA_Vertex *, vi)));
   }
 
+  SCEDA_vector_cleanup(&antichain);
   SCEDA_hashmap_delete(prev_in_chain);
   SCEDA_hashmap_delete(next_in_chain);
 
@@ -25,64 +25,76 @@
 
 #include "util.h"
 
-#include "queue.h"
+#include "aqueue.h"
 #include "pqueue.h"
+#include "vector.h"
 
 int SCEDA_graph_is_acyclic(SCEDA_Graph *g) {
   int n = SCEDA_graph_vcount(g);
 
-  SCEDA_Vertex *g_vertice[n];
-  int in_deg[n];
-  int idx[n];
+  SCEDA_Vector g_vertice;
+  SCEDA_vector_init(&g_vertice, NULL);
+  safe_call(SCEDA_vector_reserve(&g_vertice, n));
+  SCEDA_IntVector in_deg;
+  SCEDA_IntVector_init(&in_deg);
+  safe_call(SCEDA_IntVector_resize(&in_deg, n));
+  SCEDA_IntVector idx;
+  SCEDA_IntVector_init(&idx);
+  safe_call(SCEDA_IntVector_resize(&idx, n));
 
   int i = 0;
 
   int count = 0;
-  SCEDA_Queue *q = SCEDA_queue_create(NULL);
+  SCEDA_AQueue *q = SCEDA_aqueue_create(NULL);
 
   SCEDA_VerticesIterator vertice;
   SCEDA_vertices_iterator_init(g, &vertice);
   while(SCEDA_vertices_iterator_has_next(&vertice)) {
     SCEDA_Vertex *v = SCEDA_vertices_iterator_next(&vertice);
     SCEDA_vertex_set_index(v, i);
-    g_vertice[i] = v;
-    in_deg[i] = SCEDA_vertex_in_deg(v);
-    if(in_deg[i] == 0) {
-      safe_call(SCEDA_queue_enqueue(q, v));
-      idx[i] = count++;
+    safe_call(SCEDA_vector_push(&g_vertice, v));
+    SCEDA_IntVector_set(&in_deg, i, SCEDA_vertex_in_deg(v));
+    if(SCEDA_IntVector_get(&in_deg, i) == 0) {
+      safe_call(SCEDA_aqueue_enqueue(q, v));
+      SCEDA_IntVector_set(&idx, i, count++);
     }
     i++;
   }
   SCEDA_vertices_iterator_cleanup(&vertice);
 
-  while(!SCEDA_queue_is_empty(q)) {
+  while(!SCEDA_aqueue_is_empty(q)) {
     SCEDA_Vertex *v;
-    safe_call(SCEDA_queue_dequeue(q, (void **)&v));
+    safe_call(SCEDA_aqueue_dequeue(q, (void **)&v));
 
     SCEDA_VertexSuccIterator succ;
     SCEDA_vertex_succ_iterator_init(v, &succ);
     while(SCEDA_vertex_succ_iterator_has_next(&succ)) {
       SCEDA_Vertex *w = SCEDA_vertex_succ_iterator_next(&succ);
       int j = SCEDA_vertex_get_index(w);
-      in_deg[j]--;
-      if(in_deg[j] == 0) {
-	safe_call(SCEDA_queue_enqueue(q,w));
-	idx[j] = count++;
+      int *deg = SCEDA_IntVector_at(&in_deg, j);
+      (*deg)--;
+      if(*deg == 0) {
+	safe_call(SCEDA_aqueue_enqueue(q,w));
+	SCEDA_IntVector_set(&idx, j, count++);
       }
     }
     SCEDA_vertex_succ_iterator_cleanup(&succ);
   }
 
-  SCEDA_queue_delete(q);
+  SCEDA_aqueue_delete(q);
 
-  if(count == n) {
+  int acyclic = (count == n);
+  if(acyclic) {
     for(i = 0; i < n; i++) {
-      SCEDA_vertex_set_index(g_vertice[i], idx[i]);
+      SCEDA_vertex_set_index(SCEDA_vector_get(SCEDA_Vertex *, &g_vertice, i), SCEDA_IntVector_get(&idx, i));
     }
-    return TRUE;
-  } else {
-    return FALSE;
   }
+
+  SCEDA_vector_cleanup(&g_vertice);
+  SCEDA_IntVector_cleanup(&in_deg);
+  SCEDA_IntVector_cleanup(&idx);
+
+  return acyclic;
 }
 
 int SCEDA_graph_compute_topological_order(SCEDA_Graph *g) {
@@ -110,8 +122,12 @@ SCEDA_Graph *SCEDA_graph_transitive_closure(SCEDA_Graph *g) {
 
   int i;
   int n = SCEDA_graph_vcount(g);
-  SCEDA_Vertex *vertice_f[n];
-  int mark[n];
+  SCEDA_Vector vertice_f;
+  SCEDA_vector_init(&vertice_f, NULL);
+  safe_call(SCEDA_vector_resize(&vertice_f, n));
+  SCEDA_IntVector mark;
+  SCEDA_IntVector_init(&mark);
+  safe_call(SCEDA_IntVector_resize(&mark, n));
 
   // contains shallow copies of vertice of G
   SCEDA_Graph *gf = SCEDA_graph_create(NULL, NULL);
@@ -121,17 +137,22 @@ SCEDA_Graph *SCEDA_graph_transitive_closure(SCEDA_Graph *g) {
   while(SCEDA_vertices_iterator_has_next(&g_vertice)) {
     SCEDA_Vertex *vi = SCEDA_vertices_iterator_next(&g_vertice);
     i = SCEDA_vertex_get_index(vi);
-    mark[i] = FALSE;
+    SCEDA_IntVector_set(&mark, i, FALSE);
     SCEDA_Vertex *vi_f = SCEDA_graph_add_vertex(gf, vi); //create a corresponding vertex in Gf
-    vertice_f[i] = vi_f;
+    SCEDA_vector_set(&vertice_f, i, vi_f);
     SCEDA_vertex_set_index(vi_f, i);
   }
   SCEDA_vertices_iterator_cleanup(&g_vertice);
 
+  // the queue is filled and emptied once per vertex
   SCEDA_PQueue *h = SCEDA_pqueue_create(NULL, (SCEDA_compare_fun)compare_vertex);
+  SCEDA_pqueue_set_arity(h, 4);
+  SCEDA_pqueue_set_shrink(h, FALSE);
+  SCEDA_Vector succ;
+  SCEDA_vector_init(&succ, NULL);
 
   for(i = n-1; i >= 0; i--) {
-    SCEDA_Vertex *vi_f = vertice_f[i];
+    SCEDA_Vertex *vi_f = SCEDA_vector_get(SCEDA_Vertex *, &vertice_f, i);
     SCEDA_Vertex *vi = SCEDA_vertex_get_data(SCEDA_Vertex *, vi_f);
 
     SCEDA_VertexSuccIterator vi_succ;
@@ -139,16 +160,21 @@ SCEDA_Graph *SCEDA_graph_transitive_closure(SCEDA_Graph *g) {
     while(SCEDA_vertex_succ_iterator_has_next(&vi_succ)) {
       SCEDA_Vertex *vj = SCEDA_vertex_succ_iterator_next(&vi_succ);
       int j = SCEDA_vertex_get_index(vj);
-      SCEDA_Vertex *vj_f = vertice_f[j];
-      safe_call(SCEDA_pqueue_insert(h, vj_f));
+      safe_call(SCEDA_vector_push(&succ, SCEDA_vector_get(SCEDA_Vertex *, &vertice_f, j)));
     }
     SCEDA_vertex_succ_iterator_cleanup(&vi_succ);
 
+    // the queue is empty: it is built in linear time
+    if(!SCEDA_vector_is_empty(&succ)) {
+      safe_call(SCEDA_pqueue_insert_all(h, &SCEDA_vector_nth(&succ, 0), SCEDA_vector_size(&succ)));
+      safe_call(SCEDA_vector_resize(&succ, 0));
+    }
+
     while(SCEDA_pqueue_size(h) > 0) {
       SCEDA_Vertex *vj_f;
       safe_call(SCEDA_pqueue_extract(h, (void **)&vj_f));
       int j = SCEDA_vertex_get_index(vj_f);
-      if(!mark[j]) {
+      if(!SCEDA_IntVector_get(&mark, j)) {
 	SCEDA_graph_add_edge(gf, vi_f, vj_f, NULL);
 
 	SCEDA_VertexSuccIterator vj_succ;
@@ -156,8 +182,8 @@ SCEDA_Graph *SCEDA_graph_transitive_closure(SCEDA_Graph *g) {
 	while(SCEDA_vertex_succ_iterator_has_next(&vj_succ)) {
 	  SCEDA_Vertex *w = SCEDA_vertex_succ_iterator_next(&vj_succ);
 	  int k = SCEDA_vertex_get_index(w);
-	  if(!mark[k]) {
-	    mark[k] = TRUE;
+	  if(!SCEDA_IntVector_get(&mark, k)) {
+	    SCEDA_IntVector_set(&mark, k, TRUE);
 	    SCEDA_graph_add_edge(gf, vi_f, w, NULL);
 	  }
 	}
@@ -168,12 +194,15 @@ SCEDA_Graph *SCEDA_graph_transitive_closure(SCEDA_Graph *g) {
     SCEDA_vertex_succ_iterator_init(vi_f, &vi_succ);
     while(SCEDA_vertex_succ_iterator_has_next(&vi_succ)) {
       SCEDA_Vertex *v = SCEDA_vertex_succ_iterator_next(&vi_succ);
-      mark[SCEDA_vertex_get_index(v)] = FALSE;
+      SCEDA_IntVector_set(&mark, SCEDA_vertex_get_index(v), FALSE);
     }
     SCEDA_vertex_succ_iterator_cleanup(&vi_succ);
   }
 
   SCEDA_pqueue_delete(h);
+  SCEDA_vector_cleanup(&succ);
+  SCEDA_vector_cleanup(&vertice_f);
+  SCEDA_IntVector_cleanup(&mark);
 
   return gf;
 }
@@ -123,7 +123,8 @@
     void vertices_iterator_cleanup(VerticesIterator *iter);
     \endcode
 
-    Iterator over the set of vertices.
+    Iterator over the set of vertices. Vertices are visited in their
+    order of creation.
 
     \code
     void edges_iterator_init(Graph *g, EdgesIterator *iter);
@@ -132,7 +133,8 @@
     void edges_iterator_cleanup(EdgesIterator *iter);
     \endcode
 
-    Iterator over the set of edges.
+    Iterator over the set of edges. Edges are visited in their order
+    of creation.
 
     \code
     void vertex_succ_iterator_init(Vertex *v, VertexSuccIterator *iter);
@@ -20,9 +20,9 @@
 #include "graph_flow.h"
 
 #include "boxed.h"
-#include "queue.h"
-#include "stack.h"
+#include "aqueue.h"
 #include "dlist.h"
+#include "list.h"
 
 #include "util.h"
 
@@ -48,7 +48,7 @@ static void SCEDA_mf_height_update(SCEDA_Graph *g, SCEDA_Vertex *s, SCEDA_Vertex
 				   SCEDA_HashMap *flow, SCEDA_HashMap *height) {
   int n = SCEDA_graph_vcount(g);
 
-  SCEDA_Queue *todo = SCEDA_queue_create(NULL);
+  SCEDA_AQueue *todo = SCEDA_aqueue_create(NULL);
   SCEDA_HashSet *visited = SCEDA_vertex_set_create();
 
   {
@@ -59,7 +59,7 @@ static void SCEDA_mf_height_update(SCEDA_Graph *g, SCEDA_Vertex *s, SCEDA_Vertex
       boxed(int) h_u = SCEDA_hashmap_get(height, u);
       if(u == t) {
 	safe_call(SCEDA_hashset_add(visited, t));
-	safe_call(SCEDA_queue_enqueue(todo, t));
+	safe_call(SCEDA_aqueue_enqueue(todo, t));
 	boxed_set(h_u, 0);
       } else {
 	boxed_set(h_u, n);
@@ -68,9 +68,9 @@ static void SCEDA_mf_height_update(SCEDA_Graph *g, SCEDA_Vertex *s, SCEDA_Vertex
     SCEDA_vertices_iterator_cleanup(&vertices);
   }
 
-  while(!SCEDA_queue_is_empty(todo)) {
+  while(!SCEDA_aqueue_is_empty(todo)) {
     SCEDA_Vertex *u;
-    safe_call(SCEDA_queue_dequeue(todo, (void **)&u));
+    safe_call(SCEDA_aqueue_dequeue(todo, (void **)&u));
     boxed(int) h_u = SCEDA_hashmap_get(height, u);
 
     {
@@ -95,7 +95,7 @@ static void SCEDA_mf_height_update(SCEDA_Graph *g, SCEDA_Vertex *s, SCEDA_Vertex
 	  }
 	  boxed_set(h_v, boxed_get(h_u) + 1);
 	  safe_call(SCEDA_hashset_add(visited, v));
-	  safe_call(SCEDA_queue_enqueue(todo, v));
+	  safe_call(SCEDA_aqueue_enqueue(todo, v));
 	}
 	SCEDA_edge_class_iterator_cleanup(&edges);
       }
@@ -124,7 +124,7 @@ static void SCEDA_mf_height_update(SCEDA_Graph *g, SCEDA_Vertex *s, SCEDA_Vertex
 	  }
 	  boxed_set(h_v, boxed_get(h_u) + 1);
 	  safe_call(SCEDA_hashset_add(visited, v));
-	  safe_call(SCEDA_queue_enqueue(todo, v));
+	  safe_call(SCEDA_aqueue_enqueue(todo, v));
 	  break;
 	}
 	SCEDA_edge_class_iterator_cleanup(&edges);
@@ -137,7 +137,7 @@ static void SCEDA_mf_height_update(SCEDA_Graph *g, SCEDA_Vertex *s, SCEDA_Vertex
   boxed_set(h_s, n);
 
   SCEDA_hashset_delete(visited);
-  SCEDA_queue_delete(todo);
+  SCEDA_aqueue_delete(todo);
 }
 
 SCEDA_HashMap *SCEDA_graph_max_flow_relabel_to_front(SCEDA_Graph *g, SCEDA_Vertex *s, SCEDA_Vertex *t,
@@ -149,10 +149,13 @@ SCEDA_HashMap *SCEDA_graph_max_flow_relabel_to_front(SCEDA_Graph *g, SCEDA_Verte
   }
 
   SCEDA_HashMap *flow = SCEDA_edge_map_create((SCEDA_delete_fun)boxed_delete);
+  SCEDA_hashmap_reserve(flow, SCEDA_graph_ecount(g));
 
   SCEDA_HashMap *excess = SCEDA_vertex_map_create((SCEDA_delete_fun)boxed_delete);
+  SCEDA_hashmap_reserve(excess, n);
 
   SCEDA_HashMap *height = SCEDA_vertex_map_create((SCEDA_delete_fun)boxed_delete);
+  SCEDA_hashmap_reserve(height, n);
 
   /* Initialisation */
   {
@@ -193,7 +196,7 @@ SCEDA_HashMap *SCEDA_graph_max_flow_relabel_to_front(SCEDA_Graph *g, SCEDA_Verte
     SCEDA_edges_iterator_cleanup(&edges);
   }
 
-  SCEDA_List *todo = SCEDA_queue_create(NULL);
+  SCEDA_AQueue *todo = SCEDA_aqueue_create(NULL);
   {
     SCEDA_VerticesIterator vertices;
     SCEDA_vertices_iterator_init(g, &vertices);
@@ -204,16 +207,16 @@ SCEDA_HashMap *SCEDA_graph_max_flow_relabel_to_front(SCEDA_Graph *g, SCEDA_Verte
       }
       boxed(int) ex_v = SCEDA_hashmap_get(excess, v);
       if(boxed_get(ex_v) > 0) {
-	safe_call(SCEDA_queue_enqueue(todo, v));
+	safe_call(SCEDA_aqueue_enqueue(todo, v));
       }
     }
     SCEDA_vertices_iterator_cleanup(&vertices);
   }
 
   /* Preflow (relabel to front) */
-  while(!SCEDA_queue_is_empty(todo)) {
+  while(!SCEDA_aqueue_is_empty(todo)) {
     SCEDA_Vertex *u;
-    safe_call(SCEDA_queue_dequeue(todo, (void **)&u));
+    safe_call(SCEDA_aqueue_dequeue(todo, (void **)&u));
     if(u == t) {
       continue;
     }
@@ -255,7 +258,7 @@ SCEDA_HashMap *SCEDA_graph_max_flow_relabel_to_front(SCEDA_Graph *g, SCEDA_Verte
 	    if((boxed_get(ex_v) > 0) && (boxed_get(ex_v) <= push)) {
 	      /* v was not exceeding (hence not in the queue)
 		 but is now exceeding */
-	      safe_call(SCEDA_queue_enqueue(todo, v));
+	      safe_call(SCEDA_aqueue_enqueue(todo, v));
 	    }
 	    if(boxed_get(ex_u) == 0) {
 	      /* nothing to push anymore */
@@ -293,7 +296,7 @@ SCEDA_HashMap *SCEDA_graph_max_flow_relabel_to_front(SCEDA_Graph *g, SCEDA_Verte
 	    if((boxed_get(ex_v) > 0) && (boxed_get(ex_v) <= push)) {
 	      /* v was not exceeding (hence not in the queue)
 		 but is now exceeding */
-	      safe_call(SCEDA_queue_enqueue(todo, v));
+	      safe_call(SCEDA_aqueue_enqueue(todo, v));
 	    }
 	    if(boxed_get(ex_u) == 0) {
 	      /* nothing to push anymore */
@@ -313,7 +316,7 @@ SCEDA_HashMap *SCEDA_graph_max_flow_relabel_to_front(SCEDA_Graph *g, SCEDA_Verte
 
   /* Finished */
 
-  SCEDA_queue_delete(todo);
+  SCEDA_aqueue_delete(todo);
 
   SCEDA_hashmap_delete(height);
   SCEDA_hashmap_delete(excess);
@@ -332,10 +335,13 @@ SCEDA_HashMap *SCEDA_graph_max_flow_highest_label(SCEDA_Graph *g, SCEDA_Vertex *
   int n = SCEDA_graph_vcount(g);
 
   SCEDA_HashMap *flow = SCEDA_edge_map_create((SCEDA_delete_fun)boxed_delete);
+  SCEDA_hashmap_reserve(flow, SCEDA_graph_ecount(g));
 
   SCEDA_HashMap *excess = SCEDA_vertex_map_create((SCEDA_delete_fun)boxed_delete);
+  SCEDA_hashmap_reserve(excess, n);
 
   SCEDA_HashMap *height = SCEDA_vertex_map_create((SCEDA_delete_fun)boxed_delete);
+  SCEDA_hashmap_reserve(height, n);
 
   /* Initialisation */
   {
@@ -376,11 +382,13 @@ SCEDA_HashMap *SCEDA_graph_max_flow_highest_label(SCEDA_Graph *g, SCEDA_Vertex *
     SCEDA_edges_iterator_cleanup(&edges);
   }
 
-  SCEDA_Queue levels[2*n];
+  // one queue per height (heights are below 2n): kept out of the
+  // stack, which large graphs would overflow
+  SCEDA_AQueue *levels = safe_malloc(2 * n * sizeof(SCEDA_AQueue));
   {
     int i;
     for(i = 0; i < 2 * n; i++) {
-      SCEDA_queue_init(&levels[i], NULL);
+      SCEDA_aqueue_init(&levels[i], NULL);
     }
   }
 
@@ -394,7 +402,7 @@ SCEDA_HashMap *SCEDA_graph_max_flow_highest_label(SCEDA_Graph *g, SCEDA_Vertex *
       }
       boxed(int) ex_v = SCEDA_hashmap_get(excess, v);
       if(boxed_get(ex_v) > 0) {
-	safe_call(SCEDA_queue_enqueue(&levels[0], v));
+	safe_call(SCEDA_aqueue_enqueue(&levels[0], v));
       }
     }
     SCEDA_vertices_iterator_cleanup(&vertices);
@@ -404,13 +412,13 @@ SCEDA_HashMap *SCEDA_graph_max_flow_highest_label(SCEDA_Graph *g, SCEDA_Vertex *
 
   /* Preflow (highest label) */
   while(highest >= 0) {
-    if(SCEDA_queue_is_empty(&levels[highest])) {
+    if(SCEDA_aqueue_is_empty(&levels[highest])) {
       highest--;
       continue;
     }
 
     SCEDA_Vertex *u;
-    safe_call(SCEDA_queue_dequeue(&levels[highest], (void **)&u));
+    safe_call(SCEDA_aqueue_dequeue(&levels[highest], (void **)&u));
     if(u == t) {
       continue;
     }
@@ -452,7 +460,7 @@ SCEDA_HashMap *SCEDA_graph_max_flow_highest_label(SCEDA_Graph *g, SCEDA_Vertex *
 	    if((boxed_get(ex_v) > 0) && (boxed_get(ex_v) <= push)) {
 	      /* v was not exceeding (hence not in the queue)
 		 but is now exceeding */
-	      safe_call(SCEDA_queue_enqueue(&levels[boxed_get(h_v)], v));
+	      safe_call(SCEDA_aqueue_enqueue(&levels[boxed_get(h_v)], v));
 	    }
 	    if(boxed_get(ex_u) == 0) {
 	      /* nothing to push anymore */
@@ -493,7 +501,7 @@ SCEDA_HashMap *SCEDA_graph_max_flow_highest_label(SCEDA_Graph *g, SCEDA_Vertex *
 	    if((boxed_get(ex_v) > 0) && (boxed_get(ex_v) <= push)) {
 	      /* v was not exceeding (hence not in the queue)
 		 but is now exceeding */
-	      safe_call(SCEDA_queue_enqueue(&levels[boxed_get(h_v)], v));
+	      safe_call(SCEDA_aqueue_enqueue(&levels[boxed_get(h_v)], v));
 	    }
 	    if(boxed_get(ex_u) == 0) {
 	      /* nothing to push anymore */
@@ -517,9 +525,10 @@ SCEDA_HashMap *SCEDA_graph_max_flow_highest_label(SCEDA_Graph *g, SCEDA_Vertex *
   {
     int i;
     for(i = 0; i < 2*n; i++) {
-      SCEDA_queue_cleanup(&levels[i]);
+      SCEDA_aqueue_cleanup(&levels[i]);
     }
   }
+  free(levels);
 
   SCEDA_hashmap_delete(height);
   SCEDA_hashmap_delete(excess);
@@ -540,9 +549,13 @@ static int SCEDA_augment_flow_along_neg_cycle_bellman_ford(SCEDA_Graph *g,
   SCEDA_HashMap *incoming_edges = SCEDA_vertex_map_create(NULL);
   SCEDA_HashMap *reversed = SCEDA_vertex_map_create((SCEDA_delete_fun)boxed_delete);
   SCEDA_HashMap *dist = SCEDA_vertex_map_create((SCEDA_delete_fun)boxed_delete);
+  SCEDA_hashmap_reserve(incoming_edges, n);
+  SCEDA_hashmap_reserve(reversed, n);
+  SCEDA_hashmap_reserve(dist, n);
 
   SCEDA_HashSet *in_queue = SCEDA_vertex_set_create();
-  SCEDA_Queue *queue = SCEDA_queue_create(NULL);
+  SCEDA_hashset_set_shrink(in_queue, FALSE);
+  SCEDA_AQueue *queue = SCEDA_aqueue_create(NULL);
 
   /* Initially, each node is at distance 0 from a virtual source */
   {
@@ -552,23 +565,23 @@ static int SCEDA_augment_flow_along_neg_cycle_bellman_ford(SCEDA_Graph *g,
       SCEDA_Vertex *v = SCEDA_vertices_iterator_next(&vertices);
       safe_call(SCEDA_hashmap_put(dist, v, boxed_create(int, 0), NULL));
       safe_call(SCEDA_hashmap_put(reversed, v, boxed_create(int, FALSE), NULL));
-      safe_call(SCEDA_queue_enqueue(queue, v));
+      safe_call(SCEDA_aqueue_enqueue(queue, v));
       safe_call(SCEDA_hashset_add(in_queue, v));
     }
     SCEDA_vertices_iterator_cleanup(&vertices);
   }
 
-  safe_call(SCEDA_queue_enqueue(queue, NULL));
+  safe_call(SCEDA_aqueue_enqueue(queue, NULL));
 
   /* This is an adaptation of Bellman-Ford algorithm, that works on the residual graph */
   int i = 0;
-  while((i < n) && (!SCEDA_queue_is_empty(queue))) {
+  while((i < n) && (!SCEDA_aqueue_is_empty(queue))) {
     SCEDA_Vertex *u;
-    safe_call(SCEDA_queue_dequeue(queue, (void **)&u));
+    safe_call(SCEDA_aqueue_dequeue(queue, (void **)&u));
     if(u == NULL) {
       i++;
       if(i < n) {
-	safe_call(SCEDA_queue_enqueue(queue, NULL));
+	safe_call(SCEDA_aqueue_enqueue(queue, NULL));
       }
       continue;
     }
@@ -595,7 +608,7 @@ static int SCEDA_augment_flow_along_neg_cycle_bellman_ford(SCEDA_Graph *g,
 	boxed_set(dist_v, boxed_get(dist_u) + ce);
 	boxed_set(rev_v, FALSE);
 	if(!SCEDA_hashset_contains(in_queue, v)) {
-	  safe_call(SCEDA_queue_enqueue(queue, v));
+	  safe_call(SCEDA_aqueue_enqueue(queue, v));
 	  safe_call(SCEDA_hashset_add(in_queue, v));
 	}
       }
@@ -620,7 +633,7 @@ static int SCEDA_augment_flow_along_neg_cycle_bellman_ford(SCEDA_Graph *g,
 	boxed_set(dist_v, boxed_get(dist_u) + ce);
 	boxed_set(rev_v, TRUE);
 	if(!SCEDA_hashset_contains(in_queue, v)) {
-	  safe_call(SCEDA_queue_enqueue(queue, v));
+	  safe_call(SCEDA_aqueue_enqueue(queue, v));
 	  safe_call(SCEDA_hashset_add(in_queue, v));
 	}
       }
@@ -631,8 +644,8 @@ static int SCEDA_augment_flow_along_neg_cycle_bellman_ford(SCEDA_Graph *g,
   SCEDA_hashmap_delete(dist);
   SCEDA_hashset_delete(in_queue);
 
-  if((i < n) || (SCEDA_queue_is_empty(queue))) {
-    SCEDA_queue_delete(queue);
+  if((i < n) || (SCEDA_aqueue_is_empty(queue))) {
+    SCEDA_aqueue_delete(queue);
     SCEDA_hashmap_delete(incoming_edges);
     SCEDA_hashmap_delete(reversed);
     return FALSE;
@@ -640,8 +653,8 @@ static int SCEDA_augment_flow_along_neg_cycle_bellman_ford(SCEDA_Graph *g,
 
   /* We can augment the flow along a negative cost cycle ! */
   SCEDA_Vertex *cycle;
-  safe_call(SCEDA_queue_dequeue(queue, (void **)&cycle));
-  SCEDA_queue_delete(queue);
+  safe_call(SCEDA_aqueue_dequeue(queue, (void **)&cycle));
+  SCEDA_aqueue_delete(queue);
 
   {
     SCEDA_HashSet *cycle_elts = SCEDA_vertex_set_create();
@@ -970,7 +983,7 @@ static void SCEDA_mcf_price_update(SCEDA_Graph *g,
 				   SCEDA_int_edge_fun cost, void *cost_ctxt,
 				   SCEDA_HashMap *flow,
 				   SCEDA_HashMap *excess, SCEDA_HashMap *pi, double epsilon) {
-  SCEDA_Queue *todo = SCEDA_queue_create(NULL);
+  SCEDA_AQueue *todo = SCEDA_aqueue_create(NULL);
   SCEDA_HashSet *visited = SCEDA_vertex_set_create();
   SCEDA_HashSet *compl = SCEDA_vertex_set_create();
 
@@ -985,7 +998,7 @@ static void SCEDA_mcf_price_update(SCEDA_Graph *g,
       boxed(int) eu = SCEDA_hashmap_get(excess, u);
       if(boxed_get(eu) <= 0) {
 	safe_call(SCEDA_hashset_add(visited, u));
-	safe_call(SCEDA_queue_enqueue(todo, u));
+	safe_call(SCEDA_aqueue_enqueue(todo, u));
       } else {
 	safe_call(SCEDA_hashset_add(compl, u));
       }
@@ -994,9 +1007,9 @@ static void SCEDA_mcf_price_update(SCEDA_Graph *g,
   }
 
   /** Perform the (backward) reachability analysis in the admissible graph */
-  while(!SCEDA_queue_is_empty(todo)) {
+  while(!SCEDA_aqueue_is_empty(todo)) {
     SCEDA_Vertex *u;
-    safe_call(SCEDA_queue_dequeue(todo, (void **)&u));
+    safe_call(SCEDA_aqueue_dequeue(todo, (void **)&u));
 
     boxed(double) piu = SCEDA_hashmap_get(pi, u);
     {
@@ -1022,7 +1035,7 @@ static void SCEDA_mcf_price_update(SCEDA_Graph *g,
 	  double ce_red = -cost(e, cost_ctxt) - boxed_get(piv) + boxed_get(piu);
 	  if((-epsilon <= ce_red) && (ce_red < 0)) {
 	    safe_call(SCEDA_hashset_add(visited, v));
-	    safe_call(SCEDA_queue_enqueue(todo, v));
+	    safe_call(SCEDA_aqueue_enqueue(todo, v));
 	    safe_call(SCEDA_hashset_remove(compl, (void **)&v));
 	    break;
 	  }
@@ -1055,7 +1068,7 @@ static void SCEDA_mcf_price_update(SCEDA_Graph *g,
 	  double ce_red = cost(e, cost_ctxt) - boxed_get(piv) + boxed_get(piu);
 	  if((-epsilon <= ce_red) && (ce_red < 0)) {
 	    safe_call(SCEDA_hashset_add(visited, v));
-	    safe_call(SCEDA_queue_enqueue(todo, v));
+	    safe_call(SCEDA_aqueue_enqueue(todo, v));
 	    safe_call(SCEDA_hashset_remove(compl, (void **)&v));
 	    break;
 	  }
@@ -1079,7 +1092,7 @@ static void SCEDA_mcf_price_update(SCEDA_Graph *g,
 
   SCEDA_hashset_delete(compl);
   SCEDA_hashset_delete(visited);
-  SCEDA_queue_delete(todo);
+  SCEDA_aqueue_delete(todo);
 }
 
 static void SCEDA_minimise_flow_cost_cost_scaling_fifo(SCEDA_Graph *g,
@@ -1089,8 +1102,10 @@ static void SCEDA_minimise_flow_cost_cost_scaling_fifo(SCEDA_Graph *g,
   int n = SCEDA_graph_vcount(g);
 
   SCEDA_HashMap *excess = SCEDA_vertex_map_create((SCEDA_delete_fun)boxed_delete);
+  SCEDA_hashmap_reserve(excess, n);
 
   SCEDA_HashMap *pi = SCEDA_vertex_map_create((SCEDA_delete_fun)boxed_delete);
+  SCEDA_hashmap_reserve(pi, n);
 
   double epsilon = 1;
 
@@ -1158,7 +1173,7 @@ static void SCEDA_minimise_flow_cost_cost_scaling_fifo(SCEDA_Graph *g,
       SCEDA_edges_iterator_cleanup(&edges);
     }
 
-    SCEDA_Queue *todo = SCEDA_queue_create(NULL);
+    SCEDA_AQueue *todo = SCEDA_aqueue_create(NULL);
 
     {
       SCEDA_VerticesIterator vertices;
@@ -1167,7 +1182,7 @@ static void SCEDA_minimise_flow_cost_cost_scaling_fifo(SCEDA_Graph *g,
 	SCEDA_Vertex *u = SCEDA_vertices_iterator_next(&vertices);
 	boxed(int) eu = SCEDA_hashmap_get(excess, u);
 	if(boxed_get(eu) > 0) {
-	  safe_call(SCEDA_queue_enqueue(todo, u));
+	  safe_call(SCEDA_aqueue_enqueue(todo, u));
 	}
       }
       SCEDA_vertices_iterator_cleanup(&vertices);
@@ -1175,14 +1190,14 @@ static void SCEDA_minimise_flow_cost_cost_scaling_fifo(SCEDA_Graph *g,
 
     int relabelling = 0;
 
-    while(!SCEDA_queue_is_empty(todo)) {
+    while(!SCEDA_aqueue_is_empty(todo)) {
       if(relabelling > n) {
 	relabelling = 0;
 	SCEDA_mcf_price_update(g, cap, cap_ctxt, cost, cost_ctxt, flow, excess, pi, epsilon);
       }
 
       SCEDA_Vertex *u;
-      safe_call(SCEDA_queue_dequeue(todo, (void **)&u));
+      safe_call(SCEDA_aqueue_dequeue(todo, (void **)&u));
 
       boxed(int) eu = SCEDA_hashmap_get(excess, u);
       boxed(double) piu = SCEDA_hashmap_get(pi, u);
@@ -1215,7 +1230,7 @@ static void SCEDA_minimise_flow_cost_cost_scaling_fifo(SCEDA_Graph *g,
 	      boxed_set(eu, boxed_get(eu) - push);
 	      boxed_set(ev, boxed_get(ev) + push);
 	      if((boxed_get(ev) > 0) && (boxed_get(ev) <= push)) {
-		safe_call(SCEDA_queue_enqueue(todo, v));
+		safe_call(SCEDA_aqueue_enqueue(todo, v));
 	      }
 	      if(boxed_get(eu) == 0) {
 		break;
@@ -1257,7 +1272,7 @@ static void SCEDA_minimise_flow_cost_cost_scaling_fifo(SCEDA_Graph *g,
 	      boxed_set(eu, boxed_get(eu) - push);
 	      boxed_set(ev, boxed_get(ev) + push);
 	      if((boxed_get(ev) > 0) && (boxed_get(ev) <= push)) {
-		safe_call(SCEDA_queue_enqueue(todo, v));
+		safe_call(SCEDA_aqueue_enqueue(todo, v));
 	      }
 	      if(boxed_get(eu) == 0) {
 		break;
@@ -1283,7 +1298,7 @@ static void SCEDA_minimise_flow_cost_cost_scaling_fifo(SCEDA_Graph *g,
       } while(boxed_get(eu) > 0);
     }
 
-    SCEDA_queue_delete(todo);
+    SCEDA_aqueue_delete(todo);
   }
 
   SCEDA_hashmap_delete(pi);
@@ -1299,10 +1314,12 @@ static void SCEDA_minimise_flow_cost_cost_scaling_wave(SCEDA_Graph *g,
   int n = SCEDA_graph_vcount(g);
 
   SCEDA_HashMap *excess = SCEDA_vertex_map_create((SCEDA_delete_fun)boxed_delete);
+  SCEDA_hashmap_reserve(excess, n);
 
   SCEDA_HashMap *pi = SCEDA_vertex_map_create((SCEDA_delete_fun)boxed_delete);
+  SCEDA_hashmap_reserve(pi, n);
 
-  SCEDA_DList *topsort = SCEDA_dlist_create(NULL);
+  SCEDA_DList *topsort = SCEDA_dlist_create_pooled(NULL);
 
   double epsilon = 1;
 
@@ -1553,6 +1570,7 @@ SCEDA_HashMap *SCEDA_graph_feasible_flow(SCEDA_Graph *g,
   SCEDA_Vertex *t = SCEDA_graph_add_vertex(g, NULL);
   SCEDA_List *new_edges = SCEDA_list_create(NULL);
   SCEDA_HashMap *ncap = SCEDA_edge_map_create((SCEDA_delete_fun)boxed_delete);
+  SCEDA_hashmap_reserve(ncap, SCEDA_graph_ecount(g));
 
   {
     SCEDA_VerticesIterator vertices;
@@ -20,7 +20,7 @@
 #include "graph.h"
 #include "graph_matching.h"
 #include "util.h"
-#include "queue.h"
+#include "aqueue.h"
 
 #include "hashmap.h"
 
@@ -42,8 +42,10 @@ static void state_delete(State *st) {
 
 SCEDA_HashMap *SCEDA_graph_maximum_bipartite_matching(SCEDA_Graph *g, SCEDA_List *x_vert, SCEDA_List *y_vert) {
   SCEDA_HashMap *v_states = SCEDA_vertex_map_create((SCEDA_delete_fun)state_delete);
+  SCEDA_hashmap_reserve(v_states, SCEDA_graph_vcount(g));
 
   SCEDA_HashMap *spouse = SCEDA_vertex_map_create(NULL);
+  SCEDA_hashmap_reserve(spouse, SCEDA_graph_vcount(g));
 
 #define init_state(v) State *st_##v = safe_malloc(sizeof(State)); SCEDA_hashmap_put(v_states, v, st_##v, NULL)
 #define decl_state(v) State *st_##v = SCEDA_hashmap_get(v_states, v)
@@ -87,11 +89,11 @@ SCEDA_HashMap *SCEDA_graph_maximum_bipartite_matching(SCEDA_Graph *g, SCEDA_List
   SCEDA_list_iterator_cleanup(&vertice);
 
   //
-  SCEDA_Queue *q = SCEDA_queue_create(NULL);
-  SCEDA_Queue *path = SCEDA_queue_create(NULL);
+  SCEDA_AQueue *q = SCEDA_aqueue_create(NULL);
+  SCEDA_AQueue *path = SCEDA_aqueue_create(NULL);
 
   for(;;) {
-    SCEDA_queue_init(q, NULL);
+    SCEDA_aqueue_init(q, NULL);
 
     // initialize breadthfirst traversal
     SCEDA_list_iterator_init(x_vert, &vertice);
@@ -100,7 +102,7 @@ SCEDA_HashMap *SCEDA_graph_maximum_bipartite_matching(SCEDA_Graph *g, SCEDA_List
       decl_state(v);
       if(!SCEDA_vertex_get_matched(v)) {
 	SCEDA_vertex_set_color(v, GRAY);
-	safe_call(SCEDA_queue_enqueue(q, v));
+	safe_call(SCEDA_aqueue_enqueue(q, v));
       } else {
 	SCEDA_vertex_set_color(v, WHITE);
       }
@@ -119,8 +121,8 @@ SCEDA_HashMap *SCEDA_graph_maximum_bipartite_matching(SCEDA_Graph *g, SCEDA_List
 
     int couplage = XPART;
 
-    while((SCEDA_queue_size(q) > 0) && ((couplage == XPART) || (SCEDA_queue_size(path) == 0))) {
-      safe_call(SCEDA_queue_dequeue(q, (void **)&v));
+    while((SCEDA_aqueue_size(q) > 0) && ((couplage == XPART) || (SCEDA_aqueue_size(path) == 0))) {
+      safe_call(SCEDA_aqueue_dequeue(q, (void **)&v));
       decl_state(v);
       couplage = SCEDA_vertex_get_partition(v);
 
@@ -139,9 +141,9 @@ SCEDA_HashMap *SCEDA_graph_maximum_bipartite_matching(SCEDA_Graph *g, SCEDA_List
 	    SCEDA_vertex_set_parent(w, v);
 	    if(!SCEDA_vertex_get_matched(w)) {
 	      // just found an unmatched vertex
-	      safe_call(SCEDA_queue_enqueue(path, w));
+	      safe_call(SCEDA_aqueue_enqueue(path, w));
 	    }
-	    safe_call(SCEDA_queue_enqueue(q, w));
+	    safe_call(SCEDA_aqueue_enqueue(q, w));
 	  }
 	}
 	SCEDA_vertex_succ_iterator_cleanup(&v_succ);
@@ -154,7 +156,7 @@ SCEDA_HashMap *SCEDA_graph_maximum_bipartite_matching(SCEDA_Graph *g, SCEDA_List
 	  if(SCEDA_vertex_get_color(w) == WHITE) {
 	    SCEDA_vertex_set_color(w, GRAY);
 	    SCEDA_vertex_set_parent(w, v);
-	    safe_call(SCEDA_queue_enqueue(q, w));
+	    safe_call(SCEDA_aqueue_enqueue(q, w));
 	  }
 	}
       }
@@ -162,9 +164,9 @@ SCEDA_HashMap *SCEDA_graph_maximum_bipartite_matching(SCEDA_Graph *g, SCEDA_List
       SCEDA_vertex_set_color(v, BLACK);
     }
 
-    SCEDA_queue_cleanup(q); // clear the queue (it is possibly non empty)
+    SCEDA_aqueue_cleanup(q); // clear the queue (it is possibly non empty)
 
-    if(SCEDA_queue_size(path) == 0) {
+    if(SCEDA_aqueue_size(path) == 0) {
       // no more augmenting path, we are done!
       break;
     }
@@ -186,9 +188,9 @@ SCEDA_HashMap *SCEDA_graph_maximum_bipartite_matching(SCEDA_Graph *g, SCEDA_List
     SCEDA_list_iterator_cleanup(&vertice);
 
     // here, we just found a maximal set of minimum augmenting path
-    while(SCEDA_queue_size(path) > 0) {
+    while(SCEDA_aqueue_size(path) > 0) {
       SCEDA_Vertex *endpath = NULL;
-      SCEDA_queue_dequeue(path, (void **)&endpath);
+      SCEDA_aqueue_dequeue(path, (void **)&endpath);
 
       // check that the path is disjoint from previous ones
       SCEDA_Vertex *v = endpath;
@@ -221,8 +223,8 @@ SCEDA_HashMap *SCEDA_graph_maximum_bipartite_matching(SCEDA_Graph *g, SCEDA_List
     }
   }
 
-  SCEDA_queue_delete(q);
-  SCEDA_queue_delete(path);
+  SCEDA_aqueue_delete(q);
+  SCEDA_aqueue_delete(path);
 
   SCEDA_hashmap_delete(v_states);
 
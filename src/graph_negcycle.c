@@ -22,46 +22,54 @@
 #include "hashmap.h"
 #include "common.h"
 #include "util.h"
-#include "queue.h"
-#include "boxed.h"
+#include "aqueue.h"
+#include "typed_hashmap.h"
+
+#define vertex_hash(v) ((unsigned int)(v)->id)
+#define vertex_match(u, v) ((u) == (v))
 
 #define SCEDA_graph_neg_cycle(NAME,TYPE)				\
+SCEDA_DEFINE_HASHMAP(SCEDA_DistMap_##NAME, SCEDA_Vertex *, TYPE, vertex_hash, vertex_match) \
+									\
 SCEDA_List *SCEDA_graph_neg_cycle_##NAME(SCEDA_Graph *g, TYPE (*cost)(SCEDA_Edge *e, void *ctxt), void *c_ctxt) { \
   int n = SCEDA_graph_vcount(g);					\
 									\
-  SCEDA_HashMap *dist = SCEDA_vertex_map_create((SCEDA_delete_fun)boxed_delete); \
+  SCEDA_DistMap_##NAME dist;						\
+  SCEDA_DistMap_##NAME##_init(&dist);					\
+  safe_call(SCEDA_DistMap_##NAME##_reserve(&dist, n));			\
   SCEDA_HashMap *incoming_edge = SCEDA_vertex_map_create(NULL);		\
-  SCEDA_Queue *queue = SCEDA_queue_create(NULL);			\
+  SCEDA_AQueue *queue = SCEDA_aqueue_create(NULL);			\
   SCEDA_HashSet *in_queue = SCEDA_vertex_set_create();			\
+  SCEDA_hashset_set_shrink(in_queue, FALSE);				\
 									\
   {									\
     SCEDA_VerticesIterator vertices;					\
     SCEDA_vertices_iterator_init(g, &vertices);				\
     while(SCEDA_vertices_iterator_has_next(&vertices)) {		\
       SCEDA_Vertex *v = SCEDA_vertices_iterator_next(&vertices);	\
-      safe_call(SCEDA_hashmap_put(dist, v, boxed_create(TYPE, 0), NULL)); \
-      safe_call(SCEDA_queue_enqueue(queue, v));				\
+      safe_call(SCEDA_DistMap_##NAME##_put(&dist, v, 0, NULL));	\
+      safe_call(SCEDA_aqueue_enqueue(queue, v));				\
       safe_call(SCEDA_hashset_add(in_queue, v));		    \
     }								    \
     SCEDA_vertices_iterator_cleanup(&vertices);			    \
   }								    \
   /** Mark end of phase by NULL */				    \
-  safe_call(SCEDA_queue_enqueue(queue, NULL));			    \
+  safe_call(SCEDA_aqueue_enqueue(queue, NULL));			    \
 								    \
   int i = 0;						\
-  while((i < n) && (!SCEDA_queue_is_empty(queue))) {	\
+  while((i < n) && (!SCEDA_aqueue_is_empty(queue))) {	\
     SCEDA_Vertex *u;					\
-    safe_call(SCEDA_queue_dequeue(queue, (void **)&u)); \
+    safe_call(SCEDA_aqueue_dequeue(queue, (void **)&u)); \
     if(u == NULL) {					\
       i++;						\
       if(i < n) {					\
-	safe_call(SCEDA_queue_enqueue(queue, NULL));	\
+	safe_call(SCEDA_aqueue_enqueue(queue, NULL));	\
       }							\
       continue;						\
     }							\
 							\
     safe_call(SCEDA_hashset_remove(in_queue, (void **)&u)); \
-    boxed(TYPE) du = SCEDA_hashmap_get(dist, u);	    \
+    TYPE *du = SCEDA_DistMap_##NAME##_get(&dist, u);		    \
 							    \
     SCEDA_OutEdgesIterator out_edges;				   \
     SCEDA_out_edges_iterator_init(u, &out_edges);			\
@@ -69,12 +77,12 @@ SCEDA_List *SCEDA_graph_neg_cycle_##NAME(SCEDA_Graph *g, TYPE (*cost)(SCEDA_Edge
       SCEDA_Edge *e = SCEDA_out_edges_iterator_next(&out_edges);	\
       TYPE ce = cost(e, c_ctxt);					\
       SCEDA_Vertex *v = SCEDA_edge_target(e);				\
-      boxed(TYPE) dv = SCEDA_hashmap_get(dist, v);			\
-      if(boxed_get(du) + ce < boxed_get(dv)) {				\
-	boxed_set(dv, boxed_get(du) + ce);				\
+      TYPE *dv = SCEDA_DistMap_##NAME##_get(&dist, v);		\
+      if(*du + ce < *dv) {						\
+	*dv = *du + ce;							\
 	SCEDA_hashmap_put(incoming_edge, v, e, NULL);			\
 	if(!SCEDA_hashset_contains(in_queue, v)) {			\
-	  safe_call(SCEDA_queue_enqueue(queue, v));			\
+	  safe_call(SCEDA_aqueue_enqueue(queue, v));			\
 	  safe_call(SCEDA_hashset_add(in_queue, v));			\
 	}								\
       }									\
@@ -82,20 +90,20 @@ SCEDA_List *SCEDA_graph_neg_cycle_##NAME(SCEDA_Graph *g, TYPE (*cost)(SCEDA_Edge
 }									\
 									\
   SCEDA_hashset_delete(in_queue);					\
-  SCEDA_hashmap_delete(dist);						\
+  SCEDA_DistMap_##NAME##_cleanup(&dist);				\
 									\
   SCEDA_List *cycle_edges = SCEDA_list_create(NULL);			\
 									\
-  if((i < n) || (SCEDA_queue_is_empty(queue))) {			\
-    SCEDA_queue_delete(queue);						\
+  if((i < n) || (SCEDA_aqueue_is_empty(queue))) {			\
+    SCEDA_aqueue_delete(queue);						\
     SCEDA_hashmap_delete(incoming_edge);				\
     return cycle_edges;							\
   }									\
 									\
   SCEDA_Vertex *cycle;							\
-  safe_call(SCEDA_queue_dequeue(queue, (void **)&cycle));		\
+  safe_call(SCEDA_aqueue_dequeue(queue, (void **)&cycle));		\
   /** cycle is a vertex reachable from a negative cycle */		\
-  SCEDA_queue_delete(queue);						\
+  SCEDA_aqueue_delete(queue);						\
 									\
   {									\
     /** find a vertex in the negative cycle */				\
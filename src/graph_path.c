@@ -23,8 +23,11 @@
 #include "hashmap.h"
 #include "common.h"
 #include "util.h"
-#include "heap.h"
-#include "queue.h"
+#include "iheap.h"
+#include "bqueue.h"
+#include "rheap.h"
+#include "aqueue.h"
+#include "vector.h"
 
 /* #define SCEDA_DIST_TYPE long double */
 /* #include <float.h> */
@@ -94,16 +97,19 @@ static inline int SCEDA_path_relax(SCEDA_PathInfo *info_u, SCEDA_PathInfo *info_
 
 SCEDA_HashMap *SCEDA_graph_shortest_path_from_in_dag(SCEDA_Graph *g, SCEDA_Vertex *from, SCEDA_dist_fun dist, void *ctxt) {
   SCEDA_HashMap *paths = SCEDA_vertex_map_create((SCEDA_delete_fun)SCEDA_path_info_delete);
+  SCEDA_hashmap_reserve(paths, SCEDA_graph_vcount(g));
 
   int n = SCEDA_graph_vcount(g);
-  SCEDA_Vertex *vertice[n];
+  SCEDA_Vector vertice;
+  SCEDA_vector_init(&vertice, NULL);
+  safe_call(SCEDA_vector_resize(&vertice, n));
 
   SCEDA_VerticesIterator g_vertice;
   SCEDA_vertices_iterator_init(g, &g_vertice);
   while(SCEDA_vertices_iterator_has_next(&g_vertice)) {
     SCEDA_Vertex *v = SCEDA_vertices_iterator_next(&g_vertice);
     int i = SCEDA_vertex_get_index(v);
-    vertice[i] = v;
+    SCEDA_vector_set(&vertice, i, v);
     SCEDA_PathInfo *info = SCEDA_path_info_create(from, v);
     SCEDA_hashmap_put(paths, v, info, NULL);
   }
@@ -111,7 +117,7 @@ SCEDA_HashMap *SCEDA_graph_shortest_path_from_in_dag(SCEDA_Graph *g, SCEDA_Verte
 
   int i;
   for(i = 0; i < n; i++) {
-    SCEDA_Vertex *u = vertice[i];
+    SCEDA_Vertex *u = SCEDA_vector_get(SCEDA_Vertex *, &vertice, i);
     SCEDA_PathInfo *info_u = SCEDA_hashmap_get(paths, u);
     SCEDA_OutEdgesIterator out_edges;
     SCEDA_out_edges_iterator_init(u, &out_edges);
@@ -124,21 +130,26 @@ SCEDA_HashMap *SCEDA_graph_shortest_path_from_in_dag(SCEDA_Graph *g, SCEDA_Verte
     SCEDA_out_edges_iterator_cleanup(&out_edges);
   }
 
+  SCEDA_vector_cleanup(&vertice);
+
   return paths;
 }
 
 SCEDA_HashMap *SCEDA_graph_shortest_path_to_in_dag(SCEDA_Graph *g, SCEDA_Vertex *to, SCEDA_dist_fun dist, void *ctxt) {
   SCEDA_HashMap *paths = SCEDA_vertex_map_create((SCEDA_delete_fun)SCEDA_path_info_delete);
+  SCEDA_hashmap_reserve(paths, SCEDA_graph_vcount(g));
 
   int n = SCEDA_graph_vcount(g);
-  SCEDA_Vertex *vertice[n];
+  SCEDA_Vector vertice;
+  SCEDA_vector_init(&vertice, NULL);
+  safe_call(SCEDA_vector_resize(&vertice, n));
 
   SCEDA_VerticesIterator g_vertice;
   SCEDA_vertices_iterator_init(g, &g_vertice);
   while(SCEDA_vertices_iterator_has_next(&g_vertice)) {
     SCEDA_Vertex *v = SCEDA_vertices_iterator_next(&g_vertice);
     int i = SCEDA_vertex_get_index(v);
-    vertice[i] = v;
+    SCEDA_vector_set(&vertice, i, v);
     SCEDA_PathInfo *info = SCEDA_path_info_create(to, v);
     SCEDA_hashmap_put(paths, v, info, NULL);
   }
@@ -146,7 +157,7 @@ SCEDA_HashMap *SCEDA_graph_shortest_path_to_in_dag(SCEDA_Graph *g, SCEDA_Vertex
 
   int i;
   for(i = n-1; i >= 0; i--) {
-    SCEDA_Vertex *u = vertice[i];
+    SCEDA_Vertex *u = SCEDA_vector_get(SCEDA_Vertex *, &vertice, i);
     SCEDA_PathInfo *info_u = SCEDA_hashmap_get(paths, u);
     SCEDA_InEdgesIterator in_edges;
     SCEDA_in_edges_iterator_init(u, &in_edges);
@@ -159,36 +170,145 @@ SCEDA_HashMap *SCEDA_graph_shortest_path_to_in_dag(SCEDA_Graph *g, SCEDA_Vertex
     SCEDA_in_edges_iterator_cleanup(&in_edges);
   }
 
+  SCEDA_vector_cleanup(&vertice);
+
   return paths;
 }
 
-SCEDA_HashMap *SCEDA_graph_shortest_path_dijkstra(SCEDA_Graph *g, SCEDA_Vertex *from, SCEDA_dist_fun dist, void *ctxt) {
+/* priority queue of Dijkstra algorithm, indexed by vertex numbers */
+typedef struct {
+  int kind;
+  union {
+    SCEDA_IHeap heap;
+    SCEDA_BucketQueue buckets;
+    SCEDA_RadixHeap radix;
+  } q;
+} SCEDA_DijkstraQueue;
+
+/* insert vertex number j or decrease its distance */
+static inline void SCEDA_dijkstra_queue_push(SCEDA_DijkstraQueue *queue, int j, SCEDA_PathInfo *info) {
+  switch(queue->kind) {
+  case SCEDA_DIJKSTRA_BUCKETS:
+    if(SCEDA_bqueue_contains(&queue->q.buckets, j)) {
+      safe_call(SCEDA_bqueue_decrease_key(&queue->q.buckets, j, info->distance));
+    } else {
+      safe_call(SCEDA_bqueue_insert(&queue->q.buckets, j, info->distance));
+    }
+    break;
+  case SCEDA_DIJKSTRA_RADIX:
+    if(SCEDA_rheap_contains(&queue->q.radix, j)) {
+      safe_call(SCEDA_rheap_decrease_key(&queue->q.radix, j, info->distance));
+    } else {
+      safe_call(SCEDA_rheap_insert(&queue->q.radix, j, info->distance));
+    }
+    break;
+  default:
+    if(SCEDA_iheap_contains(&queue->q.heap, j)) {
+      safe_call(SCEDA_iheap_decrease_key(&queue->q.heap, j));
+    } else {
+      safe_call(SCEDA_iheap_insert(&queue->q.heap, j, NULL, info));
+    }
+  }
+}
+
+/* extract the vertex number of minimal distance, or return -1 */
+static inline int SCEDA_dijkstra_queue_pop(SCEDA_DijkstraQueue *queue) {
+  int j;
+  void *value, *key;
+  switch(queue->kind) {
+  case SCEDA_DIJKSTRA_BUCKETS:
+    return (SCEDA_bqueue_extract(&queue->q.buckets, &j, NULL) == 0) ? j : -1;
+  case SCEDA_DIJKSTRA_RADIX:
+    return (SCEDA_rheap_extract(&queue->q.radix, &j, NULL) == 0) ? j : -1;
+  default:
+    return (SCEDA_iheap_extract(&queue->q.heap, &j, &value, &key) == 0) ? j : -1;
+  }
+}
+
+SCEDA_HashMap *SCEDA_graph_shortest_path_dijkstra_with_bound(SCEDA_Graph *g, SCEDA_Vertex *from, SCEDA_dist_fun dist, void *ctxt, int kind, int max_weight) {
   SCEDA_HashMap *paths = SCEDA_vertex_map_create((SCEDA_delete_fun)SCEDA_path_info_delete);
-  SCEDA_HashMap *elts = SCEDA_vertex_map_create(NULL);
-  SCEDA_Heap *heap = SCEDA_heap_create(NULL, NULL, (SCEDA_compare_fun)SCEDA_path_info_compare);
+  SCEDA_hashmap_reserve(paths, SCEDA_graph_vcount(g));
 
+  // vertices are numbered from 0 to n-1 to be used as queue handles
+  // (their former indices are restored at the end)
+  int n = SCEDA_graph_vcount(g);
+  SCEDA_IntVector saved;
+  SCEDA_IntVector_init(&saved);
+  safe_call(SCEDA_IntVector_resize(&saved, n));
+  SCEDA_Vector vertice;
+  SCEDA_vector_init(&vertice, NULL);
+  safe_call(SCEDA_vector_resize(&vertice, n));
+  SCEDA_Vector infos;
+  SCEDA_vector_init(&infos, NULL);
+  safe_call(SCEDA_vector_resize(&infos, n));
+  // the largest weight is only needed by integer queues
+  int scan = (max_weight < 0) && (kind != SCEDA_DIJKSTRA_HEAP);
+  if(max_weight < 0) {
+    max_weight = 0;
+  }
+
+  int i = 0;
   SCEDA_VerticesIterator g_vertice;
   SCEDA_vertices_iterator_init(g, &g_vertice);
   while(SCEDA_vertices_iterator_has_next(&g_vertice)) {
     SCEDA_Vertex *v = SCEDA_vertices_iterator_next(&g_vertice);
+    SCEDA_IntVector_set(&saved, i, SCEDA_vertex_get_index(v));
+    SCEDA_vertex_set_index(v, i);
+    SCEDA_vector_set(&vertice, i, v);
     SCEDA_PathInfo *info = SCEDA_path_info_create(from, v);
     SCEDA_hashmap_put(paths, v, info, NULL);
-    SCEDA_HeapElt *elt = SCEDA_heap_insert(heap, v, info);
-    SCEDA_hashmap_put(elts, v, elt, NULL);
+    SCEDA_vector_set(&infos, i, info);
+    i++;
+
+    if(scan) {
+      SCEDA_OutEdgesIterator out_edges;
+      SCEDA_out_edges_iterator_init(v, &out_edges);
+      while(SCEDA_out_edges_iterator_has_next(&out_edges)) {
+	int de = dist(SCEDA_out_edges_iterator_next(&out_edges), ctxt);
+	if(de > max_weight) {
+	  max_weight = de;
+	}
+      }
+      SCEDA_out_edges_iterator_cleanup(&out_edges);
+    }
   }
   SCEDA_vertices_iterator_cleanup(&g_vertice);
 
-  while(!SCEDA_heap_is_empty(heap)) {
-    SCEDA_Vertex *u;
-    SCEDA_PathInfo *info_u;
-    SCEDA_heap_extract(heap, (void **)&u, (void **)&info_u);
+  // integer queues need every distance to fit in an int
+  if((n > 1) && (max_weight > (INFINITY - 1) / (n - 1))) {
+    kind = SCEDA_DIJKSTRA_HEAP;
+  } else if(kind == SCEDA_DIJKSTRA_AUTO) {
+    kind = (max_weight <= SCEDA_DIJKSTRA_MAX_BUCKETS) ? SCEDA_DIJKSTRA_BUCKETS : SCEDA_DIJKSTRA_RADIX;
+  }
+
+  SCEDA_DijkstraQueue queue;
+  queue.kind = kind;
+  switch(kind) {
+  case SCEDA_DIJKSTRA_BUCKETS:
+    SCEDA_bqueue_init(&queue.q.buckets, n, max_weight);
+    break;
+  case SCEDA_DIJKSTRA_RADIX:
+    SCEDA_rheap_init(&queue.q.radix, n);
+    break;
+  default:
+    SCEDA_iheap_init(&queue.q.heap, n, NULL, NULL, (SCEDA_compare_fun)SCEDA_path_info_compare);
+  }
+
+  // vertices enter the queue once reached: an extracted vertex is
+  // never relaxed again as weights are non negative
+  int j = SCEDA_vertex_get_index(from);
+  SCEDA_dijkstra_queue_push(&queue, j, SCEDA_vector_get(SCEDA_PathInfo *, &infos, j));
+
+  while((j = SCEDA_dijkstra_queue_pop(&queue)) != -1) {
+    SCEDA_Vertex *u = SCEDA_vector_get(SCEDA_Vertex *, &vertice, j);
+    SCEDA_PathInfo *info_u = SCEDA_vector_get(SCEDA_PathInfo *, &infos, j);
 
     SCEDA_OutEdgesIterator out_edges;
     SCEDA_out_edges_iterator_init(u, &out_edges);
     while(SCEDA_out_edges_iterator_has_next(&out_edges)) {
       SCEDA_Edge *e = SCEDA_out_edges_iterator_next(&out_edges);
-      SCEDA_Vertex *v = SCEDA_edge_target(e);
-      SCEDA_PathInfo *info_v = SCEDA_hashmap_get(paths, v);
+      int k = SCEDA_vertex_get_index(SCEDA_edge_target(e));
+      SCEDA_PathInfo *info_v = SCEDA_vector_get(SCEDA_PathInfo *, &infos, k);
 
       int de = dist(e, ctxt);
       if(de < 0) {
@@ -196,21 +316,44 @@ SCEDA_HashMap *SCEDA_graph_shortest_path_dijkstra(SCEDA_Graph *g, SCEDA_Vertex *
       }
 
       if(SCEDA_path_relax(info_u, info_v, de, e)) {
-	SCEDA_HeapElt *elt = SCEDA_hashmap_get(elts, v);
-	SCEDA_heap_decrease_key(heap, elt);
+	SCEDA_dijkstra_queue_push(&queue, k, info_v);
       }
     }
     SCEDA_out_edges_iterator_cleanup(&out_edges);
   }
 
-  SCEDA_hashmap_delete(elts);
-  SCEDA_heap_delete(heap);
+  for(i = 0; i < n; i++) {
+    SCEDA_vertex_set_index(SCEDA_vector_get(SCEDA_Vertex *, &vertice, i), SCEDA_IntVector_get(&saved, i));
+  }
+
+  switch(kind) {
+  case SCEDA_DIJKSTRA_BUCKETS:
+    SCEDA_bqueue_cleanup(&queue.q.buckets);
+    break;
+  case SCEDA_DIJKSTRA_RADIX:
+    SCEDA_rheap_cleanup(&queue.q.radix);
+    break;
+  default:
+    SCEDA_iheap_cleanup(&queue.q.heap);
+  }
+  SCEDA_vector_cleanup(&infos);
+  SCEDA_vector_cleanup(&vertice);
+  SCEDA_IntVector_cleanup(&saved);
 
   return paths;
 }
 
+SCEDA_HashMap *SCEDA_graph_shortest_path_dijkstra_with_queue(SCEDA_Graph *g, SCEDA_Vertex *from, SCEDA_dist_fun dist, void *ctxt, int kind) {
+  return SCEDA_graph_shortest_path_dijkstra_with_bound(g, from, dist, ctxt, kind, -1);
+}
+
+SCEDA_HashMap *SCEDA_graph_shortest_path_dijkstra(SCEDA_Graph *g, SCEDA_Vertex *from, SCEDA_dist_fun dist, void *ctxt) {
+  return SCEDA_graph_shortest_path_dijkstra_with_queue(g, from, dist, ctxt, SCEDA_DIJKSTRA_AUTO);
+}
+
 SCEDA_HashMap *SCEDA_graph_shortest_path_bellman_ford(SCEDA_Graph *g, SCEDA_Vertex *from, SCEDA_dist_fun dist, void *ctxt, int *has_cycle) {
   SCEDA_HashMap *paths = SCEDA_vertex_map_create((SCEDA_delete_fun)SCEDA_path_info_delete);
+  SCEDA_hashmap_reserve(paths, SCEDA_graph_vcount(g));
 
   int n = SCEDA_graph_vcount(g);
 
@@ -224,20 +367,21 @@ SCEDA_HashMap *SCEDA_graph_shortest_path_bellman_ford(SCEDA_Graph *g, SCEDA_Vert
   SCEDA_vertices_iterator_cleanup(&g_vertice);
 
   SCEDA_HashSet *in_queue = SCEDA_vertex_set_create();
+  SCEDA_hashset_set_shrink(in_queue, FALSE);
 
-  SCEDA_Queue *queue = SCEDA_queue_create(NULL);
-  safe_call(SCEDA_queue_enqueue(queue, from));
-  safe_call(SCEDA_queue_enqueue(queue, NULL));
+  SCEDA_AQueue *queue = SCEDA_aqueue_create(NULL);
+  safe_call(SCEDA_aqueue_enqueue(queue, from));
+  safe_call(SCEDA_aqueue_enqueue(queue, NULL));
   safe_call(SCEDA_hashset_add(in_queue, from));
 
   int i = 0;
-  while((i < n) && (!SCEDA_queue_is_empty(queue))) {
+  while((i < n) && (!SCEDA_aqueue_is_empty(queue))) {
     SCEDA_Vertex *u;
-    safe_call(SCEDA_queue_dequeue(queue, (void **)&u));
+    safe_call(SCEDA_aqueue_dequeue(queue, (void **)&u));
     if(u == NULL) {
       i++;
       if(i < n) {
-	safe_call(SCEDA_queue_enqueue(queue, NULL));
+	safe_call(SCEDA_aqueue_enqueue(queue, NULL));
       }
       continue;
     }
@@ -253,7 +397,7 @@ SCEDA_HashMap *SCEDA_graph_shortest_path_bellman_ford(SCEDA_Graph *g, SCEDA_Vert
       SCEDA_PathInfo *info_v = SCEDA_hashmap_get(paths, v);
       if(SCEDA_path_relax(info_u, info_v, dist(e, ctxt), e)) {
 	if(!SCEDA_hashset_contains(in_queue, v)) {
-	  safe_call(SCEDA_queue_enqueue(queue, v));
+	  safe_call(SCEDA_aqueue_enqueue(queue, v));
 	  safe_call(SCEDA_hashset_add(in_queue, v));
 	}
       }
@@ -263,12 +407,12 @@ SCEDA_HashMap *SCEDA_graph_shortest_path_bellman_ford(SCEDA_Graph *g, SCEDA_Vert
 
   SCEDA_hashset_delete(in_queue);
 
-  if((i < n) || (SCEDA_queue_is_empty(queue))) {
+  if((i < n) || (SCEDA_aqueue_is_empty(queue))) {
     *has_cycle = FALSE;
   } else {
     *has_cycle = TRUE;
   }
 
-  SCEDA_queue_delete(queue);
+  SCEDA_aqueue_delete(queue);
   return paths;
 }
@@ -58,9 +58,25 @@ SCEDA_HashMap *SCEDA_graph_shortest_path_from_in_dag(SCEDA_Graph *g, SCEDA_Verte
     A topological order must have been computed in g. */
 SCEDA_HashMap *SCEDA_graph_shortest_path_to_in_dag(SCEDA_Graph *g, SCEDA_Vertex *to, SCEDA_int_edge_fun dist, void *ctxt);
 
+/** Priority queues of Dijkstra algorithm: choose automatically */
+#define SCEDA_DIJKSTRA_AUTO 0
+/** Priority queues of Dijkstra algorithm: indexed heap (generic comparisons) */
+#define SCEDA_DIJKSTRA_HEAP 1
+/** Priority queues of Dijkstra algorithm: bucket queue (Dial) */
+#define SCEDA_DIJKSTRA_BUCKETS 2
+/** Priority queues of Dijkstra algorithm: radix heap */
+#define SCEDA_DIJKSTRA_RADIX 3
+
+/** Largest edge weight for which SCEDA_DIJKSTRA_AUTO selects a bucket
+    queue (a radix heap is selected above) */
+#define SCEDA_DIJKSTRA_MAX_BUCKETS 1024
+
 /** Compute the shortest paths from a unique source using Dijkstra
     algorithm.
 
+    The priority queue is chosen automatically (see
+    SCEDA_graph_shortest_path_dijkstra_with_queue).
+
     @param[in] g = graph
     @param[in] from = source of all the paths
     @param[in] dist = distance function (negative values are truncated)
@@ -69,6 +85,49 @@ SCEDA_HashMap *SCEDA_graph_shortest_path_to_in_dag(SCEDA_Graph *g, SCEDA_Vertex
     @return map of all shortest paths from source vertex  */
 SCEDA_HashMap *SCEDA_graph_shortest_path_dijkstra(SCEDA_Graph *g, SCEDA_Vertex *from, SCEDA_int_edge_fun dist, void *ctxt);
 
+/** Compute the shortest paths from a unique source using Dijkstra
+    algorithm with a given kind of priority queue.
+
+    Distances are integers, so they can be kept in a monotone integer
+    queue (a bucket queue or a radix heap) rather than in a heap
+    comparing path infos, provided that no distance overflows. The
+    indexed heap is used whenever the largest edge weight times the
+    number of vertices exceeds INT_MAX. Otherwise,
+    SCEDA_DIJKSTRA_AUTO selects a bucket queue if the largest edge
+    weight is at most SCEDA_DIJKSTRA_MAX_BUCKETS, and a radix heap
+    above.
+
+    Unless the indexed heap is requested, the largest edge weight is
+    computed beforehand, which calls dist once more on every edge (see
+    SCEDA_graph_shortest_path_dijkstra_with_bound to avoid it).
+
+    @param[in] g = graph
+    @param[in] from = source of all the paths
+    @param[in] dist = distance function (negative values are truncated)
+    @param[in] ctxt = distance function context
+    @param[in] queue = SCEDA_DIJKSTRA_AUTO, SCEDA_DIJKSTRA_HEAP, SCEDA_DIJKSTRA_BUCKETS or SCEDA_DIJKSTRA_RADIX
+
+    @return map of all shortest paths from source vertex  */
+SCEDA_HashMap *SCEDA_graph_shortest_path_dijkstra_with_queue(SCEDA_Graph *g, SCEDA_Vertex *from, SCEDA_int_edge_fun dist, void *ctxt, int queue);
+
+/** Compute the shortest paths from a unique source using Dijkstra
+    algorithm with a given kind of priority queue and a known bound on
+    edge weights.
+
+    Same as SCEDA_graph_shortest_path_dijkstra_with_queue, except that
+    the largest edge weight is given by the caller instead of being
+    computed. dist must never return more than max_weight.
+
+    @param[in] g = graph
+    @param[in] from = source of all the paths
+    @param[in] dist = distance function (negative values are truncated)
+    @param[in] ctxt = distance function context
+    @param[in] queue = SCEDA_DIJKSTRA_AUTO, SCEDA_DIJKSTRA_HEAP, SCEDA_DIJKSTRA_BUCKETS or SCEDA_DIJKSTRA_RADIX
+    @param[in] max_weight = largest edge weight (if negative, it is computed)
+
+    @return map of all shortest paths from source vertex  */
+SCEDA_HashMap *SCEDA_graph_shortest_path_dijkstra_with_bound(SCEDA_Graph *g, SCEDA_Vertex *from, SCEDA_int_edge_fun dist, void *ctxt, int queue, int max_weight);
+
 /** Compute the shortest paths from a unique source using Bellman-Ford
     algorithm.
 
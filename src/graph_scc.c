@@ -20,12 +20,13 @@
 #include "graph_scc.h"
 
 #include "hashset.h"
-#include "stack.h"
+#include "astack.h"
+#include "unionfind.h"
 
 #include "util.h"
 #include "common.h"
 
-static void SCEDA_DFT1(SCEDA_Vertex *u, SCEDA_HashSet *visited, SCEDA_Stack *ordered_vertices) {
+static void SCEDA_DFT1(SCEDA_Vertex *u, SCEDA_HashSet *visited, SCEDA_AStack *ordered_vertices) {
   safe_call(SCEDA_hashset_add(visited, u));
 
   SCEDA_VertexSuccIterator succ;
@@ -38,7 +39,7 @@ static void SCEDA_DFT1(SCEDA_Vertex *u, SCEDA_HashSet *visited, SCEDA_Stack *ord
   }
   SCEDA_vertex_succ_iterator_cleanup(&succ);
 
-  safe_call(SCEDA_stack_push(ordered_vertices, u));
+  safe_call(SCEDA_astack_push(ordered_vertices, u));
 }
 
 static void SCEDA_DFT2(SCEDA_Vertex *u, SCEDA_HashSet *visited, SCEDA_HashSet *cc) {
@@ -59,8 +60,9 @@ static void SCEDA_DFT2(SCEDA_Vertex *u, SCEDA_HashSet *visited, SCEDA_HashSet *c
 
 SCEDA_List *SCEDA_graph_strongly_connected_components(SCEDA_Graph *g) {
   SCEDA_HashSet *visited = SCEDA_vertex_set_create();
+  SCEDA_hashset_reserve(visited, SCEDA_graph_vcount(g));
 
-  SCEDA_Stack *ordered_vertices = SCEDA_stack_create(NULL);
+  SCEDA_AStack *ordered_vertices = SCEDA_astack_create(NULL);
 
   {
     SCEDA_VerticesIterator vertices;
@@ -79,9 +81,9 @@ SCEDA_List *SCEDA_graph_strongly_connected_components(SCEDA_Graph *g) {
   SCEDA_hashset_clear(visited);
 
   {
-    while(!SCEDA_stack_is_empty(ordered_vertices)) {
+    while(!SCEDA_astack_is_empty(ordered_vertices)) {
       SCEDA_Vertex *u;
-      safe_call(SCEDA_stack_pop(ordered_vertices, (void **)&u));
+      safe_call(SCEDA_astack_pop(ordered_vertices, (void **)&u));
       if(!SCEDA_hashset_contains(visited, u)) {
 	SCEDA_HashSet *cc = SCEDA_vertex_set_create();
 	safe_call(SCEDA_list_add(scc, cc));
@@ -90,9 +92,71 @@ SCEDA_List *SCEDA_graph_strongly_connected_components(SCEDA_Graph *g) {
     }
   }
 
-  SCEDA_stack_delete(ordered_vertices);
+  SCEDA_astack_delete(ordered_vertices);
 
   SCEDA_hashset_delete(visited);
 
   return scc;
 }
+
+SCEDA_List *SCEDA_graph_weakly_connected_components(SCEDA_Graph *g) {
+  SCEDA_List *wcc = SCEDA_list_create((SCEDA_delete_fun)SCEDA_hashset_delete);
+
+  int n = SCEDA_graph_vcount(g);
+  if(n == 0) {
+    return wcc;
+  }
+
+  // vertices are numbered from 0 to n-1 to be used as union-find
+  // elements (their former indices are restored at the end)
+  int *saved = safe_malloc(n * sizeof(int));
+  SCEDA_Vertex **vertice = safe_malloc(n * sizeof(SCEDA_Vertex *));
+
+  int i = 0;
+  SCEDA_VerticesIterator g_vertice;
+  SCEDA_vertices_iterator_init(g, &g_vertice);
+  while(SCEDA_vertices_iterator_has_next(&g_vertice)) {
+    SCEDA_Vertex *v = SCEDA_vertices_iterator_next(&g_vertice);
+    saved[i] = SCEDA_vertex_get_index(v);
+    SCEDA_vertex_set_index(v, i);
+    vertice[i] = v;
+    i++;
+  }
+  SCEDA_vertices_iterator_cleanup(&g_vertice);
+
+  SCEDA_UnionFind uf;
+  SCEDA_unionfind_init(&uf, n);
+
+  for(i = 0; i < n; i++) {
+    SCEDA_VertexSuccIterator succ;
+    SCEDA_vertex_succ_iterator_init(vertice[i], &succ);
+    while(SCEDA_vertex_succ_iterator_has_next(&succ)) {
+      SCEDA_Vertex *v = SCEDA_vertex_succ_iterator_next(&succ);
+      SCEDA_unionfind_union(&uf, i, SCEDA_vertex_get_index(v));
+    }
+    SCEDA_vertex_succ_iterator_cleanup(&succ);
+  }
+
+  // components are indexed by their representative
+  SCEDA_HashSet **components = safe_calloc(n, sizeof(SCEDA_HashSet *));
+  for(i = 0; i < n; i++) {
+    int r = SCEDA_unionfind_find(&uf, i);
+    if(components[r] == NULL) {
+      components[r] = SCEDA_vertex_set_create();
+      SCEDA_hashset_reserve(components[r], SCEDA_unionfind_set_size(&uf, r));
+      safe_call(SCEDA_list_add(wcc, components[r]));
+    }
+    safe_call(SCEDA_hashset_add(components[r], vertice[i]));
+  }
+
+  for(i = 0; i < n; i++) {
+    SCEDA_vertex_set_index(vertice[i], saved[i]);
+  }
+
+  free(components);
+  SCEDA_unionfind_cleanup(&uf);
+  free(vertice);
+  free(saved);
+
+  return wcc;
+}
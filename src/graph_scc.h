@@ -20,7 +20,7 @@
 #ifndef __SCEDA_GRAPH_SCC_H
 #define __SCEDA_GRAPH_SCC_H
 /** \file graph_scc.h
-    \brief strongly connected components */
+    \brief strongly and weakly connected components */
 
 #include "graph.h"
 #include "list.h"
@@ -33,4 +33,14 @@
     connected component of g */
 SCEDA_List *SCEDA_graph_strongly_connected_components(SCEDA_Graph *g);
 
+/** Compute the weakly connected components of a graph (the connected
+    components of g when edges are not oriented), in time complexity
+    O((|V|+|E|).alpha(|V|)).
+
+    @param g = graph
+
+    @return a list of hashset (vertex set), each set being a weakly
+    connected component of g */
+SCEDA_List *SCEDA_graph_weakly_connected_components(SCEDA_Graph *g);
+
 #endif
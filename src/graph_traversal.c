@@ -22,25 +22,25 @@
 
 /** Breadth First Search */
 void SCEDA_bfs_iterator_init(SCEDA_Vertex *v, SCEDA_BFSIterator *iter) {
-  iter->to_visit = SCEDA_queue_create(NULL);
+  iter->to_visit = SCEDA_aqueue_create(NULL);
   iter->visited = SCEDA_vertex_set_create();
-  safe_call(SCEDA_queue_enqueue(iter->to_visit, v));
+  safe_call(SCEDA_aqueue_enqueue(iter->to_visit, v));
   safe_call(SCEDA_hashset_add(iter->visited, v));
 }
 
 int SCEDA_bfs_iterator_has_next(SCEDA_BFSIterator *iter) {
-  return (!SCEDA_queue_is_empty(iter->to_visit));
+  return (!SCEDA_aqueue_is_empty(iter->to_visit));
 }
 
 SCEDA_Vertex *SCEDA_bfs_iterator_next(SCEDA_BFSIterator *iter) {
   SCEDA_Vertex *v;
-  safe_call(SCEDA_queue_dequeue(iter->to_visit, (void **)&v));
+  safe_call(SCEDA_aqueue_dequeue(iter->to_visit, (void **)&v));
   SCEDA_VertexSuccIterator succ;
   SCEDA_vertex_succ_iterator_init(v, &succ);
   while(SCEDA_vertex_succ_iterator_has_next(&succ)) {
     SCEDA_Vertex *w = SCEDA_vertex_succ_iterator_next(&succ);
     if(!SCEDA_hashset_contains(iter->visited, w)) {
-      safe_call(SCEDA_queue_enqueue(iter->to_visit, w));
+      safe_call(SCEDA_aqueue_enqueue(iter->to_visit, w));
       safe_call(SCEDA_hashset_add(iter->visited, w));
     }
   }
@@ -49,32 +49,32 @@ SCEDA_Vertex *SCEDA_bfs_iterator_next(SCEDA_BFSIterator *iter) {
 }
 
 void SCEDA_bfs_iterator_cleanup(SCEDA_BFSIterator *iter) {
-  SCEDA_queue_delete(iter->to_visit);
+  SCEDA_aqueue_delete(iter->to_visit);
   SCEDA_hashset_delete(iter->visited);
   memset(iter, 0, sizeof(SCEDA_BFSIterator));
 }
 
 /** Depth First Search */
 void SCEDA_dfs_iterator_init(SCEDA_Vertex *v, SCEDA_DFSIterator *iter) {
-  iter->to_visit = SCEDA_stack_create(NULL);
+  iter->to_visit = SCEDA_astack_create(NULL);
   iter->visited = SCEDA_vertex_set_create();
-  safe_call(SCEDA_stack_push(iter->to_visit, v));
+  safe_call(SCEDA_astack_push(iter->to_visit, v));
   safe_call(SCEDA_hashset_add(iter->visited, v));
 }
 
 int SCEDA_dfs_iterator_has_next(SCEDA_DFSIterator *iter) {
-  return (!SCEDA_stack_is_empty(iter->to_visit));
+  return (!SCEDA_astack_is_empty(iter->to_visit));
 }
 
 SCEDA_Vertex *SCEDA_dfs_iterator_next(SCEDA_DFSIterator *iter) {
   SCEDA_Vertex *v;
-  safe_call(SCEDA_stack_pop(iter->to_visit, (void **)&v));
+  safe_call(SCEDA_astack_pop(iter->to_visit, (void **)&v));
   SCEDA_VertexSuccIterator succ;
   SCEDA_vertex_succ_iterator_init(v, &succ);
   while(SCEDA_vertex_succ_iterator_has_next(&succ)) {
     SCEDA_Vertex *w = SCEDA_vertex_succ_iterator_next(&succ);
     if(!SCEDA_hashset_contains(iter->visited, w)) {
-      safe_call(SCEDA_stack_push(iter->to_visit, w));
+      safe_call(SCEDA_astack_push(iter->to_visit, w));
       safe_call(SCEDA_hashset_add(iter->visited, w));
     }
   }
@@ -83,7 +83,7 @@ SCEDA_Vertex *SCEDA_dfs_iterator_next(SCEDA_DFSIterator *iter) {
 }
 
 void SCEDA_dfs_iterator_cleanup(SCEDA_DFSIterator *iter) {
-  SCEDA_stack_delete(iter->to_visit);
+  SCEDA_astack_delete(iter->to_visit);
   SCEDA_hashset_delete(iter->visited);
   memset(iter, 0, sizeof(SCEDA_DFSIterator));
 }
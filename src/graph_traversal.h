@@ -24,17 +24,17 @@
 
 #include "graph.h"
 #include "hashset.h"
-#include "stack.h"
-#include "queue.h"
+#include "astack.h"
+#include "aqueue.h"
 
 typedef struct {
   SCEDA_HashSet *visited;
-  SCEDA_Stack *to_visit;
+  SCEDA_AStack *to_visit;
 } SCEDA_DFSIterator;
 
 typedef struct {
   SCEDA_HashSet *visited;
-  SCEDA_Queue *to_visit;
+  SCEDA_AQueue *to_visit;
 } SCEDA_BFSIterator;
 
 void SCEDA_bfs_iterator_init(SCEDA_Vertex *v, SCEDA_BFSIterator *iter);
@@ -21,132 +21,710 @@
 #include "util.h"
 #include <string.h>
 
-#define new_hash_code(hmap, key, buckets) (((hmap)->hash_key(key)) % buckets)
-#define hash_code(hmap, key) (new_hash_code(hmap, key, (hmap)->buckets))
+#define seeded_hash(hmap, x) ((hmap)->hash_key(x) ^ (hmap)->seed)
 
-void SCEDA_hashmap_init(SCEDA_HashMap *hmap, SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
-		  SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
-  hmap->buckets = SCEDA_DFLT_SIZE;
+#define nth_slot(table, i) (&((*table)[i]))
+
+#define next_bucket(i, buckets) (((i) + 1) & ((buckets) - 1))
+
+// small maps use their inline array as table (see SCEDA_HASHMAP_SMALL_SIZE)
+#define is_small(hmap) ((hmap)->buckets == SCEDA_HASHMAP_SMALL_SIZE)
+#define map_buckets(capacity) (((capacity) <= SCEDA_HASHMAP_SMALL_SIZE) ? SCEDA_HASHMAP_SMALL_SIZE : hash_buckets(capacity))
+
+// ordered maps (see hashset.c)
+#define is_ordered(hmap) ((hmap)->layout == SCEDA_HASH_ORDERED)
+#define ordered_capacity(buckets) (3 * (buckets) / 4)
+#define index_psl(hash, i, buckets, shift) ((int)(((i) - hash_index(hash, shift)) & ((buckets) - 1)) + 1)
+
+// swiss maps (see hashset.c)
+#define is_swiss(hmap) ((hmap)->layout == SCEDA_HASH_SWISS)
+#define layout_buckets(hmap, buckets) \
+  ((is_swiss(hmap) && ((buckets) != SCEDA_HASHMAP_SMALL_SIZE) && ((buckets) < SWISS_GROUP)) ? SWISS_GROUP : (buckets))
+#define next_group(g, groups) (((g) + 1) & ((groups) - 1))
+
+/* Robin Hood insertion in the index of an ordered map (see hashset.c) */
+static void SCEDA_hashmap_insert_index(SCEDA_HashIndexSlot (*index)[], int buckets, int shift,
+				       int e, unsigned int hash) {
+  SCEDA_HashIndexSlot x;
+  x.entry = e;
+  x.hash = hash;
+  int psl = 1;
+  int i = hash_index(hash, shift);
+  for(;;) {
+    SCEDA_HashIndexSlot *slot = nth_slot(index, i);
+    if(slot->entry == -1) {
+      *slot = x;
+      return;
+    }
+    int slot_psl = index_psl(slot->hash, i, buckets, shift);
+    if(slot_psl < psl) {
+      SCEDA_HashIndexSlot tmp = *slot;
+      *slot = x;
+      x = tmp;
+      psl = slot_psl;
+    }
+    psl++;
+    i = next_bucket(i, buckets);
+  }
+}
+
+/* Return the index slot of key in an ordered (not small) map, or -1. */
+static int SCEDA_hashmap_find_index(SCEDA_HashMap *hmap, const void *key, unsigned int hash) {
+  SCEDA_match_fun match = hmap->match_key;
+  SCEDA_HashIndexSlot (*index)[] = hmap->index;
+  int buckets = hmap->buckets;
+  int shift = hmap->shift;
+  int i = hash_index(hash, shift);
+  int psl = 1;
+
+  for(;;) {
+    SCEDA_HashIndexSlot *slot = nth_slot(index, i);
+    if((slot->entry == -1) || (index_psl(slot->hash, i, buckets, shift) < psl)) {
+      return -1;
+    }
+    if((slot->hash == hash) && match(SCEDA_hashmap_nth_slot(hmap, slot->entry)->key, key)) {
+      return i;
+    }
+    psl++;
+    i = next_bucket(i, buckets);
+  }
+}
+
+/* Return the index of the slot holding key in a swiss (not small) map,
+   or -1 (see hashset.c). */
+static int SCEDA_hashmap_find_swiss(SCEDA_HashMap *hmap, const void *key, unsigned int hash) {
+  SCEDA_match_fun match = hmap->match_key;
+  unsigned char h2 = swiss_h2(hash);
+  int groups = hmap->buckets >> SWISS_GROUP_SHIFT;
+  int g = hash_index(hash, hmap->shift) >> SWISS_GROUP_SHIFT;
+
+  for(;;) {
+    const unsigned char *group = &hmap->ctrl[g << SWISS_GROUP_SHIFT];
+    unsigned int m = swiss_match(group, h2);
+    while(m != 0) {
+      int i = (g << SWISS_GROUP_SHIFT) + __builtin_ctz(m);
+      SCEDA_HashMapSlot *slot = SCEDA_hashmap_nth_slot(hmap, i);
+      if((slot->hash == hash) && match(slot->key, key)) {
+	return i;
+      }
+      m &= m - 1;
+    }
+    if(swiss_match_empty(group) != 0) {
+      return -1;
+    }
+    g = next_group(g, groups);
+  }
+}
+
+/* Store a binding in the first free bucket of its probe sequence in a
+   swiss table, and return its index. */
+static int SCEDA_hashmap_insert_swiss(SCEDA_HashMapSlot (*table)[], unsigned char *ctrl, int buckets, int shift,
+				      void *key, void *value, unsigned int hash) {
+  int groups = buckets >> SWISS_GROUP_SHIFT;
+  int g = hash_index(hash, shift) >> SWISS_GROUP_SHIFT;
+  unsigned int m;
+  while((m = swiss_match_free(&ctrl[g << SWISS_GROUP_SHIFT])) == 0) {
+    g = next_group(g, groups);
+  }
+  int i = (g << SWISS_GROUP_SHIFT) + __builtin_ctz(m);
+  SCEDA_HashMapSlot *slot = nth_slot(table, i);
+  slot->key = key;
+  slot->value = value;
+  slot->hash = hash;
+  slot->psl = 1;
+  return i;
+}
+
+static void SCEDA_hashmap_init_aux(SCEDA_HashMap *hmap, SCEDA_Allocator *alloc, int layout, int capacity,
+				   SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+				   SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
+  hmap->layout = layout;
+  hmap->buckets = layout_buckets(hmap, map_buckets(capacity));
+  hmap->min_buckets = hmap->buckets;
+  hmap->shift = hash_shift(hmap->buckets);
+  hmap->seed = SCEDA_hash_seed();
   hmap->size = 0;
+  hmap->shrink = TRUE;
   hmap->delete_key = delete_key;
   hmap->delete_value = delete_value;
   hmap->match_key = match_key;
   hmap->hash_key = hash_key;
+  hmap->alloc = alloc;
+  hmap->index = NULL;
+  hmap->ctrl = NULL;
+  hmap->tombstones = 0;
 
-  hmap->table = safe_calloc(hmap->buckets, sizeof(SCEDA_ListMap));
-  int i;
-  for(i = 0; i < hmap->buckets; i++) {
-    SCEDA_listmap_init(SCEDA_hashmap_nth_map(hmap, i), delete_key, delete_value, match_key);
+  if(is_small(hmap)) {
+    memset(hmap->small, 0, sizeof(hmap->small));
+    hmap->table = &hmap->small;
+    hmap->slots = SCEDA_HASHMAP_SMALL_SIZE;
+  } else if(is_ordered(hmap)) {
+    hmap->table = alloc_malloc(alloc, ordered_capacity(hmap->buckets) * sizeof(SCEDA_HashMapSlot));
+    hmap->index = alloc_malloc(alloc, hmap->buckets * sizeof(SCEDA_HashIndexSlot));
+    memset(hmap->index, -1, hmap->buckets * sizeof(SCEDA_HashIndexSlot));
+    hmap->slots = 0;
+  } else {
+    hmap->table = alloc_calloc(alloc, hmap->buckets, sizeof(SCEDA_HashMapSlot));
+    hmap->slots = hmap->buckets;
+    if(is_swiss(hmap)) {
+      hmap->ctrl = alloc_malloc(alloc, hmap->buckets);
+      memset(hmap->ctrl, SWISS_EMPTY, hmap->buckets);
+    }
   }
 }
 
+void SCEDA_hashmap_init_with_capacity(SCEDA_HashMap *hmap, int capacity,
+				      SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+				      SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
+  SCEDA_hashmap_init_aux(hmap, SCEDA_allocator_get_default(), SCEDA_HASH_OPEN, capacity, delete_key, delete_value, match_key, hash_key);
+}
+
+void SCEDA_hashmap_init_with_allocator(SCEDA_HashMap *hmap, SCEDA_Allocator *alloc,
+				       SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+				       SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
+  SCEDA_hashmap_init_aux(hmap, alloc, SCEDA_HASH_OPEN, 0, delete_key, delete_value, match_key, hash_key);
+}
+
+void SCEDA_hashmap_init(SCEDA_HashMap *hmap, SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+		  SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
+  SCEDA_hashmap_init_with_capacity(hmap, 0, delete_key, delete_value, match_key, hash_key);
+}
+
 SCEDA_HashMap *SCEDA_hashmap_create(SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
 			SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
-  SCEDA_HashMap *hmap = (SCEDA_HashMap *)safe_malloc(sizeof(SCEDA_HashMap));
-  SCEDA_hashmap_init(hmap, delete_key, delete_value, match_key, hash_key);
+  return SCEDA_hashmap_create_with_capacity(0, delete_key, delete_value, match_key, hash_key);
+}
+
+SCEDA_HashMap *SCEDA_hashmap_create_with_capacity(int capacity,
+						  SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+						  SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
+  SCEDA_Allocator *alloc = SCEDA_allocator_get_default();
+  SCEDA_HashMap *hmap = (SCEDA_HashMap *)alloc_malloc(alloc, sizeof(SCEDA_HashMap));
+  SCEDA_hashmap_init_aux(hmap, alloc, SCEDA_HASH_OPEN, capacity, delete_key, delete_value, match_key, hash_key);
+  return hmap;
+}
+
+SCEDA_HashMap *SCEDA_hashmap_create_with_allocator(SCEDA_Allocator *alloc,
+						   SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+						   SCEDA_match_fun match_key, SCEDA_hash_fun hash_key) {
+  SCEDA_HashMap *hmap = (SCEDA_HashMap *)alloc_malloc(alloc, sizeof(SCEDA_HashMap));
+  SCEDA_hashmap_init_with_allocator(hmap, alloc, delete_key, delete_value, match_key, hash_key);
   return hmap;
 }
 
+/* Free the table (and the index) of a map */
+static void SCEDA_hashmap_free_table(SCEDA_HashMap *hmap) {
+  if(is_small(hmap) || (hmap->table == NULL)) {
+    return;
+  }
+  if(is_ordered(hmap)) {
+    alloc_free(hmap->alloc, hmap->table, ordered_capacity(hmap->buckets) * sizeof(SCEDA_HashMapSlot));
+    alloc_free(hmap->alloc, hmap->index, hmap->buckets * sizeof(SCEDA_HashIndexSlot));
+  } else {
+    alloc_free(hmap->alloc, hmap->table, hmap->buckets * sizeof(SCEDA_HashMapSlot));
+    if(is_swiss(hmap)) {
+      alloc_free(hmap->alloc, hmap->ctrl, hmap->buckets);
+    }
+  }
+}
+
 void SCEDA_hashmap_cleanup(SCEDA_HashMap *hmap) {
-  int i;
-  for(i = 0; i < hmap->buckets; i++) {
-    SCEDA_listmap_cleanup(SCEDA_hashmap_nth_map(hmap, i));
+  if((hmap->delete_key != NULL) || (hmap->delete_value != NULL)) {
+    int i;
+    for(i = 0; i < hmap->slots; i++) {
+      SCEDA_HashMapSlot *slot = SCEDA_hashmap_nth_slot(hmap, i);
+      if(slot->psl == 0) {
+	continue;
+      }
+      if(hmap->delete_key != NULL) {
+	hmap->delete_key(slot->key);
+      }
+      if(hmap->delete_value != NULL) {
+	hmap->delete_value(slot->value);
+      }
+    }
   }
-  free(hmap->table);
+  SCEDA_hashmap_free_table(hmap);
 
+  // keep the allocator, so that the map can still be cleaned up or deleted
+  SCEDA_Allocator *alloc = hmap->alloc;
   memset(hmap, 0, sizeof(SCEDA_HashMap));
+  hmap->alloc = alloc;
 }
 
 void SCEDA_hashmap_delete(SCEDA_HashMap *hmap) {
+  SCEDA_Allocator *alloc = hmap->alloc;
   SCEDA_hashmap_cleanup(hmap);
-  free(hmap);
+  alloc_free(alloc, hmap, sizeof(SCEDA_HashMap));
 }
 
-void SCEDA_hashmap_clear(SCEDA_HashMap *hmap) {
+/* Clear a map and give it the given layout */
+static void SCEDA_hashmap_reset(SCEDA_HashMap *hmap, int layout) {
   SCEDA_delete_fun delete_key = hmap->delete_key;
   SCEDA_delete_fun delete_value = hmap->delete_value;
   SCEDA_match_fun match_key = hmap->match_key;
   SCEDA_hash_fun hash_key = hmap->hash_key;
+  int capacity = 3 * hmap->min_buckets / 4;
+  int shrink = hmap->shrink;
+  SCEDA_Allocator *alloc = hmap->alloc;
   SCEDA_hashmap_cleanup(hmap);
-  SCEDA_hashmap_init(hmap, delete_key, delete_value, match_key, hash_key);
+  SCEDA_hashmap_init_aux(hmap, alloc, layout, capacity, delete_key, delete_value, match_key, hash_key);
+  hmap->shrink = shrink;
+}
+
+void SCEDA_hashmap_clear(SCEDA_HashMap *hmap) {
+  SCEDA_hashmap_reset(hmap, hmap->layout);
+}
+
+int SCEDA_hashmap_set_layout(SCEDA_HashMap *hmap, int layout) {
+  if((hmap->size != 0) || (layout < SCEDA_HASH_OPEN) || (layout > SCEDA_HASH_SWISS)) {
+    return -1;
+  }
+  if(layout != hmap->layout) {
+    SCEDA_hashmap_reset(hmap, layout);
+  }
+  return 0;
+}
+
+/* Robin Hood insertion (see hashset.c) */
+static void SCEDA_hashmap_insert_slot(SCEDA_HashMapSlot (*table)[], int buckets, int shift,
+				      void *key, void *value, unsigned int hash) {
+  SCEDA_HashMapSlot x;
+  x.key = key;
+  x.value = value;
+  x.hash = hash;
+  x.psl = 1;
+  int i = hash_index(hash, shift);
+  for(;;) {
+    SCEDA_HashMapSlot *slot = nth_slot(table, i);
+    if(slot->psl == 0) {
+      *slot = x;
+      return;
+    }
+    if(slot->psl < x.psl) {
+      SCEDA_HashMapSlot tmp = *slot;
+      *slot = x;
+      x = tmp;
+    }
+    x.psl++;
+    i = next_bucket(i, buckets);
+  }
+}
+
+/* Prefetch the home bucket of a hash code (see HASH_BATCH). */
+static void SCEDA_hashmap_prefetch(SCEDA_HashMap *hmap, unsigned int hash) {
+  if(is_small(hmap)) {
+    return;
+  }
+  int i = hash_index(hash, hmap->shift);
+  if(is_ordered(hmap)) {
+    hash_prefetch(nth_slot(hmap->index, i));
+    return;
+  }
+  if(is_swiss(hmap)) {
+    hash_prefetch(&hmap->ctrl[i & ~(SWISS_GROUP - 1)]);
+  }
+  hash_prefetch(SCEDA_hashmap_nth_slot(hmap, i));
+}
+
+/* Return the index of the slot holding key, or -1. With the ordered
+   layout, this is the position of the binding in the dense array. */
+static int SCEDA_hashmap_find_slot(SCEDA_HashMap *hmap, const void *key, unsigned int hash) {
+  SCEDA_match_fun match = hmap->match_key;
+  int buckets = hmap->buckets;
+
+  if(is_small(hmap)) {
+    int i;
+    for(i = 0; i < hmap->size; i++) {
+      SCEDA_HashMapSlot *slot = SCEDA_hashmap_nth_slot(hmap, i);
+      if((slot->hash == hash) && match(slot->key, key)) {
+	return i;
+      }
+    }
+    return -1;
+  }
+
+  if(is_ordered(hmap)) {
+    int i = SCEDA_hashmap_find_index(hmap, key, hash);
+    return (i == -1) ? -1 : nth_slot(hmap->index, i)->entry;
+  }
+
+  if(is_swiss(hmap)) {
+    return SCEDA_hashmap_find_swiss(hmap, key, hash);
+  }
+
+  int i = hash_index(hash, hmap->shift);
+  int psl = 1;
+
+  for(;;) {
+    SCEDA_HashMapSlot *slot = SCEDA_hashmap_nth_slot(hmap, i);
+    if(slot->psl < psl) {
+      return -1;
+    }
+    if((slot->hash == hash) && match(slot->key, key)) {
+      return i;
+    }
+    psl++;
+    i = next_bucket(i, buckets);
+  }
+}
+
+/* Resize (and compact) an ordered map (see hashset.c) */
+static void SCEDA_hashmap_resize_ordered(SCEDA_HashMap *hmap, int buckets) {
+  SCEDA_HashMap old = *hmap;
+  int i, j = 0;
+
+  if(buckets == SCEDA_HASHMAP_SMALL_SIZE) {
+    memset(hmap->small, 0, sizeof(hmap->small));
+    hmap->table = &hmap->small;
+    hmap->index = NULL;
+  } else {
+    hmap->table = alloc_malloc(hmap->alloc, ordered_capacity(buckets) * sizeof(SCEDA_HashMapSlot));
+    hmap->index = alloc_malloc(hmap->alloc, buckets * sizeof(SCEDA_HashIndexSlot));
+    memset(hmap->index, -1, buckets * sizeof(SCEDA_HashIndexSlot));
+    hmap->shift = hash_shift(buckets);
+  }
+  hmap->buckets = buckets;
+
+  for(i = 0; i < old.slots; i++) {
+    SCEDA_HashMapSlot *slot = nth_slot(old.table, i);
+    if(slot->psl != 0) {
+      *nth_slot(hmap->table, j) = *slot;
+      if(!is_small(hmap)) {
+	SCEDA_hashmap_insert_index(hmap->index, buckets, hmap->shift, j, slot->hash);
+      }
+      j++;
+    }
+  }
+  hmap->slots = is_small(hmap) ? SCEDA_HASHMAP_SMALL_SIZE : j;
+
+  SCEDA_hashmap_free_table(&old);
 }
 
-#define nth_map(table, i) (&((*table)[i]))
+/* Resize a swiss map, reclaiming deleted buckets (see hashset.c) */
+static void SCEDA_hashmap_resize_swiss(SCEDA_HashMap *hmap, int buckets) {
+  SCEDA_HashMap old = *hmap;
+  int i, j = 0;
 
+  if(buckets == SCEDA_HASHMAP_SMALL_SIZE) {
+    memset(hmap->small, 0, sizeof(hmap->small));
+    hmap->table = &hmap->small;
+    hmap->ctrl = NULL;
+  } else {
+    hmap->table = alloc_calloc(hmap->alloc, buckets, sizeof(SCEDA_HashMapSlot));
+    hmap->ctrl = alloc_malloc(hmap->alloc, buckets);
+    memset(hmap->ctrl, SWISS_EMPTY, buckets);
+    hmap->shift = hash_shift(buckets);
+  }
+  hmap->buckets = buckets;
+  hmap->slots = buckets;
+  hmap->tombstones = 0;
+
+  for(i = 0; i < old.slots; i++) {
+    SCEDA_HashMapSlot *slot = nth_slot(old.table, i);
+    if(slot->psl != 0) {
+      if(is_small(hmap)) {
+	hmap->small[j++] = *slot;
+      } else {
+	int k = SCEDA_hashmap_insert_swiss(hmap->table, hmap->ctrl, buckets, hmap->shift, slot->key, slot->value, slot->hash);
+	hmap->ctrl[k] = swiss_h2(slot->hash);
+      }
+    }
+  }
+
+  SCEDA_hashmap_free_table(&old);
+}
+
+/* Resize the table (see hashset.c) */
 static void SCEDA_hashmap_resize(SCEDA_HashMap *hmap, int buckets) {
-  if((buckets <= 1) || (buckets == hmap->buckets)) {
+  if(is_ordered(hmap)) {
+    SCEDA_hashmap_resize_ordered(hmap, buckets);
     return;
   }
 
-  SCEDA_ListMap (*new_table)[] = safe_calloc(buckets, sizeof(SCEDA_ListMap));
-  int i;
-  for(i = 0; i < buckets; i++) {
-    SCEDA_listmap_init(nth_map(new_table, i), hmap->delete_key,
-		 hmap->delete_value, hmap->match_key);
+  if(is_swiss(hmap)) {
+    SCEDA_hashmap_resize_swiss(hmap, buckets);
+    return;
   }
 
-  for(i = 0; i < hmap->buckets; i++) {
-    SCEDA_ListMap *map = SCEDA_hashmap_nth_map(hmap, i);
-    while(SCEDA_listmap_size(map) > 0) {
-      void *key;
-      void *value;
-      SCEDA_listmap_remove_head(map, &key, &value);
-      int j = new_hash_code(hmap, key, buckets);
-      SCEDA_listmap_add_tail(nth_map(new_table, j), key, value);
+  if(buckets == hmap->buckets) {
+    return;
+  }
+
+  SCEDA_HashMapSlot (*old_table)[] = hmap->table;
+  int old_buckets = hmap->buckets;
+  int i;
+
+  if(buckets == SCEDA_HASHMAP_SMALL_SIZE) {
+    int j = 0;
+    memset(hmap->small, 0, sizeof(hmap->small));
+    for(i = 0; i < old_buckets; i++) {
+      SCEDA_HashMapSlot *slot = nth_slot(old_table, i);
+      if(slot->psl != 0) {
+	hmap->small[j] = *slot;
+	hmap->small[j].psl = 1;
+	j++;
+      }
     }
-    SCEDA_listmap_cleanup(map);
+    hmap->table = &hmap->small;
+  } else {
+    SCEDA_HashMapSlot (*new_table)[] = alloc_calloc(hmap->alloc, buckets, sizeof(SCEDA_HashMapSlot));
+    int shift = hash_shift(buckets);
+
+    // cached hash codes: the hash function is not called again
+    for(i = 0; i < old_buckets; i++) {
+      SCEDA_HashMapSlot *slot = nth_slot(old_table, i);
+      if(slot->psl != 0) {
+	SCEDA_hashmap_insert_slot(new_table, buckets, shift, slot->key, slot->value, slot->hash);
+      }
+    }
+
+    hmap->table = new_table;
+    hmap->shift = shift;
   }
 
-  free(hmap->table);
-  hmap->table = new_table;
   hmap->buckets = buckets;
+  hmap->slots = buckets;
+  if(old_buckets != SCEDA_HASHMAP_SMALL_SIZE) {
+    alloc_free(hmap->alloc, old_table, old_buckets * sizeof(SCEDA_HashMapSlot));
+  }
+}
+
+void SCEDA_hashmap_reserve(SCEDA_HashMap *hmap, int capacity) {
+  int buckets = layout_buckets(hmap, map_buckets(capacity));
+  if(buckets > hmap->min_buckets) {
+    hmap->min_buckets = buckets;
+  }
+  if(buckets > hmap->buckets) {
+    SCEDA_hashmap_resize(hmap, buckets);
+  }
+}
+
+void SCEDA_hashmap_set_shrink(SCEDA_HashMap *hmap, int shrink) {
+  hmap->shrink = shrink;
 }
 
 int SCEDA_hashmap_put(SCEDA_HashMap *hmap, const void *key,
 		const void *value, void **old_value) {
-  int i = hash_code(hmap, key);
+  unsigned int hash = seeded_hash(hmap, key);
+  int i = SCEDA_hashmap_find_slot(hmap, key, hash);
+  if(i != -1) {
+    SCEDA_HashMapSlot *slot = SCEDA_hashmap_nth_slot(hmap, i);
+    if(old_value != NULL) {
+      *old_value = slot->value;
+    }
+    slot->value = (void *)value;
+    return 1;
+  }
 
-  int res = SCEDA_listmap_put(SCEDA_hashmap_nth_map(hmap, i), key, value, old_value);
+  if(is_small(hmap)) {
+    if(hmap->size < SCEDA_HASHMAP_SMALL_SIZE) {
+      SCEDA_HashMapSlot *slot = SCEDA_hashmap_nth_slot(hmap, hmap->size);
+      slot->key = (void *)key;
+      slot->value = (void *)value;
+      slot->hash = hash;
+      slot->psl = 1;
+      hmap->size++;
+      return 0;
+    }
+    SCEDA_hashmap_resize(hmap, layout_buckets(hmap, hash_buckets(hmap->size + 1)));
+  }
 
-  if(res == 0) {
+  if(is_ordered(hmap)) {
+    // the dense array is full: compact it (and grow the index if needed)
+    if(hmap->slots == ordered_capacity(hmap->buckets)) {
+      int buckets = hmap->buckets;
+      SCEDA_hashmap_resize(hmap, (4 * (hmap->size + 1) > 3 * buckets) ? 2 * buckets : buckets);
+    }
+    int e = hmap->slots++;
+    SCEDA_HashMapSlot *slot = SCEDA_hashmap_nth_slot(hmap, e);
+    slot->key = (void *)key;
+    slot->value = (void *)value;
+    slot->hash = hash;
+    slot->psl = 1;
     hmap->size++;
-    if(hmap->size > hmap->buckets) {
-      SCEDA_hashmap_resize(hmap, 1 + 2 * hmap->buckets);
+    SCEDA_hashmap_insert_index(hmap->index, hmap->buckets, hmap->shift, e, hash);
+    return 0;
+  }
+
+  if(is_swiss(hmap)) {
+    // deleted buckets count as used (see hashset.c)
+    if(4 * (hmap->size + hmap->tombstones + 1) > 3 * hmap->buckets) {
+      int buckets = hmap->buckets;
+      SCEDA_hashmap_resize(hmap, (8 * (hmap->size + 1) > 3 * buckets) ? 2 * buckets : buckets);
+    }
+    int i = SCEDA_hashmap_insert_swiss(hmap->table, hmap->ctrl, hmap->buckets, hmap->shift, (void *)key, (void *)value, hash);
+    if(hmap->ctrl[i] == SWISS_DELETED) {
+      hmap->tombstones--;
     }
+    hmap->ctrl[i] = swiss_h2(hash);
+    hmap->size++;
+    return 0;
+  }
+
+  hmap->size++;
+  if(4 * hmap->size > 3 * hmap->buckets) {
+    SCEDA_hashmap_resize(hmap, 2 * hmap->buckets);
   }
 
-  return res;
+  SCEDA_hashmap_insert_slot(hmap->table, hmap->buckets, hmap->shift, (void *)key, (void *)value, hash);
+
+  return 0;
+}
+
+/* Remove the binding at position e of the dense array of an ordered
+   map, whose index slot is i. */
+static void SCEDA_hashmap_remove_ordered(SCEDA_HashMap *hmap, int i, int e) {
+  SCEDA_HashMapSlot (*table)[] = hmap->table;
+  SCEDA_HashIndexSlot (*index)[] = hmap->index;
+  int buckets = hmap->buckets;
+  int shift = hmap->shift;
+
+  nth_slot(table, e)->psl = 0;
+  while((hmap->slots > 0) && (nth_slot(table, hmap->slots - 1)->psl == 0)) {
+    hmap->slots--;
+  }
+
+  // backward shift deletion in the index
+  int j = next_bucket(i, buckets);
+  while((nth_slot(index, j)->entry != -1) && (index_psl(nth_slot(index, j)->hash, j, buckets, shift) > 1)) {
+    *nth_slot(index, i) = *nth_slot(index, j);
+    i = j;
+    j = next_bucket(j, buckets);
+  }
+  nth_slot(index, i)->entry = -1;
 }
 
 int SCEDA_hashmap_remove(SCEDA_HashMap *hmap, void **key, void **value) {
-  int i = hash_code(hmap, *key);
+  unsigned int hash = seeded_hash(hmap, *key);
+  int i;
 
-  int res = SCEDA_listmap_remove(SCEDA_hashmap_nth_map(hmap, i), key, value);
+  if(is_ordered(hmap) && !is_small(hmap)) {
+    i = SCEDA_hashmap_find_index(hmap, *key, hash);
+    if(i == -1) {
+      return 1;
+    }
+    int e = nth_slot(hmap->index, i)->entry;
+    SCEDA_HashMapSlot *slot = SCEDA_hashmap_nth_slot(hmap, e);
+    *key = slot->key;
+    *value = slot->value;
+    SCEDA_hashmap_remove_ordered(hmap, i, e);
 
-  if(res == 0) {
     hmap->size--;
-    if(4 * hmap->size < hmap->buckets) {
-      SCEDA_hashmap_resize(hmap, 1 + hmap->buckets / 2);
+    if(hmap->shrink && (4 * hmap->size < hmap->buckets) && (hmap->buckets > hmap->min_buckets)) {
+      int buckets = hmap->buckets / 2;
+      SCEDA_hashmap_resize(hmap, (buckets < HASH_MIN_BUCKETS) ? SCEDA_HASHMAP_SMALL_SIZE : buckets);
+    } else if(2 * hmap->size < hmap->slots) {
+      SCEDA_hashmap_resize(hmap, hmap->buckets);
     }
+    return 0;
+  }
+
+  i = SCEDA_hashmap_find_slot(hmap, *key, hash);
+  if(i == -1) {
+    return 1;
   }
 
-  return res;
+  SCEDA_HashMapSlot *slot = SCEDA_hashmap_nth_slot(hmap, i);
+  *key = slot->key;
+  *value = slot->value;
+
+  if(is_small(hmap)) {
+    hmap->size--;
+    if(is_ordered(hmap)) {
+      memmove(slot, SCEDA_hashmap_nth_slot(hmap, i + 1), (hmap->size - i) * sizeof(SCEDA_HashMapSlot));
+    } else {
+      // the last binding takes the place of the removed one
+      *slot = *SCEDA_hashmap_nth_slot(hmap, hmap->size);
+    }
+    SCEDA_hashmap_nth_slot(hmap, hmap->size)->psl = 0;
+    return 0;
+  }
+
+  if(is_swiss(hmap)) {
+    slot->psl = 0;
+    if(swiss_match_empty(&hmap->ctrl[i & ~(SWISS_GROUP - 1)]) != 0) {
+      hmap->ctrl[i] = SWISS_EMPTY;
+    } else {
+      hmap->ctrl[i] = SWISS_DELETED;
+      hmap->tombstones++;
+    }
+
+    hmap->size--;
+    if(hmap->shrink && (4 * hmap->size < hmap->buckets) && (hmap->buckets > hmap->min_buckets)) {
+      int buckets = hmap->buckets / 2;
+      SCEDA_hashmap_resize(hmap, (buckets < SWISS_GROUP) ? SCEDA_HASHMAP_SMALL_SIZE : buckets);
+    }
+    return 0;
+  }
+
+  // backward shift deletion
+  int buckets = hmap->buckets;
+  int j = next_bucket(i, buckets);
+  while(SCEDA_hashmap_nth_slot(hmap, j)->psl > 1) {
+    slot = SCEDA_hashmap_nth_slot(hmap, i);
+    *slot = *SCEDA_hashmap_nth_slot(hmap, j);
+    slot->psl--;
+    i = j;
+    j = next_bucket(j, buckets);
+  }
+  SCEDA_hashmap_nth_slot(hmap, i)->psl = 0;
+
+  hmap->size--;
+  if(hmap->shrink && (4 * hmap->size < hmap->buckets) && (hmap->buckets > hmap->min_buckets)) {
+    buckets = hmap->buckets / 2;
+    SCEDA_hashmap_resize(hmap, (buckets < HASH_MIN_BUCKETS) ? SCEDA_HASHMAP_SMALL_SIZE : buckets);
+  }
+
+  return 0;
 }
 
 int SCEDA_hashmap_contains_key(SCEDA_HashMap *hmap, const void *key) {
-  int i = hash_code(hmap, key);
-
-  return SCEDA_listmap_contains_key(SCEDA_hashmap_nth_map(hmap, i), key);
+  return (SCEDA_hashmap_find_slot(hmap, key, seeded_hash(hmap, key)) != -1);
 }
 
 void *SCEDA_hashmap_get(SCEDA_HashMap *hmap, const void *key) {
-  int i = hash_code(hmap, key);
+  int i = SCEDA_hashmap_find_slot(hmap, key, seeded_hash(hmap, key));
+  if(i == -1) {
+    return NULL;
+  }
+
+  return SCEDA_hashmap_nth_slot(hmap, i)->value;
+}
 
-  return SCEDA_listmap_get(SCEDA_hashmap_nth_map(hmap, i), key);
+int SCEDA_hashmap_get_many(SCEDA_HashMap *hmap, void *const *keys, int n, void **values) {
+  unsigned int hashes[HASH_BATCH];
+  int found = 0;
+  int k;
+  for(k = 0; k < n; k += HASH_BATCH) {
+    int m = (n - k < HASH_BATCH) ? (n - k) : HASH_BATCH;
+    int j;
+    for(j = 0; j < m; j++) {
+      hashes[j] = seeded_hash(hmap, keys[k + j]);
+      SCEDA_hashmap_prefetch(hmap, hashes[j]);
+    }
+    for(j = 0; j < m; j++) {
+      int i = SCEDA_hashmap_find_slot(hmap, keys[k + j], hashes[j]);
+      if(i == -1) {
+	values[k + j] = NULL;
+      } else {
+	values[k + j] = SCEDA_hashmap_nth_slot(hmap, i)->value;
+	found++;
+      }
+    }
+  }
+
+  return found;
 }
 
 int SCEDA_hashmap_lookup(SCEDA_HashMap *hmap, void **key, void **value) {
-  int i = hash_code(hmap, *key);
+  int i = SCEDA_hashmap_find_slot(hmap, *key, seeded_hash(hmap, *key));
+  if(i == -1) {
+    return -1;
+  }
 
-  return SCEDA_listmap_lookup(SCEDA_hashmap_nth_map(hmap, i), key, value);
+  SCEDA_HashMapSlot *slot = SCEDA_hashmap_nth_slot(hmap, i);
+  *key = slot->key;
+  *value = slot->value;
+  return 0;
 }
@@ -20,23 +20,58 @@
 #ifndef __SCEDA_HASHMAP_H
 #define __SCEDA_HASHMAP_H
 /** \file hashmap.h
-    \brief HashMap implementation */
+    \brief HashMap implementation (open addressing, Robin Hood probing) */
 
 #include "common.h"
-#include "listmap.h"
 #include <string.h>
 
+/** Slot of the open addressing table.
+
+    Keys and values are stored inline, along with the cached (seeded)
+    hash code of the key. psl is the probe sequence length of the slot
+    plus one, 0 meaning that the slot is free. */
+typedef struct {
+  void *key;
+  void *value;
+  unsigned int hash;
+  int psl;
+} SCEDA_HashMapSlot;
+
+/** Number of bindings stored inline in the map itself. Up to this
+    size, bindings are kept in an array and searched linearly: no
+    table is allocated. */
+#define SCEDA_HASHMAP_SMALL_SIZE 4
+
+/** Hash map.
+
+    Bindings are laid out as the elements of hash sets (see
+    SCEDA_HashSet): table is either the open addressing table, or the
+    dense array of bindings in insertion order (indexed by index)
+    with the ordered layout. With the Swiss table layout, ctrl holds
+    the control byte of each bucket of the open addressing table.
+    Iterators scan the first slots slots of table. */
 typedef struct {
+  int layout;
   int buckets;
+  int min_buckets;
+  int shift;
+  unsigned int seed;
   int size;
+  int slots;
+  int shrink;
   SCEDA_delete_fun delete_key;
   SCEDA_delete_fun delete_value;
   SCEDA_match_fun match_key;
   SCEDA_hash_fun hash_key;
-  SCEDA_ListMap (*table)[];
+  SCEDA_Allocator *alloc;
+  SCEDA_HashMapSlot (*table)[];
+  SCEDA_HashIndexSlot (*index)[];
+  unsigned char *ctrl;
+  int tombstones;
+  SCEDA_HashMapSlot small[SCEDA_HASHMAP_SMALL_SIZE];
 } SCEDA_HashMap;
 
-#define SCEDA_hashmap_nth_map(map$, i$) (&((*((map$)->table))[i$]))
+#define SCEDA_hashmap_nth_slot(map$, i$) (&((*((map$)->table))[i$]))
 
 /** Initialise a (hash) map.
 
@@ -48,6 +83,19 @@ typedef struct {
 void SCEDA_hashmap_init(SCEDA_HashMap *map, SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
 		  SCEDA_match_fun match_key, SCEDA_hash_fun hash_key);
 
+/** Initialise a (hash) map able to hold capacity bindings without
+    being resized. The map never shrinks below this capacity.
+
+    @param[in] map = map
+    @param[in] capacity = expected number of bindings
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] match_key = equality function on keys
+    @param[in] hash_key = hash function for keys */
+void SCEDA_hashmap_init_with_capacity(SCEDA_HashMap *map, int capacity,
+				      SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+				      SCEDA_match_fun match_key, SCEDA_hash_fun hash_key);
+
 /** Create a (hash) map, ready for use.
 
     @param[in] delete_key = delete function for keys or NULL
@@ -59,6 +107,47 @@ void SCEDA_hashmap_init(SCEDA_HashMap *map, SCEDA_delete_fun delete_key, SCEDA_d
 SCEDA_HashMap *SCEDA_hashmap_create(SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
 			SCEDA_match_fun match_key, SCEDA_hash_fun hash_key);
 
+/** Create a (hash) map able to hold capacity bindings without being
+    resized. The map never shrinks below this capacity.
+
+    @param[in] capacity = expected number of bindings
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] match_key = equality function on keys
+    @param[in] hash_key = hash function for keys
+
+    @return the (hash) map */
+SCEDA_HashMap *SCEDA_hashmap_create_with_capacity(int capacity,
+						  SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+						  SCEDA_match_fun match_key, SCEDA_hash_fun hash_key);
+
+/** Initialise a (hash) map whose table is allocated by a given
+    allocator.
+
+    @param[in] map = map
+    @param[in] alloc = allocator
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] match_key = equality function on keys
+    @param[in] hash_key = hash function for keys */
+void SCEDA_hashmap_init_with_allocator(SCEDA_HashMap *map, SCEDA_Allocator *alloc,
+				       SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+				       SCEDA_match_fun match_key, SCEDA_hash_fun hash_key);
+
+/** Create a (hash) map, ready for use. The map and its table are
+    allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] match_key = equality function on keys
+    @param[in] hash_key = hash function for keys
+
+    @return the (hash) map */
+SCEDA_HashMap *SCEDA_hashmap_create_with_allocator(SCEDA_Allocator *alloc,
+						   SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+						   SCEDA_match_fun match_key, SCEDA_hash_fun hash_key);
+
 /** Clean up a (hash) map.
 
     @param[in] map = map to delete */
@@ -74,6 +163,37 @@ void SCEDA_hashmap_delete(SCEDA_HashMap *map);
     @param[in] map = map to clear */
 void SCEDA_hashmap_clear(SCEDA_HashMap *map);
 
+/** Reserve room for capacity bindings in a (hash) map, so that it is
+    not resized until it holds more bindings. The map never shrinks
+    below this capacity afterwards.
+
+    @param[in] map = map
+    @param[in] capacity = expected number of bindings */
+void SCEDA_hashmap_reserve(SCEDA_HashMap *map, int capacity);
+
+/** Set the shrink policy of a (hash) map. By default, the map shrinks
+    when it is less than a quarter full (but never below its reserved
+    capacity). Disabling shrinking avoids resizing back and forth when
+    bindings are repeatedly added and removed.
+
+    @param[in] map = map
+    @param[in] shrink = TRUE to allow shrinking, FALSE otherwise */
+void SCEDA_hashmap_set_shrink(SCEDA_HashMap *map, int shrink);
+
+/** Set the layout of an empty (hash) map. With the ordered layout,
+    bindings are stored in a dense array in insertion order, and
+    iterating is a linear scan of the bindings. With the Swiss table
+    layout, buckets are probed by groups of 16 using a control byte
+    per bucket, which speeds up unsuccessful searches (see
+    SCEDA_hashset_set_layout()).
+
+    @param[in] map = map
+    @param[in] layout = #SCEDA_HASH_OPEN (default), #SCEDA_HASH_ORDERED
+    or #SCEDA_HASH_SWISS
+
+    @return 0 in case of success, -1 if map is not empty or layout is not valid */
+int SCEDA_hashmap_set_layout(SCEDA_HashMap *map, int layout);
+
 /** Add (or replace) a binding in the map in time complexity O(1).
 
     @param[in] map = map
@@ -109,6 +229,18 @@ int SCEDA_hashmap_contains_key(SCEDA_HashMap *map, const void *key);
     @return the value bound to the key or NULL if the key was unbound */
 void *SCEDA_hashmap_get(SCEDA_HashMap *map, const void *key);
 
+/** Return the values bound to n keys. All the keys are hashed and
+    their buckets prefetched before the map is probed, so that the
+    memory accesses of independent keys overlap.
+
+    @param[in] map = map
+    @param[in] keys = array of n keys
+    @param[in] n = number of keys
+    @param[out] values = array of n values, NULL for unbound keys (filled by the function)
+
+    @return the number of bound keys */
+int SCEDA_hashmap_get_many(SCEDA_HashMap *map, void *const *keys, int n, void **values);
+
 /** Look up for a binding in a map in time complexity O(1).
 
     @param[in] map = map
@@ -140,7 +272,6 @@ int SCEDA_hashmap_lookup(SCEDA_HashMap *map, void **key, void **value);
 typedef struct {
   int i;
   SCEDA_HashMap *map;
-  SCEDA_ListMapIterator elements;
 } SCEDA_HashMapIterator;
 
 /** Initialise a (hash) map iterator.
@@ -151,9 +282,8 @@ typedef struct {
     \hideinitializer */
 #define SCEDA_hashmap_iterator_init(map$, iter$) \
   ({ SCEDA_HashMapIterator *_iter = (iter$);   \
-     _iter->i = 0;                        \
-     _iter->map = (map$);	            \
-     SCEDA_listmap_iterator_init(SCEDA_hashmap_nth_map((_iter->map),0), &(_iter->elements)); })
+     _iter->i = 0;                             \
+     _iter->map = (map$); })
 
 /** Test whether there is a next data in the map iterator.
 
@@ -162,14 +292,12 @@ typedef struct {
     @return TRUE if there is a "next" data, FALSE otherwise
 
     \hideinitializer */
-#define SCEDA_hashmap_iterator_has_next(iter$)                                                                  \
-  ({ SCEDA_HashMapIterator *_iter = (iter$);                                                                  \
-     while((_iter->i < _iter->map->buckets) && (!(SCEDA_listmap_iterator_has_next(&(_iter->elements))))) { \
-       _iter->i++;                                                                                       \
-       if(_iter->i < _iter->map->buckets)                                                              \
-         SCEDA_listmap_iterator_init(SCEDA_hashmap_nth_map((_iter->map),_iter->i), &(_iter->elements));          \
-     }                                                                                                     \
-     (_iter->i < _iter->map->buckets) && (SCEDA_listmap_iterator_has_next(&(_iter->elements))); })
+#define SCEDA_hashmap_iterator_has_next(iter$)                                                   \
+  ({ SCEDA_HashMapIterator *_iter = (iter$);                                                   \
+     while((_iter->i < _iter->map->slots) && (SCEDA_hashmap_nth_slot(_iter->map, _iter->i)->psl == 0)) { \
+       _iter->i++;                                                                             \
+     }                                                                                         \
+     (_iter->i < _iter->map->slots); })
 
 /** Return the next data of the map iterator.
 
@@ -179,17 +307,17 @@ typedef struct {
     @return the "next" data
 
     \hideinitializer */
-#define SCEDA_hashmap_iterator_next(iter$, key$) (SCEDA_listmap_iterator_next(&((iter$)->elements), key$))
+#define SCEDA_hashmap_iterator_next(iter$, key$)                                  \
+  ({ SCEDA_HashMapIterator *_iter = (iter$);                                    \
+     SCEDA_HashMapSlot *_slot = SCEDA_hashmap_nth_slot(_iter->map, _iter->i++); \
+     *key$ = _slot->key;                                                        \
+     _slot->value; })
 
 /** Clean up a (hash) map iterator.
 
     @param[in] iter = map iterator
 
     \hideinitializer */
-#define SCEDA_hashmap_iterator_cleanup(iter$)             \
-  ({ SCEDA_HashMapIterator *_iter = (iter$);            \
-     SCEDA_listmap_iterator_cleanup(&(_iter->elements)); \
-     memset(_iter, 0, sizeof(SCEDA_HashMapIterator)); })
-
+#define SCEDA_hashmap_iterator_cleanup(iter$) (memset(iter$, 0, sizeof(SCEDA_HashMapIterator)))
 
 #endif
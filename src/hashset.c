@@ -21,121 +21,786 @@
 #include "util.h"
 #include <string.h>
 
-#define new_hash_code(hset, data, buckets) (((hset)->hash(data)) % buckets)
-#define hash_code(hset, data) (new_hash_code(hset, data, (hset)->buckets))
+#define seeded_hash(hset, x) ((hset)->hash(x) ^ (hset)->seed)
 
-void SCEDA_hashset_init(SCEDA_HashSet *hset, SCEDA_delete_fun delete,
-		  SCEDA_match_fun match, SCEDA_hash_fun hash) {
-  hset->buckets = SCEDA_DFLT_SIZE;
+#define nth_slot(table, i) (&((*table)[i]))
+
+#define next_bucket(i, buckets) (((i) + 1) & ((buckets) - 1))
+
+// small sets use their inline array as table (see SCEDA_HASHSET_SMALL_SIZE)
+#define is_small(hset) ((hset)->buckets == SCEDA_HASHSET_SMALL_SIZE)
+#define set_buckets(capacity) (((capacity) <= SCEDA_HASHSET_SMALL_SIZE) ? SCEDA_HASHSET_SMALL_SIZE : hash_buckets(capacity))
+
+// ordered sets: the dense array holds as many elements as the index
+// may index before growing
+#define is_ordered(hset) ((hset)->layout == SCEDA_HASH_ORDERED)
+#define ordered_capacity(buckets) (3 * (buckets) / 4)
+#define index_psl(hash, i, buckets, shift) ((int)(((i) - hash_index(hash, shift)) & ((buckets) - 1)) + 1)
+
+// swiss sets have at least one group of buckets (see util.h)
+#define is_swiss(hset) ((hset)->layout == SCEDA_HASH_SWISS)
+#define layout_buckets(hset, buckets) \
+  ((is_swiss(hset) && ((buckets) != SCEDA_HASHSET_SMALL_SIZE) && ((buckets) < SWISS_GROUP)) ? SWISS_GROUP : (buckets))
+#define next_group(g, groups) (((g) + 1) & ((groups) - 1))
+
+unsigned int SCEDA_hash_seed() {
+  static unsigned int counter = 0;
+  // murmur3 finalizer, so that successive seeds differ in many bits
+  unsigned int h = __atomic_add_fetch(&counter, 1, __ATOMIC_RELAXED);
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+/* Robin Hood insertion of the position e of an element in the index of
+   an ordered set. Probe sequence lengths are computed from the cached
+   hash codes. */
+static void SCEDA_hashset_insert_index(SCEDA_HashIndexSlot (*index)[], int buckets, int shift,
+				       int e, unsigned int hash) {
+  SCEDA_HashIndexSlot x;
+  x.entry = e;
+  x.hash = hash;
+  int psl = 1;
+  int i = hash_index(hash, shift);
+  for(;;) {
+    SCEDA_HashIndexSlot *slot = nth_slot(index, i);
+    if(slot->entry == -1) {
+      *slot = x;
+      return;
+    }
+    int slot_psl = index_psl(slot->hash, i, buckets, shift);
+    if(slot_psl < psl) {
+      SCEDA_HashIndexSlot tmp = *slot;
+      *slot = x;
+      x = tmp;
+      psl = slot_psl;
+    }
+    psl++;
+    i = next_bucket(i, buckets);
+  }
+}
+
+/* Return the index slot of data in an ordered (not small) set, or -1. */
+static int SCEDA_hashset_find_index(SCEDA_HashSet *hset, const void *data, unsigned int hash) {
+  SCEDA_match_fun match = hset->match;
+  SCEDA_HashIndexSlot (*index)[] = hset->index;
+  int buckets = hset->buckets;
+  int shift = hset->shift;
+  int i = hash_index(hash, shift);
+  int psl = 1;
+
+  for(;;) {
+    SCEDA_HashIndexSlot *slot = nth_slot(index, i);
+    if((slot->entry == -1) || (index_psl(slot->hash, i, buckets, shift) < psl)) {
+      return -1;
+    }
+    if((slot->hash == hash) && match(SCEDA_hashset_nth_slot(hset, slot->entry)->data, data)) {
+      return i;
+    }
+    psl++;
+    i = next_bucket(i, buckets);
+  }
+}
+
+/* Return the index of the slot holding data in a swiss (not small)
+   set, or -1. Only the slots whose control byte matches are read. */
+static int SCEDA_hashset_find_swiss(SCEDA_HashSet *hset, const void *data, unsigned int hash) {
+  SCEDA_match_fun match = hset->match;
+  unsigned char h2 = swiss_h2(hash);
+  int groups = hset->buckets >> SWISS_GROUP_SHIFT;
+  int g = hash_index(hash, hset->shift) >> SWISS_GROUP_SHIFT;
+
+  for(;;) {
+    const unsigned char *group = &hset->ctrl[g << SWISS_GROUP_SHIFT];
+    unsigned int m = swiss_match(group, h2);
+    while(m != 0) {
+      int i = (g << SWISS_GROUP_SHIFT) + __builtin_ctz(m);
+      SCEDA_HashSetSlot *slot = SCEDA_hashset_nth_slot(hset, i);
+      if((slot->hash == hash) && match(slot->data, data)) {
+	return i;
+      }
+      m &= m - 1;
+    }
+    // data would have been stored in the first group with a free bucket
+    if(swiss_match_empty(group) != 0) {
+      return -1;
+    }
+    g = next_group(g, groups);
+  }
+}
+
+/* Store data in the first free (empty or deleted) bucket of its probe
+   sequence in a swiss table, and return its index. */
+static int SCEDA_hashset_insert_swiss(SCEDA_HashSetSlot (*table)[], unsigned char *ctrl, int buckets, int shift,
+				      void *data, unsigned int hash) {
+  int groups = buckets >> SWISS_GROUP_SHIFT;
+  int g = hash_index(hash, shift) >> SWISS_GROUP_SHIFT;
+  unsigned int m;
+  while((m = swiss_match_free(&ctrl[g << SWISS_GROUP_SHIFT])) == 0) {
+    g = next_group(g, groups);
+  }
+  int i = (g << SWISS_GROUP_SHIFT) + __builtin_ctz(m);
+  SCEDA_HashSetSlot *slot = nth_slot(table, i);
+  slot->data = data;
+  slot->hash = hash;
+  slot->psl = 1;
+  return i;
+}
+
+static void SCEDA_hashset_init_aux(SCEDA_HashSet *hset, SCEDA_Allocator *alloc, int layout, int capacity,
+				   SCEDA_delete_fun delete, SCEDA_match_fun match, SCEDA_hash_fun hash) {
+  hset->layout = layout;
+  hset->buckets = layout_buckets(hset, set_buckets(capacity));
+  hset->min_buckets = hset->buckets;
+  hset->shift = hash_shift(hset->buckets);
+  hset->seed = SCEDA_hash_seed();
   hset->size = 0;
+  hset->shrink = TRUE;
   hset->delete = delete;
   hset->match = match;
   hset->hash = hash;
+  hset->alloc = alloc;
+  hset->index = NULL;
+  hset->ctrl = NULL;
+  hset->tombstones = 0;
 
-  hset->table = safe_calloc(hset->buckets, sizeof(SCEDA_ListSet));
-  int i;
-  for(i = 0; i < hset->buckets; i++) {
-    SCEDA_listset_init(SCEDA_hashset_nth_set(hset, i), delete, match);
+  if(is_small(hset)) {
+    memset(hset->small, 0, sizeof(hset->small));
+    hset->table = &hset->small;
+    hset->slots = SCEDA_HASHSET_SMALL_SIZE;
+  } else if(is_ordered(hset)) {
+    hset->table = alloc_malloc(alloc, ordered_capacity(hset->buckets) * sizeof(SCEDA_HashSetSlot));
+    hset->index = alloc_malloc(alloc, hset->buckets * sizeof(SCEDA_HashIndexSlot));
+    memset(hset->index, -1, hset->buckets * sizeof(SCEDA_HashIndexSlot));
+    hset->slots = 0;
+  } else {
+    hset->table = alloc_calloc(alloc, hset->buckets, sizeof(SCEDA_HashSetSlot));
+    hset->slots = hset->buckets;
+    if(is_swiss(hset)) {
+      hset->ctrl = alloc_malloc(alloc, hset->buckets);
+      memset(hset->ctrl, SWISS_EMPTY, hset->buckets);
+    }
   }
 }
 
+void SCEDA_hashset_init_with_capacity(SCEDA_HashSet *hset, int capacity, SCEDA_delete_fun delete,
+				      SCEDA_match_fun match, SCEDA_hash_fun hash) {
+  SCEDA_hashset_init_aux(hset, SCEDA_allocator_get_default(), SCEDA_HASH_OPEN, capacity, delete, match, hash);
+}
+
+void SCEDA_hashset_init_with_allocator(SCEDA_HashSet *hset, SCEDA_Allocator *alloc, SCEDA_delete_fun delete,
+				       SCEDA_match_fun match, SCEDA_hash_fun hash) {
+  SCEDA_hashset_init_aux(hset, alloc, SCEDA_HASH_OPEN, 0, delete, match, hash);
+}
+
+void SCEDA_hashset_init(SCEDA_HashSet *hset, SCEDA_delete_fun delete,
+		  SCEDA_match_fun match, SCEDA_hash_fun hash) {
+  SCEDA_hashset_init_with_capacity(hset, 0, delete, match, hash);
+}
+
 SCEDA_HashSet *SCEDA_hashset_create(SCEDA_delete_fun delete, SCEDA_match_fun match,
 			SCEDA_hash_fun hash) {
-  SCEDA_HashSet *hset = (SCEDA_HashSet *)safe_malloc(sizeof(SCEDA_HashSet));
-  SCEDA_hashset_init(hset, delete, match, hash);
+  return SCEDA_hashset_create_with_capacity(0, delete, match, hash);
+}
+
+SCEDA_HashSet *SCEDA_hashset_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete,
+						   SCEDA_match_fun match, SCEDA_hash_fun hash) {
+  SCEDA_HashSet *hset = (SCEDA_HashSet *)alloc_malloc(alloc, sizeof(SCEDA_HashSet));
+  SCEDA_hashset_init_with_allocator(hset, alloc, delete, match, hash);
+  return hset;
+}
+
+SCEDA_HashSet *SCEDA_hashset_create_with_capacity(int capacity, SCEDA_delete_fun delete,
+						  SCEDA_match_fun match, SCEDA_hash_fun hash) {
+  SCEDA_Allocator *alloc = SCEDA_allocator_get_default();
+  SCEDA_HashSet *hset = (SCEDA_HashSet *)alloc_malloc(alloc, sizeof(SCEDA_HashSet));
+  SCEDA_hashset_init_aux(hset, alloc, SCEDA_HASH_OPEN, capacity, delete, match, hash);
   return hset;
 }
 
+/* Free the table (and the index) of a set */
+static void SCEDA_hashset_free_table(SCEDA_HashSet *hset) {
+  if(is_small(hset) || (hset->table == NULL)) {
+    return;
+  }
+  if(is_ordered(hset)) {
+    alloc_free(hset->alloc, hset->table, ordered_capacity(hset->buckets) * sizeof(SCEDA_HashSetSlot));
+    alloc_free(hset->alloc, hset->index, hset->buckets * sizeof(SCEDA_HashIndexSlot));
+  } else {
+    alloc_free(hset->alloc, hset->table, hset->buckets * sizeof(SCEDA_HashSetSlot));
+    if(is_swiss(hset)) {
+      alloc_free(hset->alloc, hset->ctrl, hset->buckets);
+    }
+  }
+}
+
 void SCEDA_hashset_cleanup(SCEDA_HashSet *hset) {
-  int i;
-  for(i = 0; i < hset->buckets; i++) {
-    SCEDA_listset_cleanup(SCEDA_hashset_nth_set(hset, i));
+  if(hset->delete != NULL) {
+    int i;
+    for(i = 0; i < hset->slots; i++) {
+      SCEDA_HashSetSlot *slot = SCEDA_hashset_nth_slot(hset, i);
+      if(slot->psl != 0) {
+	hset->delete(slot->data);
+      }
+    }
   }
-  free(hset->table);
+  SCEDA_hashset_free_table(hset);
 
+  // keep the allocator, so that the set can still be cleaned up or deleted
+  SCEDA_Allocator *alloc = hset->alloc;
   memset(hset, 0, sizeof(SCEDA_HashSet));
+  hset->alloc = alloc;
 }
 
 void SCEDA_hashset_delete(SCEDA_HashSet *hset) {
+  SCEDA_Allocator *alloc = hset->alloc;
   SCEDA_hashset_cleanup(hset);
-  free(hset);
+  alloc_free(alloc, hset, sizeof(SCEDA_HashSet));
 }
 
-void SCEDA_hashset_clear(SCEDA_HashSet *hset) {
+/* Clear a set and give it the given layout */
+static void SCEDA_hashset_reset(SCEDA_HashSet *hset, int layout) {
   SCEDA_delete_fun delete = hset->delete;
   SCEDA_match_fun match = hset->match;
   SCEDA_hash_fun hash = hset->hash;
+  int capacity = 3 * hset->min_buckets / 4;
+  int shrink = hset->shrink;
+  SCEDA_Allocator *alloc = hset->alloc;
   SCEDA_hashset_cleanup(hset);
-  SCEDA_hashset_init(hset, delete, match, hash);
+  SCEDA_hashset_init_aux(hset, alloc, layout, capacity, delete, match, hash);
+  hset->shrink = shrink;
 }
 
-#define nth_set(table, i) (&((*table)[i]))
+void SCEDA_hashset_clear(SCEDA_HashSet *hset) {
+  SCEDA_hashset_reset(hset, hset->layout);
+}
+
+int SCEDA_hashset_set_layout(SCEDA_HashSet *hset, int layout) {
+  if((hset->size != 0) || (layout < SCEDA_HASH_OPEN) || (layout > SCEDA_HASH_SWISS)) {
+    return -1;
+  }
+  if(layout != hset->layout) {
+    SCEDA_hashset_reset(hset, layout);
+  }
+  return 0;
+}
+
+/* Robin Hood insertion: the data travelling along the probe sequence
+   takes the place of any data that is closer to its home bucket. */
+static void SCEDA_hashset_insert_slot(SCEDA_HashSetSlot (*table)[], int buckets, int shift,
+				      void *data, unsigned int hash) {
+  SCEDA_HashSetSlot x;
+  x.data = data;
+  x.hash = hash;
+  x.psl = 1;
+  int i = hash_index(hash, shift);
+  for(;;) {
+    SCEDA_HashSetSlot *slot = nth_slot(table, i);
+    if(slot->psl == 0) {
+      *slot = x;
+      return;
+    }
+    if(slot->psl < x.psl) {
+      SCEDA_HashSetSlot tmp = *slot;
+      *slot = x;
+      x = tmp;
+    }
+    x.psl++;
+    i = next_bucket(i, buckets);
+  }
+}
+
+/* Prefetch the home bucket of a hash code (see HASH_BATCH). */
+static void SCEDA_hashset_prefetch(SCEDA_HashSet *hset, unsigned int hash) {
+  if(is_small(hset)) {
+    return;
+  }
+  int i = hash_index(hash, hset->shift);
+  if(is_ordered(hset)) {
+    hash_prefetch(nth_slot(hset->index, i));
+    return;
+  }
+  if(is_swiss(hset)) {
+    hash_prefetch(&hset->ctrl[i & ~(SWISS_GROUP - 1)]);
+  }
+  hash_prefetch(SCEDA_hashset_nth_slot(hset, i));
+}
+
+/* Return the index of the slot holding data, or -1. With the ordered
+   layout, this is the position of data in the dense array. */
+static int SCEDA_hashset_find_slot(SCEDA_HashSet *hset, const void *data, unsigned int hash) {
+  SCEDA_match_fun match = hset->match;
+  int buckets = hset->buckets;
 
+  if(is_small(hset)) {
+    int i;
+    for(i = 0; i < hset->size; i++) {
+      SCEDA_HashSetSlot *slot = SCEDA_hashset_nth_slot(hset, i);
+      if((slot->hash == hash) && match(slot->data, data)) {
+	return i;
+      }
+    }
+    return -1;
+  }
+
+  if(is_ordered(hset)) {
+    int i = SCEDA_hashset_find_index(hset, data, hash);
+    return (i == -1) ? -1 : nth_slot(hset->index, i)->entry;
+  }
+
+  if(is_swiss(hset)) {
+    return SCEDA_hashset_find_swiss(hset, data, hash);
+  }
+
+  int i = hash_index(hash, hset->shift);
+  int psl = 1;
+
+  for(;;) {
+    SCEDA_HashSetSlot *slot = SCEDA_hashset_nth_slot(hset, i);
+    if(slot->psl < psl) {
+      // free slot, or data would have been stored before this one
+      return -1;
+    }
+    if((slot->hash == hash) && match(slot->data, data)) {
+      return i;
+    }
+    psl++;
+    i = next_bucket(i, buckets);
+  }
+}
+
+/* Resize the index and the dense array of an ordered set. The array is
+   compacted, even if the number of buckets does not change. */
+static void SCEDA_hashset_resize_ordered(SCEDA_HashSet *hset, int buckets) {
+  SCEDA_HashSet old = *hset;
+  int i, j = 0;
+
+  if(buckets == SCEDA_HASHSET_SMALL_SIZE) {
+    memset(hset->small, 0, sizeof(hset->small));
+    hset->table = &hset->small;
+    hset->index = NULL;
+  } else {
+    hset->table = alloc_malloc(hset->alloc, ordered_capacity(buckets) * sizeof(SCEDA_HashSetSlot));
+    hset->index = alloc_malloc(hset->alloc, buckets * sizeof(SCEDA_HashIndexSlot));
+    memset(hset->index, -1, buckets * sizeof(SCEDA_HashIndexSlot));
+    hset->shift = hash_shift(buckets);
+  }
+  hset->buckets = buckets;
+
+  // the order of the elements is kept
+  for(i = 0; i < old.slots; i++) {
+    SCEDA_HashSetSlot *slot = nth_slot(old.table, i);
+    if(slot->psl != 0) {
+      *nth_slot(hset->table, j) = *slot;
+      if(!is_small(hset)) {
+	SCEDA_hashset_insert_index(hset->index, buckets, hset->shift, j, slot->hash);
+      }
+      j++;
+    }
+  }
+  hset->slots = is_small(hset) ? SCEDA_HASHSET_SMALL_SIZE : j;
+
+  SCEDA_hashset_free_table(&old);
+}
+
+/* Resize a swiss set. Deleted buckets are reclaimed, even if the
+   number of buckets does not change. */
+static void SCEDA_hashset_resize_swiss(SCEDA_HashSet *hset, int buckets) {
+  SCEDA_HashSet old = *hset;
+  int i, j = 0;
+
+  if(buckets == SCEDA_HASHSET_SMALL_SIZE) {
+    memset(hset->small, 0, sizeof(hset->small));
+    hset->table = &hset->small;
+    hset->ctrl = NULL;
+  } else {
+    hset->table = alloc_calloc(hset->alloc, buckets, sizeof(SCEDA_HashSetSlot));
+    hset->ctrl = alloc_malloc(hset->alloc, buckets);
+    memset(hset->ctrl, SWISS_EMPTY, buckets);
+    hset->shift = hash_shift(buckets);
+  }
+  hset->buckets = buckets;
+  hset->slots = buckets;
+  hset->tombstones = 0;
+
+  for(i = 0; i < old.slots; i++) {
+    SCEDA_HashSetSlot *slot = nth_slot(old.table, i);
+    if(slot->psl != 0) {
+      if(is_small(hset)) {
+	hset->small[j++] = *slot;
+      } else {
+	int k = SCEDA_hashset_insert_swiss(hset->table, hset->ctrl, buckets, hset->shift, slot->data, slot->hash);
+	hset->ctrl[k] = swiss_h2(slot->hash);
+      }
+    }
+  }
+
+  SCEDA_hashset_free_table(&old);
+}
+
+/* Resize the table. buckets is either SCEDA_HASHSET_SMALL_SIZE (back
+   to the inline array) or a power of two >= HASH_MIN_BUCKETS. */
 static void SCEDA_hashset_resize(SCEDA_HashSet *hset, int buckets) {
-  if((buckets <= 1) || (buckets == hset->buckets)) {
+  if(is_ordered(hset)) {
+    SCEDA_hashset_resize_ordered(hset, buckets);
     return;
   }
 
-  SCEDA_ListSet (*new_table)[] = safe_calloc(buckets, sizeof(SCEDA_ListSet));
-  int i;
-  for(i = 0; i < buckets; i++) {
-    SCEDA_listset_init(nth_set(new_table, i), hset->delete, hset->match);
+  if(is_swiss(hset)) {
+    SCEDA_hashset_resize_swiss(hset, buckets);
+    return;
+  }
+
+  if(buckets == hset->buckets) {
+    return;
   }
 
-  for(i = 0; i < hset->buckets; i++) {
-    SCEDA_ListSet *set = SCEDA_hashset_nth_set(hset, i);
-    while(SCEDA_listset_size(set) > 0) {
-      void *data;
-      SCEDA_listset_remove_head(set, &data);
-      int j = new_hash_code(hset, data, buckets);
-      SCEDA_listset_add_tail(nth_set(new_table, j), data);
+  SCEDA_HashSetSlot (*old_table)[] = hset->table;
+  int old_buckets = hset->buckets;
+  int i;
+
+  if(buckets == SCEDA_HASHSET_SMALL_SIZE) {
+    int j = 0;
+    memset(hset->small, 0, sizeof(hset->small));
+    for(i = 0; i < old_buckets; i++) {
+      SCEDA_HashSetSlot *slot = nth_slot(old_table, i);
+      if(slot->psl != 0) {
+	hset->small[j] = *slot;
+	hset->small[j].psl = 1;
+	j++;
+      }
+    }
+    hset->table = &hset->small;
+  } else {
+    SCEDA_HashSetSlot (*new_table)[] = alloc_calloc(hset->alloc, buckets, sizeof(SCEDA_HashSetSlot));
+    int shift = hash_shift(buckets);
+
+    // cached hash codes: the hash function is not called again
+    for(i = 0; i < old_buckets; i++) {
+      SCEDA_HashSetSlot *slot = nth_slot(old_table, i);
+      if(slot->psl != 0) {
+	SCEDA_hashset_insert_slot(new_table, buckets, shift, slot->data, slot->hash);
+      }
     }
-    SCEDA_listset_cleanup(set);
+
+    hset->table = new_table;
+    hset->shift = shift;
   }
 
-  free(hset->table);
-  hset->table = new_table;
   hset->buckets = buckets;
+  hset->slots = buckets;
+  if(old_buckets != SCEDA_HASHSET_SMALL_SIZE) {
+    alloc_free(hset->alloc, old_table, old_buckets * sizeof(SCEDA_HashSetSlot));
+  }
 }
 
-int SCEDA_hashset_add(SCEDA_HashSet *hset, const void *data) {
-  int i = hash_code(hset, data);
+void SCEDA_hashset_reserve(SCEDA_HashSet *hset, int capacity) {
+  int buckets = layout_buckets(hset, set_buckets(capacity));
+  if(buckets > hset->min_buckets) {
+    hset->min_buckets = buckets;
+  }
+  if(buckets > hset->buckets) {
+    SCEDA_hashset_resize(hset, buckets);
+  }
+}
 
-  int res = SCEDA_listset_add(SCEDA_hashset_nth_set(hset, i), data);
+void SCEDA_hashset_set_shrink(SCEDA_HashSet *hset, int shrink) {
+  hset->shrink = shrink;
+}
+
+/* Add data, whose seeded hash code is hash, to the set. */
+static int SCEDA_hashset_add_hashed(SCEDA_HashSet *hset, const void *data, unsigned int hash) {
+  if(SCEDA_hashset_find_slot(hset, data, hash) != -1) {
+    return 1;
+  }
 
-  if(res == 0) {
+  if(is_small(hset)) {
+    if(hset->size < SCEDA_HASHSET_SMALL_SIZE) {
+      SCEDA_HashSetSlot *slot = SCEDA_hashset_nth_slot(hset, hset->size);
+      slot->data = (void *)data;
+      slot->hash = hash;
+      slot->psl = 1;
+      hset->size++;
+      return 0;
+    }
+    SCEDA_hashset_resize(hset, layout_buckets(hset, hash_buckets(hset->size + 1)));
+  }
+
+  if(is_ordered(hset)) {
+    // the dense array is full: compact it (and grow the index if needed)
+    if(hset->slots == ordered_capacity(hset->buckets)) {
+      int buckets = hset->buckets;
+      SCEDA_hashset_resize(hset, (4 * (hset->size + 1) > 3 * buckets) ? 2 * buckets : buckets);
+    }
+    int e = hset->slots++;
+    SCEDA_HashSetSlot *slot = SCEDA_hashset_nth_slot(hset, e);
+    slot->data = (void *)data;
+    slot->hash = hash;
+    slot->psl = 1;
     hset->size++;
-    if(hset->size > hset->buckets) {
-      SCEDA_hashset_resize(hset, 1 + 2 * hset->buckets);
+    SCEDA_hashset_insert_index(hset->index, hset->buckets, hset->shift, e, hash);
+    return 0;
+  }
+
+  if(is_swiss(hset)) {
+    // deleted buckets count as used, so that probing always ends on
+    // an empty bucket: a table full of them is rebuilt at same size
+    if(4 * (hset->size + hset->tombstones + 1) > 3 * hset->buckets) {
+      int buckets = hset->buckets;
+      SCEDA_hashset_resize(hset, (8 * (hset->size + 1) > 3 * buckets) ? 2 * buckets : buckets);
     }
+    int i = SCEDA_hashset_insert_swiss(hset->table, hset->ctrl, hset->buckets, hset->shift, (void *)data, hash);
+    if(hset->ctrl[i] == SWISS_DELETED) {
+      hset->tombstones--;
+    }
+    hset->ctrl[i] = swiss_h2(hash);
+    hset->size++;
+    return 0;
   }
 
-  return res;
+  hset->size++;
+  if(4 * hset->size > 3 * hset->buckets) {
+    SCEDA_hashset_resize(hset, 2 * hset->buckets);
+  }
+
+  SCEDA_hashset_insert_slot(hset->table, hset->buckets, hset->shift, (void *)data, hash);
+
+  return 0;
+}
+
+int SCEDA_hashset_add(SCEDA_HashSet *hset, const void *data) {
+  return SCEDA_hashset_add_hashed(hset, data, seeded_hash(hset, data));
+}
+
+int SCEDA_hashset_add_many(SCEDA_HashSet *hset, void *const *data, int n) {
+  unsigned int hashes[HASH_BATCH];
+  int added = 0;
+  int k;
+  for(k = 0; k < n; k += HASH_BATCH) {
+    int m = (n - k < HASH_BATCH) ? (n - k) : HASH_BATCH;
+    int j;
+    for(j = 0; j < m; j++) {
+      hashes[j] = seeded_hash(hset, data[k + j]);
+      SCEDA_hashset_prefetch(hset, hashes[j]);
+    }
+    for(j = 0; j < m; j++) {
+      if(SCEDA_hashset_add_hashed(hset, data[k + j], hashes[j]) == 0) {
+	added++;
+      }
+    }
+  }
+
+  return added;
+}
+
+/* Remove the element at position e of the dense array of an ordered
+   set, whose index slot is i. */
+static void SCEDA_hashset_remove_ordered(SCEDA_HashSet *hset, int i, int e) {
+  SCEDA_HashSetSlot (*table)[] = hset->table;
+  SCEDA_HashIndexSlot (*index)[] = hset->index;
+  int buckets = hset->buckets;
+  int shift = hset->shift;
+
+  nth_slot(table, e)->psl = 0;
+  while((hset->slots > 0) && (nth_slot(table, hset->slots - 1)->psl == 0)) {
+    hset->slots--;
+  }
+
+  // backward shift deletion in the index
+  int j = next_bucket(i, buckets);
+  while((nth_slot(index, j)->entry != -1) && (index_psl(nth_slot(index, j)->hash, j, buckets, shift) > 1)) {
+    *nth_slot(index, i) = *nth_slot(index, j);
+    i = j;
+    j = next_bucket(j, buckets);
+  }
+  nth_slot(index, i)->entry = -1;
 }
 
 int SCEDA_hashset_remove(SCEDA_HashSet *hset, void **data) {
-  int i = hash_code(hset, *data);
+  unsigned int hash = seeded_hash(hset, *data);
+  int i;
 
-  int res = SCEDA_listset_remove(SCEDA_hashset_nth_set(hset, i), data);
+  if(is_ordered(hset) && !is_small(hset)) {
+    i = SCEDA_hashset_find_index(hset, *data, hash);
+    if(i == -1) {
+      return 1;
+    }
+    int e = nth_slot(hset->index, i)->entry;
+    *data = SCEDA_hashset_nth_slot(hset, e)->data;
+    SCEDA_hashset_remove_ordered(hset, i, e);
 
-  if(res == 0) {
     hset->size--;
-    if(4 * hset->size < hset->buckets) {
-      SCEDA_hashset_resize(hset, 1 + hset->buckets / 2);
+    if(hset->shrink && (4 * hset->size < hset->buckets) && (hset->buckets > hset->min_buckets)) {
+      int buckets = hset->buckets / 2;
+      SCEDA_hashset_resize(hset, (buckets < HASH_MIN_BUCKETS) ? SCEDA_HASHSET_SMALL_SIZE : buckets);
+    } else if(2 * hset->size < hset->slots) {
+      // more holes than elements: iterators would mostly skip holes
+      SCEDA_hashset_resize(hset, hset->buckets);
     }
+    return 0;
   }
 
-  return res;
+  i = SCEDA_hashset_find_slot(hset, *data, hash);
+  if(i == -1) {
+    return 1;
+  }
+
+  *data = SCEDA_hashset_nth_slot(hset, i)->data;
+
+  if(is_small(hset)) {
+    hset->size--;
+    if(is_ordered(hset)) {
+      // the following elements are shifted to keep their order
+      memmove(SCEDA_hashset_nth_slot(hset, i), SCEDA_hashset_nth_slot(hset, i + 1), (hset->size - i) * sizeof(SCEDA_HashSetSlot));
+    } else {
+      // the last element takes the place of the removed one
+      *SCEDA_hashset_nth_slot(hset, i) = *SCEDA_hashset_nth_slot(hset, hset->size);
+    }
+    SCEDA_hashset_nth_slot(hset, hset->size)->psl = 0;
+    return 0;
+  }
+
+  if(is_swiss(hset)) {
+    // a search never goes past a group with an empty bucket: the
+    // bucket may be emptied if its group has one
+    SCEDA_hashset_nth_slot(hset, i)->psl = 0;
+    if(swiss_match_empty(&hset->ctrl[i & ~(SWISS_GROUP - 1)]) != 0) {
+      hset->ctrl[i] = SWISS_EMPTY;
+    } else {
+      hset->ctrl[i] = SWISS_DELETED;
+      hset->tombstones++;
+    }
+
+    hset->size--;
+    if(hset->shrink && (4 * hset->size < hset->buckets) && (hset->buckets > hset->min_buckets)) {
+      int buckets = hset->buckets / 2;
+      SCEDA_hashset_resize(hset, (buckets < SWISS_GROUP) ? SCEDA_HASHSET_SMALL_SIZE : buckets);
+    }
+    return 0;
+  }
+
+  // backward shift deletion: no tombstone is needed
+  int buckets = hset->buckets;
+  int j = next_bucket(i, buckets);
+  while(SCEDA_hashset_nth_slot(hset, j)->psl > 1) {
+    SCEDA_HashSetSlot *slot = SCEDA_hashset_nth_slot(hset, i);
+    *slot = *SCEDA_hashset_nth_slot(hset, j);
+    slot->psl--;
+    i = j;
+    j = next_bucket(j, buckets);
+  }
+  SCEDA_hashset_nth_slot(hset, i)->psl = 0;
+
+  hset->size--;
+  if(hset->shrink && (4 * hset->size < hset->buckets) && (hset->buckets > hset->min_buckets)) {
+    buckets = hset->buckets / 2;
+    SCEDA_hashset_resize(hset, (buckets < HASH_MIN_BUCKETS) ? SCEDA_HASHSET_SMALL_SIZE : buckets);
+  }
+
+  return 0;
 }
 
 int SCEDA_hashset_contains(SCEDA_HashSet *hset, const void *data) {
-  int i = hash_code(hset, data);
+  return (SCEDA_hashset_find_slot(hset, data, seeded_hash(hset, data)) != -1);
+}
 
-  return SCEDA_listset_contains(SCEDA_hashset_nth_set(hset, i), data);
+int SCEDA_hashset_contains_many(SCEDA_HashSet *hset, void *const *data, int n, int *res) {
+  unsigned int hashes[HASH_BATCH];
+  int found = 0;
+  int k;
+  for(k = 0; k < n; k += HASH_BATCH) {
+    int m = (n - k < HASH_BATCH) ? (n - k) : HASH_BATCH;
+    int j;
+    for(j = 0; j < m; j++) {
+      hashes[j] = seeded_hash(hset, data[k + j]);
+      SCEDA_hashset_prefetch(hset, hashes[j]);
+    }
+    for(j = 0; j < m; j++) {
+      res[k + j] = (SCEDA_hashset_find_slot(hset, data[k + j], hashes[j]) != -1);
+      found += res[k + j];
+    }
+  }
+
+  return found;
 }
 
 int SCEDA_hashset_lookup(SCEDA_HashSet *hset, void **data) {
-  int i = hash_code(hset, *data);
+  int i = SCEDA_hashset_find_slot(hset, *data, seeded_hash(hset, *data));
+  if(i == -1) {
+    return -1;
+  }
+
+  *data = SCEDA_hashset_nth_slot(hset, i)->data;
+  return 0;
+}
+
+int SCEDA_hashset_union(SCEDA_HashSet *res, SCEDA_HashSet *set1, SCEDA_HashSet *set2) {
+  if(res->size != 0) {
+    return -1;
+  }
+  SCEDA_HashSetIterator elts;
+  SCEDA_hashset_iterator_init(set1, &elts);
+  while(SCEDA_hashset_iterator_has_next(&elts)) {
+    SCEDA_hashset_add(res, SCEDA_hashset_iterator_next(&elts));
+  }
+  SCEDA_hashset_iterator_cleanup(&elts);
+  SCEDA_hashset_iterator_init(set2, &elts);
+  while(SCEDA_hashset_iterator_has_next(&elts)) {
+    SCEDA_hashset_add(res, SCEDA_hashset_iterator_next(&elts));
+  }
+  SCEDA_hashset_iterator_cleanup(&elts);
+  return 0;
+}
+
+int SCEDA_hashset_intersection(SCEDA_HashSet *res, SCEDA_HashSet *set1, SCEDA_HashSet *set2) {
+  if(res->size != 0) {
+    return -1;
+  }
+  // scan the smaller set, but keep the elements of set1
+  int swap = (set2->size < set1->size);
+  SCEDA_HashSet *small = swap ? set2 : set1;
+  SCEDA_HashSet *large = swap ? set1 : set2;
+  SCEDA_HashSetIterator elts;
+  SCEDA_hashset_iterator_init(small, &elts);
+  while(SCEDA_hashset_iterator_has_next(&elts)) {
+    void *data = SCEDA_hashset_iterator_next(&elts);
+    if(SCEDA_hashset_lookup(large, &data) == 0) {
+      SCEDA_hashset_add(res, data);
+    }
+  }
+  SCEDA_hashset_iterator_cleanup(&elts);
+  return 0;
+}
+
+int SCEDA_hashset_difference(SCEDA_HashSet *res, SCEDA_HashSet *set1, SCEDA_HashSet *set2) {
+  if(res->size != 0) {
+    return -1;
+  }
+  SCEDA_HashSetIterator elts;
+  SCEDA_hashset_iterator_init(set1, &elts);
+  while(SCEDA_hashset_iterator_has_next(&elts)) {
+    void *data = SCEDA_hashset_iterator_next(&elts);
+    if(!SCEDA_hashset_contains(set2, data)) {
+      SCEDA_hashset_add(res, data);
+    }
+  }
+  SCEDA_hashset_iterator_cleanup(&elts);
+  return 0;
+}
 
-  return SCEDA_listset_lookup(SCEDA_hashset_nth_set(hset, i), data);
+int SCEDA_hashset_is_subset(SCEDA_HashSet *set1, SCEDA_HashSet *set2) {
+  if(set1->size > set2->size) {
+    return FALSE;
+  }
+  int res = TRUE;
+  SCEDA_HashSetIterator elts;
+  SCEDA_hashset_iterator_init(set1, &elts);
+  while(res && SCEDA_hashset_iterator_has_next(&elts)) {
+    res = SCEDA_hashset_contains(set2, SCEDA_hashset_iterator_next(&elts));
+  }
+  SCEDA_hashset_iterator_cleanup(&elts);
+  return res;
 }
@@ -20,22 +20,63 @@
 #ifndef __SCEDA_HASHSET_H
 #define __SCEDA_HASHSET_H
 /** \file hashset.h
-    \brief HashSet implementation */
+    \brief HashSet implementation (open addressing, Robin Hood probing) */
 
 #include "common.h"
-#include "listset.h"
 #include <string.h>
 
+/** Slot of the open addressing table.
+
+    hash is the cached (seeded) hash code of the data. psl is the probe
+    sequence length of the slot plus one (distance to the home bucket
+    of the data), 0 meaning that the slot is free. */
+typedef struct {
+  void *data;
+  unsigned int hash;
+  int psl;
+} SCEDA_HashSetSlot;
+
+/** Number of elements stored inline in the set itself. Up to this
+    size, elements are kept in an array and searched linearly: no
+    table is allocated. */
+#define SCEDA_HASHSET_SMALL_SIZE 4
+
+/** Hash set.
+
+    With the open layout (#SCEDA_HASH_OPEN), table is the open
+    addressing table itself. With the ordered layout
+    (#SCEDA_HASH_ORDERED), table is a dense array of elements, in
+    insertion order, and index is the open addressing table giving
+    the position of each element in table. Removed elements leave a
+    hole (psl = 0) until the array is compacted. With the Swiss table
+    layout (#SCEDA_HASH_SWISS), table is an open addressing table
+    (psl is 1 for used slots) and ctrl holds the control byte of each
+    bucket; tombstones is the number of buckets marked as deleted.
+
+    Iterators scan the first slots slots of table: all the buckets with
+    the open layout, the used part of the dense array with the ordered
+    layout. */
 typedef struct {
+  int layout;
   int buckets;
+  int min_buckets;
+  int shift;
+  unsigned int seed;
   int size;
+  int slots;
+  int shrink;
   SCEDA_delete_fun delete;
   SCEDA_match_fun match;
   SCEDA_hash_fun hash;
-  SCEDA_ListSet (*table)[];
+  SCEDA_Allocator *alloc;
+  SCEDA_HashSetSlot (*table)[];
+  SCEDA_HashIndexSlot (*index)[];
+  unsigned char *ctrl;
+  int tombstones;
+  SCEDA_HashSetSlot small[SCEDA_HASHSET_SMALL_SIZE];
 } SCEDA_HashSet;
 
-#define SCEDA_hashset_nth_set(set$, i$) (&((*((set$)->table))[i$]))
+#define SCEDA_hashset_nth_slot(set$, i$) (&((*((set$)->table))[i$]))
 
 /** Initialise a (hash) set.
 
@@ -46,6 +87,17 @@ typedef struct {
 void SCEDA_hashset_init(SCEDA_HashSet *set, SCEDA_delete_fun delete,
 			SCEDA_match_fun match, SCEDA_hash_fun hash);
 
+/** Initialise a (hash) set able to hold capacity elements without
+    being resized. The set never shrinks below this capacity.
+
+    @param[in] set = set
+    @param[in] capacity = expected number of elements
+    @param[in] delete = delete function or NULL
+    @param[in] match = equality function
+    @param[in] hash = hash function */
+void SCEDA_hashset_init_with_capacity(SCEDA_HashSet *set, int capacity, SCEDA_delete_fun delete,
+				      SCEDA_match_fun match, SCEDA_hash_fun hash);
+
 /** Create a (hash) set, ready for use.
 
     @param[in] delete = delete function or NULL
@@ -56,6 +108,41 @@ void SCEDA_hashset_init(SCEDA_HashSet *set, SCEDA_delete_fun delete,
 SCEDA_HashSet *SCEDA_hashset_create(SCEDA_delete_fun delete, SCEDA_match_fun match,
 			SCEDA_hash_fun hash);
 
+/** Create a (hash) set able to hold capacity elements without being
+    resized. The set never shrinks below this capacity.
+
+    @param[in] capacity = expected number of elements
+    @param[in] delete = delete function or NULL
+    @param[in] match = equality function
+    @param[in] hash = hash function
+
+    @return the (hash) set */
+SCEDA_HashSet *SCEDA_hashset_create_with_capacity(int capacity, SCEDA_delete_fun delete,
+						  SCEDA_match_fun match, SCEDA_hash_fun hash);
+
+/** Initialise a (hash) set whose table is allocated by a given
+    allocator.
+
+    @param[in] set = set
+    @param[in] alloc = allocator
+    @param[in] delete = delete function or NULL
+    @param[in] match = equality function
+    @param[in] hash = hash function */
+void SCEDA_hashset_init_with_allocator(SCEDA_HashSet *set, SCEDA_Allocator *alloc, SCEDA_delete_fun delete,
+				       SCEDA_match_fun match, SCEDA_hash_fun hash);
+
+/** Create a (hash) set, ready for use. The set and its table are
+    allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete = delete function or NULL
+    @param[in] match = equality function
+    @param[in] hash = hash function
+
+    @return the (hash) set */
+SCEDA_HashSet *SCEDA_hashset_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete,
+						   SCEDA_match_fun match, SCEDA_hash_fun hash);
+
 /** Clean up a (hash) set.
 
     @param[in] set = set to clean up */
@@ -71,6 +158,44 @@ void SCEDA_hashset_delete(SCEDA_HashSet *set);
     @param[in] set = set to clear */
 void SCEDA_hashset_clear(SCEDA_HashSet *set);
 
+/** Reserve room for capacity elements in a (hash) set, so that it is
+    not resized until it holds more elements. The set never shrinks
+    below this capacity afterwards.
+
+    @param[in] set = set
+    @param[in] capacity = expected number of elements */
+void SCEDA_hashset_reserve(SCEDA_HashSet *set, int capacity);
+
+/** Set the shrink policy of a (hash) set. By default, the set shrinks
+    when it is less than a quarter full (but never below its reserved
+    capacity). Disabling shrinking avoids resizing back and forth when
+    elements are repeatedly added and removed.
+
+    @param[in] set = set
+    @param[in] shrink = TRUE to allow shrinking, FALSE otherwise */
+void SCEDA_hashset_set_shrink(SCEDA_HashSet *set, int shrink);
+
+/** Set the layout of an empty (hash) set.
+
+    With the ordered layout, elements are stored in a dense array in
+    insertion order, and the hash table only holds their positions:
+    iterating is a linear scan of the elements, in a deterministic
+    order (the order of insertion), whatever the number of removed
+    elements.
+
+    With the Swiss table layout, a control byte per bucket holds 7
+    bits of the hash code of its element. Buckets are probed by groups
+    of 16, whose control bytes are compared at once (using SSE2 when
+    available): most unsuccessful searches end without calling the
+    equality function, nor even reading the elements.
+
+    @param[in] set = set
+    @param[in] layout = #SCEDA_HASH_OPEN (default), #SCEDA_HASH_ORDERED
+    or #SCEDA_HASH_SWISS
+
+    @return 0 in case of success, -1 if set is not empty or layout is not valid */
+int SCEDA_hashset_set_layout(SCEDA_HashSet *set, int layout);
+
 /** Insert data into a (hash) set in time complexity O(1).
 
     @param[in] set = set
@@ -79,6 +204,17 @@ void SCEDA_hashset_clear(SCEDA_HashSet *set);
     @return 0 in case of success, 1 if already present, -1 otherwise */
 int SCEDA_hashset_add(SCEDA_HashSet *set, const void *data);
 
+/** Insert n data into a (hash) set. All the data are hashed and their
+    buckets prefetched before the set is probed, so that the memory
+    accesses of independent data overlap.
+
+    @param[in] set = set
+    @param[in] data = array of n data to add
+    @param[in] n = number of data
+
+    @return the number of data that were not already present */
+int SCEDA_hashset_add_many(SCEDA_HashSet *set, void *const *data, int n);
+
 /** Remove a data from a set in time complexity O(1).
 
     @param[in] set = set
@@ -95,6 +231,17 @@ int SCEDA_hashset_remove(SCEDA_HashSet *set, void **data);
     @return TRUE if present, FALSE otherwise */
 int SCEDA_hashset_contains(SCEDA_HashSet *set, const void *data);
 
+/** Test whether n data belong to a set, prefetching their buckets
+    (see SCEDA_hashset_add_many()).
+
+    @param[in] set = set
+    @param[in] data = array of n data to look for
+    @param[in] n = number of data
+    @param[out] res = array of n booleans (filled by the function)
+
+    @return the number of data present in the set */
+int SCEDA_hashset_contains_many(SCEDA_HashSet *set, void *const *data, int n, int *res);
+
 /** Look up for a data in a set in time complexity O(1).
 
     @param[in] set = set
@@ -103,6 +250,49 @@ int SCEDA_hashset_contains(SCEDA_HashSet *set, const void *data);
     @return 0 if found, -1 otherwise */
 int SCEDA_hashset_lookup(SCEDA_HashSet *set, void **data);
 
+/** Compute the union of two sets in time complexity
+    O(|set1|+|set2|). The elements are shared with set1 and set2
+    (set1 is preferred for equal elements), so that res should not
+    have a delete function if set1 or set2 has one.
+
+    @param[in] res = empty set, filled with the union
+    @param[in] set1 = first set
+    @param[in] set2 = second set
+
+    @return 0 in case of success, -1 if res is not empty */
+int SCEDA_hashset_union(SCEDA_HashSet *res, SCEDA_HashSet *set1, SCEDA_HashSet *set2);
+
+/** Compute the intersection of two sets in time complexity
+    O(min(|set1|,|set2|)). The elements of res are those of set1 which
+    belong to set2.
+
+    @param[in] res = empty set, filled with the intersection
+    @param[in] set1 = first set
+    @param[in] set2 = second set
+
+    @return 0 in case of success, -1 if res is not empty */
+int SCEDA_hashset_intersection(SCEDA_HashSet *res, SCEDA_HashSet *set1, SCEDA_HashSet *set2);
+
+/** Compute the difference of two sets in time complexity
+    O(|set1|). The elements of res are those of set1 which do not
+    belong to set2.
+
+    @param[in] res = empty set, filled with the difference
+    @param[in] set1 = first set
+    @param[in] set2 = second set
+
+    @return 0 in case of success, -1 if res is not empty */
+int SCEDA_hashset_difference(SCEDA_HashSet *res, SCEDA_HashSet *set1, SCEDA_HashSet *set2);
+
+/** Test whether a set is included in another one in time complexity
+    O(|set1|).
+
+    @param[in] set1 = first set
+    @param[in] set2 = second set
+
+    @return TRUE if every element of set1 belongs to set2, FALSE otherwise */
+int SCEDA_hashset_is_subset(SCEDA_HashSet *set1, SCEDA_HashSet *set2);
+
 /** Size of the (hash) set in time complexity O(1).
 
     @param[in] set = set
@@ -125,7 +315,6 @@ int SCEDA_hashset_lookup(SCEDA_HashSet *set, void **data);
 typedef struct {
   int i;
   SCEDA_HashSet *set;
-  SCEDA_ListSetIterator elements;
 } SCEDA_HashSetIterator;
 
 /** Initialise a (hash) set iterator.
@@ -136,9 +325,8 @@ typedef struct {
     \hideinitializer */
 #define SCEDA_hashset_iterator_init(set$, iter$) \
   ({ SCEDA_HashSetIterator *_iter = (iter$);   \
-     _iter->i = 0;                        \
-     _iter->set = (set$);	            \
-     SCEDA_listset_iterator_init(SCEDA_hashset_nth_set((_iter->set),0), &(_iter->elements)); })
+     _iter->i = 0;                             \
+     _iter->set = (set$); })
 
 /** Test whether there is a next data in the set iterator.
 
@@ -147,16 +335,12 @@ typedef struct {
     @return TRUE if there is a "next" data, FALSE otherwise
 
     \hideinitializer */
-#define SCEDA_hashset_iterator_has_next(iter$)                                                                  \
-  ({ SCEDA_HashSetIterator *_iter = (iter$);                                                                  \
-     while((_iter->i < _iter->set->buckets) && (!(SCEDA_listset_iterator_has_next(&(_iter->elements))))) { \
-       _iter->i++;                                                                                       \
-       if(_iter->i < _iter->set->buckets) {                                                            \
-	 SCEDA_listset_iterator_cleanup(&(_iter->elements));		                                   \
-         SCEDA_listset_iterator_init(SCEDA_hashset_nth_set((_iter->set),_iter->i), &(_iter->elements));          \
-       }                                                                                                   \
-     }                                                                                                     \
-     (_iter->i < _iter->set->buckets) && (SCEDA_listset_iterator_has_next(&(_iter->elements))); })
+#define SCEDA_hashset_iterator_has_next(iter$)                                                   \
+  ({ SCEDA_HashSetIterator *_iter = (iter$);                                                   \
+     while((_iter->i < _iter->set->slots) && (SCEDA_hashset_nth_slot(_iter->set, _iter->i)->psl == 0)) { \
+       _iter->i++;                                                                             \
+     }                                                                                         \
+     (_iter->i < _iter->set->slots); })
 
 /** Return the next data of a set iterator.
 
@@ -165,16 +349,15 @@ typedef struct {
     @return the "next" data
 
     \hideinitializer */
-#define SCEDA_hashset_iterator_next(iter$) (SCEDA_listset_iterator_next(&((iter$)->elements)))
+#define SCEDA_hashset_iterator_next(iter$)                        \
+  ({ SCEDA_HashSetIterator *_iter = (iter$);                    \
+     SCEDA_hashset_nth_slot(_iter->set, _iter->i++)->data; })
 
 /** Clean up a (hash) set iterator.
 
     @param[in] iter = set iterator
 
     \hideinitializer */
-#define SCEDA_hashset_iterator_cleanup(iter$)             \
-  ({ SCEDA_HashSetIterator *_iter = (iter$);            \
-     SCEDA_listset_iterator_cleanup(&(_iter->elements)); \
-     memset(_iter, 0, sizeof(SCEDA_HashSetIterator)); })
+#define SCEDA_hashset_iterator_cleanup(iter$) (memset(iter$, 0, sizeof(SCEDA_HashSetIterator)))
 
 #endif
@@ -80,23 +80,183 @@ static inline void remove_child(SCEDA_HeapElt *parent, SCEDA_HeapElt *elt) {
   parent->degree--;
 }
 
-void SCEDA_heap_init(SCEDA_Heap *heap,
-		     SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
-		     SCEDA_compare_fun compare_key) {
+void SCEDA_heap_init_with_allocator(SCEDA_Heap *heap, SCEDA_Allocator *alloc,
+				    SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+				    SCEDA_compare_fun compare_key) {
   heap->min = NULL;
   heap->size = 0;
+  heap->kind = SCEDA_HEAP_FIBONACCI;
   heap->delete_value = delete_value;
   heap->delete_key = delete_key;
   heap->compare_key = compare_key;
+  heap->alloc = alloc;
+  heap->pool = NULL;
+}
+
+void SCEDA_heap_init(SCEDA_Heap *heap,
+		     SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+		     SCEDA_compare_fun compare_key) {
+  SCEDA_heap_init_with_allocator(heap, SCEDA_allocator_get_default(), delete_value, delete_key, compare_key);
+}
+
+SCEDA_Heap *SCEDA_heap_create_with_allocator(SCEDA_Allocator *alloc,
+					     SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+					     SCEDA_compare_fun compare_key) {
+  SCEDA_Heap *heap = (SCEDA_Heap *)alloc_malloc(alloc, sizeof(SCEDA_Heap));
+  SCEDA_heap_init_with_allocator(heap, alloc, delete_value, delete_key, compare_key);
+  return heap;
 }
 
 SCEDA_Heap *SCEDA_heap_create(SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
 			      SCEDA_compare_fun compare_key) {
-  SCEDA_Heap *heap = (SCEDA_Heap *)safe_malloc(sizeof(SCEDA_Heap));
-  SCEDA_heap_init(heap, delete_value, delete_key, compare_key);
+  return SCEDA_heap_create_with_allocator(SCEDA_allocator_get_default(), delete_value, delete_key, compare_key);
+}
+
+void SCEDA_heap_init_pooled(SCEDA_Heap *heap,
+			    SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+			    SCEDA_compare_fun compare_key) {
+  SCEDA_Pool *pool = SCEDA_pool_create(sizeof(SCEDA_HeapElt));
+  SCEDA_heap_init_with_allocator(heap, SCEDA_pool_allocator(pool), delete_value, delete_key, compare_key);
+  heap->pool = pool;
+}
+
+SCEDA_Heap *SCEDA_heap_create_pooled(SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+				     SCEDA_compare_fun compare_key) {
+  SCEDA_Heap *heap = (SCEDA_Heap *)alloc_malloc(SCEDA_allocator_get_default(), sizeof(SCEDA_Heap));
+  SCEDA_heap_init_pooled(heap, delete_value, delete_key, compare_key);
   return heap;
 }
 
+int SCEDA_heap_set_kind(SCEDA_Heap *heap, int kind) {
+  if(!SCEDA_heap_is_empty(heap) || ((kind != SCEDA_HEAP_FIBONACCI) && (kind != SCEDA_HEAP_PAIRING))) {
+    return -1;
+  }
+  heap->kind = kind;
+  return 0;
+}
+
+/* Pairing heaps: heap->min is the root of a single tree */
+
+/* link two detached trees, the root with the greater key becoming
+   the leftmost child of the other one */
+static inline SCEDA_HeapElt *pairing_link(SCEDA_Heap *heap, SCEDA_HeapElt *x, SCEDA_HeapElt *y) {
+  if(compare_heap_elt(heap, y, x) < 0) {
+    SCEDA_HeapElt *tmp = x;
+    x = y;
+    y = tmp;
+  }
+  y->previous = x;
+  y->next = x->child;
+  if(x->child != NULL) {
+    x->child->previous = y;
+  }
+  x->child = y;
+  x->next = NULL;
+  x->previous = NULL;
+  return x;
+}
+
+/* detach the subtree rooted at x (which is not the root) */
+static inline void pairing_cut(SCEDA_HeapElt *x) {
+  if(x->previous->child == x) {
+    x->previous->child = x->next;
+  } else {
+    x->previous->next = x->next;
+  }
+  if(x->next != NULL) {
+    x->next->previous = x->previous;
+  }
+  x->next = NULL;
+  x->previous = NULL;
+}
+
+/* two-pass merge of a list of siblings into a single tree */
+static SCEDA_HeapElt *pairing_merge_pairs(SCEDA_Heap *heap, SCEDA_HeapElt *first) {
+  // first pass: link pairs from left to right, stacking the results
+  SCEDA_HeapElt *pairs = NULL;
+  while(first != NULL) {
+    SCEDA_HeapElt *x = first;
+    SCEDA_HeapElt *y = x->next;
+    first = (y != NULL) ? y->next : NULL;
+    x->next = NULL;
+    x->previous = NULL;
+    if(y != NULL) {
+      y->next = NULL;
+      y->previous = NULL;
+      x = pairing_link(heap, x, y);
+    }
+    x->next = pairs;
+    pairs = x;
+  }
+
+  // second pass: link the results from right to left
+  SCEDA_HeapElt *root = NULL;
+  while(pairs != NULL) {
+    SCEDA_HeapElt *x = pairs;
+    pairs = x->next;
+    x->next = NULL;
+    root = (root == NULL) ? x : pairing_link(heap, x, root);
+  }
+  return root;
+}
+
+static void pairing_insert_elt(SCEDA_Heap *heap, SCEDA_HeapElt *elt) {
+  elt->child = NULL;
+  elt->next = NULL;
+  elt->previous = NULL;
+  elt->parent = NULL;
+
+  heap->min = (heap->min == NULL) ? elt : pairing_link(heap, heap->min, elt);
+  heap->size++;
+}
+
+static SCEDA_HeapElt *pairing_remove_elt(SCEDA_Heap *heap, SCEDA_HeapElt *x) {
+  if(x == heap->min) {
+    heap->min = pairing_merge_pairs(heap, x->child);
+  } else {
+    pairing_cut(x);
+    SCEDA_HeapElt *sub = pairing_merge_pairs(heap, x->child);
+    if(sub != NULL) {
+      heap->min = pairing_link(heap, heap->min, sub);
+    }
+  }
+  x->child = NULL;
+  heap->size--;
+  return x;
+}
+
+static void pairing_decrease_key(SCEDA_Heap *heap, SCEDA_HeapElt *x) {
+  if(x != heap->min) {
+    pairing_cut(x);
+    heap->min = pairing_link(heap, heap->min, x);
+  }
+}
+
+/* the trees may be deep: elements are deleted without recursion */
+static void pairing_cleanup_elts(SCEDA_Heap *heap) {
+  SCEDA_HeapElt *todo = heap->min;
+  while(todo != NULL) {
+    SCEDA_HeapElt *x = todo;
+    todo = x->next;
+    if(x->child != NULL) {
+      SCEDA_HeapElt *last = x->child;
+      while(last->next != NULL) {
+	last = last->next;
+      }
+      last->next = todo;
+      todo = x->child;
+    }
+    if(heap->delete_value != NULL) {
+      heap->delete_value(heap_elt_value(x));
+    }
+    if(heap->delete_key != NULL) {
+      heap->delete_key(heap_elt_key(x));
+    }
+    alloc_free(heap->alloc, x, sizeof(SCEDA_HeapElt));
+  }
+  heap->min = NULL;
+}
+
 static void SCEDA_heap_cleanup_aux(SCEDA_Heap *heap, SCEDA_HeapElt *elt) {
   while(elt->child != NULL) {
     SCEDA_HeapElt *child = elt->child;
@@ -109,29 +269,59 @@ static void SCEDA_heap_cleanup_aux(SCEDA_Heap *heap, SCEDA_HeapElt *elt) {
   if(heap->delete_key != NULL) {
     heap->delete_key(heap_elt_key(elt));
   }
-  free(elt);
+  alloc_free(heap->alloc, elt, sizeof(SCEDA_HeapElt));
 }
 
-void SCEDA_heap_cleanup(SCEDA_Heap *heap) {
+static void SCEDA_heap_cleanup_elts(SCEDA_Heap *heap) {
+  if((heap->delete_value == NULL) && (heap->delete_key == NULL)
+     && ((heap->pool != NULL) || (heap->alloc->free == NULL))) {
+    // nothing to delete nor deallocate one by one
+    return;
+  }
+  if(heap->kind == SCEDA_HEAP_PAIRING) {
+    pairing_cleanup_elts(heap);
+    return;
+  }
   while(heap->min != NULL) {
     SCEDA_HeapElt *root = heap->min;
     remove_root(heap, root);
     SCEDA_heap_cleanup_aux(heap, root);
   }
+}
+
+void SCEDA_heap_cleanup(SCEDA_Heap *heap) {
+  // keep the allocator of the heap itself, so that it can still be
+  // cleaned up or deleted
+  SCEDA_Allocator *alloc = (heap->pool != NULL) ? heap->pool->upstream : heap->alloc;
+  SCEDA_heap_cleanup_elts(heap);
+  if(heap->pool != NULL) {
+    SCEDA_pool_delete(heap->pool);
+  }
   memset(heap, 0, sizeof(SCEDA_Heap));
+  heap->alloc = alloc;
 }
 
 void SCEDA_heap_delete(SCEDA_Heap *heap) {
+  // a heap owning its pool is allocated by the upstream allocator
+  SCEDA_Allocator *alloc = (heap->pool != NULL) ? heap->pool->upstream : heap->alloc;
   SCEDA_heap_cleanup(heap);
-  free(heap);
+  alloc_free(alloc, heap, sizeof(SCEDA_Heap));
 }
 
 void SCEDA_heap_clear(SCEDA_Heap *heap) {
   SCEDA_delete_fun delete_value = heap->delete_value;
   SCEDA_delete_fun delete_key = heap->delete_key;
   SCEDA_compare_fun compare_key = heap->compare_key;
-  SCEDA_heap_cleanup(heap);
-  SCEDA_heap_init(heap, delete_value, delete_key, compare_key);
+  SCEDA_Allocator *alloc = heap->alloc;
+  SCEDA_Pool *pool = heap->pool;
+  int kind = heap->kind;
+  SCEDA_heap_cleanup_elts(heap);
+  if(pool != NULL) {
+    SCEDA_pool_clear(pool);
+  }
+  SCEDA_heap_init_with_allocator(heap, alloc, delete_value, delete_key, compare_key);
+  heap->pool = pool;
+  heap->kind = kind;
 }
 
 static void SCEDA_heap_insert_elt(SCEDA_Heap *heap, SCEDA_HeapElt *elt) {
@@ -150,17 +340,47 @@ static void SCEDA_heap_insert_elt(SCEDA_Heap *heap, SCEDA_HeapElt *elt) {
 }
 
 SCEDA_HeapElt *SCEDA_heap_insert(SCEDA_Heap *heap, const void *value, const void *key) {
-  SCEDA_HeapElt *elt = (SCEDA_HeapElt *)safe_malloc(sizeof(SCEDA_HeapElt));
+  SCEDA_HeapElt *elt = (SCEDA_HeapElt *)alloc_malloc(heap->alloc, sizeof(SCEDA_HeapElt));
   elt->value = (void *)value;
   elt->key = (void *)key;
 
-  SCEDA_heap_insert_elt(heap, elt);
+  if(heap->kind == SCEDA_HEAP_PAIRING) {
+    pairing_insert_elt(heap, elt);
+  } else {
+    SCEDA_heap_insert_elt(heap, elt);
+  }
 
   return elt;
 }
 
+/* Empty a heap whose elements were moved to another heap, keeping its
+   allocator. A heap whose pool was handed over gets a new pool. */
+static void SCEDA_heap_reset(SCEDA_Heap *heap, SCEDA_Pool *moved) {
+  SCEDA_Allocator *alloc = heap->alloc;
+  SCEDA_Pool *pool = heap->pool;
+  int kind = heap->kind;
+  if((pool != NULL) && (pool == moved)) {
+    pool = SCEDA_pool_create_with_allocator(moved->upstream, sizeof(SCEDA_HeapElt));
+    alloc = SCEDA_pool_allocator(pool);
+  }
+  SCEDA_heap_init_with_allocator(heap, alloc, heap->delete_value, heap->delete_key, heap->compare_key);
+  heap->pool = pool;
+  heap->kind = kind;
+}
+
 SCEDA_Heap *SCEDA_heap_union(SCEDA_Heap *heap1, SCEDA_Heap *heap2) {
-  SCEDA_Heap *heap = SCEDA_heap_create(heap1->delete_value, heap1->delete_key, heap1->compare_key);
+  if((heap1->kind != heap2->kind) || (heap1->alloc != heap2->alloc)) {
+    return NULL;
+  }
+
+  // the union takes over the pool holding the elements (if any)
+  SCEDA_Pool *pool = (heap1->pool != NULL) ? heap1->pool : heap2->pool;
+  SCEDA_Allocator *alloc = heap1->alloc;
+  SCEDA_Heap *heap = (SCEDA_Heap *)alloc_malloc((pool != NULL) ? pool->upstream : alloc, sizeof(SCEDA_Heap));
+  SCEDA_heap_init_with_allocator(heap, alloc, heap1->delete_value, heap1->delete_key, heap1->compare_key);
+  heap->pool = pool;
+  int kind = heap1->kind;
+  heap->kind = kind;
 
   heap->size = heap1->size + heap2->size;
 
@@ -168,6 +388,8 @@ SCEDA_Heap *SCEDA_heap_union(SCEDA_Heap *heap1, SCEDA_Heap *heap2) {
     heap->min = heap2->min;
   } else if(heap2->min == NULL) {
     heap->min = heap1->min;
+  } else if(kind == SCEDA_HEAP_PAIRING) {
+    heap->min = pairing_link(heap, heap1->min, heap2->min);
   } else {
     concat(heap1->min, heap2->min);
 
@@ -178,8 +400,8 @@ SCEDA_Heap *SCEDA_heap_union(SCEDA_Heap *heap1, SCEDA_Heap *heap2) {
     }
   }
 
-  SCEDA_heap_init(heap1, heap->delete_value, heap->delete_key, heap->compare_key);
-  SCEDA_heap_init(heap2, heap->delete_value, heap->delete_key, heap->compare_key);
+  SCEDA_heap_reset(heap1, pool);
+  SCEDA_heap_reset(heap2, pool);
 
   return heap;
 }
@@ -263,10 +485,15 @@ int SCEDA_heap_extract(SCEDA_Heap *heap, void **value, void **key) {
   if(SCEDA_heap_is_empty(heap)) {
     return -1;
   }
-  SCEDA_HeapElt *elt = SCEDA_heap_extract_elt(heap);
+  SCEDA_HeapElt *elt;
+  if(heap->kind == SCEDA_HEAP_PAIRING) {
+    elt = pairing_remove_elt(heap, heap->min);
+  } else {
+    elt = SCEDA_heap_extract_elt(heap);
+  }
   *value = heap_elt_value(elt);
   *key = heap_elt_key(elt);
-  free(elt);
+  alloc_free(heap->alloc, elt, sizeof(SCEDA_HeapElt));
   return 0;
 }
 
@@ -299,14 +526,22 @@ static SCEDA_HeapElt *SCEDA_heap_remove_elt(SCEDA_Heap *heap, SCEDA_HeapElt *x)
 }
 
 int SCEDA_heap_remove(SCEDA_Heap *heap, SCEDA_HeapElt *x, void **value, void **key) {
-  SCEDA_heap_remove_elt(heap, x);
+  if(heap->kind == SCEDA_HEAP_PAIRING) {
+    pairing_remove_elt(heap, x);
+  } else {
+    SCEDA_heap_remove_elt(heap, x);
+  }
   *value = heap_elt_value(x);
   *key = heap_elt_key(x);
-  free(x);
+  alloc_free(heap->alloc, x, sizeof(SCEDA_HeapElt));
   return 0;
 }
 
 void SCEDA_heap_decrease_key(SCEDA_Heap *heap, SCEDA_HeapElt *x) {
+  if(heap->kind == SCEDA_HEAP_PAIRING) {
+    pairing_decrease_key(heap, x);
+    return;
+  }
   SCEDA_HeapElt *y = x->parent;
   if((y != NULL) && (compare_heap_elt(heap, x, y) < 0)) {
     fibo_cut(heap, x, y);
@@ -318,8 +553,13 @@ void SCEDA_heap_decrease_key(SCEDA_Heap *heap, SCEDA_HeapElt *x) {
 }
 
 void SCEDA_heap_increase_key(SCEDA_Heap *heap, SCEDA_HeapElt *x) {
-  SCEDA_heap_remove_elt(heap, x);
-  SCEDA_heap_insert_elt(heap, x);
+  if(heap->kind == SCEDA_HEAP_PAIRING) {
+    pairing_remove_elt(heap, x);
+    pairing_insert_elt(heap, x);
+  } else {
+    SCEDA_heap_remove_elt(heap, x);
+    SCEDA_heap_insert_elt(heap, x);
+  }
 }
 
 void *SCEDA_heap_change_key(SCEDA_Heap *heap, SCEDA_HeapElt *x, const void *key) {
@@ -20,11 +20,21 @@
 #ifndef __SCEDA_HEAP_H
 #define __SCEDA_HEAP_H
 /** \file heap.h
-    \brief Fibonacci heaps. */
+    \brief Fibonacci heaps and pairing heaps. */
 
 #include "common.h"
+#include "pool.h"
 
-/** An element of a Fibonacci heap */
+/** Kind of heap: Fibonacci heap (the default) */
+#define SCEDA_HEAP_FIBONACCI 0
+/** Kind of heap: pairing heap */
+#define SCEDA_HEAP_PAIRING 1
+
+/** An element of a heap.
+
+    In a pairing heap, child is the leftmost child, next is the right
+    sibling, and previous is the left sibling (or the parent of the
+    leftmost child). parent, degree and marked are not used. */
 typedef struct _SCEDA_HeapElt {
   struct _SCEDA_HeapElt *parent;
   struct _SCEDA_HeapElt *child;
@@ -39,9 +49,12 @@ typedef struct _SCEDA_HeapElt {
 typedef struct {
   SCEDA_HeapElt *min;
   int size;
+  int kind;
   SCEDA_delete_fun delete_value;
   SCEDA_delete_fun delete_key;
   SCEDA_compare_fun compare_key;
+  SCEDA_Allocator *alloc;
+  SCEDA_Pool *pool;
 } SCEDA_Heap;
 
 /** Initialise a Fibonacci heap.
@@ -64,6 +77,53 @@ void SCEDA_heap_init(SCEDA_Heap *heap,
 SCEDA_Heap *SCEDA_heap_create(SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
 			      SCEDA_compare_fun compare_key);
 
+/** Initialise a Fibonacci heap whose elements are allocated by a
+    given allocator.
+
+    @param[in] heap = heap to initialise
+    @param[in] alloc = allocator
+    @param[in] delete_value = delete value function
+    @param[in] delete_key = delete key function
+    @param[in] compare_key = compare key function */
+void SCEDA_heap_init_with_allocator(SCEDA_Heap *heap, SCEDA_Allocator *alloc,
+				    SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+				    SCEDA_compare_fun compare_key);
+
+/** Create a Fibonacci heap. The heap and its elements are allocated
+    by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete_value = delete value function
+    @param[in] delete_key = delete key function
+    @param[in] compare_key = compare key function
+
+    @return a Fibonacci heap */
+SCEDA_Heap *SCEDA_heap_create_with_allocator(SCEDA_Allocator *alloc,
+					     SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+					     SCEDA_compare_fun compare_key);
+
+/** Initialise a Fibonacci heap whose elements are allocated in a pool
+    owned by the heap. Cleaning up the heap releases the pool at once.
+
+    @param[in] heap = heap to initialise
+    @param[in] delete_value = delete value function
+    @param[in] delete_key = delete key function
+    @param[in] compare_key = compare key function */
+void SCEDA_heap_init_pooled(SCEDA_Heap *heap,
+			    SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+			    SCEDA_compare_fun compare_key);
+
+/** Create a Fibonacci heap whose elements are allocated in a pool
+    owned by the heap.
+
+    @param[in] delete_value = delete value function
+    @param[in] delete_key = delete key function
+    @param[in] compare_key = compare key function
+
+    @return a Fibonacci heap */
+SCEDA_Heap *SCEDA_heap_create_pooled(SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+				     SCEDA_compare_fun compare_key);
+
 /** Clean up a Fibonacci heap.
 
     @param[in] heap = heap to clean up */
@@ -79,6 +139,18 @@ void SCEDA_heap_delete(SCEDA_Heap *heap);
     @param[in] heap = heap to clear */
 void SCEDA_heap_clear(SCEDA_Heap *heap);
 
+/** Select the kind of an empty heap: SCEDA_HEAP_FIBONACCI (the
+    default) or SCEDA_HEAP_PAIRING. Both provide the same operations.
+    Pairing heaps have better constant factors in practice, while
+    Fibonacci heaps guarantee amortized time O(1) for decrease key
+    (pairing heaps: O(log|heap|) amortized, but usually much faster).
+
+    @param[in] heap = empty heap
+    @param[in] kind = kind of heap
+
+    @return 0 in case of success, -1 if the heap is not empty or kind is not valid */
+int SCEDA_heap_set_kind(SCEDA_Heap *heap, int kind);
+
 /** Insert an element into a Fibonacci heap in time complexity O(1).
 
     @param[in] heap = heap
@@ -88,13 +160,19 @@ void SCEDA_heap_clear(SCEDA_Heap *heap);
     @return a heap element (for direct access) */
 SCEDA_HeapElt *SCEDA_heap_insert(SCEDA_Heap *heap, const void *value, const void *key);
 
-/** Merge two Fibonacci heap in time complexity O(1).
+/** Merge two heaps of the same kind in time complexity O(1).
+
+    Both heaps must be of the same kind and allocate their elements
+    with the same allocator. The union is allocated by this allocator
+    and takes over the pool of a pooled heap (which gets a new one).
 
     @param[in] heap1 = first heap (reinitialised)
     @param[in] heap2 = second heap (reinitialised)
 
     @return a heap that is the union of heap1 and heap2, which are
-    reinitialised to an empty state after the call. */
+    reinitialised to an empty state after the call, or NULL if the
+    heaps are of different kinds or use different allocators (heap1
+    and heap2 are then left unchanged). */
 SCEDA_Heap *SCEDA_heap_union(SCEDA_Heap *heap1, SCEDA_Heap *heap2);
 
 /** Extract the minimum element of a Fibonacci heap in amortized time O(log|heap|).
@@ -133,6 +133,83 @@
 
     Test whether the given Fibonacci heap is empty.
 
+    \section pheaps Pairing heaps
+
+    A heap may be turned into a pairing heap while it is still empty.
+
+    \code
+    int heap_set_kind(Heap *heap, int kind);
+    \endcode
+
+    Set the kind of a heap, either HEAP_FIBONACCI (the default) or
+    HEAP_PAIRING. Return -1 if the heap is not empty.
+
+    A pairing heap is a single tree whose root is the minimum. Its
+    operations are much simpler than those of a Fibonacci heap: insert
+    and union are a single link, decrease_key cuts the subtree and
+    links it back with the root, and extract merges the children of
+    the root two by two. It has the same API (and the same heap
+    elements) and is often faster in practice, although decrease_key
+    is only known to run in amortized time o(log|heap|).
+
+    Only heaps of the same kind can be merged by heap_union(), which
+    returns NULL otherwise.
+
+    \section iheaps Indexed heaps
+
+    When the elements of a heap can be numbered densely (e.g. the
+    vertices of a graph), an indexed heap (see \link iheap.h
+    \endlink) is usually much faster than a Fibonacci heap. It is a
+    d-ary heap stored in an array, along with the position of each
+    element: elements are designated by their number (their handle)
+    instead of a SCEDA_HeapElt, and nothing is allocated upon
+    insertion.
+
+    \code
+    IHeap *iheap_create(int capacity, delete_fun delete_value, delete_fun delete_key, compare_fun compare_key);
+    int iheap_insert(IHeap *heap, int handle, const void *value, const void *key);
+    int iheap_extract(IHeap *heap, int *handle, void **value, void **key);
+    int iheap_decrease_key(IHeap *heap, int handle);
+    int iheap_increase_key(IHeap *heap, int handle);
+    void *iheap_change_key(IHeap *heap, int handle, const void *key);
+    int iheap_remove(IHeap *heap, int handle, void **value, void **key);
+    int iheap_contains(IHeap *heap, int handle);
+    \endcode
+
+    All the operations but iheap_contains() run in time O(log|heap|).
+
+    \section mheaps Monotone integer queues
+
+    When keys are non negative integers and never go below the last
+    extracted key (as the distances in Dijkstra's algorithm), a
+    bucket queue (see \link bqueue.h \endlink) or a radix heap (see
+    \link rheap.h \endlink) avoids key comparisons altogether. Both
+    use handles as indexed heaps, but keys are stored in the queue.
+
+    \code
+    BucketQueue *bqueue_create(int capacity, int span);
+    int bqueue_insert(BucketQueue *queue, int handle, int key);
+    int bqueue_extract(BucketQueue *queue, int *handle, int *key);
+    int bqueue_decrease_key(BucketQueue *queue, int handle, int key);
+
+    RadixHeap *rheap_create(int capacity);
+    int rheap_insert(RadixHeap *heap, int handle, int key);
+    int rheap_extract(RadixHeap *heap, int *handle, int *key);
+    int rheap_decrease_key(RadixHeap *heap, int handle, int key);
+    \endcode
+
+    A bucket queue (Dial) has one bucket per key in [last, last +
+    span]: insertion and decrease_key run in time O(1), and an
+    extraction skips the empty buckets up to the next key, in time
+    O(span) at worst. It suits small spans, such as bounded edge
+    weights. A radix
+    heap has one bucket per bit of the keys: insertion and
+    decrease_key run in time O(1) and extraction in amortized time
+    O(log span), whatever the span.
+
+    Dijkstra's algorithm uses one of them, or an indexed heap when
+    distances could overflow.
+
     \section heap_examples Example
 
     The following example creates a heap of tasks.
@@ -0,0 +1,285 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include <string.h>
+#include "iheap.h"
+#include "util.h"
+
+#define father(i, shift) (((i)-1) >> (shift))
+#define first_child(i, shift) (((i) << (shift)) + 1)
+
+#define entry(heap, i) ((heap)->entries[i])
+
+static void SCEDA_iheap_grow(SCEDA_IHeap *heap, int capacity) {
+  SCEDA_Allocator *alloc = heap->alloc;
+  int old = heap->capacity;
+  heap->entries = alloc_realloc(alloc, heap->entries, old * sizeof(SCEDA_IHeapEntry), capacity * sizeof(SCEDA_IHeapEntry));
+  heap->pos = alloc_realloc(alloc, heap->pos, old * sizeof(int), capacity * sizeof(int));
+  heap->values = alloc_realloc(alloc, heap->values, old * sizeof(void *), capacity * sizeof(void *));
+  memset(&heap->pos[old], -1, (capacity - old) * sizeof(int));
+  heap->capacity = capacity;
+}
+
+void SCEDA_iheap_init_with_allocator(SCEDA_IHeap *heap, SCEDA_Allocator *alloc, int capacity,
+				     SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+				     SCEDA_compare_fun compare_key) {
+  if(capacity < SCEDA_DFLT_SIZE) {
+    capacity = SCEDA_DFLT_SIZE;
+  }
+  heap->size = 0;
+  heap->capacity = capacity;
+  heap->shift = 2;
+  heap->entries = alloc_malloc(alloc, capacity * sizeof(SCEDA_IHeapEntry));
+  heap->pos = alloc_malloc(alloc, capacity * sizeof(int));
+  heap->values = alloc_malloc(alloc, capacity * sizeof(void *));
+  memset(heap->pos, -1, capacity * sizeof(int));
+  heap->delete_value = delete_value;
+  heap->delete_key = delete_key;
+  heap->compare_key = compare_key;
+  heap->alloc = alloc;
+}
+
+void SCEDA_iheap_init(SCEDA_IHeap *heap, int capacity,
+		      SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+		      SCEDA_compare_fun compare_key) {
+  SCEDA_iheap_init_with_allocator(heap, SCEDA_allocator_get_default(), capacity, delete_value, delete_key, compare_key);
+}
+
+SCEDA_IHeap *SCEDA_iheap_create_with_allocator(SCEDA_Allocator *alloc, int capacity,
+					       SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+					       SCEDA_compare_fun compare_key) {
+  SCEDA_IHeap *heap = (SCEDA_IHeap *)alloc_malloc(alloc, sizeof(SCEDA_IHeap));
+  SCEDA_iheap_init_with_allocator(heap, alloc, capacity, delete_value, delete_key, compare_key);
+  return heap;
+}
+
+SCEDA_IHeap *SCEDA_iheap_create(int capacity,
+				SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+				SCEDA_compare_fun compare_key) {
+  return SCEDA_iheap_create_with_allocator(SCEDA_allocator_get_default(), capacity, delete_value, delete_key, compare_key);
+}
+
+static void SCEDA_iheap_cleanup_elts(SCEDA_IHeap *heap) {
+  int i;
+  for(i = 0; i < heap->size; i++) {
+    SCEDA_IHeapEntry *e = &entry(heap, i);
+    if(heap->delete_value != NULL) {
+      heap->delete_value(heap->values[e->handle]);
+    }
+    if(heap->delete_key != NULL) {
+      heap->delete_key(e->key);
+    }
+    heap->pos[e->handle] = -1;
+  }
+  heap->size = 0;
+}
+
+void SCEDA_iheap_cleanup(SCEDA_IHeap *heap) {
+  SCEDA_Allocator *alloc = heap->alloc;
+  int capacity = heap->capacity;
+  SCEDA_iheap_cleanup_elts(heap);
+  if(heap->entries != NULL) {
+    alloc_free(alloc, heap->entries, capacity * sizeof(SCEDA_IHeapEntry));
+    alloc_free(alloc, heap->pos, capacity * sizeof(int));
+    alloc_free(alloc, heap->values, capacity * sizeof(void *));
+  }
+  memset(heap, 0, sizeof(SCEDA_IHeap));
+  heap->alloc = alloc;
+}
+
+void SCEDA_iheap_delete(SCEDA_IHeap *heap) {
+  SCEDA_Allocator *alloc = heap->alloc;
+  SCEDA_iheap_cleanup(heap);
+  alloc_free(alloc, heap, sizeof(SCEDA_IHeap));
+}
+
+void SCEDA_iheap_clear(SCEDA_IHeap *heap) {
+  SCEDA_iheap_cleanup_elts(heap);
+}
+
+/* move the entry e up from the (free) index i to its place */
+static void SCEDA_iheap_sift_up(SCEDA_IHeap *heap, int i, SCEDA_IHeapEntry e) {
+  SCEDA_compare_fun compare = heap->compare_key;
+  int shift = heap->shift;
+
+  while(i != 0) {
+    int father = father(i, shift);
+    if(compare(entry(heap, father).key, e.key) <= 0) {
+      break;
+    }
+    entry(heap, i) = entry(heap, father);
+    heap->pos[entry(heap, i).handle] = i;
+    i = father;
+  }
+  entry(heap, i) = e;
+  heap->pos[e.handle] = i;
+}
+
+/* move the entry e down from the (free) index i to its place */
+static void SCEDA_iheap_sift_down(SCEDA_IHeap *heap, int i, SCEDA_IHeapEntry e) {
+  SCEDA_compare_fun compare = heap->compare_key;
+  int shift = heap->shift;
+  int size = heap->size;
+
+  for(;;) {
+    int c = first_child(i, shift);
+    if(c >= size) {
+      break;
+    }
+    int last = c + (1 << shift);
+    if(last > size) {
+      last = size;
+    }
+    int min = c;
+    for(c++; c < last; c++) {
+      if(compare(entry(heap, c).key, entry(heap, min).key) < 0) {
+	min = c;
+      }
+    }
+    if(compare(entry(heap, min).key, e.key) >= 0) {
+      break;
+    }
+    entry(heap, i) = entry(heap, min);
+    heap->pos[entry(heap, i).handle] = i;
+    i = min;
+  }
+  entry(heap, i) = e;
+  heap->pos[e.handle] = i;
+}
+
+int SCEDA_iheap_set_arity(SCEDA_IHeap *heap, int arity) {
+  int shift = 0;
+  while((1 << shift) < arity) {
+    shift++;
+  }
+  if((arity < 2) || (arity > SCEDA_IHEAP_MAX_ARITY) || ((1 << shift) != arity)) {
+    return -1;
+  }
+  if(shift != heap->shift) {
+    heap->shift = shift;
+    if(heap->size > 1) {
+      int i;
+      for(i = father(heap->size - 1, shift); i >= 0; i--) {
+	SCEDA_iheap_sift_down(heap, i, entry(heap, i));
+      }
+    }
+  }
+  return 0;
+}
+
+int SCEDA_iheap_insert(SCEDA_IHeap *heap, int handle, const void *value, const void *key) {
+  if(handle < 0) {
+    return -1;
+  }
+  if(handle >= heap->capacity) {
+    SCEDA_iheap_grow(heap, (handle < 2 * heap->capacity) ? 2 * heap->capacity : handle + 1);
+  } else if(heap->pos[handle] != -1) {
+    return -1;
+  }
+
+  SCEDA_IHeapEntry e;
+  e.key = (void *)key;
+  e.handle = handle;
+  heap->values[handle] = (void *)value;
+  heap->size++;
+  SCEDA_iheap_sift_up(heap, heap->size - 1, e);
+  return 0;
+}
+
+int SCEDA_iheap_min(SCEDA_IHeap *heap, int *handle, void **value, void **key) {
+  if(SCEDA_iheap_is_empty(heap)) {
+    return -1;
+  }
+  SCEDA_IHeapEntry *e = &entry(heap, 0);
+  if(handle != NULL) {
+    *handle = e->handle;
+  }
+  *value = heap->values[e->handle];
+  *key = e->key;
+  return 0;
+}
+
+/* remove the entry at index i */
+static void SCEDA_iheap_remove_at(SCEDA_IHeap *heap, int i) {
+  heap->pos[entry(heap, i).handle] = -1;
+  heap->size--;
+  if(i == heap->size) {
+    return;
+  }
+  // fill the hole with the last entry, which may have to go either way
+  SCEDA_IHeapEntry last = entry(heap, heap->size);
+  if((i != 0) && (heap->compare_key(last.key, entry(heap, father(i, heap->shift)).key) < 0)) {
+    SCEDA_iheap_sift_up(heap, i, last);
+  } else {
+    SCEDA_iheap_sift_down(heap, i, last);
+  }
+}
+
+int SCEDA_iheap_extract(SCEDA_IHeap *heap, int *handle, void **value, void **key) {
+  if(SCEDA_iheap_min(heap, handle, value, key) != 0) {
+    return -1;
+  }
+  SCEDA_iheap_remove_at(heap, 0);
+  return 0;
+}
+
+int SCEDA_iheap_decrease_key(SCEDA_IHeap *heap, int handle) {
+  if(!SCEDA_iheap_contains(heap, handle)) {
+    return -1;
+  }
+  int i = heap->pos[handle];
+  SCEDA_iheap_sift_up(heap, i, entry(heap, i));
+  return 0;
+}
+
+int SCEDA_iheap_increase_key(SCEDA_IHeap *heap, int handle) {
+  if(!SCEDA_iheap_contains(heap, handle)) {
+    return -1;
+  }
+  int i = heap->pos[handle];
+  SCEDA_iheap_sift_down(heap, i, entry(heap, i));
+  return 0;
+}
+
+void *SCEDA_iheap_change_key(SCEDA_IHeap *heap, int handle, const void *key) {
+  if(!SCEDA_iheap_contains(heap, handle)) {
+    return NULL;
+  }
+  int i = heap->pos[handle];
+  SCEDA_IHeapEntry e = entry(heap, i);
+  void *old_key = e.key;
+  e.key = (void *)key;
+  if(heap->compare_key(key, old_key) < 0) {
+    SCEDA_iheap_sift_up(heap, i, e);
+  } else {
+    SCEDA_iheap_sift_down(heap, i, e);
+  }
+  return old_key;
+}
+
+int SCEDA_iheap_remove(SCEDA_IHeap *heap, int handle, void **value, void **key) {
+  if(!SCEDA_iheap_contains(heap, handle)) {
+    return -1;
+  }
+  int i = heap->pos[handle];
+  *value = heap->values[handle];
+  *key = entry(heap, i).key;
+  SCEDA_iheap_remove_at(heap, i);
+  return 0;
+}
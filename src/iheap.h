@@ -0,0 +1,240 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_IHEAP_H
+#define __SCEDA_IHEAP_H
+/** \file iheap.h
+    \brief Indexed heaps (d-ary heaps with decrease key). */
+
+#include "common.h"
+
+/** Default arity of an indexed heap */
+#define SCEDA_IHEAP_DFLT_ARITY 4
+
+/** Maximal arity of an indexed heap */
+#define SCEDA_IHEAP_MAX_ARITY 16
+
+/** Entry of the heap array. The key is stored along with the handle
+    so that sifting does not dereference the per handle arrays. */
+typedef struct {
+  void *key;
+  int handle;
+} SCEDA_IHeapEntry;
+
+/** Indexed heap.
+
+    Elements are identified by dense integer handles (for instance
+    vertex indices), which give direct access to their position in
+    the heap: no element is allocated when inserting, and changing
+    the key of an element needs no pointer to it.
+
+    The children of the entry at index i are stored at indices
+    (i << shift) + 1 to (i << shift) + arity, where arity = 1 << shift.
+    pos[h] is the index of the entry of handle h, or -1 if h is not
+    in the heap. */
+typedef struct {
+  int size;
+  int capacity;
+  int shift;
+  SCEDA_IHeapEntry *entries;
+  int *pos;
+  void **values;
+  SCEDA_delete_fun delete_value;
+  SCEDA_delete_fun delete_key;
+  SCEDA_compare_fun compare_key;
+  SCEDA_Allocator *alloc;
+} SCEDA_IHeap;
+
+/** Initialise an indexed heap for handles 0 to capacity - 1. The
+    heap grows when larger handles are inserted.
+
+    @param[in] heap = heap to initialise
+    @param[in] capacity = number of handles
+    @param[in] delete_value = delete value function
+    @param[in] delete_key = delete key function
+    @param[in] compare_key = compare key function */
+void SCEDA_iheap_init(SCEDA_IHeap *heap, int capacity,
+		      SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+		      SCEDA_compare_fun compare_key);
+
+/** Create an indexed heap for handles 0 to capacity - 1.
+
+    @param[in] capacity = number of handles
+    @param[in] delete_value = delete value function
+    @param[in] delete_key = delete key function
+    @param[in] compare_key = compare key function
+
+    @return an indexed heap */
+SCEDA_IHeap *SCEDA_iheap_create(int capacity,
+				SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+				SCEDA_compare_fun compare_key);
+
+/** Initialise an indexed heap whose arrays are allocated by a given
+    allocator.
+
+    @param[in] heap = heap to initialise
+    @param[in] alloc = allocator
+    @param[in] capacity = number of handles
+    @param[in] delete_value = delete value function
+    @param[in] delete_key = delete key function
+    @param[in] compare_key = compare key function */
+void SCEDA_iheap_init_with_allocator(SCEDA_IHeap *heap, SCEDA_Allocator *alloc, int capacity,
+				     SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+				     SCEDA_compare_fun compare_key);
+
+/** Create an indexed heap. The heap and its arrays are allocated by
+    the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] capacity = number of handles
+    @param[in] delete_value = delete value function
+    @param[in] delete_key = delete key function
+    @param[in] compare_key = compare key function
+
+    @return an indexed heap */
+SCEDA_IHeap *SCEDA_iheap_create_with_allocator(SCEDA_Allocator *alloc, int capacity,
+					       SCEDA_delete_fun delete_value, SCEDA_delete_fun delete_key,
+					       SCEDA_compare_fun compare_key);
+
+/** Clean up an indexed heap.
+
+    @param[in] heap = heap to clean up */
+void SCEDA_iheap_cleanup(SCEDA_IHeap *heap);
+
+/** Delete an indexed heap.
+
+    @param[in] heap = heap to delete */
+void SCEDA_iheap_delete(SCEDA_IHeap *heap);
+
+/** Clear an indexed heap. Its capacity and arity are kept.
+
+    @param[in] heap = heap to clear */
+void SCEDA_iheap_clear(SCEDA_IHeap *heap);
+
+/** Set the arity of an indexed heap (4 by default). The heap is
+    rebuilt in time complexity O(|heap|).
+
+    @param[in] heap = heap
+    @param[in] arity = power of two between 2 and SCEDA_IHEAP_MAX_ARITY
+
+    @return 0 in case of success, -1 if arity is not valid */
+int SCEDA_iheap_set_arity(SCEDA_IHeap *heap, int arity);
+
+/** Insert an element into an indexed heap in time complexity
+    O(log|heap|).
+
+    @param[in] heap = heap
+    @param[in] handle = handle of the element (non negative)
+    @param[in] value = value to insert
+    @param[in] key = key associated to value
+
+    @return 0 in case of success, -1 if handle is negative or already in the heap */
+int SCEDA_iheap_insert(SCEDA_IHeap *heap, int handle, const void *value, const void *key);
+
+/** Extract the minimum element of an indexed heap in time complexity
+    O(log|heap|).
+
+    @param[in] heap = heap
+    @param[out] handle = handle of extracted element (set by function if not NULL)
+    @param[out] value = value of extracted element
+    @param[out] key = key of extracted element
+
+    @return 0 in case of success, -1 otherwise */
+int SCEDA_iheap_extract(SCEDA_IHeap *heap, int *handle, void **value, void **key);
+
+/** Return the minimum element of an indexed heap in time complexity O(1).
+
+    @param[in] heap = heap
+    @param[out] handle = handle of minimum element (set by function if not NULL)
+    @param[out] value = value of minimum element
+    @param[out] key = key of minimum element
+
+    @return 0 in case of success, -1 otherwise */
+int SCEDA_iheap_min(SCEDA_IHeap *heap, int *handle, void **value, void **key);
+
+/** Reflect the decrease of the key of an element, in time complexity
+    O(log|heap|).
+
+    @param[in] heap = heap
+    @param[in] handle = handle of the element whose key has decreased
+
+    @return 0 in case of success, -1 if handle is not in the heap */
+int SCEDA_iheap_decrease_key(SCEDA_IHeap *heap, int handle);
+
+/** Reflect the increase of the key of an element, in time complexity
+    O(log|heap|).
+
+    @param[in] heap = heap
+    @param[in] handle = handle of the element whose key has increased
+
+    @return 0 in case of success, -1 if handle is not in the heap */
+int SCEDA_iheap_increase_key(SCEDA_IHeap *heap, int handle);
+
+/** Modify the key of an element in time complexity O(log|heap|).
+
+    @param[in] heap = heap
+    @param[in] handle = handle of the element
+    @param[in] key = new key
+
+    @return the old key, or NULL if handle is not in the heap */
+void *SCEDA_iheap_change_key(SCEDA_IHeap *heap, int handle, const void *key);
+
+/** Remove an element from an indexed heap in time complexity
+    O(log|heap|).
+
+    @param[in] heap = heap
+    @param[in] handle = handle of the element to remove
+    @param[out] value = value of removed element
+    @param[out] key = key of removed element
+
+    @return 0 in case of success, -1 if handle is not in the heap */
+int SCEDA_iheap_remove(SCEDA_IHeap *heap, int handle, void **value, void **key);
+
+/** Test whether an element is in an indexed heap in time complexity O(1).
+
+    @param[in] heap = heap
+    @param[in] handle = handle
+
+    @return TRUE if handle is in the heap, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_iheap_contains(heap$, handle$)				\
+  ({ SCEDA_IHeap *_heap = (heap$);					\
+     int _handle = (handle$);						\
+     ((_handle >= 0) && (_handle < _heap->capacity) && (_heap->pos[_handle] != -1)); })
+
+/** Return the size of an indexed heap.
+
+    @param[in] heap = heap
+
+    @return the size of the heap
+
+    \hideinitializer */
+#define SCEDA_iheap_size(heap$) ((heap$)->size)
+
+/** Test whether an indexed heap is empty.
+
+    @param[in] heap = heap
+
+    @return TRUE if heap is empty, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_iheap_is_empty(heap$) (SCEDA_iheap_size(heap$) == 0)
+
+#endif
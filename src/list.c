@@ -21,22 +21,49 @@
 #include "list.h"
 #include "util.h"
 
-void SCEDA_list_init(SCEDA_List *list, SCEDA_delete_fun delete) {
+void SCEDA_list_init_with_allocator(SCEDA_List *list, SCEDA_Allocator *alloc, SCEDA_delete_fun delete) {
   list->size = 0;
   list->head = NULL;
   list->tail = NULL;
   list->delete = delete;
+  list->alloc = alloc;
+  list->pool = NULL;
+}
+
+void SCEDA_list_init(SCEDA_List *list, SCEDA_delete_fun delete) {
+  SCEDA_list_init_with_allocator(list, SCEDA_allocator_get_default(), delete);
+}
+
+SCEDA_List *SCEDA_list_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete) {
+  SCEDA_List *list = alloc_malloc(alloc, sizeof(SCEDA_List));
+  SCEDA_list_init_with_allocator(list, alloc, delete);
+  return list;
 }
 
 SCEDA_List *SCEDA_list_create(SCEDA_delete_fun delete) {
-  SCEDA_List *list = safe_malloc(sizeof(SCEDA_List));
-  SCEDA_list_init(list, delete);
+  return SCEDA_list_create_with_allocator(SCEDA_allocator_get_default(), delete);
+}
+
+void SCEDA_list_init_pooled(SCEDA_List *list, SCEDA_delete_fun delete) {
+  SCEDA_Pool *pool = SCEDA_pool_create(sizeof(SCEDA_ListElt));
+  SCEDA_list_init_with_allocator(list, SCEDA_pool_allocator(pool), delete);
+  list->pool = pool;
+}
+
+SCEDA_List *SCEDA_list_create_pooled(SCEDA_delete_fun delete) {
+  SCEDA_List *list = alloc_malloc(SCEDA_allocator_get_default(), sizeof(SCEDA_List));
+  SCEDA_list_init_pooled(list, delete);
   return list;
 }
 
-void SCEDA_list_cleanup(SCEDA_List *list) {
+static void SCEDA_list_cleanup_elts(SCEDA_List *list) {
   void *data = NULL;
 
+  if((list->delete == NULL) && ((list->pool != NULL) || (list->alloc->free == NULL))) {
+    // nothing to delete nor deallocate one by one
+    return;
+  }
+
   while(SCEDA_list_size(list) > 0) {
     if(SCEDA_list_rem_next(list, NULL, &data) == 0) {
       if(list->delete != NULL) {
@@ -44,23 +71,41 @@ void SCEDA_list_cleanup(SCEDA_List *list) {
       }
     }
   }
+}
 
+void SCEDA_list_cleanup(SCEDA_List *list) {
+  // keep the allocator of the list itself, so that it can still be
+  // cleaned up or deleted
+  SCEDA_Allocator *alloc = (list->pool != NULL) ? list->pool->upstream : list->alloc;
+  SCEDA_list_cleanup_elts(list);
+  if(list->pool != NULL) {
+    SCEDA_pool_delete(list->pool);
+  }
   memset(list, 0, sizeof(SCEDA_List));
+  list->alloc = alloc;
 }
 
 void SCEDA_list_delete(SCEDA_List *list) {
+  // a list owning its pool is allocated by the upstream allocator
+  SCEDA_Allocator *alloc = (list->pool != NULL) ? list->pool->upstream : list->alloc;
   SCEDA_list_cleanup(list);
-  free(list);
+  alloc_free(alloc, list, sizeof(SCEDA_List));
 }
 
 void SCEDA_list_clear(SCEDA_List *list) {
   SCEDA_delete_fun delete = list->delete;
-  SCEDA_list_cleanup(list);
-  SCEDA_list_init(list, delete);
+  SCEDA_Allocator *alloc = list->alloc;
+  SCEDA_Pool *pool = list->pool;
+  SCEDA_list_cleanup_elts(list);
+  if(pool != NULL) {
+    SCEDA_pool_clear(pool);
+  }
+  SCEDA_list_init_with_allocator(list, alloc, delete);
+  list->pool = pool;
 }
 
 int SCEDA_list_ins_next(SCEDA_List *list, SCEDA_ListElt *element, const void *data) {
-  SCEDA_ListElt *new_element = safe_malloc(sizeof(SCEDA_ListElt));
+  SCEDA_ListElt *new_element = alloc_malloc(list->alloc, sizeof(SCEDA_ListElt));
 
   new_element->data = (void *)data;
 
@@ -104,7 +149,7 @@ int SCEDA_list_rem_next(SCEDA_List *list, SCEDA_ListElt *element, void **data) {
   }
 
   *data = SCEDA_list_data(void *, old_element);
-  free(old_element);
+  alloc_free(list->alloc, old_element, sizeof(SCEDA_ListElt));
 
   list->size--;
   return 0;
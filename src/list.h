@@ -23,6 +23,7 @@
     \brief Linked lists implementation */
 
 #include "common.h"
+#include "pool.h"
 #include <string.h>
 
 typedef struct _SCEDA_ListElt {
@@ -35,6 +36,8 @@ typedef struct {
   SCEDA_ListElt *head;
   SCEDA_ListElt *tail;
   SCEDA_delete_fun delete;
+  SCEDA_Allocator *alloc;
+  SCEDA_Pool *pool;
 } SCEDA_List;
 
 /** Initialise a list.
@@ -43,6 +46,13 @@ typedef struct {
     @param[in] delete = function to delete data in the list or NULL */
 void SCEDA_list_init(SCEDA_List *list, SCEDA_delete_fun delete);
 
+/** Initialise a list whose elements are allocated by a given allocator.
+
+    @param[in] list = list to initialise
+    @param[in] alloc = allocator
+    @param[in] delete = function to delete data in the list or NULL */
+void SCEDA_list_init_with_allocator(SCEDA_List *list, SCEDA_Allocator *alloc, SCEDA_delete_fun delete);
+
 /** Create a new linked list, ready for use.
 
     @param[in] delete = function to delete data or NULL
@@ -50,6 +60,30 @@ void SCEDA_list_init(SCEDA_List *list, SCEDA_delete_fun delete);
     @return the linked list */
 SCEDA_List *SCEDA_list_create(SCEDA_delete_fun delete);
 
+/** Create a new linked list, ready for use. The list and its elements
+    are allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete = function to delete data or NULL
+
+    @return the linked list */
+SCEDA_List *SCEDA_list_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete);
+
+/** Initialise a linked list whose elements are allocated in a pool
+    owned by the list. Cleaning up the list releases the pool at once.
+
+    @param[in] list = list to initialise
+    @param[in] delete = function to delete data or NULL */
+void SCEDA_list_init_pooled(SCEDA_List *list, SCEDA_delete_fun delete);
+
+/** Create a new linked list, ready for use, whose elements are
+    allocated in a pool owned by the list.
+
+    @param[in] delete = function to delete data or NULL
+
+    @return the linked list */
+SCEDA_List *SCEDA_list_create_pooled(SCEDA_delete_fun delete);
+
 /** Delete all the elements (and possibly their data) of a list.
     The list is uninitialised.
 
@@ -18,12 +18,15 @@
    <http://www.gnu.org/licenses/>.
 */
 
-/** \page lists Linked lists, Stacks, Queues
+/** \page lists Linked lists, Stacks, Queues, Vectors
 
     SCEDA provides an implementation of linked lists. Stacks (LIFO)
     and Queues (FIFO) are implemented on top of this basic data
     structure.
 
+    Vectors are growable arrays of elements, with constant time
+    access to the i-th element.
+
     \section listsapi API
     \subsection llistssubsec Linked lists
 
@@ -248,6 +251,121 @@
 
     Test whether the given queue is empty.
 
+    \subsection arrayqueues Array-backed stacks and queues
+
+    \code
+    AStack *astack_create(delete_fun delete);
+    AQueue *aqueue_create(delete_fun delete);
+    \endcode
+
+    AStack and AQueue provide the same operations as Stack and Queue
+    (astack_push, astack_pop, aqueue_enqueue, aqueue_dequeue, ...),
+    with the same prototypes. Elements are stored in a growable array
+    (a circular one for queues) instead of a linked list, so pushing
+    and enqueueing cost no allocation but an occasional doubling of
+    the array. Unlike Stack and Queue, they are not lists and cannot
+    be iterated over. The graph algorithms use them internally.
+
+    \subsection concurrentqueues Concurrent queues
+
+    \code
+    CQueue *cqueue_create(int capacity, delete_fun delete);
+    int cqueue_try_enqueue(CQueue *queue, const void *data);
+    int cqueue_try_dequeue(CQueue *queue, void **data);
+    int cqueue_try_enqueue_many(CQueue *queue, void *data[], int n);
+    int cqueue_try_dequeue_many(CQueue *queue, void *data[], int n);
+    void cqueue_enqueue(CQueue *queue, const void *data);
+    void *cqueue_dequeue(CQueue *queue);
+    \endcode
+
+    A CQueue is a bounded queue that any number of threads may use at
+    the same time to enqueue and dequeue, without lock (Vyukov's
+    algorithm). Its capacity is fixed at creation, so that it never
+    allocates afterwards. The try_ operations fail instead of waiting
+    when the queue is full (or empty), and the _many variants move up
+    to n elements at the cost of a single atomic operation. The other
+    operations wait, spinning then yielding the processor.
+
+    \subsection vectors Vectors
+
+    \code
+    void vector_init(Vector *vector, delete_fun delete);
+    Vector *vector_create(delete_fun delete);
+    \endcode
+
+    Initialise or create a vector, i.e. a growable array. The delete
+    function provided is used (when not NULL) to delete vector elements
+    upon clean up/delete/clear.
+
+    \code
+    void vector_cleanup(Vector *vector);
+    void vector_delete(Vector *vector);
+    void vector_clear(Vector *vector);
+    \endcode
+
+    Clean up, delete or clear a vector. Clearing keeps the array.
+
+    \code
+    int vector_reserve(Vector *vector, int capacity);
+    int vector_shrink(Vector *vector);
+    int vector_resize(Vector *vector, int size);
+    \endcode
+
+    Make room for capacity elements, shrink the array to the size of
+    the vector, or change the size of the vector (new elements are
+    NULL).
+
+    \code
+    int vector_push(Vector *vector, const void *data);
+    int vector_pop(Vector *vector, void **data);
+    \endcode
+
+    Add (resp. remove) an element at the end of the vector in
+    amortized time complexity O(1).
+
+    \code
+    type vector_get(type, Vector *vector, int i);
+    void vector_set(Vector *vector, int i, const void *data);
+    \endcode
+
+    Return or replace the i-th element of the vector in time
+    complexity O(1). Indices are not checked.
+
+    \code
+    int vector_insert(Vector *vector, int i, const void *data);
+    int vector_insert_array(Vector *vector, int i, void *data[], int count);
+    int vector_remove(Vector *vector, int i, void **data);
+    \endcode
+
+    Insert one or count elements at position i, or remove the element
+    at position i, in time complexity O(n).
+
+    \code
+    void vector_sort(Vector *vector, compare_fun compare);
+    int vector_bsearch(Vector *vector, const void *data, compare_fun compare);
+    \endcode
+
+    Sort the vector (stable merge sort) in time complexity O(n.log(n)),
+    and look for an element in a sorted vector in time complexity
+    O(log(n)). vector_bsearch returns the position of the first
+    element equal to data, or -1.
+
+    \code
+    int vector_size(Vector *vector);
+    int vector_is_empty(Vector *vector);
+    \endcode
+
+    Return the size of the vector or test whether it is empty.
+
+    \code
+    void vector_iterator_init(Vector *vector, VectorIterator *iter);
+    int vector_iterator_has_next(VectorIterator *iter);
+    void *vector_iterator_next(VectorIterator *iter);
+    void vector_iterator_cleanup(VectorIterator *iter);
+    \endcode
+
+    Iterate over the elements of the vector, in order.
+
     \section list_examples Example
 
     \subsection list_exa List example
@@ -283,4 +401,11 @@
 
     \include "queue/main.c"
 
+    \subsection vector_exa Vector example
+
+    The following example fills a vector with Integers, sorts it and
+    looks for some elements by binary search.
+
+    \include "vector/main.c"
+
  */
@@ -21,27 +21,58 @@
 #include "listmap.h"
 #include "util.h"
 
-void SCEDA_listmap_init(SCEDA_ListMap *map, SCEDA_delete_fun delete_key,
-		  SCEDA_delete_fun delete_value, SCEDA_match_fun match_key) {
+void SCEDA_listmap_init_with_allocator(SCEDA_ListMap *map, SCEDA_Allocator *alloc, SCEDA_delete_fun delete_key,
+				       SCEDA_delete_fun delete_value, SCEDA_match_fun match_key) {
   map->size = 0;
   map->head = NULL;
   map->tail = NULL;
   map->delete_key = delete_key;
   map->delete_value = delete_value;
   map->match_key = match_key;
+  map->alloc = alloc;
+  map->pool = NULL;
+}
+
+void SCEDA_listmap_init(SCEDA_ListMap *map, SCEDA_delete_fun delete_key,
+		  SCEDA_delete_fun delete_value, SCEDA_match_fun match_key) {
+  SCEDA_listmap_init_with_allocator(map, SCEDA_allocator_get_default(), delete_key, delete_value, match_key);
+}
+
+SCEDA_ListMap *SCEDA_listmap_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete_key,
+						   SCEDA_delete_fun delete_value, SCEDA_match_fun match_key) {
+  SCEDA_ListMap *map = alloc_malloc(alloc, sizeof(SCEDA_ListMap));
+  SCEDA_listmap_init_with_allocator(map, alloc, delete_key, delete_value, match_key);
+  return map;
 }
 
 SCEDA_ListMap *SCEDA_listmap_create(SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
 			SCEDA_match_fun match_key) {
-  SCEDA_ListMap *map = safe_malloc(sizeof(SCEDA_ListMap));
-  SCEDA_listmap_init(map, delete_key, delete_value, match_key);
+  return SCEDA_listmap_create_with_allocator(SCEDA_allocator_get_default(), delete_key, delete_value, match_key);
+}
+
+void SCEDA_listmap_init_pooled(SCEDA_ListMap *map, SCEDA_delete_fun delete_key,
+			       SCEDA_delete_fun delete_value, SCEDA_match_fun match_key) {
+  SCEDA_Pool *pool = SCEDA_pool_create(sizeof(SCEDA_ListMapElt));
+  SCEDA_listmap_init_with_allocator(map, SCEDA_pool_allocator(pool), delete_key, delete_value, match_key);
+  map->pool = pool;
+}
+
+SCEDA_ListMap *SCEDA_listmap_create_pooled(SCEDA_delete_fun delete_key,
+					   SCEDA_delete_fun delete_value, SCEDA_match_fun match_key) {
+  SCEDA_ListMap *map = alloc_malloc(SCEDA_allocator_get_default(), sizeof(SCEDA_ListMap));
+  SCEDA_listmap_init_pooled(map, delete_key, delete_value, match_key);
   return map;
 }
 
-void SCEDA_listmap_cleanup(SCEDA_ListMap *map) {
+static void SCEDA_listmap_cleanup_elts(SCEDA_ListMap *map) {
   void *key = NULL;
   void *value = NULL;
 
+  if((map->delete_key == NULL) && (map->delete_value == NULL) && ((map->pool != NULL) || (map->alloc->free == NULL))) {
+    // nothing to delete nor deallocate one by one
+    return;
+  }
+
   while(SCEDA_listmap_size(map) > 0) {
     if(SCEDA_listmap_rem_next(map, NULL, &key, &value) == 0) {
       if(map->delete_key != NULL) {
@@ -52,25 +83,43 @@ void SCEDA_listmap_cleanup(SCEDA_ListMap *map) {
       }
     }
   }
+}
 
+void SCEDA_listmap_cleanup(SCEDA_ListMap *map) {
+  // keep the allocator of the map itself, so that it can still be
+  // cleaned up or deleted
+  SCEDA_Allocator *alloc = (map->pool != NULL) ? map->pool->upstream : map->alloc;
+  SCEDA_listmap_cleanup_elts(map);
+  if(map->pool != NULL) {
+    SCEDA_pool_delete(map->pool);
+  }
   memset(map, 0, sizeof(SCEDA_ListMap));
+  map->alloc = alloc;
 }
 
 void SCEDA_listmap_delete(SCEDA_ListMap *map) {
+  // a map owning its pool is allocated by the upstream allocator
+  SCEDA_Allocator *alloc = (map->pool != NULL) ? map->pool->upstream : map->alloc;
   SCEDA_listmap_cleanup(map);
-  free(map);
+  alloc_free(alloc, map, sizeof(SCEDA_ListMap));
 }
 
 void SCEDA_listmap_clear(SCEDA_ListMap *map) {
   SCEDA_delete_fun delete_key = map->delete_key;
   SCEDA_delete_fun delete_value = map->delete_value;
   SCEDA_match_fun match_key = map->match_key;
-  SCEDA_listmap_cleanup(map);
-  SCEDA_listmap_init(map, delete_key, delete_value, match_key);
+  SCEDA_Allocator *alloc = map->alloc;
+  SCEDA_Pool *pool = map->pool;
+  SCEDA_listmap_cleanup_elts(map);
+  if(pool != NULL) {
+    SCEDA_pool_clear(pool);
+  }
+  SCEDA_listmap_init_with_allocator(map, alloc, delete_key, delete_value, match_key);
+  map->pool = pool;
 }
 
 int SCEDA_listmap_ins_next(SCEDA_ListMap *map, SCEDA_ListMapElt *element, const void *key, const void *value) {
-  SCEDA_ListMapElt *new_element = safe_malloc(sizeof(SCEDA_ListMapElt));
+  SCEDA_ListMapElt *new_element = alloc_malloc(map->alloc, sizeof(SCEDA_ListMapElt));
 
   new_element->key = (void *)key;
   new_element->value = (void *)value;
@@ -118,7 +167,7 @@ int SCEDA_listmap_rem_next(SCEDA_ListMap *map, SCEDA_ListMapElt *element,
 
   *key = SCEDA_listmap_key(void *, old_element);
   *value = SCEDA_listmap_value(void *, old_element);
-  free(old_element);
+  alloc_free(map->alloc, old_element, sizeof(SCEDA_ListMapElt));
 
   map->size--;
   return 0;
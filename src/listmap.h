@@ -23,6 +23,7 @@
     \brief ListMap implementation */
 
 #include "common.h"
+#include "pool.h"
 #include <string.h>
 
 typedef struct _SCEDA_ListMapElt {
@@ -38,6 +39,8 @@ typedef struct {
   SCEDA_delete_fun delete_key;
   SCEDA_delete_fun delete_value;
   SCEDA_match_fun match_key;
+  SCEDA_Allocator *alloc;
+  SCEDA_Pool *pool;
 } SCEDA_ListMap;
 
 /** Initialise a (list) map.
@@ -49,6 +52,17 @@ typedef struct {
 void SCEDA_listmap_init(SCEDA_ListMap *map, SCEDA_delete_fun delete_key,
 			SCEDA_delete_fun delete_value, SCEDA_match_fun match_key);
 
+/** Initialise a (list) map whose bindings are allocated by a given
+    allocator.
+
+    @param[in] map = map to initialise
+    @param[in] alloc = allocator
+    @param[in] delete_key = function to delete keys or NULL
+    @param[in] delete_value = function to delete values or NULL
+    @param[in] match_key = equality function on keys */
+void SCEDA_listmap_init_with_allocator(SCEDA_ListMap *map, SCEDA_Allocator *alloc, SCEDA_delete_fun delete_key,
+				       SCEDA_delete_fun delete_value, SCEDA_match_fun match_key);
+
 /** Create a new (list) map, ready for use.
 
     @param[in] delete_key = function to delete keys or NULL
@@ -59,6 +73,39 @@ void SCEDA_listmap_init(SCEDA_ListMap *map, SCEDA_delete_fun delete_key,
 SCEDA_ListMap *SCEDA_listmap_create(SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
 				    SCEDA_match_fun match_key);
 
+/** Create a new (list) map, ready for use. The map and its bindings
+    are allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete_key = function to delete keys or NULL
+    @param[in] delete_value = function to delete values or NULL
+    @param[in] match_key = equality function on keys
+
+    @return the (list) map */
+SCEDA_ListMap *SCEDA_listmap_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete_key,
+						   SCEDA_delete_fun delete_value, SCEDA_match_fun match_key);
+
+/** Initialise a (list) map whose elements are allocated in a pool
+    owned by the map. Cleaning up the map releases the pool at once.
+
+    @param[in] map = map
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] match_key = equality function on keys */
+void SCEDA_listmap_init_pooled(SCEDA_ListMap *map, SCEDA_delete_fun delete_key,
+			       SCEDA_delete_fun delete_value, SCEDA_match_fun match_key);
+
+/** Create a (list) map, ready for use, whose elements are allocated
+    in a pool owned by the map.
+
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] match_key = equality function on keys
+
+    @return the (list) map */
+SCEDA_ListMap *SCEDA_listmap_create_pooled(SCEDA_delete_fun delete_key,
+					   SCEDA_delete_fun delete_value, SCEDA_match_fun match_key);
+
 /** Delete all the elements (and possibly their data) of a map.
     The map is uninitialised.
 
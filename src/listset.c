@@ -21,25 +21,36 @@
 #include "util.h"
 #include <string.h>
 
-void SCEDA_listset_init(SCEDA_ListSet *set, SCEDA_delete_fun delete, SCEDA_match_fun match) {
-  SCEDA_list_init(SCEDA_listset_elements(set), delete);
+void SCEDA_listset_init_with_allocator(SCEDA_ListSet *set, SCEDA_Allocator *alloc,
+				       SCEDA_delete_fun delete, SCEDA_match_fun match) {
+  SCEDA_list_init_with_allocator(SCEDA_listset_elements(set), alloc, delete);
   set->match = match;
 }
 
-SCEDA_ListSet *SCEDA_listset_create(SCEDA_delete_fun delete, SCEDA_match_fun match) {
-  SCEDA_ListSet *set = (SCEDA_ListSet *)safe_malloc(sizeof(SCEDA_ListSet));
-  SCEDA_listset_init(set, delete, match);
+void SCEDA_listset_init(SCEDA_ListSet *set, SCEDA_delete_fun delete, SCEDA_match_fun match) {
+  SCEDA_listset_init_with_allocator(set, SCEDA_allocator_get_default(), delete, match);
+}
+
+SCEDA_ListSet *SCEDA_listset_create_with_allocator(SCEDA_Allocator *alloc,
+						   SCEDA_delete_fun delete, SCEDA_match_fun match) {
+  SCEDA_ListSet *set = (SCEDA_ListSet *)alloc_malloc(alloc, sizeof(SCEDA_ListSet));
+  SCEDA_listset_init_with_allocator(set, alloc, delete, match);
   return set;
 }
 
+SCEDA_ListSet *SCEDA_listset_create(SCEDA_delete_fun delete, SCEDA_match_fun match) {
+  return SCEDA_listset_create_with_allocator(SCEDA_allocator_get_default(), delete, match);
+}
+
 void SCEDA_listset_cleanup(SCEDA_ListSet *set) {
   SCEDA_list_cleanup(SCEDA_listset_elements(set));
-  memset(set, 0, sizeof(SCEDA_ListSet));
+  set->match = NULL;
 }
 
 void SCEDA_listset_delete(SCEDA_ListSet *set) {
+  SCEDA_Allocator *alloc = SCEDA_listset_elements(set)->alloc;
   SCEDA_listset_cleanup(set);
-  free(set);
+  alloc_free(alloc, set, sizeof(SCEDA_ListSet));
 }
 
 void SCEDA_listset_clear(SCEDA_ListSet *set) {
@@ -37,6 +37,16 @@ typedef struct {
     @param[in] match = equality function */
 void SCEDA_listset_init(SCEDA_ListSet *set, SCEDA_delete_fun delete, SCEDA_match_fun match);
 
+/** Initialise a (list) set whose elements are allocated by a given
+    allocator.
+
+    @param[in] set = set to initialise
+    @param[in] alloc = allocator
+    @param[in] delete = function to delete data in the set or NULL
+    @param[in] match = equality function */
+void SCEDA_listset_init_with_allocator(SCEDA_ListSet *set, SCEDA_Allocator *alloc,
+				       SCEDA_delete_fun delete, SCEDA_match_fun match);
+
 /** Create a new (list) set, ready for use.
 
     @param[in] delete = function to delete data in the set or NULL
@@ -45,6 +55,17 @@ void SCEDA_listset_init(SCEDA_ListSet *set, SCEDA_delete_fun delete, SCEDA_match
     @return the (list) set */
 SCEDA_ListSet *SCEDA_listset_create(SCEDA_delete_fun delete, SCEDA_match_fun match);
 
+/** Create a new (list) set, ready for use. The set and its elements
+    are allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete = function to delete data in the set or NULL
+    @param[in] match = equality function
+
+    @return the set */
+SCEDA_ListSet *SCEDA_listset_create_with_allocator(SCEDA_Allocator *alloc,
+						   SCEDA_delete_fun delete, SCEDA_match_fun match);
+
 /** Clean up all the elements of a (list) set.
     The set is uninitialised.
 
@@ -135,4 +135,71 @@
       free(x);
     }
     \endcode
+
+    \section alloc_subsec Memory allocators
+
+    Containers obtain their memory (the data structure itself when
+    created, nodes, elements, tables...) from a SCEDA_Allocator. The
+    "init" and "create" functions use the default allocator, which is
+    malloc/free unless changed by SCEDA_allocator_set_default. Each
+    container also provides "init_with_allocator" and
+    "create_with_allocator" variants that take the allocator as first
+    argument (after the data structure for "init").
+
+    \code
+    void data_structure_init_with_allocator(DataStructure *x, SCEDA_Allocator *alloc, va_list args);
+    DataStructure *data_structure_create_with_allocator(SCEDA_Allocator *alloc, va_list args);
+    \endcode
+
+    The allocator is remembered by the container until it is cleaned
+    up, and "clear" keeps it. An allocator with no free function
+    behaves as an arena: memory is released all at once by its owner,
+    and cleaning up a container without delete functions then costs
+    no traversal at all.
+
+    A SCEDA_Pool hands out fixed-size blocks carved out of slabs and
+    recycles them through a free list. Its allocator view
+    (SCEDA_pool_allocator) can be shared by several containers whose
+    nodes have the same size. The node-based containers (lists, list
+    maps, tree sets and maps, Fibonacci heaps) also provide "pooled"
+    variants of "init" and "create" that give the container its own
+    pool: when it is cleaned up, the whole pool is released instead of
+    freeing every node.
+
+    \code
+    void data_structure_init_pooled(DataStructure *x, va_list args);
+    DataStructure *data_structure_create_pooled(va_list args);
+    \endcode
+
+    \section typed_subsec Type-specialised containers
+
+    The generic containers store void * pointers: scalar data must be
+    boxed and every comparison or hash goes through a function
+    pointer. The headers typed_vector.h, typed_pqueue.h,
+    typed_hashset.h and typed_hashmap.h provide macros that define a
+    container type specialised to given element types, with static
+    inline functions prefixed by the name of the type. Elements are
+    stored unboxed and the comparison, hash and equality operations,
+    given as macros or functions, are inlined.
+
+    \code
+    #define int_less(a, b) ((a) < (b))
+    #define int_hash(x) ((unsigned int)(x))
+    #define int_eq(a, b) ((a) == (b))
+
+    SCEDA_DEFINE_VECTOR(IntVector, int)
+    SCEDA_DEFINE_PQUEUE(IntPQueue, int, int_less)
+    SCEDA_DEFINE_HASHMAP(IntMap, int, double, int_hash, int_eq)
+
+    IntMap map;
+    IntMap_init(&map);
+    IntMap_put(&map, 42, 3.14, NULL);
+    double *x = IntMap_get(&map, 42);
+    IntMap_cleanup(&map);
+    \endcode
+
+    These containers follow the usual conventions (init, create,
+    cleanup, delete, clear, init_with_allocator) but, being expanded
+    in user code, they do not call the SCEDA failure handler: functions
+    that allocate memory return -1 when the allocator fails.
 */
@@ -44,6 +44,28 @@
 
     (depends on the hash function, worst case is linear time)
 
+    Bindings are stored inline (key and value pointers) in a single
+    contiguous table using open addressing with Robin Hood probing, so
+    that no memory is allocated per binding.
+    Maps holding at most #SCEDA_HASHMAP_SMALL_SIZE bindings do not
+    allocate any table at all: the bindings are stored inline and
+    searched linearly. This is the case of most adjacency maps of sparse
+    graphs.
+
+    When the number of bindings is known in advance, use
+    SCEDA_hashmap_create_with_capacity() or SCEDA_hashmap_reserve() to
+    avoid successive resizings. SCEDA_hashmap_set_shrink() disables
+    shrinking for maps whose size oscillates.
+
+    SCEDA_hashmap_set_layout() with #SCEDA_HASH_ORDERED stores the
+    bindings in a dense array, in insertion order, so that iterating
+    over the map does not visit empty buckets. #SCEDA_HASH_SWISS
+    selects a Swiss table, probed by groups of buckets guided by a
+    control byte per bucket (see \ref hashsets_sec).
+
+    SCEDA_hashmap_get_many() looks up an array of keys at once,
+    prefetching their buckets before probing the map.
+
     \section treemaps_sec TreeMap
 
     TreeMap is an efficient implementation of sequential access
@@ -52,6 +74,71 @@
     Insertion, Removal and Membership test run in logarithmic time
     O(log|map|).
 
+    Tree maps also answer ordered queries on keys in logarithmic
+    time: SCEDA_treemap_floor(), SCEDA_treemap_ceiling(),
+    SCEDA_treemap_lower() and SCEDA_treemap_higher() find the binding
+    with the nearest key below or above a given one (e.g. the next
+    event after a given date in a schedule), and
+    SCEDA_treemap_iterator_init_lower_bound() and
+    SCEDA_treemap_iterator_init_upper_bound() start an iteration at a
+    given key. SCEDA_treemap_rank() and SCEDA_treemap_select() convert
+    between keys and their positions in the map.
+
+    SCEDA_treemap_build_sorted() fills an empty tree map from arrays of
+    keys (in ascending order) and values in linear time.
+    SCEDA_treemap_union(), SCEDA_treemap_intersection(),
+    SCEDA_treemap_difference() and SCEDA_treemap_is_subset() combine
+    two maps by merging their keys in time O(|map1|+|map2|).
+
+    \section btreemaps_sec BTreeMap
+
+    BTreeMap is an alternative implementation of sequential access
+    maps, based on B-trees. Each node holds up to
+    SCEDA_BTREE_MAX_KEYS bindings in sorted arrays, so that a search
+    visits a few contiguous nodes instead of one node per key
+    comparison. Insertion, Removal and Membership test run in
+    logarithmic time O(log|map|), but with far fewer cache misses than
+    tree maps on large maps.
+
+    B-tree maps support SCEDA_btreemap_floor(),
+    SCEDA_btreemap_ceiling(), SCEDA_btreemap_lower(),
+    SCEDA_btreemap_higher() and bounded iterators as tree maps do, but
+    not rank and select.
+
+    \section ptreemaps_sec PTreeMap
+
+    PTreeMap is a persistent (immutable) map, based on AVL trees.
+    SCEDA_ptreemap_put() and SCEDA_ptreemap_remove() return a new
+    version of the map in logarithmic time, by copying the path to the
+    modified binding: all the other nodes are shared with the previous
+    version, which remains valid.
+
+    Versions and nodes are reference counted, so that a version can be
+    read by any number of threads while new versions are being built.
+    A SCEDA_PTreeMapCell holds the current version: the writer
+    publishes versions with SCEDA_ptreemap_cell_set(), and readers take
+    snapshots in constant time with SCEDA_ptreemap_cell_get(). Neither
+    side waits for the other to finish its work.
+
+    Persistent maps do not own their keys and values, and they do not
+    follow the API below: they are created with
+    SCEDA_ptreemap_create() and released with SCEDA_ptreemap_release().
+
+    \section chashmaps_sec CHashMap
+
+    CHashMap is a hash map that may be shared between threads. Keys
+    are spread over a fixed number of stripes (64 by default, see
+    SCEDA_chashmap_create_with_stripes()), each of them being a
+    HashMap with its own mutex: threads only wait for each other
+    when they use keys of the same stripe.
+
+    It follows the API below (with the "chashmap" prefix) and the
+    same equality and hash functions as HashMap. Besides,
+    SCEDA_chashmap_compute_if_absent() atomically returns the value
+    bound to a key, computing and binding it first when the key is
+    unbound, which is what a cache shared by several workers needs.
+    Iterators must not be used while the map is being modified.
+
     \section mapsapi_sec API
 
     The API for maps is described below.
@@ -186,11 +273,15 @@
 
     \section map_examples Examples
 
-    The following three examples create a map indexed by strings and
+    The following examples create a map indexed by strings and
     whose target values are Integers.
 
     It then print the map content, using a map iterator.
 
+    The TreeMap and BTreeMap examples go on with ordered queries, and
+    the TreeMap example with a map built from sorted keys and map
+    algebra.
+
     Finally, the map is deleted.
 
     \subsection listmap_exa ListMap example
@@ -205,4 +296,12 @@
 
     \include "treemap/main.c"
 
+    \subsection btreemap_exa BTreeMap example
+
+    \include "btreemap/main.c"
+
+    \subsection ptreemap_exa PTreeMap example
+
+    \include "ptreemap/main.c"
+
 */
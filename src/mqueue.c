@@ -0,0 +1,206 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include <string.h>
+#include "mqueue.h"
+#include "util.h"
+
+#define try_lock(h) (__atomic_exchange_n(&((h)->lock), 1, __ATOMIC_ACQUIRE) == 0)
+#define unlock(h) (__atomic_store_n(&((h)->lock), 0, __ATOMIC_RELEASE))
+
+/* per thread random numbers (xorshift) */
+static __thread unsigned int SCEDA_mqueue_seed = 0;
+
+static inline int random_heap(SCEDA_MultiQueue *mqueue) {
+  unsigned int x = SCEDA_mqueue_seed;
+  if(x == 0) {
+    // seed from the address of the thread local variable
+    x = (unsigned int)(unsigned long)&SCEDA_mqueue_seed;
+    x = (x ^ (x >> 16)) * 0x85ebca6bu;
+    x |= 1;
+  }
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  SCEDA_mqueue_seed = x;
+  return (int)(x % (unsigned int)mqueue->queues);
+}
+
+void SCEDA_mqueue_init_with_allocator(SCEDA_MultiQueue *mqueue, SCEDA_Allocator *alloc, int threads,
+				      SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  if(threads < 1) {
+    threads = 1;
+  }
+  mqueue->queues = SCEDA_MQUEUE_FACTOR * threads;
+  mqueue->alloc = alloc;
+  mqueue->heap = alloc_malloc(alloc, mqueue->queues * sizeof(SCEDA_MultiQueueHeap));
+  int i;
+  for(i = 0; i < mqueue->queues; i++) {
+    SCEDA_MultiQueueHeap *h = &(mqueue->heap[i]);
+    h->lock = 0;
+    h->size = 0;
+    SCEDA_pqueue_init_with_allocator(&(h->pqueue), alloc, delete, compare);
+  }
+}
+
+void SCEDA_mqueue_init(SCEDA_MultiQueue *mqueue, int threads, SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  SCEDA_mqueue_init_with_allocator(mqueue, SCEDA_allocator_get_default(), threads, delete, compare);
+}
+
+SCEDA_MultiQueue *SCEDA_mqueue_create_with_allocator(SCEDA_Allocator *alloc, int threads,
+						     SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  SCEDA_MultiQueue *mqueue = (SCEDA_MultiQueue *)alloc_malloc(alloc, sizeof(SCEDA_MultiQueue));
+  SCEDA_mqueue_init_with_allocator(mqueue, alloc, threads, delete, compare);
+  return mqueue;
+}
+
+SCEDA_MultiQueue *SCEDA_mqueue_create(int threads, SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  return SCEDA_mqueue_create_with_allocator(SCEDA_allocator_get_default(), threads, delete, compare);
+}
+
+void SCEDA_mqueue_cleanup(SCEDA_MultiQueue *mqueue) {
+  int i;
+  for(i = 0; i < mqueue->queues; i++) {
+    SCEDA_pqueue_cleanup(&(mqueue->heap[i].pqueue));
+  }
+  SCEDA_Allocator *alloc = mqueue->alloc;
+  if(mqueue->heap != NULL) {
+    alloc_free(alloc, mqueue->heap, mqueue->queues * sizeof(SCEDA_MultiQueueHeap));
+  }
+  memset(mqueue, 0, sizeof(SCEDA_MultiQueue));
+  mqueue->alloc = alloc;
+}
+
+void SCEDA_mqueue_delete(SCEDA_MultiQueue *mqueue) {
+  SCEDA_Allocator *alloc = mqueue->alloc;
+  SCEDA_mqueue_cleanup(mqueue);
+  alloc_free(alloc, mqueue, sizeof(SCEDA_MultiQueue));
+}
+
+int SCEDA_mqueue_insert(SCEDA_MultiQueue *mqueue, const void *data) {
+  SCEDA_MultiQueueHeap *h;
+  do {
+    h = &(mqueue->heap[random_heap(mqueue)]);
+  } while(!try_lock(h));
+
+  int res = SCEDA_pqueue_insert(&(h->pqueue), data);
+  if(res == 0) {
+    __atomic_store_n(&(h->size), SCEDA_pqueue_size(&(h->pqueue)), __ATOMIC_RELAXED);
+  }
+  unlock(h);
+
+  return res;
+}
+
+#define heap_size(h) (__atomic_load_n(&((h)->size), __ATOMIC_RELAXED))
+
+int SCEDA_mqueue_size(SCEDA_MultiQueue *mqueue) {
+  int size = 0;
+  int i;
+  for(i = 0; i < mqueue->queues; i++) {
+    size += heap_size(&(mqueue->heap[i]));
+  }
+  return size;
+}
+
+// extract the minimum of h1 or h2 (h2 may be NULL), which are locked
+static int SCEDA_mqueue_extract_better(SCEDA_MultiQueueHeap *h1, SCEDA_MultiQueueHeap *h2, void **data) {
+  SCEDA_MultiQueueHeap *best = NULL;
+  void *min1, *min2;
+  if(SCEDA_pqueue_min(&(h1->pqueue), &min1) == 0) {
+    best = h1;
+  }
+  if((h2 != NULL) && (SCEDA_pqueue_min(&(h2->pqueue), &min2) == 0)) {
+    if((best == NULL) || (h2->pqueue.compare(min2, min1) < 0)) {
+      best = h2;
+    }
+  }
+  if(best == NULL) {
+    return -1;
+  }
+  safe_call(SCEDA_pqueue_extract(&(best->pqueue), data));
+  __atomic_store_n(&(best->size), SCEDA_pqueue_size(&(best->pqueue)), __ATOMIC_RELAXED);
+  return 0;
+}
+
+int SCEDA_mqueue_extract(SCEDA_MultiQueue *mqueue, void **data) {
+  // emptiness is only told by the sizes of the internal queues: no
+  // counter is shared by all the threads
+  int empty_picks = 0;
+  for(;;) {
+    if(empty_picks == SCEDA_MQUEUE_EMPTY_PICKS) {
+      // scan all the queues, from a random one
+      int start = random_heap(mqueue);
+      int busy = FALSE;
+      int i;
+      for(i = 0; i < mqueue->queues; i++) {
+	SCEDA_MultiQueueHeap *h = &(mqueue->heap[(start + i) % mqueue->queues]);
+	if(heap_size(h) == 0) {
+	  continue;
+	}
+	if(!try_lock(h)) {
+	  busy = TRUE;
+	  continue;
+	}
+	int res = SCEDA_mqueue_extract_better(h, NULL, data);
+	unlock(h);
+	if(res == 0) {
+	  return 0;
+	}
+      }
+      if(!busy) {
+	return -1;
+      }
+      empty_picks = 0;
+    }
+
+    SCEDA_MultiQueueHeap *h1 = &(mqueue->heap[random_heap(mqueue)]);
+    SCEDA_MultiQueueHeap *h2 = &(mqueue->heap[random_heap(mqueue)]);
+    if(heap_size(h1) == 0) {
+      if(heap_size(h2) == 0) {
+	empty_picks++;
+	continue;
+      }
+      h1 = h2;
+    }
+    if((h2 == h1) || (heap_size(h2) == 0)) {
+      h2 = NULL;
+    }
+
+    if(!try_lock(h1)) {
+      continue;
+    }
+    if((h2 != NULL) && !try_lock(h2)) {
+      h2 = NULL;
+    }
+
+    // pick the better of the two (their sizes may have changed)
+    int res = SCEDA_mqueue_extract_better(h1, h2, data);
+
+    if(h2 != NULL) {
+      unlock(h2);
+    }
+    unlock(h1);
+
+    if(res == 0) {
+      return 0;
+    }
+    empty_picks++;
+  }
+}
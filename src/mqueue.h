@@ -0,0 +1,153 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_MQUEUE_H
+#define __SCEDA_MQUEUE_H
+/** \file mqueue.h
+    \brief Relaxed concurrent priority queues (MultiQueues) */
+
+#include "common.h"
+#include "pqueue.h"
+
+/** Number of internal priority queues per thread of a MultiQueue */
+#define SCEDA_MQUEUE_FACTOR 2
+
+/** Number of consecutive picks of empty internal queues after which
+    a MultiQueue extraction scans all of them */
+#define SCEDA_MQUEUE_EMPTY_PICKS 8
+
+/** Internal priority queue of a MultiQueue, with its try-lock. size
+    mirrors the size of pqueue so that empty queues are skipped
+    without being locked. The structure fills whole cache lines, so
+    that neighbouring queues do not share them. */
+typedef struct {
+  int lock;
+  int size;
+  SCEDA_PQueue pqueue;
+  char pad[SCEDA_CACHE_LINE - (2 * sizeof(int) + sizeof(SCEDA_PQueue)) % SCEDA_CACHE_LINE];
+} SCEDA_MultiQueueHeap;
+
+/** Relaxed priority queue that may be shared by any number of
+    threads.
+
+    Elements are spread over several priority queues, each guarded by
+    a spin lock that is only ever tried: a thread never waits for a
+    busy queue and picks another one instead. An element is inserted
+    into a random queue. Extraction picks two random queues and
+    extracts the minimum of the better one.
+
+    The extracted element is therefore not always the minimum of the
+    whole queue, but it is among the smallest ones (its expected rank
+    is linear in the number of internal queues). In exchange, threads
+    seldom contend. There is no global counter either: the size of the
+    MultiQueue is the sum of the sizes of its internal queues. */
+typedef struct {
+  int queues;
+  SCEDA_Allocator *alloc;
+  SCEDA_MultiQueueHeap *heap;
+} SCEDA_MultiQueue;
+
+/** Initialise a MultiQueue for a given number of threads.
+
+    @param[in] mqueue = MultiQueue to initialise
+    @param[in] threads = number of threads using the MultiQueue
+    @param[in] delete = delete function or NULL
+    @param[in] compare = comparison function */
+void SCEDA_mqueue_init(SCEDA_MultiQueue *mqueue, int threads, SCEDA_delete_fun delete, SCEDA_compare_fun compare);
+
+/** Initialise a MultiQueue whose internal queues are allocated by a
+    given (thread-safe) allocator.
+
+    @param[in] mqueue = MultiQueue to initialise
+    @param[in] alloc = allocator
+    @param[in] threads = number of threads using the MultiQueue
+    @param[in] delete = delete function or NULL
+    @param[in] compare = comparison function */
+void SCEDA_mqueue_init_with_allocator(SCEDA_MultiQueue *mqueue, SCEDA_Allocator *alloc, int threads,
+				      SCEDA_delete_fun delete, SCEDA_compare_fun compare);
+
+/** Create a MultiQueue for a given number of threads.
+
+    @param[in] threads = number of threads using the MultiQueue
+    @param[in] delete = delete function or NULL
+    @param[in] compare = comparison function
+
+    @return the MultiQueue */
+SCEDA_MultiQueue *SCEDA_mqueue_create(int threads, SCEDA_delete_fun delete, SCEDA_compare_fun compare);
+
+/** Create a MultiQueue. The MultiQueue and its internal queues are
+    allocated by the given (thread-safe) allocator.
+
+    @param[in] alloc = allocator
+    @param[in] threads = number of threads using the MultiQueue
+    @param[in] delete = delete function or NULL
+    @param[in] compare = comparison function
+
+    @return the MultiQueue */
+SCEDA_MultiQueue *SCEDA_mqueue_create_with_allocator(SCEDA_Allocator *alloc, int threads,
+						     SCEDA_delete_fun delete, SCEDA_compare_fun compare);
+
+/** Clean up a MultiQueue. No other thread may use it.
+
+    @param[in] mqueue = MultiQueue to clean up */
+void SCEDA_mqueue_cleanup(SCEDA_MultiQueue *mqueue);
+
+/** Delete a MultiQueue. No other thread may use it.
+
+    @param[in] mqueue = MultiQueue to delete */
+void SCEDA_mqueue_delete(SCEDA_MultiQueue *mqueue);
+
+/** Insert an element in a MultiQueue in expected time complexity
+    O(log|mqueue|).
+
+    @param[in] mqueue = MultiQueue
+    @param[in] data = data to insert
+
+    @return 0 in case of success, -1 otherwise */
+int SCEDA_mqueue_insert(SCEDA_MultiQueue *mqueue, const void *data);
+
+/** Extract one of the smallest elements of a MultiQueue in expected
+    time complexity O(log|mqueue|).
+
+    After SCEDA_MQUEUE_EMPTY_PICKS picks of empty internal queues in a
+    row, all of them are scanned: the extraction fails if they are all
+    empty. Under concurrent insertions, it may thus fail although an
+    element is being inserted.
+
+    @param[in] mqueue = MultiQueue
+    @param[out] data = extracted data
+
+    @return 0 in case of success, -1 if the MultiQueue is empty */
+int SCEDA_mqueue_extract(SCEDA_MultiQueue *mqueue, void **data);
+
+/** Give the size of a MultiQueue. Under concurrent operations, the
+    result is only an estimate.
+
+    @param[in] mqueue = MultiQueue
+
+    @return the number of elements in the MultiQueue */
+int SCEDA_mqueue_size(SCEDA_MultiQueue *mqueue);
+
+/** MultiQueue is empty? Under concurrent operations, the result is
+    only an estimate.
+
+    \hideinitializer */
+#define SCEDA_mqueue_is_empty(mqueue$) (SCEDA_mqueue_size(mqueue$) == 0)
+
+#endif
@@ -0,0 +1,119 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include <string.h>
+#include "pool.h"
+#include "util.h"
+
+// blocks are aligned on pointers (and so is the slab header)
+#define align(size) (((size) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+#define slab_header_size (align(sizeof(SCEDA_PoolSlab)))
+
+static void *SCEDA_pool_alloc(size_t size, SCEDA_Pool *pool) {
+  if(size > pool->size) {
+    return pool->upstream->alloc(size, pool->upstream->ctxt);
+  }
+
+  void *block = pool->free_list;
+  if(block != NULL) {
+    pool->free_list = *((void **)block);
+    return block;
+  }
+
+  if(pool->next == pool->end) {
+    size_t slab_size = slab_header_size + pool->slab_length * pool->size;
+    SCEDA_PoolSlab *slab = pool->upstream->alloc(slab_size, pool->upstream->ctxt);
+    if(slab == NULL) {
+      return NULL;
+    }
+    slab->next = pool->slabs;
+    slab->size = slab_size;
+    pool->slabs = slab;
+    pool->next = ((char *)slab) + slab_header_size;
+    pool->end = ((char *)slab) + slab_size;
+    if(pool->slab_length < SCEDA_POOL_MAX_SLAB_LENGTH) {
+      pool->slab_length *= 2;
+    }
+  }
+
+  block = pool->next;
+  pool->next += pool->size;
+  return block;
+}
+
+static void SCEDA_pool_free(void *ptr, size_t size, SCEDA_Pool *pool) {
+  if(size > pool->size) {
+    alloc_free(pool->upstream, ptr, size);
+    return;
+  }
+
+  *((void **)ptr) = pool->free_list;
+  pool->free_list = ptr;
+}
+
+void SCEDA_pool_init_with_allocator(SCEDA_Pool *pool, SCEDA_Allocator *upstream, size_t size) {
+  pool->allocator.alloc = (SCEDA_alloc_fun)SCEDA_pool_alloc;
+  pool->allocator.free = (SCEDA_free_fun)SCEDA_pool_free;
+  pool->allocator.ctxt = pool;
+  pool->upstream = upstream;
+  // a free block holds the free list link
+  pool->size = align((size < sizeof(void *)) ? sizeof(void *) : size);
+  pool->slab_length = SCEDA_POOL_MIN_SLAB_LENGTH;
+  pool->slabs = NULL;
+  pool->free_list = NULL;
+  pool->next = NULL;
+  pool->end = NULL;
+}
+
+void SCEDA_pool_init(SCEDA_Pool *pool, size_t size) {
+  SCEDA_pool_init_with_allocator(pool, SCEDA_allocator_get_default(), size);
+}
+
+SCEDA_Pool *SCEDA_pool_create_with_allocator(SCEDA_Allocator *upstream, size_t size) {
+  SCEDA_Pool *pool = (SCEDA_Pool *)alloc_malloc(upstream, sizeof(SCEDA_Pool));
+  SCEDA_pool_init_with_allocator(pool, upstream, size);
+  return pool;
+}
+
+SCEDA_Pool *SCEDA_pool_create(size_t size) {
+  return SCEDA_pool_create_with_allocator(SCEDA_allocator_get_default(), size);
+}
+
+void SCEDA_pool_cleanup(SCEDA_Pool *pool) {
+  SCEDA_PoolSlab *slab = pool->slabs;
+  while(slab != NULL) {
+    SCEDA_PoolSlab *next = slab->next;
+    alloc_free(pool->upstream, slab, slab->size);
+    slab = next;
+  }
+  memset(pool, 0, sizeof(SCEDA_Pool));
+}
+
+void SCEDA_pool_delete(SCEDA_Pool *pool) {
+  SCEDA_Allocator *upstream = pool->upstream;
+  SCEDA_pool_cleanup(pool);
+  alloc_free(upstream, pool, sizeof(SCEDA_Pool));
+}
+
+void SCEDA_pool_clear(SCEDA_Pool *pool) {
+  SCEDA_Allocator *upstream = pool->upstream;
+  size_t size = pool->size;
+  SCEDA_pool_cleanup(pool);
+  SCEDA_pool_init_with_allocator(pool, upstream, size);
+}
@@ -0,0 +1,114 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_POOL_H
+#define __SCEDA_POOL_H
+/** \file pool.h
+    \brief Pools of fixed-size blocks */
+
+#include "common.h"
+
+/** Slab of a pool. Blocks follow the header. */
+typedef struct _SCEDA_PoolSlab {
+  struct _SCEDA_PoolSlab *next;
+  size_t size;
+} SCEDA_PoolSlab;
+
+/** Pool of fixed-size blocks.
+
+    Blocks are carved out of slabs obtained from an upstream
+    allocator, and freed blocks are recycled through a free list. The
+    slabs are only given back to the upstream allocator when the pool
+    is cleaned up (or cleared), all at once.
+
+    The pool is seen by the containers as an allocator (see
+    SCEDA_pool_allocator). Requests larger than the block size are
+    forwarded to the upstream allocator. */
+typedef struct {
+  SCEDA_Allocator allocator;
+  SCEDA_Allocator *upstream;
+  size_t size;
+  int slab_length;
+  SCEDA_PoolSlab *slabs;
+  void *free_list;
+  char *next;
+  char *end;
+} SCEDA_Pool;
+
+/** Number of blocks of the first slab of a pool. Each new slab is
+    twice as large as the previous one, up to
+    SCEDA_POOL_MAX_SLAB_LENGTH blocks. */
+#define SCEDA_POOL_MIN_SLAB_LENGTH 32
+#define SCEDA_POOL_MAX_SLAB_LENGTH 4096
+
+/** Initialise a pool.
+
+    @param[in] pool = pool
+    @param[in] size = size of the blocks */
+void SCEDA_pool_init(SCEDA_Pool *pool, size_t size);
+
+/** Initialise a pool whose slabs are obtained from a given allocator.
+
+    @param[in] pool = pool
+    @param[in] upstream = allocator of the slabs
+    @param[in] size = size of the blocks */
+void SCEDA_pool_init_with_allocator(SCEDA_Pool *pool, SCEDA_Allocator *upstream, size_t size);
+
+/** Create a pool, ready for use.
+
+    @param[in] size = size of the blocks
+
+    @return the pool */
+SCEDA_Pool *SCEDA_pool_create(size_t size);
+
+/** Create a pool, ready for use. The pool and its slabs are allocated
+    by the given allocator.
+
+    @param[in] upstream = allocator of the slabs
+    @param[in] size = size of the blocks
+
+    @return the pool */
+SCEDA_Pool *SCEDA_pool_create_with_allocator(SCEDA_Allocator *upstream, size_t size);
+
+/** Clean up a pool. All the blocks are released at once.
+
+    @param[in] pool = pool to clean up */
+void SCEDA_pool_cleanup(SCEDA_Pool *pool);
+
+/** Delete a pool. All the blocks are released at once.
+
+    @param[in] pool = pool to delete */
+void SCEDA_pool_delete(SCEDA_Pool *pool);
+
+/** Clear a pool. All the blocks are released at once.
+
+    @param[in] pool = pool to clear */
+void SCEDA_pool_clear(SCEDA_Pool *pool);
+
+/** Return the allocator view of a pool, to be given to the
+    containers. The allocator is valid as long as the pool is.
+
+    @param[in] pool = pool
+
+    @return the allocator
+
+    \hideinitializer */
+#define SCEDA_pool_allocator(pool$) (&((pool$)->allocator))
+
+#endif
@@ -21,28 +21,40 @@
 #include "pqueue.h"
 #include "util.h"
 
-#define father(i) ((i-1)/2)
-#define left(i) (2*(i)+1)
-#define right(i) (2*(i)+2)
+#define father(i, shift) (((i)-1) >> (shift))
+#define first_child(i, shift) (((i) << (shift)) + 1)
 
 #define nth_elt(table, i) ((*(table))[(i)])
 
 #define SCEDA_pqueue_elt(pqueue, i) (nth_elt((pqueue)->elts, i))
 
-void SCEDA_pqueue_init(SCEDA_PQueue *pqueue, SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+void SCEDA_pqueue_init_with_allocator(SCEDA_PQueue *pqueue, SCEDA_Allocator *alloc,
+				      SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
   pqueue->size = 0;
   pqueue->length = SCEDA_DFLT_SIZE;
+  pqueue->shift = __builtin_ctz(SCEDA_PQUEUE_DFLT_ARITY);
+  pqueue->shrink = TRUE;
   pqueue->delete = delete;
   pqueue->compare = compare;
-  pqueue->elts = safe_calloc(pqueue->length, sizeof(void *));
+  pqueue->alloc = alloc;
+  pqueue->elts = alloc_calloc(alloc, pqueue->length, sizeof(void *));
 }
 
-SCEDA_PQueue *SCEDA_pqueue_create(SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
-  SCEDA_PQueue *pqueue = (SCEDA_PQueue *)safe_malloc(sizeof(SCEDA_PQueue));
-  SCEDA_pqueue_init(pqueue, delete, compare);
+void SCEDA_pqueue_init(SCEDA_PQueue *pqueue, SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  SCEDA_pqueue_init_with_allocator(pqueue, SCEDA_allocator_get_default(), delete, compare);
+}
+
+SCEDA_PQueue *SCEDA_pqueue_create_with_allocator(SCEDA_Allocator *alloc,
+						 SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  SCEDA_PQueue *pqueue = (SCEDA_PQueue *)alloc_malloc(alloc, sizeof(SCEDA_PQueue));
+  SCEDA_pqueue_init_with_allocator(pqueue, alloc, delete, compare);
   return pqueue;
 }
 
+SCEDA_PQueue *SCEDA_pqueue_create(SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  return SCEDA_pqueue_create_with_allocator(SCEDA_allocator_get_default(), delete, compare);
+}
+
 void SCEDA_pqueue_cleanup(SCEDA_PQueue *pqueue) {
   SCEDA_delete_fun delete = pqueue->delete;
 
@@ -53,20 +65,31 @@ void SCEDA_pqueue_cleanup(SCEDA_PQueue *pqueue) {
     }
   }
 
-  free(pqueue->elts);
+  SCEDA_Allocator *alloc = pqueue->alloc;
+  if(pqueue->elts != NULL) {
+    alloc_free(alloc, pqueue->elts, pqueue->length * sizeof(void *));
+  }
+  // keep the allocator, so that the queue can still be cleaned up or deleted
   memset(pqueue, 0, sizeof(SCEDA_PQueue));
+  pqueue->alloc = alloc;
 }
 
 void SCEDA_pqueue_delete(SCEDA_PQueue *pqueue) {
+  SCEDA_Allocator *alloc = pqueue->alloc;
   SCEDA_pqueue_cleanup(pqueue);
-  free(pqueue);
+  alloc_free(alloc, pqueue, sizeof(SCEDA_PQueue));
 }
 
 void SCEDA_pqueue_clear(SCEDA_PQueue *pqueue) {
   SCEDA_delete_fun delete = pqueue->delete;
   SCEDA_compare_fun compare = pqueue->compare;
+  SCEDA_Allocator *alloc = pqueue->alloc;
+  int shift = pqueue->shift;
+  int shrink = pqueue->shrink;
   SCEDA_pqueue_cleanup(pqueue);
-  SCEDA_pqueue_init(pqueue, delete, compare);
+  SCEDA_pqueue_init_with_allocator(pqueue, alloc, delete, compare);
+  pqueue->shift = shift;
+  pqueue->shrink = shrink;
 }
 
 static void resize_pqueue(SCEDA_PQueue *pqueue, const int length) {
@@ -74,71 +97,155 @@ static void resize_pqueue(SCEDA_PQueue *pqueue, const int length) {
     return;
   }
 
-  pqueue->elts = safe_realloc(pqueue->elts, length * sizeof(void *));
+  pqueue->elts = alloc_realloc(pqueue->alloc, pqueue->elts, pqueue->length * sizeof(void *), length * sizeof(void *));
   pqueue->length = length;
 }
 
-int SCEDA_pqueue_insert(SCEDA_PQueue *pqueue, const void *data) {
-  int i;
+/* move data up from the (free) index i to its place */
+static void SCEDA_pqueue_sift_up(SCEDA_PQueue *pqueue, int i, void *data) {
   SCEDA_compare_fun compare = pqueue->compare;
-
-  i = pqueue->size;
-  pqueue->size++;
-
-  if(pqueue->size > pqueue->length) {
-    resize_pqueue(pqueue, 1+2*pqueue->length);
-  }
+  int shift = pqueue->shift;
 
   while(i != 0) {
-    int father = father(i);
+    int father = father(i, shift);
     if(compare(SCEDA_pqueue_elt(pqueue, father), data) < 0) {
       break;
     }
     SCEDA_pqueue_elt(pqueue, i) = SCEDA_pqueue_elt(pqueue, father);
     i = father;
   }
-  SCEDA_pqueue_elt(pqueue, i) = (void *)data;
-  return 0;
+  SCEDA_pqueue_elt(pqueue, i) = data;
 }
 
-int SCEDA_pqueue_extract(SCEDA_PQueue *pqueue, void **data) {
-  int i;
+/* move data down from the (free) index i to its place */
+static void SCEDA_pqueue_sift_down(SCEDA_PQueue *pqueue, int i, void *data) {
   SCEDA_compare_fun compare = pqueue->compare;
+  int shift = pqueue->shift;
+  int size = pqueue->size;
 
-  if(SCEDA_pqueue_is_empty(pqueue)) {
-    return -1;
-  }
-  *data = SCEDA_pqueue_elt(pqueue, 0);
-  pqueue->size--;
-  void *ndata = SCEDA_pqueue_elt(pqueue, pqueue->size);
-
-  for(i=0;;) {
-    int l = left(i);
-    int r = right(i);
-    int min;
-    void *mindata;
-    if((l < pqueue->size) &&
-       (compare(SCEDA_pqueue_elt(pqueue, l), ndata) < 0)) {
-      min = l;
-      mindata = SCEDA_pqueue_elt(pqueue,l);
-    } else {
-      min = i;
-      mindata = ndata;
+  for(;;) {
+    int c = first_child(i, shift);
+    if(c >= size) {
+      break;
     }
-    if((r < pqueue->size) &&
-       (compare(SCEDA_pqueue_elt(pqueue, r), mindata) < 0)) {
-      min = r;
-      mindata = SCEDA_pqueue_elt(pqueue,r);
+    int last = c + (1 << shift);
+    if(last > size) {
+      last = size;
     }
-    if(i == min) {
+    int min = c;
+    void *mindata = SCEDA_pqueue_elt(pqueue, c);
+    for(c++; c < last; c++) {
+      if(compare(SCEDA_pqueue_elt(pqueue, c), mindata) < 0) {
+	min = c;
+	mindata = SCEDA_pqueue_elt(pqueue, c);
+      }
+    }
+    if(compare(mindata, data) >= 0) {
       break;
     }
     SCEDA_pqueue_elt(pqueue, i) = mindata;
     i = min;
   }
-  SCEDA_pqueue_elt(pqueue,i) = ndata;
+  SCEDA_pqueue_elt(pqueue, i) = data;
+}
+
+/* Floyd's bottom-up construction, in linear time */
+static void SCEDA_pqueue_heapify(SCEDA_PQueue *pqueue) {
+  int i;
+  if(pqueue->size <= 1) {
+    return;
+  }
+  for(i = father(pqueue->size - 1, pqueue->shift); i >= 0; i--) {
+    SCEDA_pqueue_sift_down(pqueue, i, SCEDA_pqueue_elt(pqueue, i));
+  }
+}
+
+void SCEDA_pqueue_init_from_array(SCEDA_PQueue *pqueue, SCEDA_delete_fun delete, SCEDA_compare_fun compare,
+				  void *data[], int n) {
+  SCEDA_pqueue_init(pqueue, delete, compare);
+  if(n > pqueue->length) {
+    resize_pqueue(pqueue, n);
+  }
+  if(n > 0) {
+    memcpy(&SCEDA_pqueue_elt(pqueue, 0), data, n * sizeof(void *));
+  }
+  pqueue->size = n;
+  SCEDA_pqueue_heapify(pqueue);
+}
+
+SCEDA_PQueue *SCEDA_pqueue_create_from_array(SCEDA_delete_fun delete, SCEDA_compare_fun compare,
+					     void *data[], int n) {
+  SCEDA_PQueue *pqueue = (SCEDA_PQueue *)alloc_malloc(SCEDA_allocator_get_default(), sizeof(SCEDA_PQueue));
+  SCEDA_pqueue_init_from_array(pqueue, delete, compare, data, n);
+  return pqueue;
+}
+
+int SCEDA_pqueue_set_arity(SCEDA_PQueue *pqueue, int arity) {
+  int shift = 0;
+  while((1 << shift) < arity) {
+    shift++;
+  }
+  if((arity < 2) || (arity > SCEDA_PQUEUE_MAX_ARITY) || ((1 << shift) != arity)) {
+    return -1;
+  }
+  if(shift != pqueue->shift) {
+    pqueue->shift = shift;
+    SCEDA_pqueue_heapify(pqueue);
+  }
+  return 0;
+}
+
+void SCEDA_pqueue_set_shrink(SCEDA_PQueue *pqueue, int shrink) {
+  pqueue->shrink = shrink;
+}
+
+int SCEDA_pqueue_insert(SCEDA_PQueue *pqueue, const void *data) {
+  int i = pqueue->size;
+  pqueue->size++;
+
+  if(pqueue->size > pqueue->length) {
+    resize_pqueue(pqueue, 1+2*pqueue->length);
+  }
+
+  SCEDA_pqueue_sift_up(pqueue, i, (void *)data);
+  return 0;
+}
+
+int SCEDA_pqueue_insert_all(SCEDA_PQueue *pqueue, void *data[], int n) {
+  int i;
+  if(n <= 0) {
+    return (n == 0) ? 0 : -1;
+  }
+
+  int size = pqueue->size;
+  if(size + n > pqueue->length) {
+    int length = 1+2*pqueue->length;
+    resize_pqueue(pqueue, (length < size + n) ? size + n : length);
+  }
+
+  if(n >= size) {
+    // rebuilding the whole heap is cheaper
+    memcpy(&SCEDA_pqueue_elt(pqueue, size), data, n * sizeof(void *));
+    pqueue->size = size + n;
+    SCEDA_pqueue_heapify(pqueue);
+  } else {
+    for(i = 0; i < n; i++) {
+      pqueue->size++;
+      SCEDA_pqueue_sift_up(pqueue, size + i, data[i]);
+    }
+  }
+  return 0;
+}
+
+int SCEDA_pqueue_extract(SCEDA_PQueue *pqueue, void **data) {
+  if(SCEDA_pqueue_is_empty(pqueue)) {
+    return -1;
+  }
+  *data = SCEDA_pqueue_elt(pqueue, 0);
+  pqueue->size--;
+  SCEDA_pqueue_sift_down(pqueue, 0, SCEDA_pqueue_elt(pqueue, pqueue->size));
 
-  if(4*pqueue->size < pqueue->length) {
+  if(pqueue->shrink && (4*pqueue->size < pqueue->length)) {
     resize_pqueue(pqueue, 1+pqueue->length/2);
   }
 
@@ -20,7 +20,11 @@
 
 /** \page pqueues Priority queues
 
-    Priority queues are implemented as binary heaps.
+    Priority queues are implemented as d-ary heaps stored in an array,
+    binary by default. SCEDA_pqueue_set_arity() makes the heap 4-ary or
+    8-ary, which is shallower and more cache-friendly for large
+    queues. SCEDA_pqueue_set_shrink() keeps the array from being
+    reallocated when a queue is repeatedly filled and emptied.
 
     \section pqueueapi API
 
@@ -34,6 +38,15 @@
     queue clean up/delete. The comparison function compares the
     priority of the elements.
 
+    \code
+    void pqueue_init_from_array(PQueue *pqueue, delete_fun delete, compare_fun compare, void *data[], int n);
+    PQueue *pqueue_create_from_array(delete_fun delete, compare_fun compare, void *data[], int n);
+    \endcode
+
+    Initialise or create a priority queue holding the elements of an
+    array in time O(n), which is faster than inserting them one by
+    one.
+
     \code
     void pqueue_cleanup(PQueue *pqueue);
     void pqueue_delete(PQueue *pqueue);
@@ -55,6 +68,14 @@
 
     Insert a new element in the priority queue in time O(log|pqueue|).
 
+    \code
+    int pqueue_insert_all(PQueue *pqueue, void *data[], int n);
+    \endcode
+
+    Insert the elements of an array in the priority queue. The heap is
+    rebuilt in time O(|pqueue|+n) when there are at least as many new
+    elements as old ones.
+
     \code
     int pqueue_extract(PQueue *pqueue, void **data);
     \endcode
@@ -79,6 +100,26 @@
 
     Test whether the given priority queue is empty.
 
+    \section mqueues MultiQueues
+
+    Priority queues are not thread-safe. A MultiQueue (see \link
+    mqueue.h \endlink) is a relaxed priority queue that any number of
+    threads may share.
+
+    \code
+    MultiQueue *mqueue_create(int threads, delete_fun delete, compare_fun compare);
+    int mqueue_insert(MultiQueue *mqueue, const void *data);
+    int mqueue_extract(MultiQueue *mqueue, void **data);
+    \endcode
+
+    It holds MQUEUE_FACTOR priority queues per thread, each guarded by
+    a try-lock. Insertion goes into a random queue that is not busy;
+    extraction picks two random queues and extracts the minimum of the
+    better one. The extracted element is thus one of the smallest, but
+    not necessarily the minimum: this suits parallel label-correcting
+    algorithms and job dispatchers, where the order is a heuristic and
+    contention on a single heap would be the bottleneck.
+
     \section pqueue_examples Example
 
     The following example creates a priority queue of tasks.
@@ -0,0 +1,322 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include <string.h>
+#include "ptreemap.h"
+#include "util.h"
+
+/* reference counts are shared between threads: the thread dropping
+   the last reference must see every write made by the others */
+#define atomic_incr(x) (__atomic_add_fetch(&(x), 1, __ATOMIC_RELAXED))
+#define atomic_decr(x) (__atomic_sub_fetch(&(x), 1, __ATOMIC_ACQ_REL))
+
+#define height(x) (((x) == NULL) ? 0 : (x)->height)
+
+static SCEDA_PTreeMapNode *SCEDA_ptreemap_node_retain(SCEDA_PTreeMapNode *x) {
+  if(x != NULL) {
+    atomic_incr(x->refcount);
+  }
+  return x;
+}
+
+static void SCEDA_ptreemap_node_release(SCEDA_PTreeMap *map, SCEDA_PTreeMapNode *x) {
+  while((x != NULL) && (atomic_decr(x->refcount) == 0)) {
+    SCEDA_PTreeMapNode *right = x->right;
+    SCEDA_ptreemap_node_release(map, x->left);
+    alloc_free(map->alloc, x, sizeof(SCEDA_PTreeMapNode));
+    x = right;
+  }
+}
+
+/* Build a node from two subtrees whose heights differ by at most
+   one. The node takes over the references to left and right. */
+static SCEDA_PTreeMapNode *SCEDA_ptreemap_node_create(SCEDA_PTreeMap *map, void *key, void *value,
+						      SCEDA_PTreeMapNode *left, SCEDA_PTreeMapNode *right) {
+  SCEDA_PTreeMapNode *x = (SCEDA_PTreeMapNode *)alloc_malloc(map->alloc, sizeof(SCEDA_PTreeMapNode));
+  int hl = height(left);
+  int hr = height(right);
+  x->key = key;
+  x->value = value;
+  x->height = ((hl > hr) ? hl : hr) + 1;
+  x->refcount = 1;
+  x->left = left;
+  x->right = right;
+  return x;
+}
+
+/* Build a balanced node from two subtrees whose heights differ by at
+   most two, rotating copies of the nodes on the higher side. The node
+   takes over the references to left and right. */
+static SCEDA_PTreeMapNode *SCEDA_ptreemap_balance(SCEDA_PTreeMap *map, void *key, void *value,
+						  SCEDA_PTreeMapNode *left, SCEDA_PTreeMapNode *right) {
+  SCEDA_PTreeMapNode *x;
+  int hl = height(left);
+  int hr = height(right);
+  if(hl > hr + 1) {
+    SCEDA_PTreeMapNode *ll = SCEDA_ptreemap_node_retain(left->left);
+    SCEDA_PTreeMapNode *lr = SCEDA_ptreemap_node_retain(left->right);
+    if(height(ll) >= height(lr)) {
+      x = SCEDA_ptreemap_node_create(map, left->key, left->value, ll,
+				     SCEDA_ptreemap_node_create(map, key, value, lr, right));
+    } else {
+      SCEDA_PTreeMapNode *lrl = SCEDA_ptreemap_node_retain(lr->left);
+      SCEDA_PTreeMapNode *lrr = SCEDA_ptreemap_node_retain(lr->right);
+      x = SCEDA_ptreemap_node_create(map, lr->key, lr->value,
+				     SCEDA_ptreemap_node_create(map, left->key, left->value, ll, lrl),
+				     SCEDA_ptreemap_node_create(map, key, value, lrr, right));
+      SCEDA_ptreemap_node_release(map, lr);
+    }
+    SCEDA_ptreemap_node_release(map, left);
+  } else if(hr > hl + 1) {
+    SCEDA_PTreeMapNode *rl = SCEDA_ptreemap_node_retain(right->left);
+    SCEDA_PTreeMapNode *rr = SCEDA_ptreemap_node_retain(right->right);
+    if(height(rr) >= height(rl)) {
+      x = SCEDA_ptreemap_node_create(map, right->key, right->value,
+				     SCEDA_ptreemap_node_create(map, key, value, left, rl), rr);
+    } else {
+      SCEDA_PTreeMapNode *rll = SCEDA_ptreemap_node_retain(rl->left);
+      SCEDA_PTreeMapNode *rlr = SCEDA_ptreemap_node_retain(rl->right);
+      x = SCEDA_ptreemap_node_create(map, rl->key, rl->value,
+				     SCEDA_ptreemap_node_create(map, key, value, left, rll),
+				     SCEDA_ptreemap_node_create(map, right->key, right->value, rlr, rr));
+      SCEDA_ptreemap_node_release(map, rl);
+    }
+    SCEDA_ptreemap_node_release(map, right);
+  } else {
+    x = SCEDA_ptreemap_node_create(map, key, value, left, right);
+  }
+  return x;
+}
+
+static SCEDA_PTreeMap *SCEDA_ptreemap_version(SCEDA_PTreeMap *map, SCEDA_PTreeMapNode *root, int size) {
+  SCEDA_PTreeMap *res = (SCEDA_PTreeMap *)alloc_malloc(map->alloc, sizeof(SCEDA_PTreeMap));
+  res->refcount = 1;
+  res->size = size;
+  res->root = root;
+  res->compare_key = map->compare_key;
+  res->alloc = map->alloc;
+  return res;
+}
+
+SCEDA_PTreeMap *SCEDA_ptreemap_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_compare_fun compare_key) {
+  SCEDA_PTreeMap *map = (SCEDA_PTreeMap *)alloc_malloc(alloc, sizeof(SCEDA_PTreeMap));
+  map->refcount = 1;
+  map->size = 0;
+  map->root = NULL;
+  map->compare_key = compare_key;
+  map->alloc = alloc;
+  return map;
+}
+
+SCEDA_PTreeMap *SCEDA_ptreemap_create(SCEDA_compare_fun compare_key) {
+  return SCEDA_ptreemap_create_with_allocator(SCEDA_allocator_get_default(), compare_key);
+}
+
+SCEDA_PTreeMap *SCEDA_ptreemap_retain(SCEDA_PTreeMap *map) {
+  atomic_incr(map->refcount);
+  return map;
+}
+
+void SCEDA_ptreemap_release(SCEDA_PTreeMap *map) {
+  if(atomic_decr(map->refcount) == 0) {
+    SCEDA_ptreemap_node_release(map, map->root);
+    alloc_free(map->alloc, map, sizeof(SCEDA_PTreeMap));
+  }
+}
+
+static SCEDA_PTreeMapNode *SCEDA_ptreemap_find(SCEDA_PTreeMap *map, const void *key) {
+  SCEDA_compare_fun compare = map->compare_key;
+  SCEDA_PTreeMapNode *x = map->root;
+  while(x != NULL) {
+    int res = compare(key, x->key);
+    if(res == 0) {
+      break;
+    } else if(res < 0) {
+      x = x->left;
+    } else {
+      x = x->right;
+    }
+  }
+  return x;
+}
+
+int SCEDA_ptreemap_contains_key(SCEDA_PTreeMap *map, const void *key) {
+  return (SCEDA_ptreemap_find(map, key) != NULL);
+}
+
+void *SCEDA_ptreemap_get(SCEDA_PTreeMap *map, const void *key) {
+  SCEDA_PTreeMapNode *x = SCEDA_ptreemap_find(map, key);
+  return (x != NULL) ? x->value : NULL;
+}
+
+int SCEDA_ptreemap_lookup(SCEDA_PTreeMap *map, void **key, void **value) {
+  SCEDA_PTreeMapNode *x = SCEDA_ptreemap_find(map, *key);
+  if(x == NULL) {
+    return -1;
+  }
+  *key = x->key;
+  *value = x->value;
+  return 0;
+}
+
+/* Return a copy of x where key is bound to value. found is set when
+   key was already bound. */
+static SCEDA_PTreeMapNode *SCEDA_ptreemap_put_aux(SCEDA_PTreeMap *map, SCEDA_PTreeMapNode *x,
+						  const void *key, const void *value, void **old_value, int *found) {
+  if(x == NULL) {
+    return SCEDA_ptreemap_node_create(map, (void *)key, (void *)value, NULL, NULL);
+  }
+  int res = map->compare_key(key, x->key);
+  if(res == 0) {
+    *found = TRUE;
+    *old_value = x->value;
+    return SCEDA_ptreemap_node_create(map, x->key, (void *)value,
+				      SCEDA_ptreemap_node_retain(x->left), SCEDA_ptreemap_node_retain(x->right));
+  } else if(res < 0) {
+    return SCEDA_ptreemap_balance(map, x->key, x->value,
+				  SCEDA_ptreemap_put_aux(map, x->left, key, value, old_value, found),
+				  SCEDA_ptreemap_node_retain(x->right));
+  } else {
+    return SCEDA_ptreemap_balance(map, x->key, x->value,
+				  SCEDA_ptreemap_node_retain(x->left),
+				  SCEDA_ptreemap_put_aux(map, x->right, key, value, old_value, found));
+  }
+}
+
+SCEDA_PTreeMap *SCEDA_ptreemap_put(SCEDA_PTreeMap *map, const void *key, const void *value, void **old_value) {
+  void *old = NULL;
+  int found = FALSE;
+  SCEDA_PTreeMapNode *root = SCEDA_ptreemap_put_aux(map, map->root, key, value, &old, &found);
+  if(old_value != NULL) {
+    *old_value = old;
+  }
+  return SCEDA_ptreemap_version(map, root, map->size + (found ? 0 : 1));
+}
+
+/* Return a copy of x without its least binding, which is stored in
+   key and value. */
+static SCEDA_PTreeMapNode *SCEDA_ptreemap_remove_min(SCEDA_PTreeMap *map, SCEDA_PTreeMapNode *x,
+						     void **key, void **value) {
+  if(x->left == NULL) {
+    *key = x->key;
+    *value = x->value;
+    return SCEDA_ptreemap_node_retain(x->right);
+  }
+  return SCEDA_ptreemap_balance(map, x->key, x->value,
+				SCEDA_ptreemap_remove_min(map, x->left, key, value),
+				SCEDA_ptreemap_node_retain(x->right));
+}
+
+/* Return a copy of x without the binding of key, which must be bound
+   in x. */
+static SCEDA_PTreeMapNode *SCEDA_ptreemap_remove_aux(SCEDA_PTreeMap *map, SCEDA_PTreeMapNode *x,
+						     const void *key) {
+  int res = map->compare_key(key, x->key);
+  if(res == 0) {
+    if(x->left == NULL) {
+      return SCEDA_ptreemap_node_retain(x->right);
+    } else if(x->right == NULL) {
+      return SCEDA_ptreemap_node_retain(x->left);
+    } else {
+      void *min_key;
+      void *min_value;
+      SCEDA_PTreeMapNode *right = SCEDA_ptreemap_remove_min(map, x->right, &min_key, &min_value);
+      return SCEDA_ptreemap_balance(map, min_key, min_value, SCEDA_ptreemap_node_retain(x->left), right);
+    }
+  } else if(res < 0) {
+    return SCEDA_ptreemap_balance(map, x->key, x->value,
+				  SCEDA_ptreemap_remove_aux(map, x->left, key),
+				  SCEDA_ptreemap_node_retain(x->right));
+  } else {
+    return SCEDA_ptreemap_balance(map, x->key, x->value,
+				  SCEDA_ptreemap_node_retain(x->left),
+				  SCEDA_ptreemap_remove_aux(map, x->right, key));
+  }
+}
+
+SCEDA_PTreeMap *SCEDA_ptreemap_remove(SCEDA_PTreeMap *map, void **key, void **value) {
+  SCEDA_PTreeMapNode *x = SCEDA_ptreemap_find(map, *key);
+  if(x == NULL) {
+    return SCEDA_ptreemap_retain(map);
+  }
+  *key = x->key;
+  *value = x->value;
+  SCEDA_PTreeMapNode *root = SCEDA_ptreemap_remove_aux(map, map->root, x->key);
+  return SCEDA_ptreemap_version(map, root, map->size - 1);
+}
+
+static void SCEDA_ptreemap_iterator_descend(SCEDA_PTreeMapIterator *iter, SCEDA_PTreeMapNode *x) {
+  while(x != NULL) {
+    iter->nodes[iter->depth++] = x;
+    x = x->left;
+  }
+}
+
+void SCEDA_ptreemap_iterator_init(SCEDA_PTreeMap *map, SCEDA_PTreeMapIterator *iter) {
+  iter->map = map;
+  iter->depth = 0;
+  SCEDA_ptreemap_iterator_descend(iter, map->root);
+}
+
+void *SCEDA_ptreemap_iterator_next(SCEDA_PTreeMapIterator *iter, void **key) {
+  SCEDA_PTreeMapNode *x = iter->nodes[--iter->depth];
+  SCEDA_ptreemap_iterator_descend(iter, x->right);
+  *key = x->key;
+  return x->value;
+}
+
+static void SCEDA_ptreemap_cell_lock(SCEDA_PTreeMapCell *cell) {
+  while(__atomic_exchange_n(&(cell->lock), 1, __ATOMIC_ACQUIRE)) {
+    while(__atomic_load_n(&(cell->lock), __ATOMIC_RELAXED)) {
+      // spin until the lock looks free
+    }
+  }
+}
+
+static void SCEDA_ptreemap_cell_unlock(SCEDA_PTreeMapCell *cell) {
+  __atomic_store_n(&(cell->lock), 0, __ATOMIC_RELEASE);
+}
+
+void SCEDA_ptreemap_cell_init(SCEDA_PTreeMapCell *cell, SCEDA_PTreeMap *map) {
+  cell->map = map;
+  cell->lock = 0;
+}
+
+void SCEDA_ptreemap_cell_cleanup(SCEDA_PTreeMapCell *cell) {
+  if(cell->map != NULL) {
+    SCEDA_ptreemap_release(cell->map);
+  }
+  memset(cell, 0, sizeof(SCEDA_PTreeMapCell));
+}
+
+SCEDA_PTreeMap *SCEDA_ptreemap_cell_get(SCEDA_PTreeMapCell *cell) {
+  SCEDA_ptreemap_cell_lock(cell);
+  SCEDA_PTreeMap *map = SCEDA_ptreemap_retain(cell->map);
+  SCEDA_ptreemap_cell_unlock(cell);
+  return map;
+}
+
+void SCEDA_ptreemap_cell_set(SCEDA_PTreeMapCell *cell, SCEDA_PTreeMap *map) {
+  SCEDA_ptreemap_cell_lock(cell);
+  SCEDA_PTreeMap *old = cell->map;
+  cell->map = map;
+  SCEDA_ptreemap_cell_unlock(cell);
+  // the previous version is freed outside of the lock
+  SCEDA_ptreemap_release(old);
+}
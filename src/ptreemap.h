@@ -0,0 +1,243 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_PTREEMAP_H
+#define __SCEDA_PTREEMAP_H
+/** \file ptreemap.h
+    \brief Persistent TreeMap implementation (path copying AVL trees) */
+
+#include "common.h"
+#include <string.h>
+
+/** Maximal height of a persistent tree map (AVL trees with less than
+    2^31 bindings are at most 45 levels high) */
+#define SCEDA_PTREEMAP_MAX_HEIGHT 48
+
+/** Node of a persistent tree map. Nodes are never modified once
+    built: they are shared between versions and reference counted. */
+typedef struct _SCEDA_PTreeMapNode {
+  void *key;
+  void *value;
+  int height;
+  int refcount;
+  struct _SCEDA_PTreeMapNode *left;
+  struct _SCEDA_PTreeMapNode *right;
+} SCEDA_PTreeMapNode;
+
+/** Version of a persistent tree map.
+
+    A version is never modified: SCEDA_ptreemap_put() and
+    SCEDA_ptreemap_remove() build a new version which shares all the
+    untouched subtrees with the old one. Versions are reference
+    counted, so that any thread may keep a version alive as long as it
+    needs it (see SCEDA_ptreemap_retain() and SCEDA_ptreemap_release()).
+
+    Keys and values are not owned by persistent maps: they must remain
+    valid as long as some version binds them. */
+typedef struct {
+  int refcount;
+  int size;
+  SCEDA_PTreeMapNode *root;
+  SCEDA_compare_fun compare_key;
+  SCEDA_Allocator *alloc;
+} SCEDA_PTreeMap;
+
+/** Create an empty persistent (tree) map.
+
+    @param[in] compare_key = comparison function on keys
+
+    @return the empty map, with a reference count of 1 */
+SCEDA_PTreeMap *SCEDA_ptreemap_create(SCEDA_compare_fun compare_key);
+
+/** Create an empty persistent (tree) map whose versions and nodes are
+    allocated by the given allocator. The allocator must be thread-safe
+    if versions are released by several threads.
+
+    @param[in] alloc = allocator
+    @param[in] compare_key = comparison function on keys
+
+    @return the empty map, with a reference count of 1 */
+SCEDA_PTreeMap *SCEDA_ptreemap_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_compare_fun compare_key);
+
+/** Acquire a reference to a version of a persistent map in time
+    complexity O(1).
+
+    @param[in] map = map
+
+    @return map */
+SCEDA_PTreeMap *SCEDA_ptreemap_retain(SCEDA_PTreeMap *map);
+
+/** Release a reference to a version of a persistent map. The version
+    is deleted when its last reference is released, along with the
+    nodes which are not shared with other versions.
+
+    @param[in] map = map */
+void SCEDA_ptreemap_release(SCEDA_PTreeMap *map);
+
+/** Build a new version of a map where key is bound to value, in time
+    complexity O(log|map|). The map itself is left unchanged.
+
+    @param[in] map = map
+    @param[in] key = key to be bound
+    @param[in] value = value to bind to key
+    @param[out] old_value = old value bound to key, or NULL if key was unbound (set by function if not NULL)
+
+    @return the new version, with a reference count of 1 */
+SCEDA_PTreeMap *SCEDA_ptreemap_put(SCEDA_PTreeMap *map, const void *key, const void *value, void **old_value);
+
+/** Build a new version of a map where key is unbound, in time
+    complexity O(log|map|). The map itself is left unchanged.
+
+    When key is not bound in map, map is returned with an additional
+    reference.
+
+    @param[in] map = map
+    @param[in, out] key = key to remove (replaced by the actual key)
+    @param[out] value = value removed (replaced by the actual value)
+
+    @return the new version, with a reference count of 1 */
+SCEDA_PTreeMap *SCEDA_ptreemap_remove(SCEDA_PTreeMap *map, void **key, void **value);
+
+/** Test whether the given key is bound in the map in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] key = key
+
+    @return TRUE if key is bound to a value, FALSE otherwise */
+int SCEDA_ptreemap_contains_key(SCEDA_PTreeMap *map, const void *key);
+
+/** Return the value bound to the given key or NULL in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] key = key
+
+    @return the value bound to the key or NULL if the key was unbound */
+void *SCEDA_ptreemap_get(SCEDA_PTreeMap *map, const void *key);
+
+/** Look up for a binding in a map in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in, out] key = key to look for (replaced by the actual key)
+    @param[out] value = value bound to key (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_ptreemap_lookup(SCEDA_PTreeMap *map, void **key, void **value);
+
+/** Size of the persistent map in time complexity O(1).
+
+    @param[in] map = map
+
+    @return size of the map
+
+    \hideinitializer */
+#define SCEDA_ptreemap_size(map$) ((map$)->size)
+
+/** Test whether the persistent map is empty in time complexity O(1).
+
+    @param[in] map = map
+
+    @return TRUE if empty, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_ptreemap_is_empty(map$) (SCEDA_ptreemap_size(map$) == 0)
+
+/** Persistent map iterator. It records the path from the root to the
+    next binding. The iterated version must stay alive during the
+    iteration. */
+typedef struct {
+  int depth;
+  SCEDA_PTreeMapNode *nodes[SCEDA_PTREEMAP_MAX_HEIGHT];
+  SCEDA_PTreeMap *map;
+} SCEDA_PTreeMapIterator;
+
+/** Initialise a persistent map iterator. Keys are visited in
+    ascending order.
+
+    @param[in] map = map
+    @param[in] iter = map iterator */
+void SCEDA_ptreemap_iterator_init(SCEDA_PTreeMap *map, SCEDA_PTreeMapIterator *iter);
+
+/** Test whether there is a next data in the map iterator.
+
+    @param[in] iter = map iterator
+
+    @return TRUE if there is a "next" data, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_ptreemap_iterator_has_next(iter$) ((iter$)->depth > 0)
+
+/** Return the next data of the map iterator.
+
+    @param[in] iter = map iterator
+    @param[out] key = corresponding key (filled by the iterator)
+
+    @return the "next" data */
+void *SCEDA_ptreemap_iterator_next(SCEDA_PTreeMapIterator *iter, void **key);
+
+/** Clean up the persistent map iterator.
+
+    @param[in] iter = map iterator
+
+    \hideinitializer */
+#define SCEDA_ptreemap_iterator_cleanup(iter$) (memset(iter$, 0, sizeof(SCEDA_PTreeMapIterator)))
+
+/** Shared reference to the current version of a persistent map.
+
+    A single writer publishes new versions with
+    SCEDA_ptreemap_cell_set() while any number of readers take
+    snapshots with SCEDA_ptreemap_cell_get(). Both only hold a spin
+    lock for the time needed to read or swap a pointer and update a
+    reference count: readers never wait for the writer to build a
+    version, and the writer never waits for readers to finish with
+    theirs. */
+typedef struct {
+  SCEDA_PTreeMap *map;
+  int lock;
+} SCEDA_PTreeMapCell;
+
+/** Initialise a cell holding a given version. The cell takes over the
+    reference of the caller.
+
+    @param[in] cell = cell
+    @param[in] map = initial version */
+void SCEDA_ptreemap_cell_init(SCEDA_PTreeMapCell *cell, SCEDA_PTreeMap *map);
+
+/** Clean up a cell, releasing its current version.
+
+    @param[in] cell = cell */
+void SCEDA_ptreemap_cell_cleanup(SCEDA_PTreeMapCell *cell);
+
+/** Take a snapshot of the current version of a cell in time
+    complexity O(1). The snapshot must be released with
+    SCEDA_ptreemap_release().
+
+    @param[in] cell = cell
+
+    @return the current version, with an additional reference */
+SCEDA_PTreeMap *SCEDA_ptreemap_cell_get(SCEDA_PTreeMapCell *cell);
+
+/** Publish a new version in a cell in time complexity O(1). The cell
+    takes over the reference of the caller, and releases the previous
+    version.
+
+    @param[in] cell = cell
+    @param[in] map = new version */
+void SCEDA_ptreemap_cell_set(SCEDA_PTreeMapCell *cell, SCEDA_PTreeMap *map);
+
+#endif
@@ -32,11 +32,33 @@ typedef SCEDA_List SCEDA_Queue;
     \hideinitializer */
 #define SCEDA_queue_create SCEDA_list_create
 
+/** Create a queue whose elements are allocated by a given allocator.
+
+    \hideinitializer */
+#define SCEDA_queue_create_with_allocator SCEDA_list_create_with_allocator
+
 /** Initialise a queue.
 
     \hideinitializer */
 #define SCEDA_queue_init SCEDA_list_init
 
+/** Initialise a queue whose elements are allocated by a given allocator.
+
+    \hideinitializer */
+#define SCEDA_queue_init_with_allocator SCEDA_list_init_with_allocator
+
+/** Create a queue whose elements are allocated in a pool owned by the
+    queue.
+
+    \hideinitializer */
+#define SCEDA_queue_create_pooled SCEDA_list_create_pooled
+
+/** Initialise a queue whose elements are allocated in a pool owned by
+    the queue.
+
+    \hideinitializer */
+#define SCEDA_queue_init_pooled SCEDA_list_init_pooled
+
 /** Clean up a queue.
 
     \hideinitializer */
@@ -0,0 +1,226 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include <string.h>
+#include "rheap.h"
+#include "util.h"
+
+/* bucket of a key: 0 if it equals last, otherwise one plus the index
+   of the most significant bit where it differs from last */
+#define radix_bucket(last, key) (((key) == (last)) ? 0 : (32 - __builtin_clz((unsigned int)((key) ^ (last)))))
+
+static void SCEDA_rheap_grow(SCEDA_RadixHeap *heap, int capacity) {
+  SCEDA_Allocator *alloc = heap->alloc;
+  int old = heap->capacity;
+  heap->key = alloc_realloc(alloc, heap->key, old * sizeof(int), capacity * sizeof(int));
+  heap->next = alloc_realloc(alloc, heap->next, old * sizeof(int), capacity * sizeof(int));
+  heap->previous = alloc_realloc(alloc, heap->previous, old * sizeof(int), capacity * sizeof(int));
+  heap->bucket = alloc_realloc(alloc, heap->bucket, old * sizeof(int), capacity * sizeof(int));
+  memset(&heap->bucket[old], -1, (capacity - old) * sizeof(int));
+  heap->capacity = capacity;
+}
+
+void SCEDA_rheap_init_with_allocator(SCEDA_RadixHeap *heap, SCEDA_Allocator *alloc, int capacity) {
+  if(capacity < SCEDA_DFLT_SIZE) {
+    capacity = SCEDA_DFLT_SIZE;
+  }
+  heap->size = 0;
+  heap->capacity = capacity;
+  heap->last = 0;
+  memset(heap->heads, -1, sizeof(heap->heads));
+  heap->key = alloc_malloc(alloc, capacity * sizeof(int));
+  heap->next = alloc_malloc(alloc, capacity * sizeof(int));
+  heap->previous = alloc_malloc(alloc, capacity * sizeof(int));
+  heap->bucket = alloc_malloc(alloc, capacity * sizeof(int));
+  memset(heap->bucket, -1, capacity * sizeof(int));
+  heap->alloc = alloc;
+}
+
+void SCEDA_rheap_init(SCEDA_RadixHeap *heap, int capacity) {
+  SCEDA_rheap_init_with_allocator(heap, SCEDA_allocator_get_default(), capacity);
+}
+
+SCEDA_RadixHeap *SCEDA_rheap_create_with_allocator(SCEDA_Allocator *alloc, int capacity) {
+  SCEDA_RadixHeap *heap = (SCEDA_RadixHeap *)alloc_malloc(alloc, sizeof(SCEDA_RadixHeap));
+  SCEDA_rheap_init_with_allocator(heap, alloc, capacity);
+  return heap;
+}
+
+SCEDA_RadixHeap *SCEDA_rheap_create(int capacity) {
+  return SCEDA_rheap_create_with_allocator(SCEDA_allocator_get_default(), capacity);
+}
+
+void SCEDA_rheap_cleanup(SCEDA_RadixHeap *heap) {
+  SCEDA_Allocator *alloc = heap->alloc;
+  int capacity = heap->capacity;
+  if(heap->key != NULL) {
+    alloc_free(alloc, heap->key, capacity * sizeof(int));
+    alloc_free(alloc, heap->next, capacity * sizeof(int));
+    alloc_free(alloc, heap->previous, capacity * sizeof(int));
+    alloc_free(alloc, heap->bucket, capacity * sizeof(int));
+  }
+  memset(heap, 0, sizeof(SCEDA_RadixHeap));
+  heap->alloc = alloc;
+}
+
+void SCEDA_rheap_delete(SCEDA_RadixHeap *heap) {
+  SCEDA_Allocator *alloc = heap->alloc;
+  SCEDA_rheap_cleanup(heap);
+  alloc_free(alloc, heap, sizeof(SCEDA_RadixHeap));
+}
+
+void SCEDA_rheap_clear(SCEDA_RadixHeap *heap) {
+  int b;
+  for(b = 0; b < SCEDA_RHEAP_BUCKETS; b++) {
+    int h;
+    for(h = heap->heads[b]; h != -1; h = heap->next[h]) {
+      heap->bucket[h] = -1;
+    }
+    heap->heads[b] = -1;
+  }
+  heap->size = 0;
+  heap->last = 0;
+}
+
+static inline void SCEDA_rheap_link(SCEDA_RadixHeap *heap, int handle) {
+  int b = radix_bucket(heap->last, heap->key[handle]);
+  int head = heap->heads[b];
+  heap->next[handle] = head;
+  heap->previous[handle] = -1;
+  if(head != -1) {
+    heap->previous[head] = handle;
+  }
+  heap->heads[b] = handle;
+  heap->bucket[handle] = b;
+}
+
+static inline void SCEDA_rheap_unlink(SCEDA_RadixHeap *heap, int handle) {
+  int next = heap->next[handle];
+  int previous = heap->previous[handle];
+  if(previous == -1) {
+    heap->heads[heap->bucket[handle]] = next;
+  } else {
+    heap->next[previous] = next;
+  }
+  if(next != -1) {
+    heap->previous[next] = previous;
+  }
+  heap->bucket[handle] = -1;
+}
+
+/* fill bucket 0 if needed (the heap must not be empty) */
+static int SCEDA_rheap_first(SCEDA_RadixHeap *heap) {
+  if(heap->heads[0] == -1) {
+    int b = 1;
+    while(heap->heads[b] == -1) {
+      b++;
+    }
+
+    int h;
+    int min = heap->key[heap->heads[b]];
+    for(h = heap->next[heap->heads[b]]; h != -1; h = heap->next[h]) {
+      if(heap->key[h] < min) {
+	min = heap->key[h];
+      }
+    }
+    heap->last = min;
+
+    // every element of bucket b moves to a lower bucket
+    h = heap->heads[b];
+    heap->heads[b] = -1;
+    while(h != -1) {
+      int next = heap->next[h];
+      SCEDA_rheap_link(heap, h);
+      h = next;
+    }
+  }
+  return heap->heads[0];
+}
+
+int SCEDA_rheap_insert(SCEDA_RadixHeap *heap, int handle, int key) {
+  if((handle < 0) || (key < 0)) {
+    return -1;
+  }
+  if(key < heap->last) {
+    if(heap->size != 0) {
+      return -1;
+    }
+    heap->last = key;
+  }
+  if(handle >= heap->capacity) {
+    SCEDA_rheap_grow(heap, (handle < 2 * heap->capacity) ? 2 * heap->capacity : handle + 1);
+  } else if(heap->bucket[handle] != -1) {
+    return -1;
+  }
+
+  heap->key[handle] = key;
+  SCEDA_rheap_link(heap, handle);
+  heap->size++;
+  return 0;
+}
+
+int SCEDA_rheap_min(SCEDA_RadixHeap *heap, int *handle, int *key) {
+  if(heap->size == 0) {
+    return -1;
+  }
+  int h = SCEDA_rheap_first(heap);
+  *handle = h;
+  if(key != NULL) {
+    *key = heap->key[h];
+  }
+  return 0;
+}
+
+int SCEDA_rheap_extract(SCEDA_RadixHeap *heap, int *handle, int *key) {
+  if(heap->size == 0) {
+    return -1;
+  }
+  int h = SCEDA_rheap_first(heap);
+  SCEDA_rheap_unlink(heap, h);
+  heap->size--;
+  *handle = h;
+  if(key != NULL) {
+    *key = heap->key[h];
+  }
+  return 0;
+}
+
+int SCEDA_rheap_decrease_key(SCEDA_RadixHeap *heap, int handle, int key) {
+  if(!SCEDA_rheap_contains(heap, handle) || (key > heap->key[handle]) || (key < heap->last)) {
+    return -1;
+  }
+  if(key != heap->key[handle]) {
+    SCEDA_rheap_unlink(heap, handle);
+    heap->key[handle] = key;
+    SCEDA_rheap_link(heap, handle);
+  }
+  return 0;
+}
+
+int SCEDA_rheap_remove(SCEDA_RadixHeap *heap, int handle, int *key) {
+  if(!SCEDA_rheap_contains(heap, handle)) {
+    return -1;
+  }
+  SCEDA_rheap_unlink(heap, handle);
+  heap->size--;
+  if(key != NULL) {
+    *key = heap->key[handle];
+  }
+  return 0;
+}
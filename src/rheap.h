@@ -0,0 +1,197 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_RHEAP_H
+#define __SCEDA_RHEAP_H
+/** \file rheap.h
+    \brief Radix heaps for monotone integer keys. */
+
+#include "common.h"
+
+/** Number of buckets of a radix heap (keys are non negative ints) */
+#define SCEDA_RHEAP_BUCKETS 32
+
+/** Radix heap.
+
+    Elements are identified by dense integer handles, as in indexed
+    heaps, and their keys are non negative integers. The heap is
+    monotone: a key inserted (or decreased) must not be smaller than
+    the last extracted (or minimum) key. Any key may be inserted in
+    an empty heap.
+
+    Bucket 0 holds the elements whose key equals the last extracted
+    key (last), and bucket i > 0 those whose key differs from last
+    at bit i - 1 but not at any higher bit. Buckets are doubly
+    linked lists of handles and bucket[h] is the bucket of handle h,
+    or -1 if h is not in the heap. When bucket 0 is empty, the first
+    non empty bucket is redistributed into the lower ones around its
+    minimum key, so that an element moves down at most
+    SCEDA_RHEAP_BUCKETS times. */
+typedef struct {
+  int size;
+  int capacity;
+  int last;
+  int heads[SCEDA_RHEAP_BUCKETS];
+  int *key;
+  int *next;
+  int *previous;
+  int *bucket;
+  SCEDA_Allocator *alloc;
+} SCEDA_RadixHeap;
+
+/** Initialise a radix heap for handles 0 to capacity - 1. The heap
+    grows when larger handles are inserted.
+
+    @param[in] heap = heap to initialise
+    @param[in] capacity = number of handles */
+void SCEDA_rheap_init(SCEDA_RadixHeap *heap, int capacity);
+
+/** Create a radix heap for handles 0 to capacity - 1.
+
+    @param[in] capacity = number of handles
+
+    @return a radix heap */
+SCEDA_RadixHeap *SCEDA_rheap_create(int capacity);
+
+/** Initialise a radix heap whose arrays are allocated by a given
+    allocator.
+
+    @param[in] heap = heap to initialise
+    @param[in] alloc = allocator
+    @param[in] capacity = number of handles */
+void SCEDA_rheap_init_with_allocator(SCEDA_RadixHeap *heap, SCEDA_Allocator *alloc, int capacity);
+
+/** Create a radix heap. The heap and its arrays are allocated by the
+    given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] capacity = number of handles
+
+    @return a radix heap */
+SCEDA_RadixHeap *SCEDA_rheap_create_with_allocator(SCEDA_Allocator *alloc, int capacity);
+
+/** Clean up a radix heap.
+
+    @param[in] heap = heap to clean up */
+void SCEDA_rheap_cleanup(SCEDA_RadixHeap *heap);
+
+/** Delete a radix heap.
+
+    @param[in] heap = heap to delete */
+void SCEDA_rheap_delete(SCEDA_RadixHeap *heap);
+
+/** Clear a radix heap. Its capacity is kept.
+
+    @param[in] heap = heap to clear */
+void SCEDA_rheap_clear(SCEDA_RadixHeap *heap);
+
+/** Insert an element into a radix heap in time complexity O(1).
+
+    @param[in] heap = heap
+    @param[in] handle = handle of the element (non negative)
+    @param[in] key = key of the element (non negative)
+
+    @return 0 in case of success, -1 if handle is negative or already
+    in the heap, or if key is smaller than the last extracted (or
+    minimum) key */
+int SCEDA_rheap_insert(SCEDA_RadixHeap *heap, int handle, int key);
+
+/** Extract an element of minimum key from a radix heap in amortized
+    time complexity O(log C), where C is the largest difference
+    between an inserted key and the last extracted key.
+
+    @param[in] heap = heap
+    @param[out] handle = handle of extracted element
+    @param[out] key = key of extracted element (set by function if not NULL)
+
+    @return 0 in case of success, -1 if the heap is empty */
+int SCEDA_rheap_extract(SCEDA_RadixHeap *heap, int *handle, int *key);
+
+/** Return an element of minimum key of a radix heap in amortized
+    time complexity O(log C).
+
+    @param[in] heap = heap
+    @param[out] handle = handle of minimum element
+    @param[out] key = key of minimum element (set by function if not NULL)
+
+    @return 0 in case of success, -1 if the heap is empty */
+int SCEDA_rheap_min(SCEDA_RadixHeap *heap, int *handle, int *key);
+
+/** Decrease the key of an element in time complexity O(1).
+
+    @param[in] heap = heap
+    @param[in] handle = handle of the element
+    @param[in] key = new key
+
+    @return 0 in case of success, -1 if handle is not in the heap or
+    if key is greater than its current key or smaller than the last
+    extracted (or minimum) key */
+int SCEDA_rheap_decrease_key(SCEDA_RadixHeap *heap, int handle, int key);
+
+/** Remove an element from a radix heap in time complexity O(1).
+
+    @param[in] heap = heap
+    @param[in] handle = handle of the element to remove
+    @param[out] key = key of removed element (set by function if not NULL)
+
+    @return 0 in case of success, -1 if handle is not in the heap */
+int SCEDA_rheap_remove(SCEDA_RadixHeap *heap, int handle, int *key);
+
+/** Test whether an element is in a radix heap in time complexity O(1).
+
+    @param[in] heap = heap
+    @param[in] handle = handle
+
+    @return TRUE if handle is in the heap, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_rheap_contains(heap$, handle$)				\
+  ({ SCEDA_RadixHeap *_heap = (heap$);					\
+     int _handle = (handle$);						\
+     ((_handle >= 0) && (_handle < _heap->capacity) && (_heap->bucket[_handle] != -1)); })
+
+/** Return the key of an element of a radix heap.
+
+    @param[in] heap = heap
+    @param[in] handle = handle (must be in the heap)
+
+    @return the key of the element
+
+    \hideinitializer */
+#define SCEDA_rheap_get_key(heap$, handle$) ((heap$)->key[handle$])
+
+/** Return the size of a radix heap.
+
+    @param[in] heap = heap
+
+    @return the size of the heap
+
+    \hideinitializer */
+#define SCEDA_rheap_size(heap$) ((heap$)->size)
+
+/** Test whether a radix heap is empty.
+
+    @param[in] heap = heap
+
+    @return TRUE if heap is empty, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_rheap_is_empty(heap$) (SCEDA_rheap_size(heap$) == 0)
+
+#endif
@@ -43,6 +43,44 @@
 
     (depends on the hash function, worst case is linear time)
 
+    Elements are stored in a single contiguous table (open addressing
+    with Robin Hood probing), so that no memory is allocated per
+    element.
+    Sets holding at most #SCEDA_HASHSET_SMALL_SIZE elements do not
+    allocate any table at all: the elements are stored inline and
+    searched linearly. This is the case of most adjacency sets of sparse
+    graphs.
+
+    When the number of elements is known in advance, use
+    SCEDA_hashset_create_with_capacity() or SCEDA_hashset_reserve() to
+    avoid successive resizings. SCEDA_hashset_set_shrink() disables
+    shrinking for sets whose size oscillates.
+
+    By default, iterating over a hash set scans its whole table, empty
+    buckets included. SCEDA_hashset_set_layout() with
+    #SCEDA_HASH_ORDERED stores the elements in a dense array instead,
+    the table only holding their positions: iteration is then a linear
+    scan of the elements, in their order of insertion. The array is
+    compacted when it holds more removed elements than elements. The
+    vertices and edges of graphs use this layout.
+
+    SCEDA_hashset_set_layout() with #SCEDA_HASH_SWISS selects a Swiss
+    table: each bucket has a control byte holding 7 bits of the hash
+    code of its element, and buckets are probed by groups of 16 whose
+    control bytes are compared at once (with SSE2 when available,
+    byte by byte otherwise). Unsuccessful searches seldom read an
+    element or call the equality function. This pays off for hash
+    functions that scatter their codes (strings, pointers); for vertex
+    or edge sets, whose consecutive ids go to consecutive buckets, the
+    default layout remains faster.
+
+    SCEDA_hashset_add_many() and SCEDA_hashset_contains_many() handle
+    an array of elements at once: all of them are hashed and their
+    buckets prefetched before the set is probed for any of them. On
+    out-of-order processors, independent calls to SCEDA_hashset_add()
+    or SCEDA_hashset_contains() already overlap to a large extent, so
+    the gain depends on the processor.
+
     \section treesets_sec TreeSet
 
     TreeSet is an efficient implementation of sequential access sets
@@ -52,6 +90,53 @@
     Insertion, Removal and Membership test run in logarithmic time
     O(log|set|).
 
+    Tree sets also answer ordered queries in logarithmic time:
+    SCEDA_treeset_floor(), SCEDA_treeset_ceiling(),
+    SCEDA_treeset_lower() and SCEDA_treeset_higher() find the nearest
+    element below or above a given one, and
+    SCEDA_treeset_iterator_init_lower_bound() and
+    SCEDA_treeset_iterator_init_upper_bound() start an iteration at
+    a given element. Each node records the size of its subtree, so
+    that SCEDA_treeset_rank() and SCEDA_treeset_select() convert
+    between elements and their positions in the set.
+
+    SCEDA_treeset_build_sorted() fills an empty tree set from an array
+    sorted in ascending order in linear time. SCEDA_treeset_union(),
+    SCEDA_treeset_intersection(), SCEDA_treeset_difference() and
+    SCEDA_treeset_is_subset() merge the two sets in ascending order, in
+    time O(|set1|+|set2|) instead of one logarithmic search per
+    element. Hash sets provide the same operations, based on
+    membership tests.
+
+    \section btreesets_sec BTreeSet
+
+    BTreeSet is an alternative implementation of ordered sets, based
+    on B-trees. Nodes store up to SCEDA_BTREE_MAX_KEYS elements in
+    sorted arrays, which makes searches much more cache-friendly than
+    in tree sets for large sets. Insertion, Removal and Membership
+    test run in logarithmic time O(log|set|).
+
+    B-tree sets support SCEDA_btreeset_floor(),
+    SCEDA_btreeset_ceiling(), SCEDA_btreeset_lower(),
+    SCEDA_btreeset_higher() and bounded iterators, but not rank and
+    select.
+
+    \section unionfind_sec UnionFind
+
+    UnionFind maintains a partition of a set into disjoint sets
+    (disjoint set forests). Two sets can be merged, and the set of an
+    element is identified by its representative. Sets are merged by
+    size and finding a representative halves the path to the root, so
+    that every operation runs in almost constant time
+    O(alpha(|set|)).
+
+    SCEDA_UnionFind works on dense integer elements 0 to n - 1 (for
+    instance vertex indices) and allocates nothing per element.
+    SCEDA_HashUnionFind works on arbitrary elements, given an equality
+    function and a hash function: elements are numbered when they are
+    first added (or merged) and the sets are then handled by a
+    SCEDA_UnionFind. See \link unionfind.h \endlink for the API.
+
     \section setsapi_sec API
 
     The API for sets is described below.
@@ -169,6 +254,10 @@
 
     It then print the set content, using a set iterator.
 
+    The HashSet and TreeSet examples go on with set algebra, and the
+    TreeSet example with ordered queries and a set built from a sorted
+    array.
+
     Finally, the set is deleted.
 
     \subsection listset_exa ListSet example
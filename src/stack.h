@@ -32,11 +32,33 @@ typedef SCEDA_List SCEDA_Stack;
     \hideinitializer */
 #define SCEDA_stack_create SCEDA_list_create
 
+/** Create a stack whose elements are allocated by a given allocator.
+
+    \hideinitializer */
+#define SCEDA_stack_create_with_allocator SCEDA_list_create_with_allocator
+
 /** Initialise a stack.
 
     \hideinitializer */
 #define SCEDA_stack_init SCEDA_list_init
 
+/** Initialise a stack whose elements are allocated by a given allocator.
+
+    \hideinitializer */
+#define SCEDA_stack_init_with_allocator SCEDA_list_init_with_allocator
+
+/** Create a stack whose elements are allocated in a pool owned by the
+    stack.
+
+    \hideinitializer */
+#define SCEDA_stack_create_pooled SCEDA_list_create_pooled
+
+/** Initialise a stack whose elements are allocated in a pool owned by
+    the stack.
+
+    \hideinitializer */
+#define SCEDA_stack_init_pooled SCEDA_list_init_pooled
+
 /** Clean up a stack.
 
     \hideinitializer */
@@ -53,18 +53,45 @@ static SCEDA_TreeMapElt *SCEDA_treemap_succ(SCEDA_TreeMap *map, SCEDA_TreeMapElt
   }
 }
 
-void SCEDA_treemap_init(SCEDA_TreeMap *map, SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key) {
+void SCEDA_treemap_init_with_allocator(SCEDA_TreeMap *map, SCEDA_Allocator *alloc, SCEDA_delete_fun delete_key,
+				       SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key) {
   map->size = 0;
   map->root = SCEDA_treemap_nil(map);
   map->delete_key = delete_key;
   map->delete_value = delete_value;
   map->compare_key = compare_key;
+  map->alloc = alloc;
+  map->pool = NULL;
   map->nil.color = BLACK;
+  map->nil.size = 0;
+}
+
+void SCEDA_treemap_init(SCEDA_TreeMap *map, SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key) {
+  SCEDA_treemap_init_with_allocator(map, SCEDA_allocator_get_default(), delete_key, delete_value, compare_key);
+}
+
+SCEDA_TreeMap *SCEDA_treemap_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete_key,
+						   SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key) {
+  SCEDA_TreeMap *map = (SCEDA_TreeMap *)alloc_malloc(alloc, sizeof(SCEDA_TreeMap));
+  SCEDA_treemap_init_with_allocator(map, alloc, delete_key, delete_value, compare_key);
+  return map;
 }
 
 SCEDA_TreeMap *SCEDA_treemap_create(SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key) {
-  SCEDA_TreeMap *map = (SCEDA_TreeMap *)safe_malloc(sizeof(SCEDA_TreeMap));
-  SCEDA_treemap_init(map, delete_key, delete_value, compare_key);
+  return SCEDA_treemap_create_with_allocator(SCEDA_allocator_get_default(), delete_key, delete_value, compare_key);
+}
+
+void SCEDA_treemap_init_pooled(SCEDA_TreeMap *map, SCEDA_delete_fun delete_key,
+			       SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key) {
+  SCEDA_Pool *pool = SCEDA_pool_create(sizeof(SCEDA_TreeMapElt));
+  SCEDA_treemap_init_with_allocator(map, SCEDA_pool_allocator(pool), delete_key, delete_value, compare_key);
+  map->pool = pool;
+}
+
+SCEDA_TreeMap *SCEDA_treemap_create_pooled(SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+					   SCEDA_compare_fun compare_key) {
+  SCEDA_TreeMap *map = (SCEDA_TreeMap *)alloc_malloc(SCEDA_allocator_get_default(), sizeof(SCEDA_TreeMap));
+  SCEDA_treemap_init_pooled(map, delete_key, delete_value, compare_key);
   return map;
 }
 
@@ -80,25 +107,48 @@ void SCEDA_treemap_cleanup_aux(SCEDA_TreeMap *map, SCEDA_TreeMapElt *elt) {
   if(map->delete_value != NULL) {
     map->delete_value(elt->value);
   }
-  free(elt);
+  alloc_free(map->alloc, elt, sizeof(SCEDA_TreeMapElt));
+}
+
+static void SCEDA_treemap_cleanup_elts(SCEDA_TreeMap *map) {
+  // nothing to delete nor deallocate one by one otherwise
+  if((map->delete_key != NULL) || (map->delete_value != NULL) || ((map->pool == NULL) && (map->alloc->free != NULL))) {
+    SCEDA_treemap_cleanup_aux(map, SCEDA_treemap_root(map));
+  }
 }
 
 void SCEDA_treemap_cleanup(SCEDA_TreeMap *map) {
-  SCEDA_treemap_cleanup_aux(map, SCEDA_treemap_root(map));
+  // keep the allocator of the map itself (and an empty tree), so that
+  // it can still be cleaned up or deleted
+  SCEDA_Allocator *alloc = (map->pool != NULL) ? map->pool->upstream : map->alloc;
+  SCEDA_treemap_cleanup_elts(map);
+  if(map->pool != NULL) {
+    SCEDA_pool_delete(map->pool);
+  }
   memset(map, 0, sizeof(SCEDA_TreeMap));
+  map->alloc = alloc;
+  SCEDA_treemap_root(map) = SCEDA_treemap_nil(map);
 }
 
 void SCEDA_treemap_delete(SCEDA_TreeMap *map) {
+  // a map owning its pool is allocated by the upstream allocator
+  SCEDA_Allocator *alloc = (map->pool != NULL) ? map->pool->upstream : map->alloc;
   SCEDA_treemap_cleanup(map);
-  free(map);
+  alloc_free(alloc, map, sizeof(SCEDA_TreeMap));
 }
 
 void SCEDA_treemap_clear(SCEDA_TreeMap *map) {
   SCEDA_delete_fun delete_key = map->delete_key;
   SCEDA_delete_fun delete_value = map->delete_value;
   SCEDA_compare_fun compare_key = map->compare_key;
-  SCEDA_treemap_cleanup(map);
-  SCEDA_treemap_init(map, delete_key, delete_value, compare_key);
+  SCEDA_Allocator *alloc = map->alloc;
+  SCEDA_Pool *pool = map->pool;
+  SCEDA_treemap_cleanup_elts(map);
+  if(pool != NULL) {
+    SCEDA_pool_clear(pool);
+  }
+  SCEDA_treemap_init_with_allocator(map, alloc, delete_key, delete_value, compare_key);
+  map->pool = pool;
 }
 
 int SCEDA_treemap_contains_key(SCEDA_TreeMap *map, const void *key) {
@@ -179,6 +229,9 @@ static void SCEDA_treemap_left_rotate(SCEDA_TreeMap *map, SCEDA_TreeMapElt *x) {
 
   y->left = x;
   x->parent = y;
+
+  y->size = x->size;
+  x->size = x->left->size + x->right->size + 1;
 }
 
 static void SCEDA_treemap_right_rotate(SCEDA_TreeMap *map, SCEDA_TreeMapElt *y) {
@@ -200,6 +253,9 @@ static void SCEDA_treemap_right_rotate(SCEDA_TreeMap *map, SCEDA_TreeMapElt *y)
 
   x->right = y;
   y->parent = x;
+
+  x->size = y->size;
+  y->size = y->left->size + y->right->size + 1;
 }
 
 int SCEDA_treemap_put(SCEDA_TreeMap *map, const void *key, const void *value, void **old_value) {
@@ -230,13 +286,14 @@ int SCEDA_treemap_put(SCEDA_TreeMap *map, const void *key, const void *value, vo
     }
   }
 
-  SCEDA_TreeMapElt *element = (SCEDA_TreeMapElt *)safe_malloc(sizeof(SCEDA_TreeMapElt));
+  SCEDA_TreeMapElt *element = (SCEDA_TreeMapElt *)alloc_malloc(map->alloc, sizeof(SCEDA_TreeMapElt));
   element->key = (void *)key;
   element->value = (void *)value;
   element->parent = parent;
   element->left = SCEDA_treemap_nil(map);
   element->right = SCEDA_treemap_nil(map);
   element->color = RED;
+  element->size = 1;
 
   if(parent == SCEDA_treemap_nil(map)) {
     map->root = element;
@@ -248,6 +305,12 @@ int SCEDA_treemap_put(SCEDA_TreeMap *map, const void *key, const void *value, vo
     }
   }
 
+  // the new element belongs to the subtrees of its ancestors
+  SCEDA_TreeMapElt *p;
+  for(p = parent; p != SCEDA_treemap_nil(map); p = p->parent) {
+    p->size++;
+  }
+
   /* Red Black balancing */
   SCEDA_TreeMapElt *x = element;
   while((x != SCEDA_treemap_root(map)) && (x->parent->color == RED)) {
@@ -343,13 +406,19 @@ int SCEDA_treemap_remove(SCEDA_TreeMap *map, void **key, void **value) {
     }
   }
 
+  // y no longer belongs to the subtrees of its ancestors
+  SCEDA_TreeMapElt *p;
+  for(p = y->parent; p != SCEDA_treemap_nil(map); p = p->parent) {
+    p->size--;
+  }
+
   if(y != z) {
     z->key = y->key;
     z->value = y->value;
   }
 
   int color = y->color;
-  free(y);
+  alloc_free(map->alloc, y, sizeof(SCEDA_TreeMapElt));
 
   // Red Black balancing
   if(color == BLACK) {
@@ -412,11 +481,270 @@ int SCEDA_treemap_remove(SCEDA_TreeMap *map, void **key, void **value) {
   return 0;
 }
 
+/* Return the binding with the least key greater than (or equal to, if
+   not strict) key, or nil */
+static SCEDA_TreeMapElt *SCEDA_treemap_ceiling_elt(SCEDA_TreeMap *map, const void *key, int strict) {
+  SCEDA_compare_fun compare = map->compare_key;
+
+  SCEDA_TreeMapElt *res = SCEDA_treemap_nil(map);
+  SCEDA_TreeMapElt *x = SCEDA_treemap_root(map);
+  while(x != SCEDA_treemap_nil(map)) {
+    int c = compare(key, SCEDA_treemap_key(void *, x));
+    if((c < 0) || ((c == 0) && !strict)) {
+      res = x;
+      if(c == 0) {
+	break;
+      }
+      x = x->left;
+    } else {
+      x = x->right;
+    }
+  }
+
+  return res;
+}
+
+/* Return the binding with the greatest key less than (or equal to, if
+   not strict) key, or nil */
+static SCEDA_TreeMapElt *SCEDA_treemap_floor_elt(SCEDA_TreeMap *map, const void *key, int strict) {
+  SCEDA_compare_fun compare = map->compare_key;
+
+  SCEDA_TreeMapElt *res = SCEDA_treemap_nil(map);
+  SCEDA_TreeMapElt *x = SCEDA_treemap_root(map);
+  while(x != SCEDA_treemap_nil(map)) {
+    int c = compare(key, SCEDA_treemap_key(void *, x));
+    if((c > 0) || ((c == 0) && !strict)) {
+      res = x;
+      if(c == 0) {
+	break;
+      }
+      x = x->right;
+    } else {
+      x = x->left;
+    }
+  }
+
+  return res;
+}
+
+static int SCEDA_treemap_result(SCEDA_TreeMap *map, SCEDA_TreeMapElt *x, void **key, void **value) {
+  if(x == SCEDA_treemap_nil(map)) {
+    return -1;
+  }
+  *key = SCEDA_treemap_key(void *, x);
+  *value = SCEDA_treemap_value(void *, x);
+  return 0;
+}
+
+int SCEDA_treemap_floor(SCEDA_TreeMap *map, const void *key, void **res_key, void **value) {
+  return SCEDA_treemap_result(map, SCEDA_treemap_floor_elt(map, key, FALSE), res_key, value);
+}
+
+int SCEDA_treemap_ceiling(SCEDA_TreeMap *map, const void *key, void **res_key, void **value) {
+  return SCEDA_treemap_result(map, SCEDA_treemap_ceiling_elt(map, key, FALSE), res_key, value);
+}
+
+int SCEDA_treemap_lower(SCEDA_TreeMap *map, const void *key, void **res_key, void **value) {
+  return SCEDA_treemap_result(map, SCEDA_treemap_floor_elt(map, key, TRUE), res_key, value);
+}
+
+int SCEDA_treemap_higher(SCEDA_TreeMap *map, const void *key, void **res_key, void **value) {
+  return SCEDA_treemap_result(map, SCEDA_treemap_ceiling_elt(map, key, TRUE), res_key, value);
+}
+
+int SCEDA_treemap_rank(SCEDA_TreeMap *map, const void *key) {
+  SCEDA_compare_fun compare = map->compare_key;
+
+  int rank = 0;
+  SCEDA_TreeMapElt *x = SCEDA_treemap_root(map);
+  while(x != SCEDA_treemap_nil(map)) {
+    int c = compare(key, SCEDA_treemap_key(void *, x));
+    if(c <= 0) {
+      if(c == 0) {
+	return rank + x->left->size;
+      }
+      x = x->left;
+    } else {
+      rank += x->left->size + 1;
+      x = x->right;
+    }
+  }
+
+  return rank;
+}
+
+int SCEDA_treemap_select(SCEDA_TreeMap *map, int i, void **key, void **value) {
+  if((i < 0) || (i >= map->size)) {
+    return -1;
+  }
+
+  SCEDA_TreeMapElt *x = SCEDA_treemap_root(map);
+  for(;;) {
+    int left = x->left->size;
+    if(i < left) {
+      x = x->left;
+    } else if(i == left) {
+      break;
+    } else {
+      i -= left + 1;
+      x = x->right;
+    }
+  }
+
+  *key = SCEDA_treemap_key(void *, x);
+  *value = SCEDA_treemap_value(void *, x);
+  return 0;
+}
+
+static SCEDA_TreeMapElt *SCEDA_treemap_build_aux(SCEDA_TreeMap *map, void **keys, void **values, int lo, int hi,
+						 SCEDA_TreeMapElt *parent, int depth, int red_depth) {
+  if(lo >= hi) {
+    return SCEDA_treemap_nil(map);
+  }
+  int mid = lo + (hi - lo) / 2;
+  SCEDA_TreeMapElt *elt = (SCEDA_TreeMapElt *)alloc_malloc(map->alloc, sizeof(SCEDA_TreeMapElt));
+  elt->key = keys[mid];
+  elt->value = (values != NULL) ? values[mid] : NULL;
+  elt->parent = parent;
+  elt->color = (depth == red_depth) ? RED : BLACK;
+  elt->size = hi - lo;
+  elt->left = SCEDA_treemap_build_aux(map, keys, values, lo, mid, elt, depth + 1, red_depth);
+  elt->right = SCEDA_treemap_build_aux(map, keys, values, mid + 1, hi, elt, depth + 1, red_depth);
+  return elt;
+}
+
+static void SCEDA_treemap_build(SCEDA_TreeMap *map, void **keys, void **values, int n) {
+  // halving makes a tree whose leaves are on its last two levels:
+  // colouring the last level red when it is incomplete makes every
+  // path contain the same number of black nodes
+  int height = 0;
+  while((1 << height) - 1 < n) {
+    height++;
+  }
+  int red_depth = ((1 << height) - 1 == n) ? -1 : height - 1;
+  map->root = SCEDA_treemap_build_aux(map, keys, values, 0, n, SCEDA_treemap_nil(map), 0, red_depth);
+  map->size = n;
+}
+
+int SCEDA_treemap_build_sorted(SCEDA_TreeMap *map, void **keys, void **values, int n) {
+  if(map->size != 0) {
+    return -1;
+  }
+  int i;
+  for(i = 1; i < n; i++) {
+    if(map->compare_key(keys[i - 1], keys[i]) >= 0) {
+      return -1;
+    }
+  }
+  SCEDA_treemap_build(map, keys, values, n);
+  return 0;
+}
+
+#define MERGE_LEFT 1
+#define MERGE_BOTH 2
+#define MERGE_RIGHT 4
+
+/* walk both maps in ascending order of keys and keep the bindings
+   whose key is bound in map1 only, in both maps or in map2 only */
+static int SCEDA_treemap_merge(SCEDA_TreeMap *res, SCEDA_TreeMap *map1, SCEDA_TreeMap *map2, int keep) {
+  if(res->size != 0) {
+    return -1;
+  }
+  int total = map1->size + map2->size;
+  if(total == 0) {
+    return 0;
+  }
+  SCEDA_compare_fun compare = map1->compare_key;
+  void **keys = (void **)safe_malloc(sizeof(void *) * total);
+  void **values = (void **)safe_malloc(sizeof(void *) * total);
+  int n = 0;
+  SCEDA_TreeMapElt *x = SCEDA_treemap_min(map1, SCEDA_treemap_root(map1));
+  SCEDA_TreeMapElt *y = SCEDA_treemap_min(map2, SCEDA_treemap_root(map2));
+  while(x != SCEDA_treemap_nil(map1)) {
+    int c = (y == SCEDA_treemap_nil(map2)) ? -1 : compare(x->key, y->key);
+    if(c < 0) {
+      if(keep & MERGE_LEFT) {
+	keys[n] = x->key;
+	values[n++] = x->value;
+      }
+      x = SCEDA_treemap_succ(map1, x);
+    } else if(c > 0) {
+      if(keep & MERGE_RIGHT) {
+	keys[n] = y->key;
+	values[n++] = y->value;
+      }
+      y = SCEDA_treemap_succ(map2, y);
+    } else {
+      if(keep & MERGE_BOTH) {
+	keys[n] = x->key;
+	values[n++] = x->value;
+      }
+      x = SCEDA_treemap_succ(map1, x);
+      y = SCEDA_treemap_succ(map2, y);
+    }
+  }
+  if(keep & MERGE_RIGHT) {
+    while(y != SCEDA_treemap_nil(map2)) {
+      keys[n] = y->key;
+      values[n++] = y->value;
+      y = SCEDA_treemap_succ(map2, y);
+    }
+  }
+  SCEDA_treemap_build(res, keys, values, n);
+  free(keys);
+  free(values);
+  return 0;
+}
+
+int SCEDA_treemap_union(SCEDA_TreeMap *res, SCEDA_TreeMap *map1, SCEDA_TreeMap *map2) {
+  return SCEDA_treemap_merge(res, map1, map2, MERGE_LEFT | MERGE_BOTH | MERGE_RIGHT);
+}
+
+int SCEDA_treemap_intersection(SCEDA_TreeMap *res, SCEDA_TreeMap *map1, SCEDA_TreeMap *map2) {
+  return SCEDA_treemap_merge(res, map1, map2, MERGE_BOTH);
+}
+
+int SCEDA_treemap_difference(SCEDA_TreeMap *res, SCEDA_TreeMap *map1, SCEDA_TreeMap *map2) {
+  return SCEDA_treemap_merge(res, map1, map2, MERGE_LEFT);
+}
+
+int SCEDA_treemap_is_subset(SCEDA_TreeMap *map1, SCEDA_TreeMap *map2) {
+  if(map1->size > map2->size) {
+    return FALSE;
+  }
+  SCEDA_compare_fun compare = map1->compare_key;
+  SCEDA_TreeMapElt *x = SCEDA_treemap_min(map1, SCEDA_treemap_root(map1));
+  SCEDA_TreeMapElt *y = SCEDA_treemap_min(map2, SCEDA_treemap_root(map2));
+  while(x != SCEDA_treemap_nil(map1)) {
+    if(y == SCEDA_treemap_nil(map2)) {
+      return FALSE;
+    }
+    int c = compare(x->key, y->key);
+    if(c < 0) {
+      return FALSE;
+    } else if(c == 0) {
+      x = SCEDA_treemap_succ(map1, x);
+    }
+    y = SCEDA_treemap_succ(map2, y);
+  }
+  return TRUE;
+}
+
 void SCEDA_treemap_iterator_init(SCEDA_TreeMap *map, SCEDA_TreeMapIterator *iter) {
   iter->map = map;
   iter->elt = SCEDA_treemap_min(map, SCEDA_treemap_root(map));
 }
 
+void SCEDA_treemap_iterator_init_lower_bound(SCEDA_TreeMap *map, const void *key, SCEDA_TreeMapIterator *iter) {
+  iter->map = map;
+  iter->elt = SCEDA_treemap_ceiling_elt(map, key, FALSE);
+}
+
+void SCEDA_treemap_iterator_init_upper_bound(SCEDA_TreeMap *map, const void *key, SCEDA_TreeMapIterator *iter) {
+  iter->map = map;
+  iter->elt = SCEDA_treemap_ceiling_elt(map, key, TRUE);
+}
+
 int SCEDA_treemap_iterator_has_next(SCEDA_TreeMapIterator *iter) {
   return (iter->elt != SCEDA_treemap_nil(iter->map));
 }
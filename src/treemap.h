@@ -23,12 +23,14 @@
     \brief TreeMap implementation */
 
 #include "common.h"
+#include "pool.h"
 #include <string.h>
 
 typedef struct _SCEDA_TreeMapElt {
   void *key;
   void *value;
   int color;
+  int size;
   struct _SCEDA_TreeMapElt *parent;
   struct _SCEDA_TreeMapElt *left;
   struct _SCEDA_TreeMapElt *right;
@@ -41,6 +43,8 @@ typedef struct {
   SCEDA_delete_fun delete_key;
   SCEDA_delete_fun delete_value;
   SCEDA_compare_fun compare_key;
+  SCEDA_Allocator *alloc;
+  SCEDA_Pool *pool;
 } SCEDA_TreeMap;
 
 /** Initialise a (tree) map.
@@ -52,6 +56,17 @@ typedef struct {
 void SCEDA_treemap_init(SCEDA_TreeMap *map, SCEDA_delete_fun delete_key,
 			SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key);
 
+/** Initialise a (tree) map whose nodes are allocated by a given
+    allocator.
+
+    @param[in] map = map
+    @param[in] alloc = allocator
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] compare_key = comparison function on keys */
+void SCEDA_treemap_init_with_allocator(SCEDA_TreeMap *map, SCEDA_Allocator *alloc, SCEDA_delete_fun delete_key,
+				       SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key);
+
 /** Create a (tree) map, ready for use.
 
     @param[in] delete_key = delete function for keys or NULL
@@ -62,6 +77,39 @@ void SCEDA_treemap_init(SCEDA_TreeMap *map, SCEDA_delete_fun delete_key,
 SCEDA_TreeMap *SCEDA_treemap_create(SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
 				    SCEDA_compare_fun compare_key);
 
+/** Create a (tree) map, ready for use. The map and its nodes are
+    allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] compare_key = comparison function on keys
+
+    @return the (tree) map */
+SCEDA_TreeMap *SCEDA_treemap_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete_key,
+						   SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key);
+
+/** Initialise a (tree) map whose nodes are allocated in a pool owned
+    by the map. Cleaning up the map releases the pool at once.
+
+    @param[in] map = map
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] compare_key = comparison function on keys */
+void SCEDA_treemap_init_pooled(SCEDA_TreeMap *map, SCEDA_delete_fun delete_key,
+			       SCEDA_delete_fun delete_value, SCEDA_compare_fun compare_key);
+
+/** Create a (tree) map, ready for use, whose nodes are allocated in a
+    pool owned by the map.
+
+    @param[in] delete_key = delete function for keys or NULL
+    @param[in] delete_value = delete function for values or NULL
+    @param[in] compare_key = comparison function on keys
+
+    @return the (tree) map */
+SCEDA_TreeMap *SCEDA_treemap_create_pooled(SCEDA_delete_fun delete_key, SCEDA_delete_fun delete_value,
+					   SCEDA_compare_fun compare_key);
+
 /** Clean up a (tree) map.
 
     @param[in] map = map to clean up */
@@ -121,6 +169,128 @@ void *SCEDA_treemap_get(SCEDA_TreeMap *map, const void *key);
     @return 0 if found, -1 otherwise */
 int SCEDA_treemap_lookup(SCEDA_TreeMap *map, void **key, void **value);
 
+/** Find the binding of a map with the greatest key less than or
+    equal to key in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] key = key
+    @param[out] res_key = found key (filled by the function)
+    @param[out] value = value bound to the found key (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_treemap_floor(SCEDA_TreeMap *map, const void *key, void **res_key, void **value);
+
+/** Find the binding of a map with the least key greater than or
+    equal to key in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] key = key
+    @param[out] res_key = found key (filled by the function)
+    @param[out] value = value bound to the found key (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_treemap_ceiling(SCEDA_TreeMap *map, const void *key, void **res_key, void **value);
+
+/** Find the binding of a map with the greatest key strictly less
+    than key in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] key = key
+    @param[out] res_key = found key (filled by the function)
+    @param[out] value = value bound to the found key (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_treemap_lower(SCEDA_TreeMap *map, const void *key, void **res_key, void **value);
+
+/** Find the binding of a map with the least key strictly greater
+    than key in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] key = key
+    @param[out] res_key = found key (filled by the function)
+    @param[out] value = value bound to the found key (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_treemap_higher(SCEDA_TreeMap *map, const void *key, void **res_key, void **value);
+
+/** Number of keys of a map strictly less than key, in time
+    complexity O(log|map|). This is the position of key in the map
+    when it is bound.
+
+    @param[in] map = map
+    @param[in] key = key
+
+    @return the rank of key */
+int SCEDA_treemap_rank(SCEDA_TreeMap *map, const void *key);
+
+/** Find the binding with the i-th least key of a map (starting from
+    0) in time complexity O(log|map|).
+
+    @param[in] map = map
+    @param[in] i = rank
+    @param[out] key = i-th key (filled by the function)
+    @param[out] value = value bound to the i-th key (filled by the function)
+
+    @return 0 in case of success, -1 if i is out of bounds */
+int SCEDA_treemap_select(SCEDA_TreeMap *map, int i, void **key, void **value);
+
+/** Fill an empty map with n bindings whose keys are given in strictly
+    ascending order, in time complexity O(n). The resulting tree is
+    balanced.
+
+    @param[in] map = empty map
+    @param[in] keys = array of n keys, sorted in strictly ascending order
+    @param[in] values = array of n values (keys[i] is bound to values[i]), or NULL to bind keys to NULL
+    @param[in] n = number of bindings
+
+    @return 0 in case of success, -1 if the map is not empty or keys
+    are not sorted */
+int SCEDA_treemap_build_sorted(SCEDA_TreeMap *map, void **keys, void **values, int n);
+
+/** Compute the union of two maps in time complexity
+    O(|map1|+|map2|). Both maps must be ordered by the same comparison
+    function. The bindings of map1 are preferred for keys bound in
+    both maps. Keys and values are shared with map1 and map2, so that
+    res should not have delete functions if map1 or map2 has some.
+
+    @param[in] res = empty map, filled with the union
+    @param[in] map1 = first map
+    @param[in] map2 = second map
+
+    @return 0 in case of success, -1 if res is not empty */
+int SCEDA_treemap_union(SCEDA_TreeMap *res, SCEDA_TreeMap *map1, SCEDA_TreeMap *map2);
+
+/** Compute the intersection of two maps in time complexity
+    O(|map1|+|map2|). The bindings of res are those of map1 whose key
+    is bound in map2.
+
+    @param[in] res = empty map, filled with the intersection
+    @param[in] map1 = first map
+    @param[in] map2 = second map
+
+    @return 0 in case of success, -1 if res is not empty */
+int SCEDA_treemap_intersection(SCEDA_TreeMap *res, SCEDA_TreeMap *map1, SCEDA_TreeMap *map2);
+
+/** Compute the difference of two maps in time complexity
+    O(|map1|+|map2|). The bindings of res are those of map1 whose key
+    is not bound in map2.
+
+    @param[in] res = empty map, filled with the difference
+    @param[in] map1 = first map
+    @param[in] map2 = second map
+
+    @return 0 in case of success, -1 if res is not empty */
+int SCEDA_treemap_difference(SCEDA_TreeMap *res, SCEDA_TreeMap *map1, SCEDA_TreeMap *map2);
+
+/** Test whether the keys of a map are all bound in another one, in
+    time complexity O(|map1|+|map2|). Values are not compared.
+
+    @param[in] map1 = first map
+    @param[in] map2 = second map
+
+    @return TRUE if every key of map1 is bound in map2, FALSE otherwise */
+int SCEDA_treemap_is_subset(SCEDA_TreeMap *map1, SCEDA_TreeMap *map2);
+
 /** Size of the (tree) map in time complexity O(1).
 
     @param[in] map = map
@@ -154,6 +324,24 @@ typedef struct {
     @param[in] iter = map iterator */
 void SCEDA_treemap_iterator_init(SCEDA_TreeMap *map, SCEDA_TreeMapIterator *iter);
 
+/** Initialise a (tree) map iterator starting at the least key greater
+    than or equal to key, in time complexity O(log|map|). Keys are
+    visited in ascending order.
+
+    @param[in] map = map
+    @param[in] key = key
+    @param[in] iter = map iterator */
+void SCEDA_treemap_iterator_init_lower_bound(SCEDA_TreeMap *map, const void *key, SCEDA_TreeMapIterator *iter);
+
+/** Initialise a (tree) map iterator starting at the least key strictly
+    greater than key, in time complexity O(log|map|). Keys are visited
+    in ascending order.
+
+    @param[in] map = map
+    @param[in] key = key
+    @param[in] iter = map iterator */
+void SCEDA_treemap_iterator_init_upper_bound(SCEDA_TreeMap *map, const void *key, SCEDA_TreeMapIterator *iter);
+
 /** Test whether there is a next data in the map iterator.
 
     @param[in] iter = map iterator
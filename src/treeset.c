@@ -53,17 +53,42 @@ static SCEDA_TreeSetElt *SCEDA_treeset_succ(SCEDA_TreeSet *set, SCEDA_TreeSetElt
   }
 }
 
-void SCEDA_treeset_init(SCEDA_TreeSet *set, SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+void SCEDA_treeset_init_with_allocator(SCEDA_TreeSet *set, SCEDA_Allocator *alloc,
+				       SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
   set->size = 0;
   set->root = SCEDA_treeset_nil(set);
   set->delete = delete;
   set->compare = compare;
+  set->alloc = alloc;
+  set->pool = NULL;
   set->nil.color = BLACK;
+  set->nil.size = 0;
+}
+
+void SCEDA_treeset_init(SCEDA_TreeSet *set, SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  SCEDA_treeset_init_with_allocator(set, SCEDA_allocator_get_default(), delete, compare);
+}
+
+SCEDA_TreeSet *SCEDA_treeset_create_with_allocator(SCEDA_Allocator *alloc,
+						   SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  SCEDA_TreeSet *set = (SCEDA_TreeSet *)alloc_malloc(alloc, sizeof(SCEDA_TreeSet));
+  SCEDA_treeset_init_with_allocator(set, alloc, delete, compare);
+  return set;
 }
 
 SCEDA_TreeSet *SCEDA_treeset_create(SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
-  SCEDA_TreeSet *set = (SCEDA_TreeSet *)safe_malloc(sizeof(SCEDA_TreeSet));
-  SCEDA_treeset_init(set, delete, compare);
+  return SCEDA_treeset_create_with_allocator(SCEDA_allocator_get_default(), delete, compare);
+}
+
+void SCEDA_treeset_init_pooled(SCEDA_TreeSet *set, SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  SCEDA_Pool *pool = SCEDA_pool_create(sizeof(SCEDA_TreeSetElt));
+  SCEDA_treeset_init_with_allocator(set, SCEDA_pool_allocator(pool), delete, compare);
+  set->pool = pool;
+}
+
+SCEDA_TreeSet *SCEDA_treeset_create_pooled(SCEDA_delete_fun delete, SCEDA_compare_fun compare) {
+  SCEDA_TreeSet *set = (SCEDA_TreeSet *)alloc_malloc(SCEDA_allocator_get_default(), sizeof(SCEDA_TreeSet));
+  SCEDA_treeset_init_pooled(set, delete, compare);
   return set;
 }
 
@@ -76,24 +101,47 @@ void SCEDA_treeset_cleanup_aux(SCEDA_TreeSet *set, SCEDA_TreeSetElt *elt) {
   if(set->delete != NULL) {
     set->delete(elt->data);
   }
-  free(elt);
+  alloc_free(set->alloc, elt, sizeof(SCEDA_TreeSetElt));
+}
+
+static void SCEDA_treeset_cleanup_elts(SCEDA_TreeSet *set) {
+  // nothing to delete nor deallocate one by one otherwise
+  if((set->delete != NULL) || ((set->pool == NULL) && (set->alloc->free != NULL))) {
+    SCEDA_treeset_cleanup_aux(set, SCEDA_treeset_root(set));
+  }
 }
 
 void SCEDA_treeset_cleanup(SCEDA_TreeSet *set) {
-  SCEDA_treeset_cleanup_aux(set, SCEDA_treeset_root(set));
+  // keep the allocator of the set itself (and an empty tree), so that
+  // it can still be cleaned up or deleted
+  SCEDA_Allocator *alloc = (set->pool != NULL) ? set->pool->upstream : set->alloc;
+  SCEDA_treeset_cleanup_elts(set);
+  if(set->pool != NULL) {
+    SCEDA_pool_delete(set->pool);
+  }
   memset(set, 0, sizeof(SCEDA_TreeSet));
+  set->alloc = alloc;
+  SCEDA_treeset_root(set) = SCEDA_treeset_nil(set);
 }
 
 void SCEDA_treeset_delete(SCEDA_TreeSet *set) {
+  // a set owning its pool is allocated by the upstream allocator
+  SCEDA_Allocator *alloc = (set->pool != NULL) ? set->pool->upstream : set->alloc;
   SCEDA_treeset_cleanup(set);
-  free(set);
+  alloc_free(alloc, set, sizeof(SCEDA_TreeSet));
 }
 
 void SCEDA_treeset_clear(SCEDA_TreeSet *set) {
   SCEDA_delete_fun delete = set->delete;
   SCEDA_compare_fun compare = set->compare;
-  SCEDA_treeset_cleanup(set);
-  SCEDA_treeset_init(set, delete, compare);
+  SCEDA_Allocator *alloc = set->alloc;
+  SCEDA_Pool *pool = set->pool;
+  SCEDA_treeset_cleanup_elts(set);
+  if(pool != NULL) {
+    SCEDA_pool_clear(pool);
+  }
+  SCEDA_treeset_init_with_allocator(set, alloc, delete, compare);
+  set->pool = pool;
 }
 
 int SCEDA_treeset_contains(SCEDA_TreeSet *set, const void *data) {
@@ -154,6 +202,9 @@ static void SCEDA_treeset_left_rotate(SCEDA_TreeSet *set, SCEDA_TreeSetElt *x) {
 
   y->left = x;
   x->parent = y;
+
+  y->size = x->size;
+  x->size = x->left->size + x->right->size + 1;
 }
 
 static void SCEDA_treeset_right_rotate(SCEDA_TreeSet *set, SCEDA_TreeSetElt *y) {
@@ -175,6 +226,9 @@ static void SCEDA_treeset_right_rotate(SCEDA_TreeSet *set, SCEDA_TreeSetElt *y)
 
   x->right = y;
   y->parent = x;
+
+  x->size = y->size;
+  y->size = y->left->size + y->right->size + 1;
 }
 
 int SCEDA_treeset_add(SCEDA_TreeSet *set, const void *data) {
@@ -201,12 +255,13 @@ int SCEDA_treeset_add(SCEDA_TreeSet *set, const void *data) {
     }
   }
 
-  SCEDA_TreeSetElt *element = (SCEDA_TreeSetElt *)safe_malloc(sizeof(SCEDA_TreeSetElt));
+  SCEDA_TreeSetElt *element = (SCEDA_TreeSetElt *)alloc_malloc(set->alloc, sizeof(SCEDA_TreeSetElt));
   element->data = (void *)data;
   element->parent = parent;
   element->left = SCEDA_treeset_nil(set);
   element->right = SCEDA_treeset_nil(set);
   element->color = RED;
+  element->size = 1;
 
   if(parent == SCEDA_treeset_nil(set)) {
     set->root = element;
@@ -218,6 +273,12 @@ int SCEDA_treeset_add(SCEDA_TreeSet *set, const void *data) {
     }
   }
 
+  // the new element belongs to the subtrees of its ancestors
+  SCEDA_TreeSetElt *p;
+  for(p = parent; p != SCEDA_treeset_nil(set); p = p->parent) {
+    p->size++;
+  }
+
   /* Red Black balancing */
   SCEDA_TreeSetElt *x = element;
   while((x != SCEDA_treeset_root(set)) && (x->parent->color == RED)) {
@@ -312,12 +373,18 @@ int SCEDA_treeset_remove(SCEDA_TreeSet *set, void **data) {
     }
   }
 
+  // y no longer belongs to the subtrees of its ancestors
+  SCEDA_TreeSetElt *p;
+  for(p = y->parent; p != SCEDA_treeset_nil(set); p = p->parent) {
+    p->size--;
+  }
+
   if(y != z) {
     z->data = y->data;
   }
 
   int color = y->color;
-  free(y);
+  alloc_free(set->alloc, y, sizeof(SCEDA_TreeSetElt));
 
   // Red Black balancing
   if(color == BLACK) {
@@ -380,11 +447,261 @@ int SCEDA_treeset_remove(SCEDA_TreeSet *set, void **data) {
   return 0;
 }
 
+/* Return the least element greater than (or equal to, if not strict)
+   data, or nil */
+static SCEDA_TreeSetElt *SCEDA_treeset_ceiling_elt(SCEDA_TreeSet *set, const void *data, int strict) {
+  SCEDA_compare_fun compare = set->compare;
+
+  SCEDA_TreeSetElt *res = SCEDA_treeset_nil(set);
+  SCEDA_TreeSetElt *x = SCEDA_treeset_root(set);
+  while(x != SCEDA_treeset_nil(set)) {
+    int c = compare(data, SCEDA_treeset_data(void *, x));
+    if((c < 0) || ((c == 0) && !strict)) {
+      res = x;
+      if(c == 0) {
+	break;
+      }
+      x = x->left;
+    } else {
+      x = x->right;
+    }
+  }
+
+  return res;
+}
+
+/* Return the greatest element less than (or equal to, if not strict)
+   data, or nil */
+static SCEDA_TreeSetElt *SCEDA_treeset_floor_elt(SCEDA_TreeSet *set, const void *data, int strict) {
+  SCEDA_compare_fun compare = set->compare;
+
+  SCEDA_TreeSetElt *res = SCEDA_treeset_nil(set);
+  SCEDA_TreeSetElt *x = SCEDA_treeset_root(set);
+  while(x != SCEDA_treeset_nil(set)) {
+    int c = compare(data, SCEDA_treeset_data(void *, x));
+    if((c > 0) || ((c == 0) && !strict)) {
+      res = x;
+      if(c == 0) {
+	break;
+      }
+      x = x->right;
+    } else {
+      x = x->left;
+    }
+  }
+
+  return res;
+}
+
+static int SCEDA_treeset_result(SCEDA_TreeSet *set, SCEDA_TreeSetElt *x, void **data) {
+  if(x == SCEDA_treeset_nil(set)) {
+    return -1;
+  }
+  *data = SCEDA_treeset_data(void *, x);
+  return 0;
+}
+
+int SCEDA_treeset_floor(SCEDA_TreeSet *set, const void *data, void **res) {
+  return SCEDA_treeset_result(set, SCEDA_treeset_floor_elt(set, data, FALSE), res);
+}
+
+int SCEDA_treeset_ceiling(SCEDA_TreeSet *set, const void *data, void **res) {
+  return SCEDA_treeset_result(set, SCEDA_treeset_ceiling_elt(set, data, FALSE), res);
+}
+
+int SCEDA_treeset_lower(SCEDA_TreeSet *set, const void *data, void **res) {
+  return SCEDA_treeset_result(set, SCEDA_treeset_floor_elt(set, data, TRUE), res);
+}
+
+int SCEDA_treeset_higher(SCEDA_TreeSet *set, const void *data, void **res) {
+  return SCEDA_treeset_result(set, SCEDA_treeset_ceiling_elt(set, data, TRUE), res);
+}
+
+int SCEDA_treeset_rank(SCEDA_TreeSet *set, const void *data) {
+  SCEDA_compare_fun compare = set->compare;
+
+  int rank = 0;
+  SCEDA_TreeSetElt *x = SCEDA_treeset_root(set);
+  while(x != SCEDA_treeset_nil(set)) {
+    int c = compare(data, SCEDA_treeset_data(void *, x));
+    if(c <= 0) {
+      if(c == 0) {
+	return rank + x->left->size;
+      }
+      x = x->left;
+    } else {
+      rank += x->left->size + 1;
+      x = x->right;
+    }
+  }
+
+  return rank;
+}
+
+int SCEDA_treeset_select(SCEDA_TreeSet *set, int i, void **data) {
+  if((i < 0) || (i >= set->size)) {
+    return -1;
+  }
+
+  SCEDA_TreeSetElt *x = SCEDA_treeset_root(set);
+  for(;;) {
+    int left = x->left->size;
+    if(i < left) {
+      x = x->left;
+    } else if(i == left) {
+      break;
+    } else {
+      i -= left + 1;
+      x = x->right;
+    }
+  }
+
+  *data = SCEDA_treeset_data(void *, x);
+  return 0;
+}
+
+static SCEDA_TreeSetElt *SCEDA_treeset_build_aux(SCEDA_TreeSet *set, void **data, int lo, int hi,
+						 SCEDA_TreeSetElt *parent, int depth, int red_depth) {
+  if(lo >= hi) {
+    return SCEDA_treeset_nil(set);
+  }
+  int mid = lo + (hi - lo) / 2;
+  SCEDA_TreeSetElt *elt = (SCEDA_TreeSetElt *)alloc_malloc(set->alloc, sizeof(SCEDA_TreeSetElt));
+  elt->data = data[mid];
+  elt->parent = parent;
+  elt->color = (depth == red_depth) ? RED : BLACK;
+  elt->size = hi - lo;
+  elt->left = SCEDA_treeset_build_aux(set, data, lo, mid, elt, depth + 1, red_depth);
+  elt->right = SCEDA_treeset_build_aux(set, data, mid + 1, hi, elt, depth + 1, red_depth);
+  return elt;
+}
+
+static void SCEDA_treeset_build(SCEDA_TreeSet *set, void **data, int n) {
+  // halving makes a tree whose leaves are on its last two levels:
+  // colouring the last level red when it is incomplete makes every
+  // path contain the same number of black nodes
+  int height = 0;
+  while((1 << height) - 1 < n) {
+    height++;
+  }
+  int red_depth = ((1 << height) - 1 == n) ? -1 : height - 1;
+  set->root = SCEDA_treeset_build_aux(set, data, 0, n, SCEDA_treeset_nil(set), 0, red_depth);
+  set->size = n;
+}
+
+int SCEDA_treeset_build_sorted(SCEDA_TreeSet *set, void **data, int n) {
+  if(set->size != 0) {
+    return -1;
+  }
+  int i;
+  for(i = 1; i < n; i++) {
+    if(set->compare(data[i - 1], data[i]) >= 0) {
+      return -1;
+    }
+  }
+  SCEDA_treeset_build(set, data, n);
+  return 0;
+}
+
+#define MERGE_LEFT 1
+#define MERGE_BOTH 2
+#define MERGE_RIGHT 4
+
+/* walk both sets in ascending order and keep the elements
+   belonging to set1 only, to both sets or to set2 only */
+static int SCEDA_treeset_merge(SCEDA_TreeSet *res, SCEDA_TreeSet *set1, SCEDA_TreeSet *set2, int keep) {
+  if(res->size != 0) {
+    return -1;
+  }
+  int total = set1->size + set2->size;
+  if(total == 0) {
+    return 0;
+  }
+  SCEDA_compare_fun compare = set1->compare;
+  void **data = (void **)safe_malloc(sizeof(void *) * total);
+  int n = 0;
+  SCEDA_TreeSetElt *x = SCEDA_treeset_min(set1, SCEDA_treeset_root(set1));
+  SCEDA_TreeSetElt *y = SCEDA_treeset_min(set2, SCEDA_treeset_root(set2));
+  while(x != SCEDA_treeset_nil(set1)) {
+    int c = (y == SCEDA_treeset_nil(set2)) ? -1 : compare(x->data, y->data);
+    if(c < 0) {
+      if(keep & MERGE_LEFT) {
+	data[n++] = x->data;
+      }
+      x = SCEDA_treeset_succ(set1, x);
+    } else if(c > 0) {
+      if(keep & MERGE_RIGHT) {
+	data[n++] = y->data;
+      }
+      y = SCEDA_treeset_succ(set2, y);
+    } else {
+      if(keep & MERGE_BOTH) {
+	data[n++] = x->data;
+      }
+      x = SCEDA_treeset_succ(set1, x);
+      y = SCEDA_treeset_succ(set2, y);
+    }
+  }
+  if(keep & MERGE_RIGHT) {
+    while(y != SCEDA_treeset_nil(set2)) {
+      data[n++] = y->data;
+      y = SCEDA_treeset_succ(set2, y);
+    }
+  }
+  SCEDA_treeset_build(res, data, n);
+  free(data);
+  return 0;
+}
+
+int SCEDA_treeset_union(SCEDA_TreeSet *res, SCEDA_TreeSet *set1, SCEDA_TreeSet *set2) {
+  return SCEDA_treeset_merge(res, set1, set2, MERGE_LEFT | MERGE_BOTH | MERGE_RIGHT);
+}
+
+int SCEDA_treeset_intersection(SCEDA_TreeSet *res, SCEDA_TreeSet *set1, SCEDA_TreeSet *set2) {
+  return SCEDA_treeset_merge(res, set1, set2, MERGE_BOTH);
+}
+
+int SCEDA_treeset_difference(SCEDA_TreeSet *res, SCEDA_TreeSet *set1, SCEDA_TreeSet *set2) {
+  return SCEDA_treeset_merge(res, set1, set2, MERGE_LEFT);
+}
+
+int SCEDA_treeset_is_subset(SCEDA_TreeSet *set1, SCEDA_TreeSet *set2) {
+  if(set1->size > set2->size) {
+    return FALSE;
+  }
+  SCEDA_compare_fun compare = set1->compare;
+  SCEDA_TreeSetElt *x = SCEDA_treeset_min(set1, SCEDA_treeset_root(set1));
+  SCEDA_TreeSetElt *y = SCEDA_treeset_min(set2, SCEDA_treeset_root(set2));
+  while(x != SCEDA_treeset_nil(set1)) {
+    if(y == SCEDA_treeset_nil(set2)) {
+      return FALSE;
+    }
+    int c = compare(x->data, y->data);
+    if(c < 0) {
+      return FALSE;
+    } else if(c == 0) {
+      x = SCEDA_treeset_succ(set1, x);
+    }
+    y = SCEDA_treeset_succ(set2, y);
+  }
+  return TRUE;
+}
+
 void SCEDA_treeset_iterator_init(SCEDA_TreeSet *set, SCEDA_TreeSetIterator *titer) {
   titer->set = set;
   titer->elt = SCEDA_treeset_min(set, SCEDA_treeset_root(set));
 }
 
+void SCEDA_treeset_iterator_init_lower_bound(SCEDA_TreeSet *set, const void *data, SCEDA_TreeSetIterator *titer) {
+  titer->set = set;
+  titer->elt = SCEDA_treeset_ceiling_elt(set, data, FALSE);
+}
+
+void SCEDA_treeset_iterator_init_upper_bound(SCEDA_TreeSet *set, const void *data, SCEDA_TreeSetIterator *titer) {
+  titer->set = set;
+  titer->elt = SCEDA_treeset_ceiling_elt(set, data, TRUE);
+}
+
 int SCEDA_treeset_iterator_has_next(SCEDA_TreeSetIterator *titer) {
   return (titer->elt != SCEDA_treeset_nil(titer->set));
 }
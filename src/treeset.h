@@ -23,11 +23,13 @@
     \brief TreeSet implementation */
 
 #include "common.h"
+#include "pool.h"
 #include <string.h>
 
 typedef struct _SCEDA_TreeSetElt {
   void *data;
   int color;
+  int size;
   struct _SCEDA_TreeSetElt *parent;
   struct _SCEDA_TreeSetElt *left;
   struct _SCEDA_TreeSetElt *right;
@@ -39,6 +41,8 @@ typedef struct {
   SCEDA_TreeSetElt nil;
   SCEDA_delete_fun delete;
   SCEDA_compare_fun compare;
+  SCEDA_Allocator *alloc;
+  SCEDA_Pool *pool;
 } SCEDA_TreeSet;
 
 /** Initialise a (tree) set.
@@ -48,6 +52,16 @@ typedef struct {
     @param[in] compare = comparison function */
 void SCEDA_treeset_init(SCEDA_TreeSet *set, SCEDA_delete_fun delete, SCEDA_compare_fun compare);
 
+/** Initialise a (tree) set whose nodes are allocated by a given
+    allocator.
+
+    @param[in] set = set
+    @param[in] alloc = allocator
+    @param[in] delete = delete function or NULL
+    @param[in] compare = comparison function */
+void SCEDA_treeset_init_with_allocator(SCEDA_TreeSet *set, SCEDA_Allocator *alloc,
+				       SCEDA_delete_fun delete, SCEDA_compare_fun compare);
+
 /** Create a (tree) set, ready for use.
 
     @param[in] delete = delete function or NULL
@@ -56,6 +70,34 @@ void SCEDA_treeset_init(SCEDA_TreeSet *set, SCEDA_delete_fun delete, SCEDA_compa
     @return the (tree) set */
 SCEDA_TreeSet *SCEDA_treeset_create(SCEDA_delete_fun delete, SCEDA_compare_fun compare);
 
+/** Create a (tree) set, ready for use. The set and its nodes are
+    allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete = delete function or NULL
+    @param[in] compare = comparison function
+
+    @return the (tree) set */
+SCEDA_TreeSet *SCEDA_treeset_create_with_allocator(SCEDA_Allocator *alloc,
+						   SCEDA_delete_fun delete, SCEDA_compare_fun compare);
+
+/** Initialise a (tree) set whose nodes are allocated in a pool owned
+    by the set. Cleaning up the set releases the pool at once.
+
+    @param[in] set = set
+    @param[in] delete = delete function or NULL
+    @param[in] compare = comparison function */
+void SCEDA_treeset_init_pooled(SCEDA_TreeSet *set, SCEDA_delete_fun delete, SCEDA_compare_fun compare);
+
+/** Create a (tree) set, ready for use, whose nodes are allocated in a
+    pool owned by the set.
+
+    @param[in] delete = delete function or NULL
+    @param[in] compare = comparison function
+
+    @return the (tree) set */
+SCEDA_TreeSet *SCEDA_treeset_create_pooled(SCEDA_delete_fun delete, SCEDA_compare_fun compare);
+
 /** Clean up a (tree) set.
 
     @param[in] set = set to clean up */
@@ -103,6 +145,121 @@ int SCEDA_treeset_contains(SCEDA_TreeSet *set, const void *data);
     @return 0 if found, -1 otherwise */
 int SCEDA_treeset_lookup(SCEDA_TreeSet *set, void **data);
 
+/** Find the greatest element of a set less than or equal to data in
+    time complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in] data = data
+    @param[out] res = found element (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_treeset_floor(SCEDA_TreeSet *set, const void *data, void **res);
+
+/** Find the least element of a set greater than or equal to data in
+    time complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in] data = data
+    @param[out] res = found element (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_treeset_ceiling(SCEDA_TreeSet *set, const void *data, void **res);
+
+/** Find the greatest element of a set strictly less than data in time
+    complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in] data = data
+    @param[out] res = found element (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_treeset_lower(SCEDA_TreeSet *set, const void *data, void **res);
+
+/** Find the least element of a set strictly greater than data in time
+    complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in] data = data
+    @param[out] res = found element (filled by the function)
+
+    @return 0 if found, -1 otherwise */
+int SCEDA_treeset_higher(SCEDA_TreeSet *set, const void *data, void **res);
+
+/** Number of elements of a set strictly less than data, in time
+    complexity O(log|set|). This is the position of data in the set
+    when it belongs to it.
+
+    @param[in] set = set
+    @param[in] data = data
+
+    @return the rank of data */
+int SCEDA_treeset_rank(SCEDA_TreeSet *set, const void *data);
+
+/** Find the i-th least element of a set (starting from 0) in time
+    complexity O(log|set|).
+
+    @param[in] set = set
+    @param[in] i = rank
+    @param[out] data = i-th element (filled by the function)
+
+    @return 0 in case of success, -1 if i is out of bounds */
+int SCEDA_treeset_select(SCEDA_TreeSet *set, int i, void **data);
+
+/** Fill an empty set with n elements given in strictly ascending
+    order, in time complexity O(n). The resulting tree is balanced.
+
+    @param[in] set = empty set
+    @param[in] data = array of n elements, sorted in strictly ascending order
+    @param[in] n = number of elements
+
+    @return 0 in case of success, -1 if the set is not empty or data
+    are not sorted */
+int SCEDA_treeset_build_sorted(SCEDA_TreeSet *set, void **data, int n);
+
+/** Compute the union of two sets in time complexity
+    O(|set1|+|set2|). Both sets must be ordered by the same comparison
+    function. The elements are shared with set1 and set2 (set1 is
+    preferred for equal elements), so that res should not have a
+    delete function if set1 or set2 has one.
+
+    @param[in] res = empty set, filled with the union
+    @param[in] set1 = first set
+    @param[in] set2 = second set
+
+    @return 0 in case of success, -1 if res is not empty */
+int SCEDA_treeset_union(SCEDA_TreeSet *res, SCEDA_TreeSet *set1, SCEDA_TreeSet *set2);
+
+/** Compute the intersection of two sets in time complexity
+    O(|set1|+|set2|). The elements of res are those of set1 which
+    belong to set2.
+
+    @param[in] res = empty set, filled with the intersection
+    @param[in] set1 = first set
+    @param[in] set2 = second set
+
+    @return 0 in case of success, -1 if res is not empty */
+int SCEDA_treeset_intersection(SCEDA_TreeSet *res, SCEDA_TreeSet *set1, SCEDA_TreeSet *set2);
+
+/** Compute the difference of two sets in time complexity
+    O(|set1|+|set2|). The elements of res are those of set1 which do
+    not belong to set2.
+
+    @param[in] res = empty set, filled with the difference
+    @param[in] set1 = first set
+    @param[in] set2 = second set
+
+    @return 0 in case of success, -1 if res is not empty */
+int SCEDA_treeset_difference(SCEDA_TreeSet *res, SCEDA_TreeSet *set1, SCEDA_TreeSet *set2);
+
+/** Test whether a set is included in another one in time complexity
+    O(|set1|+|set2|).
+
+    @param[in] set1 = first set
+    @param[in] set2 = second set
+
+    @return TRUE if every element of set1 belongs to set2, FALSE otherwise */
+int SCEDA_treeset_is_subset(SCEDA_TreeSet *set1, SCEDA_TreeSet *set2);
+
 /** Size of the (tree) set in time complexity O(1).
 
     @param[in] set = set
@@ -136,6 +293,24 @@ typedef struct {
     @param[in] iter = tree set iterator */
 void SCEDA_treeset_iterator_init(SCEDA_TreeSet *set, SCEDA_TreeSetIterator *iter);
 
+/** Initialise a (tree) set iterator starting at the least element
+    greater than or equal to data, in time complexity O(log|set|).
+    Elements are visited in ascending order.
+
+    @param[in] set = set
+    @param[in] data = data
+    @param[in] iter = tree set iterator */
+void SCEDA_treeset_iterator_init_lower_bound(SCEDA_TreeSet *set, const void *data, SCEDA_TreeSetIterator *iter);
+
+/** Initialise a (tree) set iterator starting at the least element
+    strictly greater than data, in time complexity O(log|set|).
+    Elements are visited in ascending order.
+
+    @param[in] set = set
+    @param[in] data = data
+    @param[in] iter = tree set iterator */
+void SCEDA_treeset_iterator_init_upper_bound(SCEDA_TreeSet *set, const void *data, SCEDA_TreeSetIterator *iter);
+
 /** Test whether there is a next data in the set iterator.
 
     @param[in] iter = set iterator
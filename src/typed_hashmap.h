@@ -0,0 +1,324 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_TYPED_HASHMAP_H
+#define __SCEDA_TYPED_HASHMAP_H
+/** \file typed_hashmap.h
+    \brief Type-specialised HashMap (open addressing, Robin Hood probing) */
+
+#include "common.h"
+#include <string.h>
+
+/** Minimal number of buckets of a type-specialised hash table. */
+#define SCEDA_TYPED_HASH_MIN_BUCKETS 16
+
+/** Define a (hash) map type NAME binding keys of type K to values of
+    type V, both stored unboxed in the table, together with its
+    (inline) functions. HASH(k) must be an expression (or a function)
+    returning the unsigned int hash code of key k and EQ(k1, k2) must
+    hold when k1 and k2 are equal keys.
+
+    \code
+    void NAME_init(NAME *map);
+    void NAME_init_with_allocator(NAME *map, SCEDA_Allocator *alloc);
+    NAME *NAME_create();
+    void NAME_cleanup(NAME *map);
+    void NAME_delete(NAME *map);
+    void NAME_clear(NAME *map);
+    int NAME_reserve(NAME *map, int capacity);
+    int NAME_put(NAME *map, K key, V value, V *old_value);
+    int NAME_remove(NAME *map, K key, V *value);
+    int NAME_contains_key(NAME *map, K key);
+    V *NAME_get(NAME *map, K key);
+    int NAME_lookup(NAME *map, K key, V *value);
+    int NAME_size(NAME *map);
+    int NAME_is_empty(NAME *map);
+
+    void NAME_iterator_init(NAME *map, NAMEIterator *iter);
+    int NAME_iterator_has_next(NAMEIterator *iter);
+    V NAME_iterator_next(NAMEIterator *iter, K *key);
+    void NAME_iterator_cleanup(NAMEIterator *iter);
+    \endcode
+
+    Apart from working on unboxed keys and values, the functions
+    behave like their SCEDA_hashmap counterparts: put returns 0 for a
+    new binding, 1 if the binding was replaced; remove returns 0 in
+    case of success, 1 if the key was unbound; lookup returns 0 if
+    found; get returns a pointer to the value bound to the key (valid
+    until the next modification of the map) or NULL. Functions that
+    may allocate return -1 when out of memory. The table is allocated
+    on the first insertion. As in a SCEDA_HashMap, each map xors the
+    hash codes with its own seed (see SCEDA_hash_seed()).
+
+    \hideinitializer */
+#define SCEDA_DEFINE_HASHMAP(NAME, K, V, HASH, EQ)			\
+  typedef struct {							\
+    K key;								\
+    V value;								\
+    unsigned int hash;							\
+    int psl;								\
+  } NAME##Slot;								\
+									\
+  typedef struct {							\
+    int buckets;							\
+    int min_buckets;							\
+    int shift;								\
+    int size;								\
+    unsigned int seed;							\
+    SCEDA_Allocator *alloc;						\
+    NAME##Slot *table;							\
+  } NAME;								\
+									\
+  typedef struct {							\
+    int i;								\
+    NAME *map;								\
+  } NAME##Iterator;							\
+									\
+  static inline int NAME##_index(unsigned int hash, int shift) {	\
+    return (hash ^ (hash >> shift)) & ((1u << (32 - shift)) - 1);	\
+  }									\
+									\
+  static inline unsigned int NAME##_hash(NAME *map, K key) {		\
+    return (HASH(key)) ^ map->seed;					\
+  }									\
+									\
+  static inline void NAME##_init_with_allocator(NAME *map, SCEDA_Allocator *alloc) { \
+    map->buckets = 0;							\
+    map->min_buckets = 0;						\
+    map->shift = 32;							\
+    map->size = 0;							\
+    map->seed = SCEDA_hash_seed();					\
+    map->alloc = alloc;							\
+    map->table = NULL;							\
+  }									\
+									\
+  static inline void NAME##_init(NAME *map) {				\
+    NAME##_init_with_allocator(map, SCEDA_allocator_get_default());	\
+  }									\
+									\
+  static inline NAME *NAME##_create() {					\
+    SCEDA_Allocator *alloc = SCEDA_allocator_get_default();		\
+    NAME *map = (NAME *)alloc->alloc(sizeof(NAME), alloc->ctxt);	\
+    if(map != NULL) {							\
+      NAME##_init_with_allocator(map, alloc);				\
+    }									\
+    return map;								\
+  }									\
+									\
+  static inline void NAME##_cleanup(NAME *map) {			\
+    SCEDA_Allocator *alloc = map->alloc;				\
+    if((map->table != NULL) && (alloc->free != NULL)) {			\
+      alloc->free(map->table, map->buckets * sizeof(NAME##Slot), alloc->ctxt); \
+    }									\
+    memset(map, 0, sizeof(NAME));					\
+    map->alloc = alloc;							\
+  }									\
+									\
+  static inline void NAME##_delete(NAME *map) {				\
+    SCEDA_Allocator *alloc = map->alloc;				\
+    NAME##_cleanup(map);						\
+    if(alloc->free != NULL) {						\
+      alloc->free(map, sizeof(NAME), alloc->ctxt);			\
+    }									\
+  }									\
+									\
+  static inline void NAME##_clear(NAME *map) {				\
+    if(map->table != NULL) {						\
+      memset(map->table, 0, map->buckets * sizeof(NAME##Slot));		\
+    }									\
+    map->size = 0;							\
+  }									\
+									\
+  static inline void NAME##_insert_slot(NAME##Slot *table, int buckets, int shift, NAME##Slot x) { \
+    int i = NAME##_index(x.hash, shift);				\
+    x.psl = 1;								\
+    for(;;) {								\
+      NAME##Slot *slot = &table[i];					\
+      if(slot->psl == 0) {						\
+	*slot = x;							\
+	return;								\
+      }									\
+      if(slot->psl < x.psl) {						\
+	NAME##Slot tmp = *slot;						\
+	*slot = x;							\
+	x = tmp;							\
+      }									\
+      x.psl++;								\
+      i = (i + 1) & (buckets - 1);					\
+    }									\
+  }									\
+									\
+  static inline int NAME##_resize(NAME *map, int buckets) {		\
+    NAME##Slot *table = (NAME##Slot *)map->alloc->alloc(buckets * sizeof(NAME##Slot), map->alloc->ctxt); \
+    if(table == NULL) {							\
+      return -1;							\
+    }									\
+    memset(table, 0, buckets * sizeof(NAME##Slot));			\
+    int shift = 32 - __builtin_ctz(buckets);				\
+    int i;								\
+    for(i = 0; i < map->buckets; i++) {					\
+      if(map->table[i].psl != 0) {					\
+	NAME##_insert_slot(table, buckets, shift, map->table[i]);	\
+      }									\
+    }									\
+    if((map->table != NULL) && (map->alloc->free != NULL)) {		\
+      map->alloc->free(map->table, map->buckets * sizeof(NAME##Slot), map->alloc->ctxt); \
+    }									\
+    map->table = table;							\
+    map->buckets = buckets;						\
+    map->shift = shift;							\
+    return 0;								\
+  }									\
+									\
+  static inline int NAME##_reserve(NAME *map, int capacity) {		\
+    int buckets = SCEDA_TYPED_HASH_MIN_BUCKETS;				\
+    while(4 * capacity > 3 * buckets) {					\
+      buckets *= 2;							\
+    }									\
+    if(buckets > map->min_buckets) {					\
+      map->min_buckets = buckets;					\
+    }									\
+    if(buckets > map->buckets) {					\
+      return NAME##_resize(map, buckets);				\
+    }									\
+    return 0;								\
+  }									\
+									\
+  static inline NAME##Slot *NAME##_find_slot(NAME *map, K key, unsigned int hash) { \
+    if(map->size == 0) {						\
+      return NULL;							\
+    }									\
+    int i = NAME##_index(hash, map->shift);				\
+    int psl = 1;							\
+    for(;;) {								\
+      NAME##Slot *slot = &map->table[i];				\
+      if(slot->psl < psl) {						\
+	return NULL;							\
+      }									\
+      if((slot->hash == hash) && (EQ(slot->key, key))) {		\
+	return slot;							\
+      }									\
+      psl++;								\
+      i = (i + 1) & (map->buckets - 1);					\
+    }									\
+  }									\
+									\
+  static inline int NAME##_put(NAME *map, K key, V value, V *old_value) { \
+    unsigned int hash = NAME##_hash(map, key);				\
+    NAME##Slot *slot = NAME##_find_slot(map, key, hash);		\
+    if(slot != NULL) {							\
+      if(old_value != NULL) {						\
+	*old_value = slot->value;					\
+      }									\
+      slot->value = value;						\
+      return 1;								\
+    }									\
+    if(4 * (map->size + 1) > 3 * map->buckets) {			\
+      int buckets = (map->buckets == 0) ? SCEDA_TYPED_HASH_MIN_BUCKETS : 2 * map->buckets; \
+      if(NAME##_resize(map, buckets) != 0) {				\
+	return -1;							\
+      }									\
+    }									\
+    NAME##Slot x;							\
+    x.key = key;							\
+    x.value = value;							\
+    x.hash = hash;							\
+    NAME##_insert_slot(map->table, map->buckets, map->shift, x);	\
+    map->size++;							\
+    return 0;								\
+  }									\
+									\
+  static inline int NAME##_remove(NAME *map, K key, V *value) {		\
+    NAME##Slot *slot = NAME##_find_slot(map, key, NAME##_hash(map, key)); \
+    if(slot == NULL) {							\
+      return 1;								\
+    }									\
+    if(value != NULL) {							\
+      *value = slot->value;						\
+    }									\
+    /* backward shift deletion */					\
+    int i = slot - map->table;						\
+    int j = (i + 1) & (map->buckets - 1);				\
+    while(map->table[j].psl > 1) {					\
+      map->table[i] = map->table[j];					\
+      map->table[i].psl--;						\
+      i = j;								\
+      j = (j + 1) & (map->buckets - 1);					\
+    }									\
+    map->table[i].psl = 0;						\
+    map->size--;							\
+    if((4 * map->size < map->buckets) && (map->buckets > map->min_buckets) \
+       && (map->buckets > SCEDA_TYPED_HASH_MIN_BUCKETS)) {		\
+      /* shrinking is only an optimisation */				\
+      NAME##_resize(map, map->buckets / 2);				\
+    }									\
+    return 0;								\
+  }									\
+									\
+  static inline int NAME##_contains_key(NAME *map, K key) {		\
+    return (NAME##_find_slot(map, key, NAME##_hash(map, key)) != NULL); \
+  }									\
+									\
+  static inline V *NAME##_get(NAME *map, K key) {			\
+    NAME##Slot *slot = NAME##_find_slot(map, key, NAME##_hash(map, key)); \
+    return (slot == NULL) ? NULL : &slot->value;			\
+  }									\
+									\
+  static inline int NAME##_lookup(NAME *map, K key, V *value) {		\
+    NAME##Slot *slot = NAME##_find_slot(map, key, NAME##_hash(map, key)); \
+    if(slot == NULL) {							\
+      return -1;							\
+    }									\
+    *value = slot->value;						\
+    return 0;								\
+  }									\
+									\
+  static inline int NAME##_size(NAME *map) {				\
+    return map->size;							\
+  }									\
+									\
+  static inline int NAME##_is_empty(NAME *map) {			\
+    return (map->size == 0);						\
+  }									\
+									\
+  static inline void NAME##_iterator_init(NAME *map, NAME##Iterator *iter) { \
+    iter->i = 0;							\
+    iter->map = map;							\
+  }									\
+									\
+  static inline int NAME##_iterator_has_next(NAME##Iterator *iter) {	\
+    while((iter->i < iter->map->buckets) && (iter->map->table[iter->i].psl == 0)) { \
+      iter->i++;							\
+    }									\
+    return (iter->i < iter->map->buckets);				\
+  }									\
+									\
+  static inline V NAME##_iterator_next(NAME##Iterator *iter, K *key) {	\
+    NAME##Slot *slot = &iter->map->table[iter->i++];			\
+    if(key != NULL) {							\
+      *key = slot->key;							\
+    }									\
+    return slot->value;							\
+  }									\
+									\
+  static inline void NAME##_iterator_cleanup(NAME##Iterator *iter) {	\
+    memset(iter, 0, sizeof(NAME##Iterator));				\
+  }
+
+#endif
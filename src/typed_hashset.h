@@ -0,0 +1,131 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_TYPED_HASHSET_H
+#define __SCEDA_TYPED_HASHSET_H
+/** \file typed_hashset.h
+    \brief Type-specialised HashSet (open addressing, Robin Hood probing) */
+
+#include "typed_hashmap.h"
+
+/** Define a (hash) set type NAME whose elements of type T are stored
+    unboxed, together with its (inline) functions. HASH and EQ are as
+    in SCEDA_DEFINE_HASHMAP.
+
+    \code
+    void NAME_init(NAME *set);
+    void NAME_init_with_allocator(NAME *set, SCEDA_Allocator *alloc);
+    NAME *NAME_create();
+    void NAME_cleanup(NAME *set);
+    void NAME_delete(NAME *set);
+    void NAME_clear(NAME *set);
+    int NAME_reserve(NAME *set, int capacity);
+    int NAME_add(NAME *set, T x);
+    int NAME_remove(NAME *set, T x);
+    int NAME_contains(NAME *set, T x);
+    int NAME_size(NAME *set);
+    int NAME_is_empty(NAME *set);
+
+    void NAME_iterator_init(NAME *set, NAMEIterator *iter);
+    int NAME_iterator_has_next(NAMEIterator *iter);
+    T NAME_iterator_next(NAMEIterator *iter);
+    void NAME_iterator_cleanup(NAMEIterator *iter);
+    \endcode
+
+    add returns 0 in case of success, 1 if the element was already
+    present, -1 when out of memory; remove returns 0 in case of
+    success, 1 if the element was not present.
+
+    \hideinitializer */
+#define SCEDA_DEFINE_HASHSET(NAME, T, HASH, EQ)				\
+  SCEDA_DEFINE_HASHMAP(NAME##_Map, T, char, HASH, EQ)			\
+									\
+  typedef NAME##_Map NAME;						\
+  typedef NAME##_MapIterator NAME##Iterator;				\
+									\
+  static inline void NAME##_init_with_allocator(NAME *set, SCEDA_Allocator *alloc) { \
+    NAME##_Map_init_with_allocator(set, alloc);				\
+  }									\
+									\
+  static inline void NAME##_init(NAME *set) {				\
+    NAME##_Map_init(set);						\
+  }									\
+									\
+  static inline NAME *NAME##_create() {					\
+    return NAME##_Map_create();						\
+  }									\
+									\
+  static inline void NAME##_cleanup(NAME *set) {			\
+    NAME##_Map_cleanup(set);						\
+  }									\
+									\
+  static inline void NAME##_delete(NAME *set) {				\
+    NAME##_Map_delete(set);						\
+  }									\
+									\
+  static inline void NAME##_clear(NAME *set) {				\
+    NAME##_Map_clear(set);						\
+  }									\
+									\
+  static inline int NAME##_reserve(NAME *set, int capacity) {		\
+    return NAME##_Map_reserve(set, capacity);				\
+  }									\
+									\
+  static inline int NAME##_add(NAME *set, T x) {			\
+    if(NAME##_Map_contains_key(set, x)) {				\
+      return 1;								\
+    }									\
+    return NAME##_Map_put(set, x, 0, NULL);				\
+  }									\
+									\
+  static inline int NAME##_remove(NAME *set, T x) {			\
+    return NAME##_Map_remove(set, x, NULL);				\
+  }									\
+									\
+  static inline int NAME##_contains(NAME *set, T x) {			\
+    return NAME##_Map_contains_key(set, x);				\
+  }									\
+									\
+  static inline int NAME##_size(NAME *set) {				\
+    return set->size;							\
+  }									\
+									\
+  static inline int NAME##_is_empty(NAME *set) {			\
+    return (set->size == 0);						\
+  }									\
+									\
+  static inline void NAME##_iterator_init(NAME *set, NAME##Iterator *iter) { \
+    NAME##_Map_iterator_init(set, iter);				\
+  }									\
+									\
+  static inline int NAME##_iterator_has_next(NAME##Iterator *iter) {	\
+    return NAME##_Map_iterator_has_next(iter);				\
+  }									\
+									\
+  static inline T NAME##_iterator_next(NAME##Iterator *iter) {		\
+    T x;								\
+    NAME##_Map_iterator_next(iter, &x);					\
+    return x;								\
+  }									\
+									\
+  static inline void NAME##_iterator_cleanup(NAME##Iterator *iter) {	\
+    NAME##_Map_iterator_cleanup(iter);					\
+  }
+
+#endif
@@ -0,0 +1,149 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_TYPED_PQUEUE_H
+#define __SCEDA_TYPED_PQUEUE_H
+/** \file typed_pqueue.h
+    \brief Type-specialised priority queues (binary heaps) */
+
+#include "typed_vector.h"
+
+/** Define a priority queue type NAME (a binary heap) whose elements
+    of type T are stored unboxed, together with its (inline)
+    functions. LESS(a, b) must be an expression (or a function) that
+    holds when a has a higher priority than b, i.e. the element
+    extracted first is the least one.
+
+    \code
+    void NAME_init(NAME *pqueue);
+    void NAME_init_with_allocator(NAME *pqueue, SCEDA_Allocator *alloc);
+    NAME *NAME_create();
+    void NAME_cleanup(NAME *pqueue);
+    void NAME_delete(NAME *pqueue);
+    void NAME_clear(NAME *pqueue);
+    int NAME_reserve(NAME *pqueue, int capacity);
+    int NAME_insert(NAME *pqueue, T x);
+    int NAME_extract(NAME *pqueue, T *x);
+    T NAME_peek(NAME *pqueue);
+    int NAME_size(NAME *pqueue);
+    int NAME_is_empty(NAME *pqueue);
+    \endcode
+
+    insert and extract run in time complexity O(log(n)) and return 0
+    in case of success, -1 otherwise (out of memory, empty queue). peek
+    must not be called on an empty queue.
+
+    \hideinitializer */
+#define SCEDA_DEFINE_PQUEUE(NAME, T, LESS)				\
+  SCEDA_DEFINE_VECTOR(NAME##_Vector, T)					\
+									\
+  typedef struct {							\
+    NAME##_Vector elts;							\
+  } NAME;								\
+									\
+  static inline void NAME##_init_with_allocator(NAME *pqueue, SCEDA_Allocator *alloc) { \
+    NAME##_Vector_init_with_allocator(&pqueue->elts, alloc);		\
+  }									\
+									\
+  static inline void NAME##_init(NAME *pqueue) {			\
+    NAME##_Vector_init(&pqueue->elts);					\
+  }									\
+									\
+  static inline NAME *NAME##_create() {					\
+    return (NAME *)NAME##_Vector_create();				\
+  }									\
+									\
+  static inline void NAME##_cleanup(NAME *pqueue) {			\
+    NAME##_Vector_cleanup(&pqueue->elts);				\
+  }									\
+									\
+  static inline void NAME##_delete(NAME *pqueue) {			\
+    NAME##_Vector_delete(&pqueue->elts);				\
+  }									\
+									\
+  static inline void NAME##_clear(NAME *pqueue) {			\
+    NAME##_Vector_clear(&pqueue->elts);					\
+  }									\
+									\
+  static inline int NAME##_reserve(NAME *pqueue, int capacity) {	\
+    return NAME##_Vector_reserve(&pqueue->elts, capacity);		\
+  }									\
+									\
+  static inline int NAME##_insert(NAME *pqueue, T x) {			\
+    if(NAME##_Vector_push(&pqueue->elts, x) != 0) {			\
+      return -1;							\
+    }									\
+    T *a = pqueue->elts.elts;						\
+    int i = pqueue->elts.size - 1;					\
+    while(i > 0) {							\
+      int father = (i - 1) / 2;						\
+      if(!(LESS(x, a[father]))) {					\
+	break;								\
+      }									\
+      a[i] = a[father];							\
+      i = father;							\
+    }									\
+    a[i] = x;								\
+    return 0;								\
+  }									\
+									\
+  static inline int NAME##_extract(NAME *pqueue, T *x) {		\
+    T last;								\
+    if(NAME##_Vector_pop(&pqueue->elts, &last) != 0) {			\
+      return -1;							\
+    }									\
+    T *a = pqueue->elts.elts;						\
+    int n = pqueue->elts.size;						\
+    if(n == 0) {							\
+      *x = last;							\
+      return 0;								\
+    }									\
+    *x = a[0];								\
+    int i = 0;								\
+    for(;;) {								\
+      int child = 2 * i + 1;						\
+      if(child >= n) {							\
+	break;								\
+      }									\
+      if((child + 1 < n) && (LESS(a[child + 1], a[child]))) {		\
+	child++;							\
+      }									\
+      if(!(LESS(a[child], last))) {					\
+	break;								\
+      }									\
+      a[i] = a[child];							\
+      i = child;							\
+    }									\
+    a[i] = last;							\
+    return 0;								\
+  }									\
+									\
+  static inline T NAME##_peek(NAME *pqueue) {				\
+    return pqueue->elts.elts[0];					\
+  }									\
+									\
+  static inline int NAME##_size(NAME *pqueue) {				\
+    return pqueue->elts.size;						\
+  }									\
+									\
+  static inline int NAME##_is_empty(NAME *pqueue) {			\
+    return (pqueue->elts.size == 0);					\
+  }
+
+#endif
@@ -0,0 +1,173 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_TYPED_VECTOR_H
+#define __SCEDA_TYPED_VECTOR_H
+/** \file typed_vector.h
+    \brief Type-specialised growable arrays */
+
+#include "common.h"
+#include <string.h>
+
+/** Define a growable array type NAME whose elements of type T are
+    stored unboxed, together with its (inline) functions:
+
+    \code
+    void NAME_init(NAME *vector);
+    void NAME_init_with_allocator(NAME *vector, SCEDA_Allocator *alloc);
+    NAME *NAME_create();
+    void NAME_cleanup(NAME *vector);
+    void NAME_delete(NAME *vector);
+    void NAME_clear(NAME *vector);
+    int NAME_reserve(NAME *vector, int capacity);
+    int NAME_resize(NAME *vector, int size);
+    int NAME_push(NAME *vector, T x);
+    int NAME_pop(NAME *vector, T *x);
+    T NAME_get(NAME *vector, int i);
+    void NAME_set(NAME *vector, int i, T x);
+    T *NAME_at(NAME *vector, int i);
+    int NAME_size(NAME *vector);
+    int NAME_is_empty(NAME *vector);
+    \endcode
+
+    Functions returning an int return 0 in case of success and -1
+    otherwise (out of memory, empty vector). Indices are not checked:
+    they must be less than the size of the vector. NAME_resize sets
+    the size of the vector, the new elements being zeroed.
+
+    \hideinitializer */
+#define SCEDA_DEFINE_VECTOR(NAME, T)					\
+  typedef struct {							\
+    int size;								\
+    int length;								\
+    SCEDA_Allocator *alloc;						\
+    T *elts;								\
+  } NAME;								\
+									\
+  static inline void NAME##_init_with_allocator(NAME *vector, SCEDA_Allocator *alloc) { \
+    vector->size = 0;							\
+    vector->length = 0;							\
+    vector->alloc = alloc;						\
+    vector->elts = NULL;						\
+  }									\
+									\
+  static inline void NAME##_init(NAME *vector) {			\
+    NAME##_init_with_allocator(vector, SCEDA_allocator_get_default());	\
+  }									\
+									\
+  static inline NAME *NAME##_create() {					\
+    SCEDA_Allocator *alloc = SCEDA_allocator_get_default();		\
+    NAME *vector = (NAME *)alloc->alloc(sizeof(NAME), alloc->ctxt);	\
+    if(vector != NULL) {						\
+      NAME##_init_with_allocator(vector, alloc);			\
+    }									\
+    return vector;							\
+  }									\
+									\
+  static inline void NAME##_cleanup(NAME *vector) {			\
+    SCEDA_Allocator *alloc = vector->alloc;				\
+    if((vector->elts != NULL) && (alloc->free != NULL)) {		\
+      alloc->free(vector->elts, vector->length * sizeof(T), alloc->ctxt); \
+    }									\
+    memset(vector, 0, sizeof(NAME));					\
+    vector->alloc = alloc;						\
+  }									\
+									\
+  static inline void NAME##_delete(NAME *vector) {			\
+    SCEDA_Allocator *alloc = vector->alloc;				\
+    NAME##_cleanup(vector);						\
+    if(alloc->free != NULL) {						\
+      alloc->free(vector, sizeof(NAME), alloc->ctxt);			\
+    }									\
+  }									\
+									\
+  static inline void NAME##_clear(NAME *vector) {			\
+    vector->size = 0;							\
+  }									\
+									\
+  static inline int NAME##_reserve(NAME *vector, int capacity) {	\
+    if(capacity <= vector->length) {					\
+      return 0;								\
+    }									\
+    T *elts = (T *)vector->alloc->alloc(capacity * sizeof(T), vector->alloc->ctxt); \
+    if(elts == NULL) {							\
+      return -1;							\
+    }									\
+    if(vector->elts != NULL) {						\
+      memcpy(elts, vector->elts, vector->size * sizeof(T));		\
+      if(vector->alloc->free != NULL) {					\
+	vector->alloc->free(vector->elts, vector->length * sizeof(T), vector->alloc->ctxt); \
+      }									\
+    }									\
+    vector->elts = elts;						\
+    vector->length = capacity;						\
+    return 0;								\
+  }									\
+									\
+  static inline int NAME##_resize(NAME *vector, int size) {		\
+    if(size > vector->size) {						\
+      if(NAME##_reserve(vector, size) != 0) {				\
+	return -1;							\
+      }									\
+      memset(&vector->elts[vector->size], 0, (size - vector->size) * sizeof(T)); \
+    }									\
+    vector->size = size;						\
+    return 0;								\
+  }									\
+									\
+  static inline int NAME##_push(NAME *vector, T x) {			\
+    if(vector->size == vector->length) {				\
+      int capacity = (vector->length == 0) ? SCEDA_DFLT_SIZE : 2 * vector->length; \
+      if(NAME##_reserve(vector, capacity) != 0) {			\
+	return -1;							\
+      }									\
+    }									\
+    vector->elts[vector->size++] = x;					\
+    return 0;								\
+  }									\
+									\
+  static inline int NAME##_pop(NAME *vector, T *x) {			\
+    if(vector->size == 0) {						\
+      return -1;							\
+    }									\
+    *x = vector->elts[--vector->size];					\
+    return 0;								\
+  }									\
+									\
+  static inline T NAME##_get(NAME *vector, int i) {			\
+    return vector->elts[i];						\
+  }									\
+									\
+  static inline void NAME##_set(NAME *vector, int i, T x) {		\
+    vector->elts[i] = x;						\
+  }									\
+									\
+  static inline T *NAME##_at(NAME *vector, int i) {			\
+    return &(vector->elts[i]);						\
+  }									\
+									\
+  static inline int NAME##_size(NAME *vector) {				\
+    return vector->size;						\
+  }									\
+									\
+  static inline int NAME##_is_empty(NAME *vector) {			\
+    return (vector->size == 0);						\
+  }
+
+#endif
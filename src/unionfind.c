@@ -0,0 +1,244 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include <string.h>
+#include "unionfind.h"
+#include "util.h"
+
+static void SCEDA_unionfind_grow(SCEDA_UnionFind *uf, int capacity) {
+  SCEDA_Allocator *alloc = uf->alloc;
+  int old = uf->capacity;
+  uf->parent = alloc_realloc(alloc, uf->parent, old * sizeof(int), capacity * sizeof(int));
+  uf->weight = alloc_realloc(alloc, uf->weight, old * sizeof(int), capacity * sizeof(int));
+  uf->capacity = capacity;
+}
+
+/* put the elements 0 to size - 1 in singleton sets */
+static void SCEDA_unionfind_reset(SCEDA_UnionFind *uf) {
+  int x;
+  for(x = 0; x < uf->size; x++) {
+    uf->parent[x] = x;
+    uf->weight[x] = 1;
+  }
+  uf->count = uf->size;
+}
+
+void SCEDA_unionfind_init_with_allocator(SCEDA_UnionFind *uf, SCEDA_Allocator *alloc, int size) {
+  int capacity = size;
+  if(capacity < SCEDA_DFLT_SIZE) {
+    capacity = SCEDA_DFLT_SIZE;
+  }
+  uf->size = size;
+  uf->capacity = capacity;
+  uf->parent = alloc_malloc(alloc, capacity * sizeof(int));
+  uf->weight = alloc_malloc(alloc, capacity * sizeof(int));
+  uf->alloc = alloc;
+  SCEDA_unionfind_reset(uf);
+}
+
+void SCEDA_unionfind_init(SCEDA_UnionFind *uf, int size) {
+  SCEDA_unionfind_init_with_allocator(uf, SCEDA_allocator_get_default(), size);
+}
+
+SCEDA_UnionFind *SCEDA_unionfind_create_with_allocator(SCEDA_Allocator *alloc, int size) {
+  SCEDA_UnionFind *uf = (SCEDA_UnionFind *)alloc_malloc(alloc, sizeof(SCEDA_UnionFind));
+  SCEDA_unionfind_init_with_allocator(uf, alloc, size);
+  return uf;
+}
+
+SCEDA_UnionFind *SCEDA_unionfind_create(int size) {
+  return SCEDA_unionfind_create_with_allocator(SCEDA_allocator_get_default(), size);
+}
+
+void SCEDA_unionfind_cleanup(SCEDA_UnionFind *uf) {
+  SCEDA_Allocator *alloc = uf->alloc;
+  if(uf->parent != NULL) {
+    alloc_free(alloc, uf->parent, uf->capacity * sizeof(int));
+    alloc_free(alloc, uf->weight, uf->capacity * sizeof(int));
+  }
+  memset(uf, 0, sizeof(SCEDA_UnionFind));
+  uf->alloc = alloc;
+}
+
+void SCEDA_unionfind_delete(SCEDA_UnionFind *uf) {
+  SCEDA_Allocator *alloc = uf->alloc;
+  SCEDA_unionfind_cleanup(uf);
+  alloc_free(alloc, uf, sizeof(SCEDA_UnionFind));
+}
+
+void SCEDA_unionfind_clear(SCEDA_UnionFind *uf) {
+  SCEDA_unionfind_reset(uf);
+}
+
+int SCEDA_unionfind_add(SCEDA_UnionFind *uf) {
+  int x = uf->size;
+  if(x == uf->capacity) {
+    SCEDA_unionfind_grow(uf, 2 * uf->capacity);
+  }
+  uf->parent[x] = x;
+  uf->weight[x] = 1;
+  uf->size++;
+  uf->count++;
+  return x;
+}
+
+/* find with path halving: every other node on the path is linked to
+   its grand father */
+static inline int SCEDA_unionfind_root(int *parent, int x) {
+  while(parent[x] != x) {
+    int y = parent[parent[x]];
+    parent[x] = y;
+    x = y;
+  }
+  return x;
+}
+
+#define is_element(uf, x) (((x) >= 0) && ((x) < (uf)->size))
+
+int SCEDA_unionfind_find(SCEDA_UnionFind *uf, int x) {
+  if(!is_element(uf, x)) {
+    return -1;
+  }
+  return SCEDA_unionfind_root(uf->parent, x);
+}
+
+int SCEDA_unionfind_union(SCEDA_UnionFind *uf, int x, int y) {
+  if(!is_element(uf, x) || !is_element(uf, y)) {
+    return -1;
+  }
+  x = SCEDA_unionfind_root(uf->parent, x);
+  y = SCEDA_unionfind_root(uf->parent, y);
+  if(x == y) {
+    return 1;
+  }
+  if(uf->weight[x] < uf->weight[y]) {
+    int z = x;
+    x = y;
+    y = z;
+  }
+  uf->parent[y] = x;
+  uf->weight[x] += uf->weight[y];
+  uf->count--;
+  return 0;
+}
+
+int SCEDA_unionfind_same(SCEDA_UnionFind *uf, int x, int y) {
+  if(!is_element(uf, x) || !is_element(uf, y)) {
+    return FALSE;
+  }
+  return SCEDA_unionfind_root(uf->parent, x) == SCEDA_unionfind_root(uf->parent, y);
+}
+
+int SCEDA_unionfind_set_size(SCEDA_UnionFind *uf, int x) {
+  if(!is_element(uf, x)) {
+    return 0;
+  }
+  return uf->weight[SCEDA_unionfind_root(uf->parent, x)];
+}
+
+/* ids are stored plus one in the map, so that unbound elements get -1 */
+#define id_of(uf, elt) ((int)(long)SCEDA_hashmap_get(&(uf)->ids, elt) - 1)
+
+void SCEDA_hashunionfind_init_with_allocator(SCEDA_HashUnionFind *uf, SCEDA_Allocator *alloc,
+					     SCEDA_delete_fun delete,
+					     SCEDA_match_fun match, SCEDA_hash_fun hash) {
+  SCEDA_unionfind_init_with_allocator(&uf->uf, alloc, 0);
+  SCEDA_hashmap_init_with_allocator(&uf->ids, alloc, delete, NULL, match, hash);
+  SCEDA_vector_init_with_allocator(&uf->elts, alloc, NULL);
+}
+
+void SCEDA_hashunionfind_init(SCEDA_HashUnionFind *uf, SCEDA_delete_fun delete,
+			      SCEDA_match_fun match, SCEDA_hash_fun hash) {
+  SCEDA_hashunionfind_init_with_allocator(uf, SCEDA_allocator_get_default(), delete, match, hash);
+}
+
+SCEDA_HashUnionFind *SCEDA_hashunionfind_create_with_allocator(SCEDA_Allocator *alloc,
+							       SCEDA_delete_fun delete,
+							       SCEDA_match_fun match, SCEDA_hash_fun hash) {
+  SCEDA_HashUnionFind *uf = (SCEDA_HashUnionFind *)alloc_malloc(alloc, sizeof(SCEDA_HashUnionFind));
+  SCEDA_hashunionfind_init_with_allocator(uf, alloc, delete, match, hash);
+  return uf;
+}
+
+SCEDA_HashUnionFind *SCEDA_hashunionfind_create(SCEDA_delete_fun delete,
+						SCEDA_match_fun match, SCEDA_hash_fun hash) {
+  return SCEDA_hashunionfind_create_with_allocator(SCEDA_allocator_get_default(), delete, match, hash);
+}
+
+void SCEDA_hashunionfind_cleanup(SCEDA_HashUnionFind *uf) {
+  SCEDA_hashmap_cleanup(&uf->ids);
+  SCEDA_vector_cleanup(&uf->elts);
+  SCEDA_unionfind_cleanup(&uf->uf);
+}
+
+void SCEDA_hashunionfind_delete(SCEDA_HashUnionFind *uf) {
+  SCEDA_Allocator *alloc = uf->uf.alloc;
+  SCEDA_hashunionfind_cleanup(uf);
+  alloc_free(alloc, uf, sizeof(SCEDA_HashUnionFind));
+}
+
+void SCEDA_hashunionfind_clear(SCEDA_HashUnionFind *uf) {
+  SCEDA_hashmap_clear(&uf->ids);
+  SCEDA_vector_clear(&uf->elts);
+  uf->uf.size = 0;
+  uf->uf.count = 0;
+}
+
+/* return the id of elt, adding it if needed */
+static int SCEDA_hashunionfind_id(SCEDA_HashUnionFind *uf, const void *elt) {
+  int x = id_of(uf, elt);
+  if(x == -1) {
+    x = SCEDA_unionfind_add(&uf->uf);
+    safe_call(SCEDA_hashmap_put(&uf->ids, elt, (void *)(long)(x + 1), NULL));
+    safe_call(SCEDA_vector_push(&uf->elts, elt));
+  }
+  return x;
+}
+
+int SCEDA_hashunionfind_add(SCEDA_HashUnionFind *uf, const void *elt) {
+  int size = SCEDA_hashunionfind_size(uf);
+  SCEDA_hashunionfind_id(uf, elt);
+  return (size == SCEDA_hashunionfind_size(uf)) ? 1 : 0;
+}
+
+int SCEDA_hashunionfind_contains(SCEDA_HashUnionFind *uf, const void *elt) {
+  return SCEDA_hashmap_contains_key(&uf->ids, elt);
+}
+
+void *SCEDA_hashunionfind_find(SCEDA_HashUnionFind *uf, const void *elt) {
+  int x = SCEDA_unionfind_find(&uf->uf, id_of(uf, elt));
+  if(x == -1) {
+    return NULL;
+  }
+  return SCEDA_vector_get(void *, &uf->elts, x);
+}
+
+int SCEDA_hashunionfind_union(SCEDA_HashUnionFind *uf, const void *elt1, const void *elt2) {
+  int x = SCEDA_hashunionfind_id(uf, elt1);
+  int y = SCEDA_hashunionfind_id(uf, elt2);
+  return SCEDA_unionfind_union(&uf->uf, x, y);
+}
+
+int SCEDA_hashunionfind_same(SCEDA_HashUnionFind *uf, const void *elt1, const void *elt2) {
+  return SCEDA_unionfind_same(&uf->uf, id_of(uf, elt1), id_of(uf, elt2));
+}
+
+int SCEDA_hashunionfind_set_size(SCEDA_HashUnionFind *uf, const void *elt) {
+  return SCEDA_unionfind_set_size(&uf->uf, id_of(uf, elt));
+}
@@ -0,0 +1,307 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_UNIONFIND_H
+#define __SCEDA_UNIONFIND_H
+/** \file unionfind.h
+    \brief Union-find (disjoint set forests) */
+
+#include "common.h"
+#include "hashmap.h"
+#include "vector.h"
+
+/** Union-find over dense integer ids.
+
+    Elements are the integers 0 to size - 1. Each set is a tree whose
+    root is the representative of the set: parent[x] is the father of
+    x, or x itself if x is a root. weight[r] is the number of elements
+    of the set whose root is r (meaningless if r is not a root).
+
+    Sets are merged by size (the smaller tree is linked below the
+    larger one) and find halves the paths it follows, so that a
+    sequence of m operations runs in time O(m.alpha(m)). */
+typedef struct {
+  int size;
+  int count;
+  int capacity;
+  int *parent;
+  int *weight;
+  SCEDA_Allocator *alloc;
+} SCEDA_UnionFind;
+
+/** Initialise a union-find with the singletons {0}, ..., {size - 1}.
+
+    @param[in] uf = union-find to initialise
+    @param[in] size = number of elements */
+void SCEDA_unionfind_init(SCEDA_UnionFind *uf, int size);
+
+/** Create a union-find with the singletons {0}, ..., {size - 1}.
+
+    @param[in] size = number of elements
+
+    @return a union-find */
+SCEDA_UnionFind *SCEDA_unionfind_create(int size);
+
+/** Initialise a union-find whose arrays are allocated by a given
+    allocator.
+
+    @param[in] uf = union-find to initialise
+    @param[in] alloc = allocator
+    @param[in] size = number of elements */
+void SCEDA_unionfind_init_with_allocator(SCEDA_UnionFind *uf, SCEDA_Allocator *alloc, int size);
+
+/** Create a union-find. The union-find and its arrays are allocated
+    by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] size = number of elements
+
+    @return a union-find */
+SCEDA_UnionFind *SCEDA_unionfind_create_with_allocator(SCEDA_Allocator *alloc, int size);
+
+/** Clean up a union-find.
+
+    @param[in] uf = union-find to clean up */
+void SCEDA_unionfind_cleanup(SCEDA_UnionFind *uf);
+
+/** Delete a union-find.
+
+    @param[in] uf = union-find to delete */
+void SCEDA_unionfind_delete(SCEDA_UnionFind *uf);
+
+/** Clear a union-find: every element is put back in its own
+    singleton set.
+
+    @param[in] uf = union-find to clear */
+void SCEDA_unionfind_clear(SCEDA_UnionFind *uf);
+
+/** Add a new element to a union-find, in its own singleton set, in
+    time complexity O(1) (amortized).
+
+    @param[in] uf = union-find
+
+    @return the new element (that is the former size of uf) */
+int SCEDA_unionfind_add(SCEDA_UnionFind *uf);
+
+/** Find the representative of the set of an element, in time
+    complexity O(alpha(|uf|)) (amortized).
+
+    @param[in] uf = union-find
+    @param[in] x = element
+
+    @return the representative of x, or -1 if x is not an element */
+int SCEDA_unionfind_find(SCEDA_UnionFind *uf, int x);
+
+/** Merge the sets of two elements, in time complexity
+    O(alpha(|uf|)) (amortized).
+
+    @param[in] uf = union-find
+    @param[in] x = element
+    @param[in] y = element
+
+    @return 0 if the sets were merged, 1 if x and y were already in
+    the same set, -1 if x or y is not an element */
+int SCEDA_unionfind_union(SCEDA_UnionFind *uf, int x, int y);
+
+/** Test whether two elements are in the same set, in time complexity
+    O(alpha(|uf|)) (amortized).
+
+    @param[in] uf = union-find
+    @param[in] x = element
+    @param[in] y = element
+
+    @return TRUE if x and y are elements of the same set, FALSE otherwise */
+int SCEDA_unionfind_same(SCEDA_UnionFind *uf, int x, int y);
+
+/** Return the size of the set of an element, in time complexity
+    O(alpha(|uf|)) (amortized).
+
+    @param[in] uf = union-find
+    @param[in] x = element
+
+    @return the size of the set of x, or 0 if x is not an element */
+int SCEDA_unionfind_set_size(SCEDA_UnionFind *uf, int x);
+
+/** Number of elements of a union-find in time complexity O(1).
+
+    @param[in] uf = union-find
+
+    @return number of elements
+
+    \hideinitializer */
+#define SCEDA_unionfind_size(uf$) ((uf$)->size)
+
+/** Number of (disjoint) sets of a union-find in time complexity O(1).
+
+    @param[in] uf = union-find
+
+    @return number of sets
+
+    \hideinitializer */
+#define SCEDA_unionfind_count(uf$) ((uf$)->count)
+
+/** Union-find over arbitrary elements.
+
+    Elements are numbered in their order of insertion: ids maps each
+    element to its number (plus one) and elts maps numbers back to
+    elements, so that sets are handled by a union-find over dense
+    ids. */
+typedef struct {
+  SCEDA_UnionFind uf;
+  SCEDA_HashMap ids;
+  SCEDA_Vector elts;
+} SCEDA_HashUnionFind;
+
+/** Initialise an empty (hash) union-find.
+
+    @param[in] uf = union-find to initialise
+    @param[in] delete = delete function for elements or NULL
+    @param[in] match = equality function on elements
+    @param[in] hash = hash function for elements */
+void SCEDA_hashunionfind_init(SCEDA_HashUnionFind *uf, SCEDA_delete_fun delete,
+			      SCEDA_match_fun match, SCEDA_hash_fun hash);
+
+/** Create an empty (hash) union-find.
+
+    @param[in] delete = delete function for elements or NULL
+    @param[in] match = equality function on elements
+    @param[in] hash = hash function for elements
+
+    @return a (hash) union-find */
+SCEDA_HashUnionFind *SCEDA_hashunionfind_create(SCEDA_delete_fun delete,
+						SCEDA_match_fun match, SCEDA_hash_fun hash);
+
+/** Initialise an empty (hash) union-find whose tables are allocated
+    by a given allocator.
+
+    @param[in] uf = union-find to initialise
+    @param[in] alloc = allocator
+    @param[in] delete = delete function for elements or NULL
+    @param[in] match = equality function on elements
+    @param[in] hash = hash function for elements */
+void SCEDA_hashunionfind_init_with_allocator(SCEDA_HashUnionFind *uf, SCEDA_Allocator *alloc,
+					     SCEDA_delete_fun delete,
+					     SCEDA_match_fun match, SCEDA_hash_fun hash);
+
+/** Create an empty (hash) union-find. The union-find and its tables
+    are allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete = delete function for elements or NULL
+    @param[in] match = equality function on elements
+    @param[in] hash = hash function for elements
+
+    @return a (hash) union-find */
+SCEDA_HashUnionFind *SCEDA_hashunionfind_create_with_allocator(SCEDA_Allocator *alloc,
+							       SCEDA_delete_fun delete,
+							       SCEDA_match_fun match, SCEDA_hash_fun hash);
+
+/** Clean up a (hash) union-find.
+
+    @param[in] uf = union-find to clean up */
+void SCEDA_hashunionfind_cleanup(SCEDA_HashUnionFind *uf);
+
+/** Delete a (hash) union-find.
+
+    @param[in] uf = union-find to delete */
+void SCEDA_hashunionfind_delete(SCEDA_HashUnionFind *uf);
+
+/** Clear a (hash) union-find: all its elements are removed.
+
+    @param[in] uf = union-find to clear */
+void SCEDA_hashunionfind_clear(SCEDA_HashUnionFind *uf);
+
+/** Add an element to a (hash) union-find, in its own singleton set,
+    in time complexity O(1).
+
+    @param[in] uf = union-find
+    @param[in] elt = element to add
+
+    @return 0 if the element was added, 1 if it was already there */
+int SCEDA_hashunionfind_add(SCEDA_HashUnionFind *uf, const void *elt);
+
+/** Test whether an element belongs to a (hash) union-find in time
+    complexity O(1).
+
+    @param[in] uf = union-find
+    @param[in] elt = element
+
+    @return TRUE if elt is an element of uf, FALSE otherwise */
+int SCEDA_hashunionfind_contains(SCEDA_HashUnionFind *uf, const void *elt);
+
+/** Find the representative of the set of an element, in time
+    complexity O(alpha(|uf|)) (amortized).
+
+    @param[in] uf = union-find
+    @param[in] elt = element
+
+    @return the representative of elt, or NULL if elt is not an element */
+void *SCEDA_hashunionfind_find(SCEDA_HashUnionFind *uf, const void *elt);
+
+/** Merge the sets of two elements, in time complexity
+    O(alpha(|uf|)) (amortized). Elements not yet in the union-find
+    are added first.
+
+    @param[in] uf = union-find
+    @param[in] elt1 = element
+    @param[in] elt2 = element
+
+    @return 0 if the sets were merged, 1 if elt1 and elt2 were already
+    in the same set */
+int SCEDA_hashunionfind_union(SCEDA_HashUnionFind *uf, const void *elt1, const void *elt2);
+
+/** Test whether two elements are in the same set, in time complexity
+    O(alpha(|uf|)) (amortized).
+
+    @param[in] uf = union-find
+    @param[in] elt1 = element
+    @param[in] elt2 = element
+
+    @return TRUE if elt1 and elt2 are elements of the same set, FALSE otherwise */
+int SCEDA_hashunionfind_same(SCEDA_HashUnionFind *uf, const void *elt1, const void *elt2);
+
+/** Return the size of the set of an element, in time complexity
+    O(alpha(|uf|)) (amortized).
+
+    @param[in] uf = union-find
+    @param[in] elt = element
+
+    @return the size of the set of elt, or 0 if elt is not an element */
+int SCEDA_hashunionfind_set_size(SCEDA_HashUnionFind *uf, const void *elt);
+
+/** Number of elements of a (hash) union-find in time complexity O(1).
+
+    @param[in] uf = union-find
+
+    @return number of elements
+
+    \hideinitializer */
+#define SCEDA_hashunionfind_size(uf$) (SCEDA_unionfind_size(&(uf$)->uf))
+
+/** Number of (disjoint) sets of a (hash) union-find in time
+    complexity O(1).
+
+    @param[in] uf = union-find
+
+    @return number of sets
+
+    \hideinitializer */
+#define SCEDA_hashunionfind_count(uf$) (SCEDA_unionfind_count(&(uf$)->uf))
+
+#endif
@@ -23,6 +23,94 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "typed_vector.h"
+
+/* Hash tables have a power-of-two number of buckets, so that no
+   division is needed to compute the home bucket of a hash code.
+
+   By default, the topmost bits of the hash code are folded onto its
+   lowest bits: consecutive hash codes (such as vertex/edge ids) go to
+   consecutive buckets, which preserves their allocation order. Define
+   FIBONACCI_HASHING to use Fibonacci (multiplicative) hashing instead,
+   for hash functions whose lowest bits are poorly distributed. */
+#define HASH_MIN_BUCKETS 8
+#define hash_shift(buckets) (32 - __builtin_ctz(buckets))
+#define hash_buckets(capacity) \
+  ({ int b = HASH_MIN_BUCKETS; \
+     while(4 * (capacity) > 3 * b) b *= 2; \
+     b; })
+#ifdef FIBONACCI_HASHING
+#define hash_index(h, shift) ((unsigned int)((h) * 2654435769u) >> (shift))
+#else
+#define hash_index(h, shift) (((h) ^ ((h) >> (shift))) & ((1u << (32 - (shift))) - 1))
+#endif
+
+/* Each table xors the hash codes with its own seed. Otherwise,
+   iterating over a table and inserting into another one would visit
+   the home buckets in order, which builds huge clusters when the
+   target table is smaller. Tables may be created from several threads
+   at once. (SCEDA_hash_seed is declared in common.h and defined in
+   hashset.c) */
+
+/* Swiss tables (SCEDA_HASH_SWISS layout) keep a control byte per
+   bucket: SWISS_EMPTY, SWISS_DELETED or 7 bits of the hash code
+   (swiss_h2, taken from the top bits of a Fibonacci product, so that
+   consecutive hash codes get different bytes). Buckets are probed by
+   aligned groups of SWISS_GROUP control bytes: swiss_match* return
+   the bit mask of the bytes of a group that are equal to h2, empty,
+   or free (empty or deleted). */
+#define SWISS_GROUP_SHIFT 4
+#define SWISS_GROUP (1 << SWISS_GROUP_SHIFT)
+#define SWISS_EMPTY 0x80
+#define SWISS_DELETED 0xfe
+#define swiss_h2(h) ((unsigned char)(((h) * 2654435769u) >> 25))
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+
+static inline unsigned int swiss_match(const unsigned char *group, unsigned char h2) {
+  __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)h2)));
+}
+
+static inline unsigned int swiss_match_empty(const unsigned char *group) {
+  return swiss_match(group, SWISS_EMPTY);
+}
+
+static inline unsigned int swiss_match_free(const unsigned char *group) {
+  // only empty and deleted bytes have their top bit set
+  return _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+}
+#else
+static inline unsigned int swiss_match(const unsigned char *group, unsigned char h2) {
+  unsigned int m = 0;
+  int i;
+  for(i = 0; i < SWISS_GROUP; i++) {
+    m |= (unsigned int)(group[i] == h2) << i;
+  }
+  return m;
+}
+
+static inline unsigned int swiss_match_empty(const unsigned char *group) {
+  return swiss_match(group, SWISS_EMPTY);
+}
+
+static inline unsigned int swiss_match_free(const unsigned char *group) {
+  unsigned int m = 0;
+  int i;
+  for(i = 0; i < SWISS_GROUP; i++) {
+    m |= (unsigned int)(group[i] >> 7) << i;
+  }
+  return m;
+}
+#endif
+
+/* Batched operations (*_many) hash up to HASH_BATCH keys and prefetch
+   their home buckets before probing the table for any of them, so
+   that the cache misses of independent keys overlap. */
+#define HASH_BATCH 16
+#define hash_prefetch(p) (__builtin_prefetch(p))
+
 #ifdef UNSAFE
 #undef UNSAFE
 #define UNSAFE 1
@@ -38,6 +126,8 @@
 
 #define safe_strdup(s) (strdup(s))
 
+#define alloc_malloc(a, size) ((a)->alloc(size, (a)->ctxt))
+
 #define safe_call(x) (x)
 
 #define safe_ptr(x)
@@ -72,6 +162,11 @@
      if(res == NULL) fail("out of memory"); \
      res; })
 
+#define alloc_malloc(a, size) \
+  ({ void *res = (a)->alloc(size, (a)->ctxt); \
+     if(res == NULL) fail("out of memory"); \
+     res; })
+
 #define safe_call(x) \
   ({ if((x) != 0) fail("unsafe call"); })
 
@@ -83,4 +178,24 @@
 
 #endif
 
+/* Allocations through a SCEDA_Allocator (see allocator.h) */
+#define alloc_calloc(a, nmemb, size) \
+  ({ size_t alloc_len = (nmemb) * (size); \
+     void *alloc_res = alloc_malloc(a, alloc_len); \
+     memset(alloc_res, 0, alloc_len); \
+     alloc_res; })
+
+#define alloc_free(a, ptr, size) \
+  ({ if((a)->free != NULL) (a)->free(ptr, size, (a)->ctxt); })
+
+#define alloc_realloc(a, ptr, old_size, size) \
+  ({ void *alloc_res = alloc_malloc(a, size); \
+     memcpy(alloc_res, ptr, ((old_size) < (size)) ? (old_size) : (size)); \
+     alloc_free(a, ptr, old_size); \
+     alloc_res; })
+
+/* Growable arrays of integers, such as the per-vertex tables of graph
+   algorithms (see typed_vector.h) */
+SCEDA_DEFINE_VECTOR(SCEDA_IntVector, int)
+
 #endif
@@ -0,0 +1,248 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#include <string.h>
+#include "vector.h"
+#include "util.h"
+
+void SCEDA_vector_init_with_allocator(SCEDA_Vector *vector, SCEDA_Allocator *alloc, SCEDA_delete_fun delete) {
+  vector->size = 0;
+  vector->length = 0;
+  vector->delete = delete;
+  vector->alloc = alloc;
+  vector->elts = NULL;
+}
+
+void SCEDA_vector_init(SCEDA_Vector *vector, SCEDA_delete_fun delete) {
+  SCEDA_vector_init_with_allocator(vector, SCEDA_allocator_get_default(), delete);
+}
+
+SCEDA_Vector *SCEDA_vector_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete) {
+  SCEDA_Vector *vector = (SCEDA_Vector *)alloc_malloc(alloc, sizeof(SCEDA_Vector));
+  SCEDA_vector_init_with_allocator(vector, alloc, delete);
+  return vector;
+}
+
+SCEDA_Vector *SCEDA_vector_create(SCEDA_delete_fun delete) {
+  return SCEDA_vector_create_with_allocator(SCEDA_allocator_get_default(), delete);
+}
+
+/* Delete the elements from position i to the end */
+static void SCEDA_vector_cleanup_elts(SCEDA_Vector *vector, int i) {
+  if(vector->delete != NULL) {
+    int j;
+    for(j = vector->size - 1; j >= i; j--) {
+      vector->delete(SCEDA_vector_nth(vector, j));
+    }
+  }
+}
+
+void SCEDA_vector_cleanup(SCEDA_Vector *vector) {
+  SCEDA_vector_cleanup_elts(vector, 0);
+  SCEDA_Allocator *alloc = vector->alloc;
+  if(vector->elts != NULL) {
+    alloc_free(alloc, vector->elts, vector->length * sizeof(void *));
+  }
+  // keep the allocator, so that the vector can still be cleaned up or deleted
+  memset(vector, 0, sizeof(SCEDA_Vector));
+  vector->alloc = alloc;
+}
+
+void SCEDA_vector_delete(SCEDA_Vector *vector) {
+  SCEDA_Allocator *alloc = vector->alloc;
+  SCEDA_vector_cleanup(vector);
+  alloc_free(alloc, vector, sizeof(SCEDA_Vector));
+}
+
+void SCEDA_vector_clear(SCEDA_Vector *vector) {
+  SCEDA_vector_cleanup_elts(vector, 0);
+  vector->size = 0;
+}
+
+/* Reallocate the array to the given length (at least the size). The
+   vector is left unchanged if the allocation fails. */
+static int SCEDA_vector_set_length(SCEDA_Vector *vector, int length) {
+  if(length == vector->length) {
+    return 0;
+  }
+  if(length == 0) {
+    alloc_free(vector->alloc, vector->elts, vector->length * sizeof(void *));
+    vector->elts = NULL;
+  } else {
+    void *(*elts)[] = alloc_malloc(vector->alloc, length * sizeof(void *));
+    if(elts == NULL) {
+      return -1;
+    }
+    if(vector->elts != NULL) {
+      memcpy(elts, vector->elts, vector->size * sizeof(void *));
+      alloc_free(vector->alloc, vector->elts, vector->length * sizeof(void *));
+    }
+    vector->elts = elts;
+  }
+  vector->length = length;
+  return 0;
+}
+
+int SCEDA_vector_grow(SCEDA_Vector *vector) {
+  return SCEDA_vector_set_length(vector, (vector->length == 0) ? SCEDA_DFLT_SIZE : 2 * vector->length);
+}
+
+int SCEDA_vector_reserve(SCEDA_Vector *vector, int capacity) {
+  if(capacity > vector->length) {
+    return SCEDA_vector_set_length(vector, capacity);
+  }
+  return 0;
+}
+
+int SCEDA_vector_shrink(SCEDA_Vector *vector) {
+  return SCEDA_vector_set_length(vector, vector->size);
+}
+
+int SCEDA_vector_resize(SCEDA_Vector *vector, int size) {
+  if(size < vector->size) {
+    SCEDA_vector_cleanup_elts(vector, size);
+  } else if(size > vector->size) {
+    if(SCEDA_vector_reserve(vector, size) != 0) {
+      return -1;
+    }
+    memset(&SCEDA_vector_nth(vector, vector->size), 0, (size - vector->size) * sizeof(void *));
+  }
+  vector->size = size;
+  return 0;
+}
+
+int SCEDA_vector_insert_array(SCEDA_Vector *vector, int i, void *data[], int count) {
+  if((i < 0) || (i > vector->size) || (count < 0)) {
+    return -1;
+  }
+  if(vector->size + count > vector->length) {
+    int length = (vector->length == 0) ? SCEDA_DFLT_SIZE : 2 * vector->length;
+    if(length < vector->size + count) {
+      length = vector->size + count;
+    }
+    if(SCEDA_vector_set_length(vector, length) != 0) {
+      return -1;
+    }
+  }
+  if(count > 0) {
+    memmove(&SCEDA_vector_nth(vector, i + count), &SCEDA_vector_nth(vector, i), (vector->size - i) * sizeof(void *));
+    memcpy(&SCEDA_vector_nth(vector, i), data, count * sizeof(void *));
+    vector->size += count;
+  }
+  return 0;
+}
+
+int SCEDA_vector_insert(SCEDA_Vector *vector, int i, const void *data) {
+  void *x = (void *)data;
+  return SCEDA_vector_insert_array(vector, i, &x, 1);
+}
+
+int SCEDA_vector_remove(SCEDA_Vector *vector, int i, void **data) {
+  if((i < 0) || (i >= vector->size)) {
+    return -1;
+  }
+  *data = SCEDA_vector_nth(vector, i);
+  vector->size--;
+  memmove(&SCEDA_vector_nth(vector, i), &SCEDA_vector_nth(vector, i + 1), (vector->size - i) * sizeof(void *));
+  return 0;
+}
+
+/* Runs shorter than this are sorted by insertion */
+#define SCEDA_VECTOR_RUN 16
+
+static void SCEDA_vector_insertion_sort(void **elts, int n, SCEDA_compare_fun compare) {
+  int i;
+  for(i = 1; i < n; i++) {
+    void *x = elts[i];
+    int j = i;
+    while((j > 0) && (compare(elts[j-1], x) > 0)) {
+      elts[j] = elts[j-1];
+      j--;
+    }
+    elts[j] = x;
+  }
+}
+
+/* Merge the sorted runs src[lo..mid) and src[mid..hi) into dst[lo..hi) */
+static void SCEDA_vector_merge(void **src, void **dst, int lo, int mid, int hi, SCEDA_compare_fun compare) {
+  int i = lo;
+  int j = mid;
+  int k;
+  for(k = lo; k < hi; k++) {
+    if((i < mid) && ((j >= hi) || (compare(src[i], src[j]) <= 0))) {
+      dst[k] = src[i++];
+    } else {
+      dst[k] = src[j++];
+    }
+  }
+}
+
+/* Bottom-up merge sort */
+void SCEDA_vector_sort(SCEDA_Vector *vector, SCEDA_compare_fun compare) {
+  int n = vector->size;
+  if(n <= 1) {
+    return;
+  }
+
+  void **elts = &SCEDA_vector_nth(vector, 0);
+  int lo;
+  for(lo = 0; lo < n; lo += SCEDA_VECTOR_RUN) {
+    int len = (n - lo < SCEDA_VECTOR_RUN) ? n - lo : SCEDA_VECTOR_RUN;
+    SCEDA_vector_insertion_sort(elts + lo, len, compare);
+  }
+  if(n <= SCEDA_VECTOR_RUN) {
+    return;
+  }
+
+  void **tmp = alloc_malloc(vector->alloc, n * sizeof(void *));
+  void **src = elts;
+  void **dst = tmp;
+  int width;
+  for(width = SCEDA_VECTOR_RUN; width < n; width *= 2) {
+    for(lo = 0; lo < n; lo += 2 * width) {
+      int mid = (lo + width < n) ? lo + width : n;
+      int hi = (lo + 2 * width < n) ? lo + 2 * width : n;
+      SCEDA_vector_merge(src, dst, lo, mid, hi, compare);
+    }
+    void **swap = src;
+    src = dst;
+    dst = swap;
+  }
+  if(src != elts) {
+    memcpy(elts, src, n * sizeof(void *));
+  }
+  alloc_free(vector->alloc, tmp, n * sizeof(void *));
+}
+
+int SCEDA_vector_bsearch(SCEDA_Vector *vector, const void *data, SCEDA_compare_fun compare) {
+  int lo = 0;
+  int hi = vector->size;
+  while(lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if(compare(SCEDA_vector_nth(vector, mid), data) < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  if((lo < vector->size) && (compare(SCEDA_vector_nth(vector, lo), data) == 0)) {
+    return lo;
+  }
+  return -1;
+}
@@ -0,0 +1,279 @@
+/*
+   Copyright Sebastien Briais 2008, 2009
+
+   This file is part of SCEDA.
+
+   SCEDA is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   SCEDA is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with SCEDA.  If not, see
+   <http://www.gnu.org/licenses/>.
+*/
+#ifndef __SCEDA_VECTOR_H
+#define __SCEDA_VECTOR_H
+/** \file vector.h
+    \brief growable arrays */
+
+#include "common.h"
+#include <string.h>
+
+/** Vector, i.e. growable array of pointers. The array is allocated on
+    the first insertion. */
+typedef struct {
+  int size;
+  int length;
+  SCEDA_delete_fun delete;
+  SCEDA_Allocator *alloc;
+  void *(*elts)[];
+} SCEDA_Vector;
+
+/** Initialise a vector.
+
+    @param[in] vector = vector to initialise
+    @param[in] delete = function to delete data or NULL */
+void SCEDA_vector_init(SCEDA_Vector *vector, SCEDA_delete_fun delete);
+
+/** Initialise a vector whose array is allocated by a given allocator.
+
+    @param[in] vector = vector to initialise
+    @param[in] alloc = allocator
+    @param[in] delete = function to delete data or NULL */
+void SCEDA_vector_init_with_allocator(SCEDA_Vector *vector, SCEDA_Allocator *alloc, SCEDA_delete_fun delete);
+
+/** Create a vector, ready for use.
+
+    @param[in] delete = function to delete data or NULL
+
+    @return the vector */
+SCEDA_Vector *SCEDA_vector_create(SCEDA_delete_fun delete);
+
+/** Create a vector, ready for use. The vector and its array are
+    allocated by the given allocator.
+
+    @param[in] alloc = allocator
+    @param[in] delete = function to delete data or NULL
+
+    @return the vector */
+SCEDA_Vector *SCEDA_vector_create_with_allocator(SCEDA_Allocator *alloc, SCEDA_delete_fun delete);
+
+/** Clean up a vector.
+
+    @param[in] vector = vector to clean up */
+void SCEDA_vector_cleanup(SCEDA_Vector *vector);
+
+/** Delete a vector.
+
+    @param[in] vector = vector to delete */
+void SCEDA_vector_delete(SCEDA_Vector *vector);
+
+/** Clear a vector. The array is kept.
+
+    @param[in] vector = vector to clear */
+void SCEDA_vector_clear(SCEDA_Vector *vector);
+
+/** Make room for capacity elements in a vector, so that it is not
+    reallocated until it holds more elements.
+
+    @param[in] vector = vector
+    @param[in] capacity = expected number of elements
+
+    @return 0 in case of success, -1 otherwise */
+int SCEDA_vector_reserve(SCEDA_Vector *vector, int capacity);
+
+/** Shrink the array of a vector to the size of the vector.
+
+    @param[in] vector = vector
+
+    @return 0 in case of success, -1 otherwise */
+int SCEDA_vector_shrink(SCEDA_Vector *vector);
+
+/** Change the size of a vector. New elements are NULL. Removed
+    elements are deleted according to the delete function.
+
+    @param[in] vector = vector
+    @param[in] size = new size
+
+    @return 0 in case of success, -1 otherwise */
+int SCEDA_vector_resize(SCEDA_Vector *vector, int size);
+
+/** Double the length of the array of a vector (internal use).
+
+    @param[in] vector = vector
+
+    @return 0 in case of success, -1 otherwise */
+int SCEDA_vector_grow(SCEDA_Vector *vector);
+
+#define SCEDA_vector_nth(vector$, i$) ((*((vector$)->elts))[i$])
+
+/** Add an element at the end of a vector in amortized time complexity
+    O(1).
+
+    @param[in] vector = vector
+    @param[in] data = data to add
+
+    @return 0 in case of success, -1 otherwise
+
+    \hideinitializer */
+#define SCEDA_vector_push(vector$, data$) \
+  ({ SCEDA_Vector *_vector = (vector$); \
+     int _res = -1; \
+     if((_vector->size < _vector->length) || (SCEDA_vector_grow(_vector) == 0)) { \
+       SCEDA_vector_nth(_vector, _vector->size++) = (void *)(data$); \
+       _res = 0; \
+     } \
+     _res; })
+
+/** Remove the last element of a vector in time complexity O(1).
+
+    @param[in] vector = vector
+    @param[out] data = removed data
+
+    @return 0 in case of success, -1 otherwise
+
+    \hideinitializer */
+#define SCEDA_vector_pop(vector$, data$) \
+  ({ SCEDA_Vector *_vector = (vector$); \
+     int _res = -1; \
+     if(_vector->size > 0) { \
+       *(data$) = SCEDA_vector_nth(_vector, --_vector->size); \
+       _res = 0; \
+     } \
+     _res; })
+
+/** Return the i-th element of a vector in time complexity O(1). The
+    index is not checked.
+
+    @param type = type of elements in the vector
+    @param[in] vector = vector
+    @param[in] i = index
+
+    @return the i-th element
+
+    \hideinitializer */
+#define SCEDA_vector_get(type$, vector$, i$) ((type$)SCEDA_vector_nth(vector$, i$))
+
+/** Replace the i-th element of a vector in time complexity O(1). The
+    index is not checked and the replaced element is not deleted.
+
+    @param[in] vector = vector
+    @param[in] i = index
+    @param[in] data = new data
+
+    \hideinitializer */
+#define SCEDA_vector_set(vector$, i$, data$) (SCEDA_vector_nth(vector$, i$) = (void *)(data$))
+
+/** Insert an element at a given position (between 0 and the size of
+    the vector) in time complexity O(n). The following elements are
+    moved one position up.
+
+    @param[in] vector = vector
+    @param[in] i = position
+    @param[in] data = data to insert
+
+    @return 0 in case of success, -1 otherwise */
+int SCEDA_vector_insert(SCEDA_Vector *vector, int i, const void *data);
+
+/** Insert count elements at a given position (between 0 and the size
+    of the vector) in time complexity O(n + count). The array is grown
+    at most once.
+
+    @param[in] vector = vector
+    @param[in] i = position
+    @param[in] data = array of count data to insert
+    @param[in] count = number of elements to insert
+
+    @return 0 in case of success, -1 otherwise */
+int SCEDA_vector_insert_array(SCEDA_Vector *vector, int i, void *data[], int count);
+
+/** Remove the element at a given position in time complexity O(n).
+    The following elements are moved one position down.
+
+    @param[in] vector = vector
+    @param[in] i = position
+    @param[out] data = removed data
+
+    @return 0 in case of success, -1 otherwise */
+int SCEDA_vector_remove(SCEDA_Vector *vector, int i, void **data);
+
+/** Sort a vector in time complexity O(n.log(n)). The sort is stable.
+
+    @param[in] vector = vector
+    @param[in] compare = comparison function */
+void SCEDA_vector_sort(SCEDA_Vector *vector, SCEDA_compare_fun compare);
+
+/** Look for an element in a sorted vector in time complexity
+    O(log(n)).
+
+    @param[in] vector = vector sorted according to compare
+    @param[in] data = data to look for
+    @param[in] compare = comparison function
+
+    @return the position of the first element equal to data, or -1 if
+    there is none */
+int SCEDA_vector_bsearch(SCEDA_Vector *vector, const void *data, SCEDA_compare_fun compare);
+
+/** Give the size of the vector.
+
+    \hideinitializer */
+#define SCEDA_vector_size(vector$) ((vector$)->size)
+
+/** SCEDA_Vector is empty?
+
+    \hideinitializer */
+#define SCEDA_vector_is_empty(vector$) (SCEDA_vector_size(vector$) == 0)
+
+/** Vector iterator */
+typedef struct {
+  int i;
+  SCEDA_Vector *vector;
+} SCEDA_VectorIterator;
+
+/** Initialise a vector iterator.
+
+    @param[in] vector = vector
+    @param[in] iter = vector iterator
+
+    \hideinitializer */
+#define SCEDA_vector_iterator_init(vector$, iter$) \
+  ({ SCEDA_VectorIterator *_iter = (iter$); \
+     _iter->i = 0; \
+     _iter->vector = (vector$); })
+
+/** Test whether there is a next element in the vector iterator.
+
+    @param[in] iter = vector iterator
+
+    @return TRUE if there is a "next" element, FALSE otherwise
+
+    \hideinitializer */
+#define SCEDA_vector_iterator_has_next(iter$) \
+  ({ SCEDA_VectorIterator *_iter = (iter$); \
+     (_iter->i < _iter->vector->size); })
+
+/** Return the next element of the vector iterator.
+
+    @param[in] iter = vector iterator
+
+    @return the "next" element
+
+    \hideinitializer */
+#define SCEDA_vector_iterator_next(iter$) \
+  ({ SCEDA_VectorIterator *_iter = (iter$); \
+     SCEDA_vector_nth(_iter->vector, _iter->i++); })
+
+/** Clean up a vector iterator.
+
+    @param[in] iter = vector iterator
+
+    \hideinitializer */
+#define SCEDA_vector_iterator_cleanup(iter$) (memset(iter$, 0, sizeof(SCEDA_VectorIterator)))
+
+#endif